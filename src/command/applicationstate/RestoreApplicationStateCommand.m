@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2013-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2013-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -24,6 +24,7 @@
 #import "../../go/GoGame.h"
 #import "../../go/GoScore.h"
 #import "../../go/GoUtilities.h"
+#import "../../gtp/GtpAnalysisCache.h"
 #import "../../main/ApplicationDelegate.h"
 #import "../../ui/UiSettingsModel.h"
 #import "../../utility/PathUtilities.h"
@@ -46,6 +47,8 @@
 
   GoGame* unarchivedGame = unarchiveGameCommand.game;
 
+  [self restoreAnalysisCache];
+
   [GoUtilities relinkMoves:unarchivedGame];
   [GoUtilities recalculateZobristHashes:unarchivedGame];
 
@@ -115,4 +118,23 @@
   return true;
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Private helper for doIt(). Restores the content of GtpAnalysisCache
+/// if it was saved by SaveApplicationStateCommand. Failure to do so is not
+/// treated as an error, because the cache content can always be regenerated.
+// -----------------------------------------------------------------------------
+- (void) restoreAnalysisCache
+{
+  GtpAnalysisCache* analysisCache = [ApplicationDelegate sharedDelegate].gtpAnalysisCache;
+  if (! analysisCache)
+    return;
+  BOOL fileExists;
+  NSString* analysisCachePath = [PathUtilities filePathForBackupFileNamed:analysisCacheBackupFileName
+                                                               fileExists:&fileExists];
+  if (! fileExists)
+    return;
+  if (! [analysisCache readFromFile:analysisCachePath])
+    DDLogWarn(@"%@: Failed to restore analysis cache file %@", [self shortDescription], analysisCachePath);
+}
+
 @end
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2013-2015 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2013-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -32,6 +32,11 @@
 ///
 /// The NSCoding archive is overwritten if it already exists.
 ///
+/// If this is enabled in the user defaults, SaveApplicationStateCommand also
+/// saves the content of GtpAnalysisCache next to the NSCoding archive. Failure
+/// to do so is not treated as an error, because the cache content can always
+/// be regenerated.
+///
 /// SaveApplicationStateCommand executes synchronously.
 ///
 /// @see RestoreApplicationStateCommand.
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2013-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2013-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -18,6 +18,8 @@
 // Project includes
 #import "SaveApplicationStateCommand.h"
 #import "../../go/GoGame.h"
+#import "../../gtp/GtpAnalysisCache.h"
+#import "../../main/ApplicationDelegate.h"
 #import "../../utility/PathUtilities.h"
 
 
@@ -49,7 +51,27 @@
     @throw exception;
   }
 
+  [self saveAnalysisCache];
+
   return true;
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Private helper for doIt(). Saves the content of GtpAnalysisCache if
+/// this is enabled in the user defaults.
+// -----------------------------------------------------------------------------
+- (void) saveAnalysisCache
+{
+  GtpAnalysisCache* analysisCache = [ApplicationDelegate sharedDelegate].gtpAnalysisCache;
+  if (! analysisCache)
+    return;
+  NSDictionary* dictionary = [[NSUserDefaults standardUserDefaults] dictionaryForKey:gtpEngineConfigurationKey];
+  if (! [[dictionary valueForKey:persistAnalysisCacheKey] boolValue])
+    return;
+
+  NSString* analysisCachePath = [[PathUtilities backupFolderPath] stringByAppendingPathComponent:analysisCacheBackupFileName];
+  if (! [analysisCache writeToFile:analysisCachePath])
+    DDLogWarn(@"%@: Failed to save analysis cache file %@", [self shortDescription], analysisCachePath);
+}
+
 @end
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2013-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2013-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -43,6 +43,23 @@ enum SyncBoardPositionType
 ///
 /// Board positions for nodes that contain neither setup nor a move are ignored.
 ///
+/// SyncGTPEngineCommand synchronizes incrementally if possible. It asks the
+/// GtpEnginePositionTracker for the moves that the GTP engine has currently
+/// played. If the GTP engine was set up with the same komi, handicap/setup
+/// stones and setup player as the target board position, only the difference
+/// is sent to the GTP engine: A single "gg-undo" command that takes back the
+/// moves that are not shared by the GTP engine's and the target board
+/// position, followed by a single "gogui-play_sequence" command that plays the
+/// remaining moves up to the target board position. This preserves the GTP
+/// engine's search tree as much as possible and makes stepping through a long
+/// game cheap.
+///
+/// If incremental synchronization is not possible (e.g. because a new game was
+/// started, a different setup is needed, or the tracked board position is
+/// invalid) or if it fails, SyncGTPEngineCommand performs a full
+/// synchronization: It clears the board and sends the setup and all moves up
+/// to the target board position.
+///
 /// If execution of SyncGTPEngineCommand fails, the GTP engine is left in an
 /// unknown state.
 // -----------------------------------------------------------------------------
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2013-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2013-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -27,8 +27,12 @@
 #import "../../go/GoPoint.h"
 #import "../../go/GoUtilities.h"
 #import "../../go/GoVertex.h"
+#import "../../gtp/GtpClient.h"
 #import "../../gtp/GtpCommand.h"
+#import "../../gtp/GtpEnginePool.h"
+#import "../../gtp/GtpEnginePositionTracker.h"
 #import "../../gtp/GtpResponse.h"
+#import "../../main/ApplicationDelegate.h"
 
 
 // -----------------------------------------------------------------------------
@@ -73,38 +77,62 @@
 // -----------------------------------------------------------------------------
 - (bool) doIt
 {
+  // A move suggestion that has not yet been generated would refer to the board
+  // position that the GTP engine is about to leave
+  [[ApplicationDelegate sharedDelegate].gtpEnginePool cancelCommandsWithCoalescingKey:moveSuggestionGtpCommandCoalescingKey];
+
   GoNode* syncUpToThisNode = [self findNodeUpToWhichToSync];
   GoNodeSetup* nodeSetupUpToWhichToSync = [self findeNodeSetupUpToWhichToSync:syncUpToThisNode];
   GoMove* syncUpToThisMove = [self findeMoveUpToWhichToSync:syncUpToThisNode];
 
-  // This clears all board state related parameters (handicap, komi, setup
-  // stones, setup player, moves) but leaves board size, game rules and player
-  // configuration (e.g. UCT parameters) untouched
-  if (! [self syncGTPEngineClearBoard])
+  NSArray* setupCommands = [self setupCommandsForNodeSetup:nodeSetupUpToWhichToSync];
+  if (! setupCommands)
   {
-    DDLogError(@"%@: Aborting because syncGTPEngineClearBoard failed: %@", [self shortDescription], self.errorDescription);
+    DDLogError(@"%@: Aborting because setupCommandsForNodeSetup failed: %@", [self shortDescription], self.errorDescription);
     return false;
   }
 
-  if (! [self syncGTPEngineKomi])
+  NSArray* moves = [self movesUpToMove:syncUpToThisMove];
+  if (! moves)
   {
-    DDLogError(@"%@: Aborting because syncGTPEngineKomi failed: %@", [self shortDescription], self.errorDescription);
+    DDLogError(@"%@: Aborting because movesUpToMove failed: %@", [self shortDescription], self.errorDescription);
     return false;
   }
 
-  if (! [self syncGTPEngineHandicapAndSetupStones:nodeSetupUpToWhichToSync])
+  // The tracker only returns the moves that the GTP engine has played if the
+  // GTP engine was set up in the same way that we would set it up now
+  GtpEnginePositionTracker* positionTracker = [ApplicationDelegate sharedDelegate].gtpClient.positionTracker;
+  NSArray* movesInGtpEngine = [positionTracker movesIfSetupCommandsMatch:setupCommands];
+  if (movesInGtpEngine)
   {
-    DDLogError(@"%@: Aborting because syncGTPEngineHandicapAndSetupStones failed: %@", [self shortDescription], self.errorDescription);
-    return false;
+    if ([self syncGTPEngineMovesIncrementallyFrom:movesInGtpEngine to:moves])
+      return true;
+
+    // A failed command has already caused the tracker to invalidate its
+    // board position, so the next SyncGTPEngineCommand will also perform a
+    // full synchronization
+    DDLogWarn(@"%@: syncGTPEngineMovesIncrementallyFrom:to: failed, falling back to full synchronization: %@", [self shortDescription], self.errorDescription);
   }
 
-  if (! [self syncGTPEngineSetupPlayer:nodeSetupUpToWhichToSync])
+  // This clears all board state related parameters (handicap, komi, setup
+  // stones, setup player, moves) but leaves board size, game rules and player
+  // configuration (e.g. UCT parameters) untouched
+  if (! [self syncGTPEngineClearBoard])
   {
-    DDLogError(@"%@: Aborting because syncGTPEngineSetupPlayer failed: %@", [self shortDescription], self.errorDescription);
+    DDLogError(@"%@: Aborting because syncGTPEngineClearBoard failed: %@", [self shortDescription], self.errorDescription);
     return false;
   }
 
-  if (! [self syncGTPEngineMoves:syncUpToThisMove])
+  for (NSString* setupCommand in setupCommands)
+  {
+    if (! [self submitCommandString:setupCommand])
+    {
+      DDLogError(@"%@: Aborting because setup command '%@' failed: %@", [self shortDescription], setupCommand, self.errorDescription);
+      return false;
+    }
+  }
+
+  if (! [self syncGTPEngineMoves:moves])
   {
     DDLogError(@"%@: Aborting because syncGTPEngineMoves failed: %@", [self shortDescription], self.errorDescription);
     return false;
@@ -190,35 +218,46 @@
 // -----------------------------------------------------------------------------
 - (bool) syncGTPEngineClearBoard
 {
-  GtpCommand* commandClearBoard = [GtpCommand command:@"clear_board"];
-  [commandClearBoard submit];
-  assert(commandClearBoard.response.status);
-  if (commandClearBoard.response.status)
-    self.errorDescription = commandClearBoard.response.parsedResponse;
-  return commandClearBoard.response.status;
+  return [self submitCommandString:@"clear_board"];
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Private helper for doIt(). Returns true on success, false on failure.
+/// @brief Private helper for doIt(). Returns the list of GTP commands that set
+/// up the board state on top of a cleared board: Komi, handicap and setup
+/// stones, and setup player. The commands are returned in the order in which
+/// they must be submitted. Returns @e nil on failure.
+///
+/// The GTP engine's board position tracker compares the returned command
+/// strings verbatim against the commands that were last used to set up the
+/// GTP engine. The command strings generated by this method therefore must be
+/// deterministic.
 // -----------------------------------------------------------------------------
-- (bool) syncGTPEngineKomi
+- (NSArray*) setupCommandsForNodeSetup:(GoNodeSetup*)nodeSetupUpToWhichToSync
 {
+  NSMutableArray* setupCommands = [NSMutableArray array];
+
+  // The GTP command "clear_board" causes Fuego to reset komi to the last value
+  // that was explicitly set with the GTP command "komi" (or to the built-in
+  // default komi value, in case no "komi" command was ever sent). Therefore,
+  // unlike handicap we always have to setup komi.
   GoGame* game = [GoGame sharedGame];
+  [setupCommands addObject:[NSString stringWithFormat:@"komi %.1f", game.komi]];
 
-  // The previously sent GTP command "clear_board" has caused Fuego to reset
-  // komi to the last value that was explicitly set with the GTP command "komi"
-  // (or to the built-in default komi value, in case no "komi" command was ever
-  // sent). Therefore, unlike handicap we always have to setup komi.
-  GtpCommand* command = [GtpCommand command:[NSString stringWithFormat:@"komi %.1f", game.komi]];
-  [command submit];
-  assert(command.response.status);
-  if (! command.response.status)
-    self.errorDescription = command.response.parsedResponse;
-  return command.response.status;
+  NSString* setupStonesCommand = [self handicapAndSetupStonesCommand:nodeSetupUpToWhichToSync];
+  if (setupStonesCommand)
+    [setupCommands addObject:setupStonesCommand];
+
+  NSString* setupPlayerCommand = [self setupPlayerCommand:nodeSetupUpToWhichToSync];
+  if (setupPlayerCommand)
+    [setupCommands addObject:setupPlayerCommand];
+
+  return setupCommands;
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Private helper for doIt(). Returns true on success, false on failure.
+/// @brief Private helper for setupCommandsForNodeSetup:(). Returns the
+/// "gogui-setup" command string that sets up handicap and setup stones, or
+/// @e nil if there are no stones to set up.
 ///
 /// The "gogui-setup" command does not allow to clear stones, so we can't just
 /// submit one "gogui-setup" command for each GoNodeSetup. Also we can't submit
@@ -235,7 +274,7 @@
 /// has shown that Fuego does not use the @e number of handicap stones for the
 /// evaluation of the board position.
 // -----------------------------------------------------------------------------
-- (bool) syncGTPEngineHandicapAndSetupStones:(GoNodeSetup*)nodeSetupUpToWhichToSync
+- (NSString*) handicapAndSetupStonesCommand:(GoNodeSetup*)nodeSetupUpToWhichToSync
 {
   NSMutableArray* blackSetupPoints = [NSMutableArray array];
   NSMutableArray* whiteSetupPoints = [NSMutableArray array];
@@ -264,55 +303,33 @@
   }
 
   if (blackSetupPoints.count == 0 && whiteSetupPoints.count == 0)
-    return true;
-
-  NSString* commandString = @"gogui-setup";
-  for (NSNumber* stoneColorAsNumber in @[[NSNumber numberWithInt:GoColorBlack], [NSNumber numberWithInt:GoColorWhite]])
-  {
-    enum GoColor stoneColor = [stoneColorAsNumber intValue];
-
-    NSArray* setupPoints;
-    NSString* colorString;
-    if (stoneColor == GoColorBlack)
-    {
-      setupPoints = blackSetupPoints;
-      colorString = @"B";
-    }
-    else
-    {
-      setupPoints = whiteSetupPoints;
-      colorString = @"W";
-    }
+    return nil;
 
-    for (GoPoint* setupPoint in setupPoints)
-    {
-      NSString* setupStoneString = [NSString stringWithFormat:@" %@ %@", colorString, setupPoint.vertex.string];
-      commandString = [commandString stringByAppendingString:setupStoneString];
-    }
-  }
+  NSMutableString* commandString = [NSMutableString stringWithString:@"gogui-setup"];
+  for (GoPoint* setupPoint in blackSetupPoints)
+    [commandString appendFormat:@" B %@", setupPoint.vertex.string];
+  for (GoPoint* setupPoint in whiteSetupPoints)
+    [commandString appendFormat:@" W %@", setupPoint.vertex.string];
 
-  GtpCommand* command = [GtpCommand command:commandString];
-  [command submit];
-  assert(command.response.status);
-  if (! command.response.status)
-    self.errorDescription = command.response.parsedResponse;
-  return command.response.status;
+  return commandString;
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Private helper for doIt(). Returns true on success, false on failure.
+/// @brief Private helper for setupCommandsForNodeSetup:(). Returns the
+/// "gogui-setup_player" command string, or @e nil if no setup player needs to
+/// be set up.
 // -----------------------------------------------------------------------------
-- (bool) syncGTPEngineSetupPlayer:(GoNodeSetup*)nodeSetupUpToWhichToSync
+- (NSString*) setupPlayerCommand:(GoNodeSetup*)nodeSetupUpToWhichToSync
 {
   if (! nodeSetupUpToWhichToSync)
-    return true;
+    return nil;
 
   enum GoColor setupFirstMoveColor = nodeSetupUpToWhichToSync.setupFirstMoveColor;
   if (setupFirstMoveColor == GoColorNone)
   {
     setupFirstMoveColor = nodeSetupUpToWhichToSync.previousSetupFirstMoveColor;
     if (setupFirstMoveColor == GoColorNone)
-      return true;
+      return nil;
   }
 
   NSString* colorString;
@@ -321,27 +338,23 @@
   else
     colorString = @"W";
 
-  NSString* commandString = [NSString stringWithFormat:@"gogui-setup_player %@", colorString];
-
-  GtpCommand* command = [GtpCommand command:commandString];
-  [command submit];
-  assert(command.response.status);
-  if (! command.response.status)
-    self.errorDescription = command.response.parsedResponse;
-  return command.response.status;
+  return [NSString stringWithFormat:@"gogui-setup_player %@", colorString];
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Private helper for doIt(). Returns true on success, false on failure.
+/// @brief Private helper for doIt(). Returns the list of moves in the current
+/// game variation, up to and including @a syncUpToThisMove. The list elements
+/// are move strings in the form generated by GtpEnginePositionTracker. Returns
+/// an empty list if @a syncUpToThisMove is @e nil. Returns @e nil on failure.
 // -----------------------------------------------------------------------------
-- (bool) syncGTPEngineMoves:(GoMove*)syncUpToThisMove
+- (NSArray*) movesUpToMove:(GoMove*)syncUpToThisMove
 {
+  NSMutableArray* moves = [NSMutableArray array];
   if (! syncUpToThisMove)
-    return true;
+    return moves;
 
   GoNodeModel* nodeModel = [GoGame sharedGame].nodeModel;
 
-  NSString* commandString = @"gogui-play_sequence";
   int numberOfNodes = nodeModel.numberOfNodes;
   for (int indexOfNode = 0; indexOfNode < numberOfNodes; ++indexOfNode)
   {
@@ -350,22 +363,20 @@
     GoMove* move = node.goMove;
     if (move)
     {
-      if (move.player.black)
-        commandString = [commandString stringByAppendingString:@" B "];
-      else
-        commandString = [commandString stringByAppendingString:@" W "];
+      NSString* colorString = move.player.black ? @"B" : @"W";
       switch (move.type)
       {
         case GoMoveTypePlay:
-          commandString = [commandString stringByAppendingString:move.point.vertex.string];
+          [moves addObject:[GtpEnginePositionTracker moveStringWithColor:colorString vertex:move.point.vertex.string]];
           break;
         case GoMoveTypePass:
-          commandString = [commandString stringByAppendingString:@" PASS"];
+          [moves addObject:[GtpEnginePositionTracker moveStringWithColor:colorString vertex:@"PASS"]];
           break;
         default:
-          DDLogError(@"%@: Unexpected move type %d", [self shortDescription], move.type);
+          self.errorDescription = [NSString stringWithFormat:@"Unexpected move type %d", move.type];
+          DDLogError(@"%@: %@", [self shortDescription], self.errorDescription);
           assert(0);
-          return false;
+          return nil;
       }
 
       if (move == syncUpToThisMove)
@@ -373,12 +384,69 @@
     }
   }
 
-  GtpCommand* commandSetup = [GtpCommand command:commandString];
-  [commandSetup submit];
-  assert(commandSetup.response.status);
-  if (! commandSetup.response.status)
-    self.errorDescription = commandSetup.response.parsedResponse;
-  return commandSetup.response.status;
+  return moves;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for doIt(). Brings the GTP engine from the moves
+/// @a movesInGtpEngine to the moves @a moves by taking back moves until the
+/// common prefix of the two move lists is reached, then playing the remaining
+/// moves from @a moves. Returns true on success, false on failure.
+///
+/// Navigating one board position back or forth therefore costs only one
+/// move, instead of replaying the entire game.
+// -----------------------------------------------------------------------------
+- (bool) syncGTPEngineMovesIncrementallyFrom:(NSArray*)movesInGtpEngine to:(NSArray*)moves
+{
+  NSUInteger numberOfCommonMoves = 0;
+  NSUInteger maximumNumberOfCommonMoves = MIN(movesInGtpEngine.count, moves.count);
+  while (numberOfCommonMoves < maximumNumberOfCommonMoves &&
+         [movesInGtpEngine[numberOfCommonMoves] isEqualToString:moves[numberOfCommonMoves]])
+  {
+    numberOfCommonMoves++;
+  }
+
+  NSUInteger numberOfMovesToUndo = movesInGtpEngine.count - numberOfCommonMoves;
+  if (numberOfMovesToUndo > 0)
+  {
+    NSString* commandString = [NSString stringWithFormat:@"gg-undo %lu", (unsigned long)numberOfMovesToUndo];
+    if (! [self submitCommandString:commandString])
+      return false;
+  }
+
+  NSArray* movesToPlay = [moves subarrayWithRange:NSMakeRange(numberOfCommonMoves, moves.count - numberOfCommonMoves)];
+  return [self syncGTPEngineMoves:movesToPlay];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for doIt(). Plays the moves @a moves in a single
+/// "gogui-play_sequence" command. Returns true on success, false on failure.
+// -----------------------------------------------------------------------------
+- (bool) syncGTPEngineMoves:(NSArray*)moves
+{
+  if (moves.count == 0)
+    return true;
+
+  NSMutableString* commandString = [NSMutableString stringWithString:@"gogui-play_sequence"];
+  for (NSString* move in moves)
+    [commandString appendFormat:@" %@", move];
+
+  return [self submitCommandString:commandString];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Submits the GTP command @a commandString
+/// synchronously. Returns true on success, false on failure. On failure the
+/// property @e errorDescription is set to the GTP engine's response.
+// -----------------------------------------------------------------------------
+- (bool) submitCommandString:(NSString*)commandString
+{
+  GtpCommand* command = [GtpCommand command:commandString];
+  [command submit];
+  assert(command.response.status);
+  if (! command.response.status)
+    self.errorDescription = command.response.parsedResponse;
+  return command.response.status;
 }
 
 @end
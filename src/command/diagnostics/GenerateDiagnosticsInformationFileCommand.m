@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2012-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2012-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -21,7 +21,9 @@
 #import "../../diagnostics/BugReportUtilities.h"
 #import "../../go/GoGame.h"
 #import "../../gtp/GtpCommand.h"
+#import "../../gtp/GtpEnginePool.h"
 #import "../../gtp/GtpResponse.h"
+#import "../../gtp/GtpStatistics.h"
 #import "../../main/ApplicationDelegate.h"
 #import "../../main/MainUtility.h"
 #import "../../ui/UiUtilities.h"
@@ -109,6 +111,7 @@
     [self saveCurrentGameAsSgf];
     [self saveBoardScreenshot];
     [self saveBoardAsSeenByGtpEngine];
+    [self saveGtpStatistics];
     [self zipLogFiles];
 
     [self zipDiagnosticsInformationFolder];
@@ -279,6 +282,31 @@
                              toFile:[self.diagnosticsInformationFolderPath stringByAppendingPathComponent:bugReportBoardAsSeenByGtpEngineFileName]];
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Creates a text file that contains the timing statistics of the GTP
+/// commands that have been processed so far.
+// -----------------------------------------------------------------------------
+- (void) saveGtpStatistics
+{
+  DDLogVerbose(@"%@: Writing GTP command timing statistics to file", [self shortDescription]);
+
+  NSString* report = [[ApplicationDelegate sharedDelegate].gtpEnginePool.statistics report];
+  NSString* filePath = [self.diagnosticsInformationFolderPath stringByAppendingPathComponent:bugReportGtpStatisticsFileName];
+  BOOL success = [report writeToFile:filePath
+                          atomically:YES
+                            encoding:NSUTF8StringEncoding
+                               error:nil];
+  if (! success)
+  {
+    NSString* errorMessage = [NSString stringWithFormat:@"Failed to write GTP command timing statistics to file %@", filePath];
+    DDLogError(@"%@: %@", [self shortDescription], errorMessage);
+    NSException* exception = [NSException exceptionWithName:NSGenericException
+                                                     reason:errorMessage
+                                                   userInfo:nil];
+    @throw exception;
+  }
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Creates a .zip archive in the diagnostics information folder that
 /// contains the application log files. The .zip archive is not created if no
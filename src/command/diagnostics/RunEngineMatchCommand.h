@@ -0,0 +1,55 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Project includes
+#import "../CommandBase.h"
+#import "../AsynchronousCommand.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief The RunEngineMatchCommand class is responsible for letting the GTP
+/// engine play a number of games against itself to measure its throughput.
+/// Command execution occurs asynchronously.
+///
+/// RunEngineMatchCommand uses GtpMatchRunner with the settings of the active
+/// GTP engine profile, or the fallback profile if no profile is active. The
+/// games are played by secondary GTP engines of the application's
+/// GtpEnginePool, so the current game is not affected. If the application uses
+/// no secondary GTP engines, the games are played by the primary GTP engine.
+/// This is safe because the progress HUD locks the UI and the command blocks
+/// the command processor while the match is running, so the current game
+/// cannot submit GTP commands. The current game must not be in a state where
+/// the computer player is thinking, though. The command fails if no GTP engine
+/// is available. The results are available from the property @e report after
+/// the command has finished.
+// -----------------------------------------------------------------------------
+@interface RunEngineMatchCommand : CommandBase <AsynchronousCommand>
+{
+}
+
+- (id) init;
+
+/// @brief The number of games to play. The default is 10.
+@property(nonatomic, assign) int numberOfGames;
+/// @brief The number of games to play in parallel. The default is 1.
+@property(nonatomic, assign) int numberOfParallelGames;
+/// @brief The results of the match as human-readable text. Is @e nil until
+/// the command has finished.
+@property(nonatomic, retain) NSString* report;
+
+@end
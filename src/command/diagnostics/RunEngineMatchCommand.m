@@ -0,0 +1,96 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Project includes
+#import "RunEngineMatchCommand.h"
+#import "../../gtp/GtpMatchRunner.h"
+#import "../../main/ApplicationDelegate.h"
+#import "../../player/GtpEngineProfile.h"
+#import "../../player/GtpEngineProfileModel.h"
+
+
+@implementation RunEngineMatchCommand
+
+@synthesize asynchronousCommandDelegate;
+@synthesize showProgressHUD;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a RunEngineMatchCommand object.
+///
+/// @note This is the designated initializer of RunEngineMatchCommand.
+// -----------------------------------------------------------------------------
+- (id) init
+{
+  // Call designated initializer of superclass (CommandBase)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.showProgressHUD = true;
+  self.numberOfGames = 10;
+  self.numberOfParallelGames = 1;
+  self.report = nil;
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this RunEngineMatchCommand object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.report = nil;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Executes this command. See the class documentation for details.
+// -----------------------------------------------------------------------------
+- (bool) doIt
+{
+  GtpEngineProfileModel* profileModel = [ApplicationDelegate sharedDelegate].gtpEngineProfileModel;
+  GtpEngineProfile* profile = profileModel.activeProfile;
+  if (! profile)
+    profile = [profileModel fallbackProfile];
+
+  GtpMatchRunner* matchRunner = [[[GtpMatchRunner alloc] initWithProfile:profile] autorelease];
+  matchRunner.numberOfGames = self.numberOfGames;
+  matchRunner.numberOfParallelGames = self.numberOfParallelGames;
+
+  int numberOfGames = self.numberOfGames;
+  [self.asynchronousCommandDelegate asynchronousCommand:self
+                                            didProgress:0.0
+                                        nextStepMessage:[NSString stringWithFormat:@"Playing %d games...", numberOfGames]];
+  matchRunner.progressHandler = ^(int numberOfGamesPlayed)
+  {
+    [self.asynchronousCommandDelegate asynchronousCommand:self
+                                              didProgress:(float)numberOfGamesPlayed / numberOfGames
+                                          nextStepMessage:nil];
+  };
+
+  bool success = [matchRunner run];
+  matchRunner.progressHandler = nil;
+  if (! success)
+    return false;
+
+  self.report = [matchRunner report];
+  return true;
+}
+
+@end
@@ -0,0 +1,81 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Project includes
+#import "../CommandBase.h"
+#import "../AsynchronousCommand.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief The AnalyzeArchiveGamesCommand class is responsible for letting GTP
+/// engines analyze every board position of a number of archived games, and
+/// for storing the results in the .sgf files of those games. Command execution
+/// occurs asynchronously.
+///
+/// For each game AnalyzeArchiveGamesCommand proceeds as follows:
+/// - Read the game's .sgf file with LoadSgfCommand. The game is @b not loaded
+///   into the current game, the user's game and the GoGame object remain
+///   untouched.
+/// - Collect board size, komi, setup stones, setup player and the moves of the
+///   main variation directly from the SgfcKit document.
+/// - Let GtpBatchAnalyzer analyze the board position before the first move
+///   and after every move. GtpBatchAnalyzer reconstructs each board position
+///   on its reserved GTP engines. It uses all secondary GTP engines of the
+///   application's GtpEnginePool, or the primary GTP engine if the
+///   application uses no secondary GTP engines (user default
+///   NumberOfGtpEngines). In the latter case the primary GTP engine's board
+///   position is restored when the analysis is done.
+/// - Store the results in the SGF node that creates the board position: The
+///   estimated score in the SGF property V, and a circle symbol on the
+///   suggested move in the SGF property CR. If the suggested move is a pass
+///   or resignation, or if the node already has a symbol on the intersection,
+///   no circle is added. The estimated score is an approximation, see
+///   GtpBatchAnalysisResult.
+/// - Save the modified SgfcKit document with SaveSgfCommand, overwriting the
+///   archived .sgf file.
+///
+/// Games that contain setup after the first move are skipped, because the GTP
+/// engine cannot be set up with a board position that lies before such a
+/// setup. Games that cannot be read or saved are reported as failed.
+///
+/// The progress HUD blocks user interaction while AnalyzeArchiveGamesCommand
+/// executes. This is important if the primary GTP engine is used for the
+/// analysis, because the user's game cannot use it in the meantime.
+///
+/// AnalyzeArchiveGamesCommand records the names of the games that it has
+/// finished (successfully or not) in a progress file. If the command is
+/// interrupted, e.g. because the app is terminated, the next execution for
+/// the same set of games resumes where the previous execution left off. The
+/// progress file is removed when all games have been analyzed.
+///
+/// A throughput report is available from the property @e report after the
+/// command has finished.
+// -----------------------------------------------------------------------------
+@interface AnalyzeArchiveGamesCommand : CommandBase <AsynchronousCommand>
+{
+}
+
+- (id) initWithGames:(NSArray*)games;
+
+/// @brief The ArchiveGame objects that represent the games to analyze.
+@property(nonatomic, retain) NSArray* games;
+/// @brief The results of the analysis as human-readable text. Is @e nil until
+/// the command has finished.
+@property(nonatomic, retain) NSString* report;
+
+@end
@@ -0,0 +1,570 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Project includes
+#import "AnalyzeArchiveGamesCommand.h"
+#import "../sgf/LoadSgfCommand.h"
+#import "../sgf/SaveSgfCommand.h"
+#import "../../archive/ArchiveGame.h"
+#import "../../archive/ArchiveViewModel.h"
+#import "../../gtp/GtpBatchAnalyzer.h"
+#import "../../gtp/GtpEnginePool.h"
+#import "../../gtp/GtpEnginePositionTracker.h"
+#import "../../main/ApplicationDelegate.h"
+#import "../../player/GtpEngineProfile.h"
+#import "../../player/GtpEngineProfileModel.h"
+#import "../../sgf/SgfUtilities.h"
+#import "../../utility/PathUtilities.h"
+
+
+/// @brief Key in the progress file whose value is the list of names of the
+/// games that are analyzed.
+static NSString* gameNamesKey = @"GameNames";
+/// @brief Key in the progress file whose value is the list of names of the
+/// games that have already been analyzed.
+static NSString* finishedGameNamesKey = @"FinishedGameNames";
+
+
+// -----------------------------------------------------------------------------
+/// @brief Enumerates the possible outcomes of analyzing a single game.
+// -----------------------------------------------------------------------------
+enum GameAnalysisOutcome
+{
+  GameAnalysisOutcomeAnalyzed,
+  GameAnalysisOutcomeSkipped,
+  GameAnalysisOutcomeFailed
+};
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for
+/// AnalyzeArchiveGamesCommand.
+// -----------------------------------------------------------------------------
+@interface AnalyzeArchiveGamesCommand()
+@property(nonatomic, retain) GtpBatchAnalyzer* analyzer;
+@property(nonatomic, retain) NSString* progressFilePath;
+@property(nonatomic, retain) NSMutableArray* finishedGameNames;
+@property(nonatomic, retain) NSMutableArray* failedGameNames;
+@property(nonatomic, retain) NSMutableArray* skippedGameNames;
+@property(nonatomic, assign) int numberOfGamesAnalyzed;
+@property(nonatomic, assign) int numberOfGamesResumed;
+@end
+
+
+@implementation AnalyzeArchiveGamesCommand
+
+@synthesize asynchronousCommandDelegate;
+@synthesize showProgressHUD;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes an AnalyzeArchiveGamesCommand object that analyzes the
+/// games represented by the ArchiveGame objects in @a games.
+///
+/// @note This is the designated initializer of AnalyzeArchiveGamesCommand.
+// -----------------------------------------------------------------------------
+- (id) initWithGames:(NSArray*)games
+{
+  // Call designated initializer of superclass (CommandBase)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.showProgressHUD = true;
+  self.games = games;
+  self.report = nil;
+  self.analyzer = nil;
+  self.progressFilePath = nil;
+  self.finishedGameNames = [NSMutableArray array];
+  self.failedGameNames = [NSMutableArray array];
+  self.skippedGameNames = [NSMutableArray array];
+  self.numberOfGamesAnalyzed = 0;
+  self.numberOfGamesResumed = 0;
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this AnalyzeArchiveGamesCommand
+/// object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.games = nil;
+  self.report = nil;
+  self.analyzer = nil;
+  self.progressFilePath = nil;
+  self.finishedGameNames = nil;
+  self.failedGameNames = nil;
+  self.skippedGameNames = nil;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Executes this command. See the class documentation for details.
+// -----------------------------------------------------------------------------
+- (bool) doIt
+{
+  NSMutableArray* gameNames = [NSMutableArray array];
+  for (ArchiveGame* game in self.games)
+    [gameNames addObject:game.name];
+  if (gameNames.count == 0)
+    return false;
+
+  [self readProgressFileForGameNames:gameNames];
+
+  GtpEngineProfileModel* profileModel = [ApplicationDelegate sharedDelegate].gtpEngineProfileModel;
+  GtpEngineProfile* profile = profileModel.activeProfile;
+  if (! profile)
+    profile = [profileModel fallbackProfile];
+  // All secondary GTP engines analyze. If there are none GtpBatchAnalyzer
+  // falls back to the primary GTP engine.
+  int numberOfWorkers = (int)[ApplicationDelegate sharedDelegate].gtpEnginePool.engines.count - 1;
+
+  self.analyzer = [[[GtpBatchAnalyzer alloc] initWithProfile:profile] autorelease];
+  self.analyzer.numberOfWorkers = MAX(1, numberOfWorkers);
+  if (! [self.analyzer start])
+  {
+    DDLogError(@"%@: Cannot analyze games because no GTP engine is available", [self shortDescription]);
+    return false;
+  }
+
+  NSUInteger numberOfGames = gameNames.count;
+  @try
+  {
+    for (NSUInteger indexOfGame = 0; indexOfGame < numberOfGames; ++indexOfGame)
+    {
+      NSString* gameName = [gameNames objectAtIndex:indexOfGame];
+      if ([self.finishedGameNames containsObject:gameName])
+        continue;
+
+      NSAutoreleasePool* gamePool = [[NSAutoreleasePool alloc] init];
+      @try
+      {
+        [self analyzeGameWithName:gameName indexOfGame:indexOfGame numberOfGames:numberOfGames];
+      }
+      @finally
+      {
+        [gamePool drain];
+      }
+      [self writeProgressFileForGameNames:gameNames];
+    }
+  }
+  @finally
+  {
+    [self.analyzer stop];
+    self.analyzer.progressHandler = nil;
+  }
+
+  [PathUtilities deleteItemIfExists:self.progressFilePath];
+
+  self.report = [self reportForNumberOfGames:(int)numberOfGames];
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for doIt(). Analyzes the archived game named
+/// @a gameName, then records it as finished.
+// -----------------------------------------------------------------------------
+- (void) analyzeGameWithName:(NSString*)gameName indexOfGame:(NSUInteger)indexOfGame numberOfGames:(NSUInteger)numberOfGames
+{
+  NSString* message = [NSString stringWithFormat:@"Analyzing game %lu of %lu...", (unsigned long)indexOfGame + 1, (unsigned long)numberOfGames];
+  [self.asynchronousCommandDelegate asynchronousCommand:self
+                                            didProgress:(float)indexOfGame / numberOfGames
+                                        nextStepMessage:message];
+
+  enum GameAnalysisOutcome outcome = [self analyzeAndSaveGameWithName:gameName indexOfGame:indexOfGame numberOfGames:numberOfGames];
+  switch (outcome)
+  {
+    case GameAnalysisOutcomeAnalyzed:
+      self.numberOfGamesAnalyzed++;
+      break;
+    case GameAnalysisOutcomeSkipped:
+      [self.skippedGameNames addObject:gameName];
+      break;
+    default:
+      [self.failedGameNames addObject:gameName];
+      break;
+  }
+  [self.finishedGameNames addObject:gameName];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for analyzeGameWithName:indexOfGame:numberOfGames:().
+/// Reads, analyzes and saves the archived game named @a gameName.
+// -----------------------------------------------------------------------------
+- (enum GameAnalysisOutcome) analyzeAndSaveGameWithName:(NSString*)gameName indexOfGame:(NSUInteger)indexOfGame numberOfGames:(NSUInteger)numberOfGames
+{
+  ArchiveViewModel* model = [ApplicationDelegate sharedDelegate].archiveViewModel;
+  NSString* filePath = [model filePathForGameWithName:gameName];
+  SGFCDocument* sgfDocument = [self sgfDocumentWithFilePath:filePath];
+  if (! sgfDocument)
+  {
+    DDLogError(@"%@: Failed to read game %@", [self shortDescription], gameName);
+    return GameAnalysisOutcomeFailed;
+  }
+
+  SGFCGame* sgfGame = [sgfDocument.games firstObject];
+  SGFCGoGameInfo* sgfGoGameInfo = [self goGameInfoOfGame:sgfGame];
+  if (! sgfGoGameInfo)
+  {
+    DDLogError(@"%@: Game %@ has no usable game information", [self shortDescription], gameName);
+    return GameAnalysisOutcomeFailed;
+  }
+  NSString* errorMessage;
+  enum GoBoardSize boardSize = [SgfUtilities goBoardSizeForSgfBoardSize:sgfGoGameInfo.boardSize
+                                                           errorMessage:&errorMessage];
+  if (boardSize == GoBoardSizeUndefined)
+  {
+    DDLogError(@"%@: Game %@ has an unsupported board size: %@", [self shortDescription], gameName, errorMessage);
+    return GameAnalysisOutcomeFailed;
+  }
+
+  NSMutableArray* positionNodes = [NSMutableArray array];
+  NSMutableArray* setupCommands = [NSMutableArray array];
+  NSMutableArray* moves = [NSMutableArray array];
+  enum GameAnalysisOutcome outcome = [self collectPositionNodes:positionNodes
+                                                  setupCommands:setupCommands
+                                                          moves:moves
+                                                         inGame:sgfGame
+                                                           komi:sgfGoGameInfo.komi];
+  if (outcome == GameAnalysisOutcomeSkipped)
+  {
+    DDLogWarn(@"%@: Skipping game %@ because it contains setup after the first move", [self shortDescription], gameName);
+    return outcome;
+  }
+  else if (outcome == GameAnalysisOutcomeFailed)
+  {
+    DDLogError(@"%@: Game %@ contains an invalid setup or move", [self shortDescription], gameName);
+    return outcome;
+  }
+
+  int numberOfPositions = (int)positionNodes.count;
+  self.analyzer.progressHandler = ^(int numberOfPositionsAnalyzed)
+  {
+    float progress = (indexOfGame + (float)numberOfPositionsAnalyzed / numberOfPositions) / numberOfGames;
+    [self.asynchronousCommandDelegate asynchronousCommand:self didProgress:progress nextStepMessage:nil];
+  };
+  NSArray* results = [self.analyzer analyzeGameWithSetupCommands:setupCommands moves:moves boardSize:boardSize];
+  self.analyzer.progressHandler = nil;
+
+  [positionNodes enumerateObjectsUsingBlock:^(id node, NSUInteger indexOfPosition, BOOL* stop)
+  {
+    // The node is NSNull if the root node contains the first move
+    if ([node isKindOfClass:[SGFCNode class]])
+      [self annotateNode:node withResult:[results objectAtIndex:indexOfPosition] boardSize:sgfGoGameInfo.boardSize];
+  }];
+
+  SaveSgfCommand* saveSgfCommand = [[[SaveSgfCommand alloc] initWithSgfDocument:sgfDocument
+                                                                     sgfFilePath:filePath
+                                                            sgfFileAlreadyExists:true] autorelease];
+  if (! [saveSgfCommand submit])
+  {
+    DDLogError(@"%@: Failed to save game %@: %@", [self shortDescription], gameName, saveSgfCommand.errorMessage);
+    return GameAnalysisOutcomeFailed;
+  }
+  return GameAnalysisOutcomeAnalyzed;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for analyzeAndSaveGameWithName:indexOfGame:numberOfGames:().
+/// Reads the .sgf file at @a filePath and returns the SgfcKit document. Returns
+/// @e nil if the file cannot be read, or if it does not contain exactly one
+/// game.
+// -----------------------------------------------------------------------------
+- (SGFCDocument*) sgfDocumentWithFilePath:(NSString*)filePath
+{
+  LoadSgfCommand* loadSgfCommand = [[[LoadSgfCommand alloc] initWithSgfFilePath:filePath] autorelease];
+  if (! [loadSgfCommand submit])
+    return nil;
+
+  SGFCDocumentReadResult* sgfReadResult = loadSgfCommand.sgfDocumentReadResultSingleEncoding;
+  if (! sgfReadResult)
+    sgfReadResult = loadSgfCommand.sgfDocumentReadResultMultipleEncodings;
+  if (! sgfReadResult.isSgfDataValid)
+    return nil;
+  SGFCDocument* sgfDocument = sgfReadResult.document;
+  if (sgfDocument.games.count != 1)
+    return nil;
+  return sgfDocument;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for analyzeAndSaveGameWithName:indexOfGame:numberOfGames:().
+/// Returns the Go game information of @a sgfGame. Returns @e nil if
+/// @a sgfGame has no root node or more than one game info node, or if the
+/// game is not a Go game.
+// -----------------------------------------------------------------------------
+- (SGFCGoGameInfo*) goGameInfoOfGame:(SGFCGame*)sgfGame
+{
+  if (! sgfGame.hasRootNode)
+    return nil;
+  NSArray* sgfGameInfoNodes = sgfGame.gameInfoNodes;
+  if (sgfGameInfoNodes.count == 0)
+    sgfGameInfoNodes = @[sgfGame.rootNode];
+  else if (sgfGameInfoNodes.count > 1)
+    return nil;
+  SGFCNode* sgfGameInfoNode = [sgfGameInfoNodes firstObject];
+  return sgfGameInfoNode.gameInfo.toGoGameInfo;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for analyzeAndSaveGameWithName:indexOfGame:numberOfGames:().
+/// Examines the main variation of @a sgfGame and fills @a positionNodes,
+/// @a setupCommands and @a moves with the information that GtpBatchAnalyzer
+/// needs, and that is required to store the results.
+///
+/// @a setupCommands receives the GTP commands that set up komi, setup stones
+/// and the setup player, in the same form as SyncGTPEngineCommand generates
+/// them. @a moves receives the moves of the main variation in the normalized
+/// form of GtpEnginePositionTracker. @a positionNodes receives the nodes that
+/// create the board positions which GtpBatchAnalyzer analyzes: The first
+/// element is the node that creates the board position before the first move,
+/// the remaining elements are the nodes that contain the moves. The first
+/// element is NSNull if the root node contains the first move.
+///
+/// Returns #GameAnalysisOutcomeSkipped if a node after the first move
+/// contains setup, #GameAnalysisOutcomeFailed if a setup or move property
+/// cannot be interpreted, and #GameAnalysisOutcomeAnalyzed otherwise.
+// -----------------------------------------------------------------------------
+- (enum GameAnalysisOutcome) collectPositionNodes:(NSMutableArray*)positionNodes
+                                    setupCommands:(NSMutableArray*)setupCommands
+                                            moves:(NSMutableArray*)moves
+                                           inGame:(SGFCGame*)sgfGame
+                                             komi:(double)komi
+{
+  // Like SyncGTPEngineCommand we aggregate all setup into a single
+  // "gogui-setup" command, because "gogui-setup" cannot clear stones
+  NSMutableArray* blackSetupVertices = [NSMutableArray array];
+  NSMutableArray* whiteSetupVertices = [NSMutableArray array];
+  NSString* setupPlayer = nil;
+
+  SGFCNode* previousNode = nil;
+  for (SGFCNode* node = sgfGame.rootNode; node; node = node.firstChild)
+  {
+    NSArray* setupProperties = [node propertiesWithCategory:SGFCPropertyCategorySetup];
+    if (setupProperties.count > 0 && moves.count > 0)
+      return GameAnalysisOutcomeSkipped;
+
+    for (SGFCProperty* setupProperty in setupProperties)
+    {
+      SGFCPropertyType propertyType = setupProperty.propertyType;
+      if (propertyType == SGFCPropertyTypePL)
+      {
+        SGFCColor color = setupProperty.propertyValue.toSingleValue.toColorValue.colorValue;
+        setupPlayer = (color == SGFCColorBlack) ? @"B" : @"W";
+        continue;
+      }
+
+      for (id<SGFCPropertyValue> setupPropertyValue in setupProperty.propertyValues)
+      {
+        SGFCGoPoint* sgfGoPoint;
+        if (propertyType == SGFCPropertyTypeAE)
+          sgfGoPoint = setupPropertyValue.toSingleValue.toPointValue.toGoPointValue.goPoint;
+        else
+          sgfGoPoint = setupPropertyValue.toSingleValue.toStoneValue.toGoStoneValue.goStone.location;
+        NSString* vertex = [AnalyzeArchiveGamesCommand vertexForSgfGoPoint:sgfGoPoint];
+        if (! vertex)
+          return GameAnalysisOutcomeFailed;
+
+        [blackSetupVertices removeObject:vertex];
+        [whiteSetupVertices removeObject:vertex];
+        if (propertyType == SGFCPropertyTypeAB)
+          [blackSetupVertices addObject:vertex];
+        else if (propertyType == SGFCPropertyTypeAW)
+          [whiteSetupVertices addObject:vertex];
+      }
+    }
+
+    SGFCProperty* moveProperty = [node propertyWithType:SGFCPropertyTypeB];
+    if (! moveProperty)
+      moveProperty = [node propertyWithType:SGFCPropertyTypeW];
+    if (moveProperty)
+    {
+      SGFCGoMove* sgfGoMove = moveProperty.propertyValue.toSingleValue.toMoveValue.toGoMoveValue.goMove;
+      if (! sgfGoMove)
+        return GameAnalysisOutcomeFailed;
+      NSString* vertex = @"PASS";
+      if (! sgfGoMove.isPassMove)
+      {
+        vertex = [AnalyzeArchiveGamesCommand vertexForSgfGoPoint:sgfGoMove.stone.location];
+        if (! vertex)
+          return GameAnalysisOutcomeFailed;
+      }
+      NSString* color = (moveProperty.propertyType == SGFCPropertyTypeB) ? @"B" : @"W";
+
+      if (moves.count == 0)
+      {
+        if (previousNode)
+          [positionNodes addObject:previousNode];
+        else
+          [positionNodes addObject:[NSNull null]];
+      }
+      [moves addObject:[GtpEnginePositionTracker moveStringWithColor:color vertex:vertex]];
+      [positionNodes addObject:node];
+    }
+
+    previousNode = node;
+  }
+
+  if (positionNodes.count == 0)
+    [positionNodes addObject:previousNode];
+
+  [setupCommands addObject:[NSString stringWithFormat:@"komi %.1f", komi]];
+  if (blackSetupVertices.count > 0 || whiteSetupVertices.count > 0)
+  {
+    NSMutableString* commandString = [NSMutableString stringWithString:@"gogui-setup"];
+    for (NSString* vertex in blackSetupVertices)
+      [commandString appendFormat:@" B %@", vertex];
+    for (NSString* vertex in whiteSetupVertices)
+      [commandString appendFormat:@" W %@", vertex];
+    [setupCommands addObject:commandString];
+  }
+  if (setupPlayer)
+    [setupCommands addObject:[NSString stringWithFormat:@"gogui-setup_player %@", setupPlayer]];
+
+  return GameAnalysisOutcomeAnalyzed;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for analyzeAndSaveGameWithName:indexOfGame:numberOfGames:().
+/// Stores the estimated score in @a result in the SGF property V of @a node,
+/// and marks the suggested move in @a result with a circle (SGF property CR).
+/// Does nothing if @a result is not valid.
+///
+/// No circle is added if the suggested move is a pass or resignation, or if
+/// @a node already has a symbol on the intersection of the suggested move.
+// -----------------------------------------------------------------------------
+- (void) annotateNode:(SGFCNode*)node withResult:(GtpBatchAnalysisResult*)result boardSize:(SGFCBoardSize)boardSize
+{
+  if (! result.valid)
+    return;
+
+  // The territory statistics are not precise enough for more than one decimal
+  SGFCReal estimatedScore = round(result.estimatedScore * 10.0) / 10.0;
+  SGFCRealPropertyValue* vPropertyValue = [SGFCPropertyValueFactory propertyValueWithReal:estimatedScore];
+  [node setProperty:[SGFCPropertyFactory propertyWithType:SGFCPropertyTypeV value:vPropertyValue]];
+
+  NSString* suggestedMove = result.suggestedMove;
+  if ([suggestedMove isEqualToString:@"PASS"] || [suggestedMove isEqualToString:@"resign"])
+    return;
+
+  // A node may contain only one symbol per intersection, and symbols that are
+  // already there take precedence. The new CR property replaces the existing
+  // one, so it must also contain the existing values.
+  NSMutableArray* crVertices = [NSMutableArray array];
+  for (NSNumber* propertyTypeAsNumber in @[@(SGFCPropertyTypeCR), @(SGFCPropertyTypeSQ), @(SGFCPropertyTypeTR), @(SGFCPropertyTypeMA), @(SGFCPropertyTypeSL)])
+  {
+    SGFCPropertyType propertyType = (SGFCPropertyType)propertyTypeAsNumber.integerValue;
+    SGFCProperty* symbolProperty = [node propertyWithType:propertyType];
+    for (id<SGFCPropertyValue> propertyValue in symbolProperty.propertyValues)
+    {
+      NSString* vertex = [AnalyzeArchiveGamesCommand vertexForSgfGoPoint:propertyValue.toSingleValue.toPointValue.toGoPointValue.goPoint];
+      if ([vertex isEqualToString:suggestedMove])
+        return;
+      if (vertex && propertyType == SGFCPropertyTypeCR)
+        [crVertices addObject:vertex];
+    }
+  }
+  [crVertices addObject:suggestedMove];
+
+  SGFCProperty* crProperty = [SGFCPropertyFactory propertyWithType:SGFCPropertyTypeCR];
+  for (NSString* vertex in crVertices)
+    [crProperty appendPropertyValue:[SGFCPropertyValueFactory propertyValueWithGoPoint:vertex boardSize:boardSize]];
+  [node setProperty:crProperty];  // overwrite!
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns the vertex (e.g. "D4") of the intersection
+/// referred to by @a sgfGoPoint. Returns @e nil if @a sgfGoPoint is @e nil or
+/// cannot be expressed as a vertex.
+// -----------------------------------------------------------------------------
++ (NSString*) vertexForSgfGoPoint:(SGFCGoPoint*)sgfGoPoint
+{
+  if (! sgfGoPoint)
+    return nil;
+  if (! [sgfGoPoint hasPositionInGoPointNotation:SGFCGoPointNotationHybrid])
+    return nil;
+  return [sgfGoPoint positionInGoPointNotation:SGFCGoPointNotationHybrid];
+}
+
+#pragma mark - Progress file
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for doIt(). Reads the progress file and fills the
+/// property @e finishedGameNames with the names of the games that a previous
+/// execution has already finished. The progress file is ignored if it was
+/// written for a different set of games than @a gameNames.
+// -----------------------------------------------------------------------------
+- (void) readProgressFileForGameNames:(NSArray*)gameNames
+{
+  BOOL fileExists;
+  self.progressFilePath = [PathUtilities filePathForBackupFileNamed:batchAnalysisProgressFileName
+                                                          fileExists:&fileExists];
+  if (! fileExists)
+    return;
+
+  NSDictionary* progress = [NSDictionary dictionaryWithContentsOfFile:self.progressFilePath];
+  if (! [[progress objectForKey:gameNamesKey] isEqualToArray:gameNames])
+  {
+    DDLogInfo(@"%@: Ignoring progress file of a different set of games", [self shortDescription]);
+    return;
+  }
+
+  NSArray* finishedGameNames = [progress objectForKey:finishedGameNamesKey];
+  if (! finishedGameNames)
+    return;
+  [self.finishedGameNames addObjectsFromArray:finishedGameNames];
+  self.numberOfGamesResumed = (int)finishedGameNames.count;
+  DDLogInfo(@"%@: Resuming after %d games", [self shortDescription], self.numberOfGamesResumed);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for doIt(). Writes the names of the games that have
+/// been finished so far to the progress file.
+// -----------------------------------------------------------------------------
+- (void) writeProgressFileForGameNames:(NSArray*)gameNames
+{
+  NSDictionary* progress = @{gameNamesKey : gameNames,
+                             finishedGameNamesKey : self.finishedGameNames};
+  if (! [progress writeToFile:self.progressFilePath atomically:YES])
+    DDLogError(@"%@: Failed to write progress file %@", [self shortDescription], self.progressFilePath);
+}
+
+#pragma mark - Report
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for doIt(). Returns the results of the analysis as
+/// human-readable text.
+// -----------------------------------------------------------------------------
+- (NSString*) reportForNumberOfGames:(int)numberOfGames
+{
+  NSMutableString* report = [NSMutableString string];
+  [report appendFormat:@"Games: %d\n", numberOfGames];
+  [report appendFormat:@"Analyzed: %d\n", self.numberOfGamesAnalyzed];
+  if (self.numberOfGamesResumed > 0)
+    [report appendFormat:@"Analyzed previously: %d\n", self.numberOfGamesResumed];
+  if (self.skippedGameNames.count > 0)
+    [report appendFormat:@"Skipped (setup after first move): %@\n", [self.skippedGameNames componentsJoinedByString:@", "]];
+  if (self.failedGameNames.count > 0)
+    [report appendFormat:@"Failed: %@\n", [self.failedGameNames componentsJoinedByString:@", "]];
+  [report appendFormat:@"\n%@", [self.analyzer report]];
+  return report;
+}
+
+@end
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -761,19 +761,30 @@ withPropertiesFromSgfNode:(SGFCNode*)sgfNode
   GoGame* game = [GoGame sharedGame];
   bool sgfNodeIsGameInfoNode = [sgfNode isEqualToNode:self.sgfGameInfoNode];
 
-  GoNodeSetup* goNodeSetup = [[[GoNodeSetup alloc] initWithGame:game] autorelease];
+  // The setup, annotation and markup objects are created only when the first
+  // property for them is found. In a large game tree most nodes contain
+  // nothing but a move, so this saves up to three allocations per node.
+  GoNodeSetup* goNodeSetup = nil;
   GoMove* goMove = nil;
   enum GoMoveValuation goMoveValuation = GoMoveValuationNone;
-  GoNodeAnnotation* goNodeAnnotation = [[[GoNodeAnnotation alloc] init] autorelease];
+  GoNodeAnnotation* goNodeAnnotation = nil;
   bool atLeastOneAnnotationPropertyWasFound = false;
-  GoNodeMarkup* goNodeMarkup = [[[GoNodeMarkup alloc] init] autorelease];
+  GoNodeMarkup* goNodeMarkup = nil;
 
   for (SGFCProperty* sgfProperty in sgfNode.properties)
   {
     SGFCPropertyType propertyType = sgfProperty.propertyType;
 
+    if (! goNodeAnnotation && [LoadGameCommand isNodeAnnotationPropertyType:propertyType])
+      goNodeAnnotation = [[[GoNodeAnnotation alloc] init] autorelease];
+    else if (! goNodeMarkup && [LoadGameCommand isMarkupPropertyType:propertyType])
+      goNodeMarkup = [[[GoNodeMarkup alloc] init] autorelease];
+
     if (sgfProperty.propertyCategory == SGFCPropertyCategorySetup)
     {
+      if (! goNodeSetup)
+        goNodeSetup = [[[GoNodeSetup alloc] initWithGame:game] autorelease];
+
       bool success = [self populateGoNodeSetup:goNodeSetup
                              withSetupProperty:sgfProperty
                            foundInGameInfoNode:sgfNodeIsGameInfoNode
@@ -950,7 +961,7 @@ withPropertiesFromSgfNode:(SGFCNode*)sgfNode
     }
   }
 
-  if (! goNodeSetup.isEmpty)
+  if (goNodeSetup && ! goNodeSetup.isEmpty)
     goNode.goNodeSetup = goNodeSetup;
 
   if (goMove)
@@ -1314,7 +1325,7 @@ withPropertiesFromSgfNode:(SGFCNode*)sgfNode
         // Setup validation requires the board to be already in the new state
         [currentNode modifyBoard];
         [currentNode calculateZobristHash:game];
-        bool success = [self validateBoardSetupWithGame:game errorMessage:errorMessage];
+        bool success = [self validateBoardSetup:currentNode.goNodeSetup withGame:game errorMessage:errorMessage];
         if (! success)
           return false;
       }
@@ -1422,9 +1433,13 @@ withPropertiesFromSgfNode:(SGFCNode*)sgfNode
 /// currently set up is valid. Returns @e true if the board state is valid,
 /// returns @e false if the board state is not valid.
 ///
+/// @a nodeSetup is the GoNodeSetup that was most recently applied to the
+/// board. The board state before that is known to be valid, so only the stone
+/// groups affected by @a nodeSetup need to be examined.
+///
 /// This is a helper function for validateSetupAndMoveNodes:errorMessage:().
 // -----------------------------------------------------------------------------
-- (bool) validateBoardSetupWithGame:(GoGame*)game errorMessage:(NSString**)errorMessage
+- (bool) validateBoardSetup:(GoNodeSetup*)nodeSetup withGame:(GoGame*)game errorMessage:(NSString**)errorMessage
 {
   // We have to evaluate the board state after the entire setup information in
   // a GoNodeSetup was applied to the board. It is not possible to invoke the
@@ -1433,8 +1448,17 @@ withPropertiesFromSgfNode:(SGFCNode*)sgfNode
   // separately for each point in GoNodeSetup, because an intermediate board
   // state, before all setup stones are placed ore removed, might well be
   // illegal.
+  NSMutableArray* setupPoints = [NSMutableArray array];
+  if (nodeSetup.blackSetupStones)
+    [setupPoints addObjectsFromArray:nodeSetup.blackSetupStones];
+  if (nodeSetup.whiteSetupStones)
+    [setupPoints addObjectsFromArray:nodeSetup.whiteSetupStones];
+  if (nodeSetup.noSetupStones)
+    [setupPoints addObjectsFromArray:nodeSetup.noSetupStones];
+
   NSString* suicidalIntersectionsString;
-  bool isLegalBoardSetup = [game isLegalBoardSetup:&suicidalIntersectionsString];
+  bool isLegalBoardSetup = [game isLegalBoardSetupAfterChangingPoints:setupPoints
+                                          suicidalIntersectionsString:&suicidalIntersectionsString];
 
   if (! isLegalBoardSetup)
   {
@@ -1952,7 +1976,59 @@ withPropertiesFromSgfNode:(SGFCNode*)sgfNode
     return nil;
   }
 
-  return vertexString;
+  // Return the vertex string owned by GoPoint instead of the one we got from
+  // SgfcKit. Markup stores vertex strings as dictionary keys and array
+  // elements, so with this all markup in the entire game tree shares one
+  // string object per intersection instead of allocating a new string for
+  // every markup property value.
+  return goPoint.vertex.string;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if @a propertyType is one of the node annotation
+/// properties that populateGoNode:withPropertiesFromSgfNode:previousMove:errorMessage:()
+/// stores in a GoNodeAnnotation object. Returns false otherwise.
+// -----------------------------------------------------------------------------
++ (bool) isNodeAnnotationPropertyType:(SGFCPropertyType)propertyType
+{
+  switch (propertyType)
+  {
+    case SGFCPropertyTypeN:
+    case SGFCPropertyTypeC:
+    case SGFCPropertyTypeGB:
+    case SGFCPropertyTypeGW:
+    case SGFCPropertyTypeDM:
+    case SGFCPropertyTypeUC:
+    case SGFCPropertyTypeHO:
+    case SGFCPropertyTypeV:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if @a propertyType is one of the markup properties
+/// that populateGoNode:withPropertiesFromSgfNode:previousMove:errorMessage:()
+/// stores in a GoNodeMarkup object. Returns false otherwise.
+// -----------------------------------------------------------------------------
++ (bool) isMarkupPropertyType:(SGFCPropertyType)propertyType
+{
+  switch (propertyType)
+  {
+    case SGFCPropertyTypeCR:
+    case SGFCPropertyTypeSQ:
+    case SGFCPropertyTypeTR:
+    case SGFCPropertyTypeMA:
+    case SGFCPropertyTypeSL:
+    case SGFCPropertyTypeAR:
+    case SGFCPropertyTypeLN:
+    case SGFCPropertyTypeLB:
+    case SGFCPropertyTypeDD:
+      return true;
+    default:
+      return false;
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2013 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -18,7 +18,7 @@
 // Project includes
 #import "InterruptComputerCommand.h"
 #import "../../go/GoGame.h"
-#import "../../gtp/GtpClient.h"
+#import "../../gtp/GtpEnginePool.h"
 #import "../../main/ApplicationDelegate.h"
 
 
@@ -66,9 +66,11 @@
 // -----------------------------------------------------------------------------
 - (bool) doIt
 {
+  // The computer may be thinking on any of the GTP engines in the pool (e.g.
+  // a move suggestion on a secondary GTP engine)
   ApplicationDelegate* delegate = [ApplicationDelegate sharedDelegate];
-  GtpClient* gtpClient = delegate.gtpClient;
-  [gtpClient interrupt];
+  GtpEnginePool* gtpEnginePool = delegate.gtpEnginePool;
+  [gtpEnginePool interrupt];
   return true;
 }
 
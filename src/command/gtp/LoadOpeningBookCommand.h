@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2013 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -20,17 +20,22 @@
 
 
 // -----------------------------------------------------------------------------
-/// @brief The LoadOpeningBookCommand class is responsible for submitting a
-/// "book_load" command to the GTP engine. Command execution occurs
+/// @brief The LoadOpeningBookCommand class is responsible for loading the
+/// opening book that is shared by all GTP engines. Command execution occurs
 /// synchronously.
 ///
-/// The opening book file used as the command argument is a project resource
-/// with hard-coded name, i.e. there is no support for variable opening books.
+/// The opening book is a project resource with hard-coded name, i.e. there is
+/// no support for variable opening books. The resource is a text file in the
+/// format that Fuego's "book_load" GTP command understands. Instead of letting
+/// every GTP engine parse the text file into its own heap, LoadOpeningBookCommand
+/// compiles the text file into a binary file in the Caches folder and memory
+/// maps the binary file with GoOpeningBook. The binary file is compiled only if
+/// it does not exist, if it is older than the resource, or if it cannot be
+/// loaded (e.g. because the file format has changed).
 ///
-/// @note If variable opening books are implemented, make sure to thoroughly
-/// test file names that are not "book.dat", and files that do not contain
-/// opening book data. Preliminary tests suggest that esp. the latter case may
-/// not be handled properly by Fuego.
+/// The GoOpeningBook object is stored in ApplicationDelegate, where the
+/// commands that generate computer moves consult it before they ask the GTP
+/// engine. Fuego's own opening book remains empty.
 // -----------------------------------------------------------------------------
 @interface LoadOpeningBookCommand : CommandBase
 {
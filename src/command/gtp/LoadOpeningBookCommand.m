@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2013 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -17,9 +17,9 @@
 
 // Project includes
 #import "LoadOpeningBookCommand.h"
+#import "../../go/GoOpeningBook.h"
 #import "../../main/ApplicationDelegate.h"
-#import "../../gtp/GtpCommand.h"
-#import "../../gtp/GtpResponse.h"
+#import "../../utility/PathUtilities.h"
 
 
 @implementation LoadOpeningBookCommand
@@ -30,27 +30,43 @@
 - (bool) doIt
 {
   NSFileManager* fileManager = [NSFileManager defaultManager];
-  NSString* bookFilePath = [[ApplicationDelegate sharedDelegate].resourceBundle pathForResource:openingBookResource ofType:nil];
-  if (! [fileManager fileExistsAtPath:bookFilePath])
+  ApplicationDelegate* applicationDelegate = [ApplicationDelegate sharedDelegate];
+  NSString* textBookPath = [applicationDelegate.resourceBundle pathForResource:openingBookResource ofType:nil];
+  if (! [fileManager fileExistsAtPath:textBookPath])
   {
-    DDLogError(@"%@: Opening book file not found: %@", [self shortDescription], bookFilePath);
+    DDLogError(@"%@: Opening book file not found: %@", [self shortDescription], textBookPath);
     return false;
   }
-  NSString* bookFileName = [bookFilePath lastPathComponent];
-  NSString* bookFileFolder = [bookFilePath stringByDeletingLastPathComponent];
 
-  NSString* oldCurrentDirectory = [fileManager currentDirectoryPath];
-  [fileManager changeCurrentDirectoryPath:bookFileFolder];
-  DDLogVerbose(@"%@: Working directory changed to %@", [self shortDescription], bookFileFolder);
-
-  NSString* commandString = [NSString stringWithFormat:@"book_load %@", bookFileName];
-  GtpCommand* command = [GtpCommand command:commandString];
-  [command submit];
+  NSString* binaryBookPath = [self binaryBookPath];
+  GoOpeningBook* openingBook = nil;
+  if ([fileManager fileExistsAtPath:binaryBookPath] &&
+      [PathUtilities isItemAtPath:binaryBookPath newerThanItemAtPath:textBookPath])
+    openingBook = [[[GoOpeningBook alloc] initWithContentsOfFile:binaryBookPath] autorelease];
+  if (! openingBook)
+  {
+    DDLogInfo(@"%@: Compiling opening book %@", [self shortDescription], textBookPath);
+    if (! [GoOpeningBook compileTextBookAtPath:textBookPath toBinaryBookAtPath:binaryBookPath])
+      return false;
+    openingBook = [[[GoOpeningBook alloc] initWithContentsOfFile:binaryBookPath] autorelease];
+    if (! openingBook)
+      return false;
+  }
 
-  [fileManager changeCurrentDirectoryPath:oldCurrentDirectory];
-  DDLogVerbose(@"%@: Working directory changed to %@", [self shortDescription], oldCurrentDirectory);
+  DDLogVerbose(@"%@: Opening book with %d positions loaded from %@", [self shortDescription], openingBook.numberOfPositions, binaryBookPath);
+  applicationDelegate.openingBook = openingBook;
+  return true;
+}
 
-  return command.response.status;
+// -----------------------------------------------------------------------------
+/// @brief Returns the full path of the binary opening book file.
+// -----------------------------------------------------------------------------
+- (NSString*) binaryBookPath
+{
+  BOOL expandTilde = YES;
+  NSArray* paths = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, expandTilde);
+  NSString* cachesDirectory = [paths objectAtIndex:0];
+  return [cachesDirectory stringByAppendingPathComponent:openingBookBinaryFileName];
 }
 
 @end
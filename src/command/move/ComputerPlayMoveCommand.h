@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2021 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -31,6 +31,11 @@
 /// updates GoGame so that it generates a GoMove of the appropriate type for
 /// the player whose turn it is (not necessarily a computer player).
 ///
+/// If the shared GoOpeningBook contains a move for the current board position,
+/// or if GtpMoveSpeculator has pre-computed a reply for it,
+/// ComputerPlayMoveCommand instead submits a "play" command with that move to
+/// the GTP engine, then updates GoGame with the same move.
+///
 /// Another ComputerPlayMoveCommand is submitted automatically if it is now
 /// the computer player's turn to move.
 ///
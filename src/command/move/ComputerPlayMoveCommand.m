@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -27,10 +27,12 @@
 #import "../../go/GoBoard.h"
 #import "../../go/GoGame.h"
 #import "../../go/GoMoveNodeCreationOptions.h"
+#import "../../go/GoOpeningBook.h"
 #import "../../go/GoPlayer.h"
 #import "../../go/GoPoint.h"
 #import "../../go/GoVertex.h"
 #import "../../gtp/GtpCommand.h"
+#import "../../gtp/GtpMoveSpeculator.h"
 #import "../../gtp/GtpResponse.h"
 #import "../../main/ApplicationDelegate.h"
 #import "../../play/model/GameVariationModel.h"
@@ -53,6 +55,10 @@ enum AlertType
 // -----------------------------------------------------------------------------
 @interface ComputerPlayMoveCommand()
 @property(nonatomic, retain) GoPoint* illegalMove;
+/// @brief The vertex of the move that was known before the GTP engine was
+/// asked, i.e. a move from the opening book or a reply that GtpMoveSpeculator
+/// pre-computed. @e nil if the move is generated by the GTP engine.
+@property(nonatomic, retain) NSString* knownMove;
 @end
 
 
@@ -89,6 +95,7 @@ enum AlertType
 
   self.game = sharedGame;
   self.illegalMove = nil;
+  self.knownMove = nil;
 
   return self;
 }
@@ -100,6 +107,7 @@ enum AlertType
 {
   self.game = nil;
   self.illegalMove = nil;
+  self.knownMove = nil;
   [super dealloc];
 }
 
@@ -108,10 +116,28 @@ enum AlertType
 // -----------------------------------------------------------------------------
 - (bool) doIt
 {
+  // If the move is already known we tell the GTP engine which move to play
+  // instead of letting it search. The GTP engine's board must be kept in sync
+  // either way.
+  NSString* commandString;
+  ApplicationDelegate* applicationDelegate = [ApplicationDelegate sharedDelegate];
+  GoPoint* knownPoint = [applicationDelegate.openingBook moveForGame:self.game];
+  if (! knownPoint)
+    knownPoint = [applicationDelegate.gtpMoveSpeculator replyForGame:self.game];
+  if (knownPoint)
+  {
+    self.knownMove = knownPoint.vertex.string;
+    commandString = [NSString stringWithFormat:@"play %@ %@", self.game.nextMovePlayer.colorString, self.knownMove];
+    DDLogVerbose(@"%@: Playing known move %@", [self shortDescription], self.knownMove);
+  }
+  else
+  {
+    commandString = @"genmove ";
+    commandString = [commandString stringByAppendingString:self.game.nextMovePlayer.colorString];
+  }
+
   // It's important that we do not wait for the GTP command to complete. This
   // gives the UI the time to update (e.g. status view, activity indicator).
-  NSString* commandString = @"genmove ";
-  commandString = [commandString stringByAppendingString:self.game.nextMovePlayer.colorString];
   GtpCommand* command = [GtpCommand asynchronousCommand:commandString
                                          responseTarget:self
                                                selector:@selector(gtpResponseReceived:)];
@@ -143,13 +169,18 @@ enum AlertType
     if (! success)
       return;
 
+    // The GTP engine collects territory statistics only while it searches. A
+    // known move was played with "play" instead of "genmove", so the engine's
+    // statistics still belong to an earlier search and are not worth a query.
+    //
     // Don't check command execution result, it is irrelevant for us whether the
     // command succeeds or not. There is a known case where the command fails:
     // If statistics collection was enabled while the "genmove" command above
     // was still running. In that case, UpdateTerritoryStatisticsCommand will
     // try to acquire statistics data, but will fail because the GTP engine has
     // not yet collected any data.
-    [[[[UpdateTerritoryStatisticsCommand alloc] init] autorelease] submit];
+    if (! self.knownMove)
+      [[[[UpdateTerritoryStatisticsCommand alloc] init] autorelease] submit];
 
     // If another ComputerPlayMoveCommand is submitted, this returns after the
     // next ComputerPlayMoveCommand has submitted its GTP command
@@ -164,8 +195,9 @@ enum AlertType
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Instructs GoGame to play the move that is inside @a response. Returns
-/// true on success, false on failure (e.g. if move was illegal).
+/// @brief Instructs GoGame to play the move that is inside @a response, or the
+/// known move if doIt() found one. Returns true on success, false on
+/// failure (e.g. if move was illegal).
 ///
 /// This is a private helper for gtpResponseReceived.
 // -----------------------------------------------------------------------------
@@ -178,7 +210,11 @@ enum AlertType
   else
     options = [GoMoveNodeCreationOptions moveNodeCreationOptionsWithInsertPolicyReplaceFutureBoardPositions];
 
-  NSString* responseString = [response.parsedResponse lowercaseString];
+  NSString* responseString;
+  if (self.knownMove)
+    responseString = [self.knownMove lowercaseString];
+  else
+    responseString = [response.parsedResponse lowercaseString];
   if ([responseString isEqualToString:@"pass"])
   {
     enum GoMoveIsIllegalReason illegalReason;
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2021 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2021-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -34,6 +34,11 @@
 /// While the GTP command is executing GoGame::reasonForComputerIsThinking()
 /// property is set so that observers can react and disable user interaction
 /// where appropriate.
+///
+/// Move suggestions are stored in the GtpAnalysisCache. If a suggestion for
+/// the current board position is already known, ComputerSuggestMoveCommand
+/// does not submit a GTP command. It displays the known suggestion instead,
+/// also asynchronously.
 // -----------------------------------------------------------------------------
 @interface ComputerSuggestMoveCommand : CommandBase
 {
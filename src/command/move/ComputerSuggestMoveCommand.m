@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2021-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2021-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -19,8 +19,13 @@
 #import "ComputerSuggestMoveCommand.h"
 #import "../../go/GoBoard.h"
 #import "../../go/GoGame.h"
+#import "../../go/GoOpeningBook.h"
+#import "../../go/GoPoint.h"
+#import "../../go/GoVertex.h"
+#import "../../gtp/GtpAnalysisCache.h"
 #import "../../gtp/GtpCommand.h"
 #import "../../gtp/GtpResponse.h"
+#import "../../main/ApplicationDelegate.h"
 #import "../../utility/ExceptionUtility.h"
 #import "../../utility/NSStringAdditions.h"
 
@@ -31,6 +36,10 @@
 // -----------------------------------------------------------------------------
 @interface ComputerSuggestMoveCommand()
 @property(nonatomic, assign) enum GoColor color;
+/// @brief The key under which the move suggestion is stored in the
+/// GtpAnalysisCache. Is generated when the suggestion is requested, because
+/// the board position may have changed when the suggestion arrives.
+@property(nonatomic, retain) NSString* analysisCacheKey;
 @end
 
 
@@ -63,6 +72,7 @@
   }
 
   self.color = color;
+  self.analysisCacheKey = nil;
 
   return self;
 }
@@ -73,6 +83,7 @@
 // -----------------------------------------------------------------------------
 - (void) dealloc
 {
+  self.analysisCacheKey = nil;
   [super dealloc];
 }
 
@@ -94,9 +105,43 @@
   GtpCommand* command = [GtpCommand asynchronousCommand:commandString
                                          responseTarget:self
                                                selector:@selector(gtpResponseReceived:)];
+
+  // If the suggestion for this board position is already known, the response
+  // is delivered asynchronously, just like a response from the GTP engine
+  self.analysisCacheKey = [GtpAnalysisCache keyForAnalysis:commandString];
+  NSData* cachedResponseData = [[ApplicationDelegate sharedDelegate].gtpAnalysisCache resultForKey:self.analysisCacheKey];
+  if (cachedResponseData)
+  {
+    GtpResponse* response = [GtpResponse responseWithData:cachedResponseData toCommand:command];
+    [self performSelector:@selector(gtpResponseReceived:) withObject:response afterDelay:0];
+    return true;
+  }
+
+  // The same applies if the opening book knows a move for this board position.
+  // The opening book only knows moves for the color that is to move next.
+  GoGame* sharedGame = [GoGame sharedGame];
+  if (self.color == sharedGame.nextMoveColor)
+  {
+    GoPoint* openingBookPoint = [[ApplicationDelegate sharedDelegate].openingBook moveForGame:sharedGame];
+    if (openingBookPoint)
+    {
+      NSString* responseString = [NSString stringWithFormat:@"= %@", openingBookPoint.vertex.string];
+      NSData* responseData = [responseString dataUsingEncoding:NSUTF8StringEncoding];
+      GtpResponse* response = [GtpResponse responseWithData:responseData toCommand:command];
+      [self performSelector:@selector(gtpResponseReceived:) withObject:response afterDelay:0];
+      return true;
+    }
+  }
+
+  // A move suggestion does not change the board position, so a secondary GTP
+  // engine can generate it without disturbing the primary GTP engine
+  command.kind = GtpCommandKindAnalysis;
+  // Allows SyncGTPEngineCommand to drop the command if the board position
+  // changes before the GTP engine has started to generate the suggestion
+  command.coalescingKey = moveSuggestionGtpCommandCoalescingKey;
   [command submit];
 
-  [GoGame sharedGame].reasonForComputerIsThinking = GoGameComputerIsThinkingReasonMoveSuggestion;
+  sharedGame.reasonForComputerIsThinking = GoGameComputerIsThinkingReasonMoveSuggestion;
 
   return true;
 }
@@ -110,6 +155,15 @@
   GoGame* sharedGame = [GoGame sharedGame];
   sharedGame.reasonForComputerIsThinking = GoGameComputerIsThinkingReasonIsNotThinking;
 
+  if (response.command.isCancelled)
+  {
+    DDLogInfo(@"%@: Move suggestion was dropped because the board position changed", [self shortDescription]);
+    return;
+  }
+
+  if (response.status)
+    [[ApplicationDelegate sharedDelegate].gtpAnalysisCache storeResult:response.rawResponseData forKey:self.analysisCacheKey];
+
   enum MoveSuggestionType moveSuggestionType = MoveSuggestionTypePlay;
   GoPoint* point = nil;
   NSString* errorMessage = nil;
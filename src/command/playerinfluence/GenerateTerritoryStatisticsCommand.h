@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2013-2015 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2013-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -22,7 +22,7 @@
 // -----------------------------------------------------------------------------
 /// @brief The GenerateTerritoryStatisticsCommand class is responsible for
 /// submitting a command to the GTP engine that generates territory statistics.
-/// Command execution occurs synchronously.
+/// Command execution occurs asynchronously.
 ///
 /// GenerateTerritoryStatisticsCommand currently uses the "reg_genmove" GTP
 /// command to generate territory statistics. "reg_genmove" does not actually
@@ -32,6 +32,28 @@
 /// be able to make the suggestion, the GTP engine is forced to calculate
 /// playouts, and that, as a side effect, generates the desired territory
 /// statistics.
+///
+/// If live sampling is enabled in the user defaults (key
+/// #liveTerritoryStatisticsSamplingIntervalKey in the GTP engine configuration
+/// dictionary), GenerateTerritoryStatisticsCommand splits the search into
+/// slices whose duration is the sampling interval, and fetches territory
+/// statistics after each slice. Samples are passed to the main thread via
+/// TerritoryStatisticsMailbox, so that the influence display is updated
+/// progressively while the GTP engine keeps searching. The GTP engine can
+/// process only one command at a time, so sampling the statistics of a search
+/// that is still running is not possible.
+///
+/// The GTP commands are analysis commands, so that they are processed by a
+/// secondary GTP engine if one is available. GenerateTerritoryStatisticsCommand
+/// pins that GTP engine in the GtpEnginePool for the entire sequence of time
+/// limit, slices, samples and restoration of the time limit. The shortened
+/// time limit therefore never affects another GTP engine, and the territory
+/// statistics are always fetched from the GTP engine that ran the search.
+///
+/// The final territory statistics of a search that was not interrupted are
+/// stored in the GtpAnalysisCache. If the territory statistics for the current
+/// board position are already known, GenerateTerritoryStatisticsCommand
+/// displays them without searching.
 // -----------------------------------------------------------------------------
 @interface GenerateTerritoryStatisticsCommand : CommandBase
 {
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2013-2015 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2013-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,17 +15,101 @@
 // -----------------------------------------------------------------------------
 
 
+
 // Project includes
 #import "GenerateTerritoryStatisticsCommand.h"
+#import "TerritoryStatisticsMailbox.h"
 #import "UpdateTerritoryStatisticsCommand.h"
+#import "../../go/GoBoard.h"
 #import "../../go/GoGame.h"
 #import "../../go/GoPlayer.h"
+#import "../../gtp/GtpAnalysisCache.h"
+#import "../../gtp/GtpClient.h"
 #import "../../gtp/GtpCommand.h"
+#import "../../gtp/GtpEnginePool.h"
 #import "../../gtp/GtpResponse.h"
+#import "../../main/ApplicationDelegate.h"
+#import "../../player/GtpEngineProfile.h"
+#import "../../player/GtpEngineProfileModel.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for
+/// GenerateTerritoryStatisticsCommand.
+// -----------------------------------------------------------------------------
+@interface GenerateTerritoryStatisticsCommand()
+@property(nonatomic, assign) int numberOfSlices;
+@property(nonatomic, assign) int numberOfSlicesSearched;
+@property(nonatomic, assign) unsigned int numberOfInterrupts;
+@property(nonatomic, assign) unsigned int maxThinkingTime;
+@property(nonatomic, assign) int boardSize;
+/// @brief The GtpClient that processes all GTP commands of this command. Is
+/// pinned in the GtpEnginePool until tearDown() is invoked.
+@property(retain) GtpClient* client;
+/// @brief The "uct_stat_territory" command whose response is expected next.
+/// Is accessed both from the main thread and from the GTP client thread.
+@property(retain) GtpCommand* sampleCommand;
+/// @brief The sum of all samples received so far. Is accessed only from the
+/// GTP client thread.
+@property(nonatomic, retain) NSMutableData* accumulatedScores;
+/// @brief The number of samples received so far. Is accessed only from the
+/// GTP client thread.
+@property(nonatomic, assign) int numberOfSamples;
+@property(nonatomic, retain) TerritoryStatisticsMailbox* mailbox;
+/// @brief The most recent sample. Is written on the GTP client thread and read
+/// on the main thread after the last sample was taken.
+@property(retain) NSData* lastSample;
+/// @brief The key under which the final sample is stored in the
+/// GtpAnalysisCache.
+@property(nonatomic, retain) NSString* analysisCacheKey;
+@end
 
 
 @implementation GenerateTerritoryStatisticsCommand
 
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GenerateTerritoryStatisticsCommand object.
+///
+/// @note This is the designated initializer of
+/// GenerateTerritoryStatisticsCommand.
+// -----------------------------------------------------------------------------
+- (id) init
+{
+  // Call designated initializer of superclass (CommandBase)
+  self = [super init];
+  if (! self)
+    return nil;
+  self.numberOfSlices = 1;
+  self.numberOfSlicesSearched = 0;
+  self.numberOfInterrupts = 0;
+  self.maxThinkingTime = 0;
+  self.boardSize = 0;
+  self.client = nil;
+  self.sampleCommand = nil;
+  self.accumulatedScores = nil;
+  self.numberOfSamples = 0;
+  self.mailbox = nil;
+  self.lastSample = nil;
+  self.analysisCacheKey = nil;
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this
+/// GenerateTerritoryStatisticsCommand object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  [[NSNotificationCenter defaultCenter] removeObserver:self];
+  self.client = nil;
+  self.sampleCommand = nil;
+  self.accumulatedScores = nil;
+  self.mailbox = nil;
+  self.lastSample = nil;
+  self.analysisCacheKey = nil;
+  [super dealloc];
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Executes this command. See the class documentation for details.
 // -----------------------------------------------------------------------------
@@ -34,30 +118,223 @@
   GoGame* game = [GoGame sharedGame];
   if (! game)
     return false;
+
+  self.analysisCacheKey = [GtpAnalysisCache keyForAnalysis:@"TerritoryStatistics"];
+  NSData* cachedSample = [[ApplicationDelegate sharedDelegate].gtpAnalysisCache resultForKey:self.analysisCacheKey];
+  if (cachedSample)
+  {
+    DDLogInfo(@"%@: Territory statistics for this board position are already known", [self shortDescription]);
+    [[[[UpdateTerritoryStatisticsCommand alloc] initWithTerritoryStatisticsSample:cachedSample] autorelease] submit];
+    return true;
+  }
+
+  self.boardSize = game.board.size;
+  self.accumulatedScores = [NSMutableData dataWithLength:self.boardSize * self.boardSize * sizeof(float)];
+  self.mailbox = [[[TerritoryStatisticsMailbox alloc] init] autorelease];
+  [[NSNotificationCenter defaultCenter] addObserver:self
+                                           selector:@selector(gtpResponseWasReceived:)
+                                               name:gtpResponseWasReceivedNotification
+                                             object:nil];
+
+  // The time limit, all slices, all samples and the restoration of the time
+  // limit must be processed by the same GTP engine
+  GtpCommand* sliceCommand = [self sliceCommandForPlayer:game.nextMovePlayer];
+  self.client = [[ApplicationDelegate sharedDelegate].gtpEnginePool pinClientForAnalysisCommand:sliceCommand];
+  [self setupSlices];
+  self.numberOfInterrupts = self.client.numberOfInterrupts;
+  [self.client submit:sliceCommand];
+  game.reasonForComputerIsThinking = GoGameComputerIsThinkingReasonPlayerInfluence;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for doIt(). Splits the search into slices if live
+/// sampling is enabled. Leaves the search in a single slice if live sampling
+/// is disabled, or if the GTP engine cannot be configured for live sampling.
+// -----------------------------------------------------------------------------
+- (void) setupSlices
+{
+  NSUserDefaults* userDefaults = [NSUserDefaults standardUserDefaults];
+  NSDictionary* dictionary = [userDefaults dictionaryForKey:gtpEngineConfigurationKey];
+  int samplingInterval = [[dictionary valueForKey:liveTerritoryStatisticsSamplingIntervalKey] intValue];
+  if (samplingInterval <= 0)
+    return;
+  GtpEngineProfile* profile = [ApplicationDelegate sharedDelegate].gtpEngineProfileModel.activeProfile;
+  if (! profile)
+    return;
+  int numberOfSlices = (profile.fuegoMaxThinkingTime * 1000) / samplingInterval;
+  if (numberOfSlices <= 1)
+    return;
+
+  NSString* commandString = [NSString stringWithFormat:@"go_param timelimit %f", samplingInterval / 1000.0];
+  GtpCommand* command = [GtpCommand command:commandString];
+  command.kind = GtpCommandKindAnalysis;
+  [self.client submit:command];
+  if (! command.response.status)
+  {
+    DDLogWarn(@"%@: GTP engine does not accept time limit for live sampling, searching in a single slice", [self shortDescription]);
+    return;
+  }
+
+  self.numberOfSlices = numberOfSlices;
+  self.maxThinkingTime = profile.fuegoMaxThinkingTime;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns a new GTP command that searches one slice
+/// for @a player.
+///
+/// All GTP commands of GenerateTerritoryStatisticsCommand are analysis
+/// commands. They are submitted directly to the GtpClient that doIt() has
+/// pinned in the GtpEnginePool, so that they are all processed by the same
+/// GTP engine, even while an intermediate sample is still pending.
+// -----------------------------------------------------------------------------
+- (GtpCommand*) sliceCommandForPlayer:(GoPlayer*)player
+{
   NSString* commandString = @"reg_genmove ";
-  commandString = [commandString stringByAppendingString:game.nextMovePlayer.colorString];
+  commandString = [commandString stringByAppendingString:player.colorString];
   GtpCommand* command = [GtpCommand asynchronousCommand:commandString
                                          responseTarget:self
                                                selector:@selector(gtpResponseReceived:)];
-  [command submit];
-  game.reasonForComputerIsThinking = GoGameComputerIsThinkingReasonPlayerInfluence;
-  return true;
+  command.kind = GtpCommandKindAnalysis;
+  return command;
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Is triggered when the GTP engine responds to the command submitted
-/// in doIt().
+/// @brief Is triggered when the GTP engine responds to a command that was
+/// created by sliceCommandForPlayer:().
 // -----------------------------------------------------------------------------
 - (void) gtpResponseReceived:(GtpResponse*)response
 {
+  GoGame* game = [GoGame sharedGame];
   if (! response.status)
   {
     DDLogError(@"%@: Aborting due to failed GTP command", [self shortDescription]);
     assert(0);
+    [self tearDown];
+    return;
+  }
+
+  self.numberOfSlicesSearched++;
+  bool interrupted = (self.client.numberOfInterrupts != self.numberOfInterrupts);
+  bool lastSlice = (interrupted || self.numberOfSlicesSearched >= self.numberOfSlices);
+
+  // Intermediate samples are taken asynchronously so that the main thread can
+  // keep drawing while the GTP engine searches the next slice. The last sample
+  // is taken synchronously so that it has been posted into the mailbox when
+  // tearDown() stops listening for samples.
+  GtpCommand* sampleCommand;
+  if (lastSlice)
+  {
+    sampleCommand = [GtpCommand command:@"uct_stat_territory"];
+  }
+  else
+  {
+    sampleCommand = [GtpCommand asynchronousCommand:@"uct_stat_territory" responseTarget:nil selector:nil];
+    // If the GTP engine lags behind, an intermediate sample that is still
+    // waiting to be taken is superseded by this newer one
+    sampleCommand.coalescingKey = territoryStatisticsSampleGtpCommandCoalescingKey;
+  }
+  sampleCommand.kind = GtpCommandKindAnalysis;
+  self.sampleCommand = sampleCommand;
+  [self.client submit:sampleCommand];
+
+  if (lastSlice)
+  {
+    [self tearDown];
+    // The statistics of an interrupted search are incomplete
+    if (! interrupted && self.lastSample)
+      [[ApplicationDelegate sharedDelegate].gtpAnalysisCache storeResult:self.lastSample forKey:self.analysisCacheKey];
+    game.reasonForComputerIsThinking = GoGameComputerIsThinkingReasonIsNotThinking;
+  }
+  else
+  {
+    [self.client submit:[self sliceCommandForPlayer:game.nextMovePlayer]];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Restores the GTP engine's time limit if the search
+/// was split into slices, unpins the GtpClient, and stops listening for
+/// samples.
+///
+/// Restoring the time limit is done synchronously. When the command returns,
+/// the GTP engine has responded to all sample commands submitted before, so
+/// it is safe to stop listening.
+// -----------------------------------------------------------------------------
+- (void) tearDown
+{
+  if (self.numberOfSlices > 1)
+  {
+    NSString* commandString = [NSString stringWithFormat:@"go_param timelimit %u", self.maxThinkingTime];
+    GtpCommand* command = [GtpCommand command:commandString];
+    command.kind = GtpCommandKindAnalysis;
+    [self.client submit:command];
+  }
+  [[ApplicationDelegate sharedDelegate].gtpEnginePool unpinClient:self.client];
+  [[NSNotificationCenter defaultCenter] removeObserver:self name:gtpResponseWasReceivedNotification object:nil];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Responds to the #gtpResponseWasReceivedNotification notification.
+///
+/// This method is invoked in the context of the GTP client thread. It converts
+/// the response to a "uct_stat_territory" command into a sample and posts it
+/// into the mailbox.
+///
+/// The GTP engine starts collecting territory statistics from scratch every
+/// time it starts a new search, i.e. every "uct_stat_territory" response only
+/// reflects the playouts of the slice that was searched last. The sample that
+/// is posted therefore is the mean of all responses received so far, so that
+/// the user sees the estimate converge instead of jumping around. Because all
+/// slices have the same duration, they contribute a similar number of playouts
+/// and can be weighted equally.
+// -----------------------------------------------------------------------------
+- (void) gtpResponseWasReceived:(NSNotification*)notification
+{
+  GtpResponse* response = notification.object;
+  if (response.command != self.sampleCommand)
+    return;
+  if (! response.status)
+    return;
+
+  int numberOfScores = self.boardSize * self.boardSize;
+  float scores[numberOfScores];
+  if (! [response decodeFloatGrid:scores numberOfRows:self.boardSize numberOfColumns:self.boardSize])
+  {
+    DDLogError(@"%@: GTP response does not contain %d lines with %d elements each", [self shortDescription], self.boardSize, self.boardSize);
     return;
   }
-  [[[[UpdateTerritoryStatisticsCommand alloc] init] autorelease] submit];
-  [GoGame sharedGame].reasonForComputerIsThinking = GoGameComputerIsThinkingReasonIsNotThinking;
+
+  self.numberOfSamples++;
+  float* accumulatedScores = (float*)self.accumulatedScores.mutableBytes;
+  NSMutableData* sample = [NSMutableData dataWithLength:numberOfScores * sizeof(float)];
+  float* sampleScores = (float*)sample.mutableBytes;
+  for (int indexOfScore = 0; indexOfScore < numberOfScores; ++indexOfScore)
+  {
+    accumulatedScores[indexOfScore] += scores[indexOfScore];
+    sampleScores[indexOfScore] = accumulatedScores[indexOfScore] / self.numberOfSamples;
+  }
+
+  self.lastSample = sample;
+
+  // If the slot was not empty the main thread has not yet taken the previous
+  // sample and does not need to be notified again
+  if ([self.mailbox postSample:sample])
+    [self performSelectorOnMainThread:@selector(takeSample) withObject:nil waitUntilDone:NO];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Takes the most recent sample from the mailbox and displays it.
+///
+/// This method is invoked in the context of the main thread.
+// -----------------------------------------------------------------------------
+- (void) takeSample
+{
+  NSData* sample = [self.mailbox takeSample];
+  if (! sample)
+    return;
+  [[[[UpdateTerritoryStatisticsCommand alloc] initWithTerritoryStatisticsSample:sample] autorelease] submit];
 }
 
 @end
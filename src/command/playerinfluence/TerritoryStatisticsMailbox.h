@@ -0,0 +1,43 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// -----------------------------------------------------------------------------
+/// @brief The TerritoryStatisticsMailbox class is a single-slot mailbox that
+/// transports territory statistics samples from the thread that receives them
+/// from the GTP engine to the main thread that displays them.
+///
+/// The producer and the consumer never block each other: The slot is replaced
+/// and emptied with atomic exchange operations, no locks are involved. If the
+/// producer posts a new sample before the consumer has had the chance to take
+/// the previous sample, the previous sample is discarded. The consumer
+/// therefore always gets the most recent sample, and a slow consumer never
+/// causes samples to pile up.
+///
+/// A sample is an NSData object that contains one float value per
+/// intersection, in the order in which the GTP command "uct_stat_territory"
+/// reports the values (i.e. the top row of the board first, each row from
+/// left to right).
+// -----------------------------------------------------------------------------
+@interface TerritoryStatisticsMailbox : NSObject
+{
+}
+
+- (bool) postSample:(NSData*)sample;
+- (NSData*) takeSample;
+
+@end
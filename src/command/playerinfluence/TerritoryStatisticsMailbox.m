@@ -0,0 +1,101 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Project includes
+#import "TerritoryStatisticsMailbox.h"
+
+// System includes
+#import <stdatomic.h>
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private member variables for
+/// TerritoryStatisticsMailbox.
+// -----------------------------------------------------------------------------
+@interface TerritoryStatisticsMailbox()
+{
+@private
+  /// @brief The slot. Holds a retained NSData object, or NULL if the slot is
+  /// empty.
+  _Atomic(void*) slot;
+}
+@end
+
+
+@implementation TerritoryStatisticsMailbox
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a TerritoryStatisticsMailbox object with an empty slot.
+///
+/// @note This is the designated initializer of TerritoryStatisticsMailbox.
+// -----------------------------------------------------------------------------
+- (id) init
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+  atomic_init(&slot, NULL);
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this TerritoryStatisticsMailbox
+/// object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  NSData* sample = (NSData*)atomic_exchange(&slot, NULL);
+  [sample release];
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Places @a sample into the slot. Discards the sample that was in the
+/// slot before, if any. Returns true if the slot was empty, false if a sample
+/// was discarded.
+///
+/// The return value allows the producer to find out whether the consumer must
+/// be notified: If the slot was not empty, the consumer has already been
+/// notified and has not yet taken the discarded sample, so it will pick up
+/// @a sample instead.
+///
+/// This method can be invoked from any thread.
+// -----------------------------------------------------------------------------
+- (bool) postSample:(NSData*)sample
+{
+  NSData* discardedSample = (NSData*)atomic_exchange(&slot, [sample retain]);
+  if (! discardedSample)
+    return true;
+  [discardedSample release];
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Removes the sample from the slot and returns it. Returns nil if the
+/// slot is empty.
+///
+/// This method can be invoked from any thread.
+// -----------------------------------------------------------------------------
+- (NSData*) takeSample
+{
+  NSData* sample = (NSData*)atomic_exchange(&slot, NULL);
+  return [sample autorelease];
+}
+
+@end
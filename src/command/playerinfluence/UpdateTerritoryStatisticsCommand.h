@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2013 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2013-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -27,6 +27,12 @@
 /// UpdateTerritoryStatisticsCommand posts the notification
 /// #territoryStatisticsChanged after all GoPoint objects have been updated.
 ///
+/// If UpdateTerritoryStatisticsCommand is initialized with a territory
+/// statistics sample, it does not query the GTP engine but uses the values in
+/// the sample instead. The sample is expected to contain one float value per
+/// intersection, in the order in which the GTP command "uct_stat_territory"
+/// reports the values. See TerritoryStatisticsMailbox for details.
+///
 /// UpdateTerritoryStatisticsCommand executes successfully but does nothing if
 /// the user preference to display player influence is turned off.
 // -----------------------------------------------------------------------------
@@ -34,4 +40,7 @@
 {
 }
 
+- (id) init;
+- (id) initWithTerritoryStatisticsSample:(NSData*)sample;
+
 @end
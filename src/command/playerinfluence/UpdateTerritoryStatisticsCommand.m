@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2013-2014 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2013-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -21,14 +21,59 @@
 #import "../../go/GoBoard.h"
 #import "../../go/GoGame.h"
 #import "../../go/GoPoint.h"
-#import "../../go/GoVertex.h"
 #import "../../gtp/GtpCommand.h"
 #import "../../gtp/GtpResponse.h"
 #import "../../play/model/BoardViewModel.h"
 
 
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for
+/// UpdateTerritoryStatisticsCommand.
+// -----------------------------------------------------------------------------
+@interface UpdateTerritoryStatisticsCommand()
+@property(nonatomic, retain) NSData* sample;
+@end
+
+
 @implementation UpdateTerritoryStatisticsCommand
 
+// -----------------------------------------------------------------------------
+/// @brief Initializes an UpdateTerritoryStatisticsCommand object that queries
+/// the GTP engine for territory statistics.
+// -----------------------------------------------------------------------------
+- (id) init
+{
+  return [self initWithTerritoryStatisticsSample:nil];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes an UpdateTerritoryStatisticsCommand object that uses the
+/// territory statistics in @a sample. If @a sample is nil the command queries
+/// the GTP engine for territory statistics.
+///
+/// @note This is the designated initializer of
+/// UpdateTerritoryStatisticsCommand.
+// -----------------------------------------------------------------------------
+- (id) initWithTerritoryStatisticsSample:(NSData*)sample
+{
+  // Call designated initializer of superclass (CommandBase)
+  self = [super init];
+  if (! self)
+    return nil;
+  self.sample = sample;
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this UpdateTerritoryStatisticsCommand
+/// object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.sample = nil;
+  [super dealloc];
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Executes this command. See the class documentation for details.
 // -----------------------------------------------------------------------------
@@ -40,11 +85,19 @@
     DDLogVerbose(@"%@: Display of player influence is turned off, nothing to do.", [self shortDescription]);
     return true;
   }
-  GtpCommand* command = [GtpCommand command:@"uct_stat_territory"];
-  [command submit];
-  if (! command.response.status)
-    return false;
-  bool success = [self updateBoardWithGtpResponse:command.response.parsedResponse];
+  bool success;
+  if (self.sample)
+  {
+    success = [self updateBoardWithSample:self.sample];
+  }
+  else
+  {
+    GtpCommand* command = [GtpCommand command:@"uct_stat_territory"];
+    [command submit];
+    if (! command.response.status)
+      return false;
+    success = [self updateBoardWithGtpResponse:command.response];
+  }
   if (! success)
     return false;
   [[NSNotificationCenter defaultCenter] postNotificationName:territoryStatisticsChanged object:nil];
@@ -53,55 +106,68 @@
 
 // -----------------------------------------------------------------------------
 /// @brief Private helper
+///
+/// The response is decoded directly into a C array of floats because this
+/// command is executed frequently (e.g. after every computer move), and the
+/// response for a 19x19 board contains 361 numbers.
 // -----------------------------------------------------------------------------
-- (bool) updateBoardWithGtpResponse:(NSString*)gtpResponse
+- (bool) updateBoardWithGtpResponse:(GtpResponse*)gtpResponse
 {
   GoBoard* board = [GoGame sharedGame].board;
-  struct GoVertexNumeric vertexNumeric;
-  vertexNumeric.x = 1;
-  vertexNumeric.y = board.size;  // start at the top of the board
-  NSArray* responseLines = [gtpResponse componentsSeparatedByString:@"\n"];
-  for (NSString* responseLine in responseLines)
+  int boardSize = board.size;
+  float territoryStatisticsScores[boardSize * boardSize];
+  if (! [gtpResponse decodeFloatGrid:territoryStatisticsScores numberOfRows:boardSize numberOfColumns:boardSize])
   {
-    if (0 == vertexNumeric.y)
-    {
-      assert(false);
-      DDLogError(@"%@: GTP response has too many lines", [self shortDescription]);
-      return false;
-    }
-    NSMutableArray* territoryStatisticScores = [NSMutableArray arrayWithArray:[responseLine componentsSeparatedByString:@" "]];
-    [territoryStatisticScores removeObject:@""];
-    if (territoryStatisticScores.count != board.size)
-      continue;  // skip the first line which is empty
-    // Start at the left edge of the board
-    NSString* vertexLeftEdge = [GoVertex vertexFromNumeric:vertexNumeric].string;
-    GoPoint* point = [board pointAtVertex:vertexLeftEdge];
-    for (NSString* territoryStatisticScore in territoryStatisticScores)
-    {
-      if (! point)
-      {
-        assert(false);
-        DDLogError(@"%@: Line in GTP response has too many elements", [self shortDescription]);
-        return false;
-      }
-      point.territoryStatisticsScore = [territoryStatisticScore floatValue];
-      point = point.right;  // continue on the same line to the right
-    }
-    if (point)
-    {
-      assert(false);
-      DDLogError(@"%@: Line in GTP response has not enough elements", [self shortDescription]);
-      return false;
-    }
-    vertexNumeric.y--;  // move down one line
+    assert(false);
+    DDLogError(@"%@: GTP response does not contain %d lines with %d elements each", [self shortDescription], boardSize, boardSize);
+    return false;
   }
-  if (0 != vertexNumeric.y)
+  [self updateBoard:board withTerritoryStatisticsScores:territoryStatisticsScores];
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper
+///
+/// Unlike a GTP response, a sample can legitimately fail to match the board:
+/// The board size may have changed after the sample was taken, but before the
+/// main thread got around to processing the sample. The sample is discarded
+/// in that case.
+// -----------------------------------------------------------------------------
+- (bool) updateBoardWithSample:(NSData*)sample
+{
+  GoBoard* board = [GoGame sharedGame].board;
+  int boardSize = board.size;
+  if (sample.length != boardSize * boardSize * sizeof(float))
   {
-    assert(false);
-    DDLogError(@"%@: GTP response has not enough lines", [self shortDescription]);
+    DDLogWarn(@"%@: Discarding territory statistics sample that does not match board size %d", [self shortDescription], boardSize);
     return false;
   }
+  [self updateBoard:board withTerritoryStatisticsScores:(const float*)sample.bytes];
   return true;
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Private helper
+// -----------------------------------------------------------------------------
+- (void) updateBoard:(GoBoard*)board withTerritoryStatisticsScores:(const float*)territoryStatisticsScores
+{
+  // The scores start with the top line of the board. Start at the left edge
+  // of the board and continue on the same line to the right, then move down
+  // one line.
+  int indexOfScore = 0;
+  GoPoint* pointLeftEdge = [board pointAtCorner:GoBoardCornerTopLeft];
+  while (pointLeftEdge)
+  {
+    GoPoint* point = pointLeftEdge;
+    while (point)
+    {
+      point.territoryStatisticsScore = territoryStatisticsScores[indexOfScore];
+      indexOfScore++;
+      point = point.right;
+    }
+    pointLeftEdge = pointLeftEdge.below;
+  }
+}
+
 @end
@@ -18,6 +18,9 @@
 // Project includes
 #import "CommandBase.h"
 
+// Forward declarations
+@class SGFCDocument;
+
 
 // -----------------------------------------------------------------------------
 /// @brief The SaveSgfCommand class is responsible for saving the current
@@ -43,6 +46,11 @@
 ///
 /// SaveSgfCommand executes synchronously.
 ///
+/// If SaveSgfCommand is initialized with an SGFCDocument it saves that
+/// document instead of the current game, with the same precautions. This is
+/// useful for commands that modify archived games without loading them into
+/// the current game, e.g. AnalyzeArchiveGamesCommand.
+///
 /// The resulting SGF file is structured as follows:
 /// - Contains only one game
 /// - Contains 1-n variations
@@ -71,6 +79,14 @@
 /// path of the .sgf file to be saved. @a sgfFileAlreadyExists indicates whether
 /// a file already exists at the destination.
 - (id) initWithSgfFilePath:(NSString*)sgfFilePath sgfFileAlreadyExists:(bool)sgfFileAlreadyExists;
+/// @brief Initializes the SaveSgfCommand object so that it saves
+/// @a sgfDocument instead of the current game. The other parameters have the
+/// same meaning as for initWithSgfFilePath:sgfFileAlreadyExists:().
+- (id) initWithSgfDocument:(SGFCDocument*)sgfDocument sgfFilePath:(NSString*)sgfFilePath sgfFileAlreadyExists:(bool)sgfFileAlreadyExists;
+
+/// @brief The SgfcKit document to be saved. Is @e nil if the current game
+/// should be saved.
+@property(nonatomic, retain) SGFCDocument* sgfDocument;
 
 /// @brief The full path of the .sgf file to which the current game should be
 /// saved. This affects the wording of some of the error messages that
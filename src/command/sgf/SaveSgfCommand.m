@@ -39,17 +39,27 @@
 #pragma mark - Initialization and deallocation
 
 // -----------------------------------------------------------------------------
-/// @brief Initializes a SaveSgfCommand object.
+/// @brief Initializes a SaveSgfCommand object that saves the current game.
+// -----------------------------------------------------------------------------
+- (id) initWithSgfFilePath:(NSString*)sgfFilePath sgfFileAlreadyExists:(bool)sgfFileAlreadyExists
+{
+  return [self initWithSgfDocument:nil sgfFilePath:sgfFilePath sgfFileAlreadyExists:sgfFileAlreadyExists];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a SaveSgfCommand object that saves @a sgfDocument, or
+/// the current game if @a sgfDocument is @e nil.
 ///
 /// @note This is the designated initializer of SaveSgfCommand.
 // -----------------------------------------------------------------------------
-- (id) initWithSgfFilePath:(NSString*)sgfFilePath sgfFileAlreadyExists:(bool)sgfFileAlreadyExists
+- (id) initWithSgfDocument:(SGFCDocument*)sgfDocument sgfFilePath:(NSString*)sgfFilePath sgfFileAlreadyExists:(bool)sgfFileAlreadyExists
 {
   // Call designated initializer of superclass (CommandBase)
   self = [super init];
   if (! self)
     return nil;
 
+  self.sgfDocument = sgfDocument;
   self.sgfFilePath = sgfFilePath;
   self.sgfFileAlreadyExists = sgfFileAlreadyExists;
   self.destinationFolderWasTouched = false;
@@ -63,6 +73,7 @@
 // -----------------------------------------------------------------------------
 - (void) dealloc
 {
+  self.sgfDocument = nil;
   self.sgfFilePath = nil;
   self.errorMessage = nil;
   [super dealloc];
@@ -75,10 +86,14 @@
 // -----------------------------------------------------------------------------
 - (bool) doIt
 {
-  SGFCDocument* sgfDocument;
+  SGFCDocument* sgfDocument = self.sgfDocument;
   NSString* errorMessage = @"Internal error";
-  bool success = [self createSgfDocument:&sgfDocument
-                            errorMessage:&errorMessage];
+  bool success = true;
+  if (! sgfDocument)
+  {
+    success = [self createSgfDocument:&sgfDocument
+                         errorMessage:&errorMessage];
+  }
 
   if (success)
   {
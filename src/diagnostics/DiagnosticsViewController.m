@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -23,11 +23,19 @@
 #import "GtpCommandViewController.h"
 #import "LoggingModel.h"
 #import "SendBugReportController.h"
+#import "../archive/ArchiveViewModel.h"
+#import "../command/diagnostics/RunEngineMatchCommand.h"
+#import "../command/game/AnalyzeArchiveGamesCommand.h"
 #import "../go/GoGame.h"
 #import "../go/GoScore.h"
+#import "../gtp/GtpEngineMemoryGovernor.h"
+#import "../gtp/GtpEnginePool.h"
+#import "../gtp/GtpStatistics.h"
 #import "../main/ApplicationDelegate.h"
+#import "../main/DocumentViewController.h"
 #import "../ui/TableViewCellFactory.h"
 #import "../ui/UiSettingsModel.h"
+#import "../ui/UIViewControllerAdditions.h"
 
 
 // -----------------------------------------------------------------------------
@@ -50,6 +58,11 @@ enum GtpSectionItem
   GtpLogItem,
   GtpCommandsItem,
   GtpSettingsItem,
+  GtpCommandQueueItem,
+  GtpMemoryBudgetItem,
+  GtpStatisticsItem,
+  GtpEngineMatchItem,
+  GtpBatchAnalysisItem,
   MaxGtpSectionItem
 };
 
@@ -136,6 +149,24 @@ enum BugReportSectionItem
   self.bugReportSectionIsDisabled = [self shouldDisableBugReportSection];
 }
 
+// -----------------------------------------------------------------------------
+/// @brief UIViewController method.
+///
+/// The GTP command queue metrics and the GTP engine memory budget change all
+/// the time. Instead of observing them, they are refreshed every time the view
+/// appears.
+// -----------------------------------------------------------------------------
+- (void) viewWillAppear:(BOOL)animated
+{
+  [super viewWillAppear:animated];
+  NSArray* indexPaths = [NSArray arrayWithObjects:
+                         [NSIndexPath indexPathForRow:GtpCommandQueueItem inSection:GtpSection],
+                         [NSIndexPath indexPathForRow:GtpMemoryBudgetItem inSection:GtpSection],
+                         nil];
+  [self.tableView reloadRowsAtIndexPaths:indexPaths
+                        withRowAnimation:UITableViewRowAnimationNone];
+}
+
 #pragma mark - Setup/remove notification responders
 
 // -----------------------------------------------------------------------------
@@ -256,6 +287,38 @@ enum BugReportSectionItem
   {
     case GtpSection:
     {
+      if (GtpCommandQueueItem == indexPath.row)
+      {
+        GtpEnginePool* gtpEnginePool = [ApplicationDelegate sharedDelegate].gtpEnginePool;
+        cell = [TableViewCellFactory cellWithType:Value1CellType tableView:tableView];
+        cell.selectionStyle = UITableViewCellSelectionStyleNone;
+        cell.accessoryType = UITableViewCellAccessoryNone;
+        cell.textLabel.text = @"Command queue";
+        cell.detailTextLabel.text = [NSString stringWithFormat:@"%d pending, max. %d, %d dropped",
+                                     gtpEnginePool.numberOfPendingCommands,
+                                     gtpEnginePool.maximumNumberOfPendingCommands,
+                                     gtpEnginePool.numberOfDroppedCommands];
+        break;
+      }
+      else if (GtpMemoryBudgetItem == indexPath.row)
+      {
+        GtpEngineMemoryGovernor* memoryGovernor = [ApplicationDelegate sharedDelegate].gtpEngineMemoryGovernor;
+        cell = [TableViewCellFactory cellWithType:Value1CellType tableView:tableView];
+        cell.selectionStyle = UITableViewCellSelectionStyleNone;
+        cell.accessoryType = UITableViewCellAccessoryNone;
+        cell.textLabel.text = @"Engine memory";
+        if (memoryGovernor.memoryPressureLevel > 0)
+        {
+          cell.detailTextLabel.text = [NSString stringWithFormat:@"%d MB, pressure level %d",
+                                       memoryGovernor.activeMemoryBudget,
+                                       memoryGovernor.memoryPressureLevel];
+        }
+        else
+        {
+          cell.detailTextLabel.text = [NSString stringWithFormat:@"%d MB", memoryGovernor.activeMemoryBudget];
+        }
+        break;
+      }
       cell = [TableViewCellFactory cellWithType:DefaultCellType tableView:tableView];
       cell.accessoryType = UITableViewCellAccessoryDisclosureIndicator;
       switch (indexPath.row)
@@ -269,6 +332,15 @@ enum BugReportSectionItem
         case GtpSettingsItem:
           cell.textLabel.text = @"Settings";
           break;
+        case GtpStatisticsItem:
+          cell.textLabel.text = @"Command timing";
+          break;
+        case GtpEngineMatchItem:
+          cell.textLabel.text = @"Engine match benchmark";
+          break;
+        case GtpBatchAnalysisItem:
+          cell.textLabel.text = @"Analyze archived games";
+          break;
         default:
           assert(0);
           @throw [NSException exceptionWithName:NSInternalInconsistencyException reason:[NSString stringWithFormat:@"invalid index path %@", indexPath] userInfo:nil];
@@ -368,6 +440,18 @@ enum BugReportSectionItem
         case GtpSettingsItem:
           [self viewGtpSettings];
           break;
+        case GtpCommandQueueItem:
+        case GtpMemoryBudgetItem:
+          break;  // metrics only, nothing to select
+        case GtpStatisticsItem:
+          [self viewGtpStatistics];
+          break;
+        case GtpEngineMatchItem:
+          [self runEngineMatch];
+          break;
+        case GtpBatchAnalysisItem:
+          [self analyzeArchiveGames];
+          break;
         default:
           assert(0);
           break;
@@ -449,6 +533,153 @@ enum BugReportSectionItem
   [self.navigationController pushViewController:controller animated:YES];
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Displays the timing statistics of the GTP commands that have been
+/// processed so far.
+// -----------------------------------------------------------------------------
+- (void) viewGtpStatistics
+{
+  NSString* report = [[ApplicationDelegate sharedDelegate].gtpEnginePool.statistics report];
+  [self viewReport:report withTitle:@"Command timing"];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Lets the GTP engine play a number of games against itself, then
+/// displays the throughput that was measured.
+// -----------------------------------------------------------------------------
+- (void) runEngineMatch
+{
+  // Without secondary GTP engines the match is played by the GTP engine that
+  // also plays the current game, which therefore must be idle
+  if ([ApplicationDelegate sharedDelegate].gtpEnginePool.engines.count < 2 && [self shouldDisableBugReportSection])
+  {
+    [self presentOkAlertWithTitle:@"Engine match"
+                          message:@"The app currently uses only one GTP engine, and the engine match must use the same engine as your current game. Please pause the game, or wait until the computer player has finished thinking, and try again."];
+    return;
+  }
+
+  RunEngineMatchCommand* command = [[[RunEngineMatchCommand alloc] init] autorelease];
+  [command submitWithCompletionHandler:^(NSObject<Command>* command, bool success)
+   {
+    // UIKit manipulations must occur on the main thread. This completion
+    // handler is not invoked on the main thread because RunEngineMatchCommand
+    // is an asynchronous command.
+    if (success)
+    {
+      [self performSelectorOnMainThread:@selector(viewEngineMatchReport:)
+                             withObject:((RunEngineMatchCommand*)command).report
+                          waitUntilDone:NO];
+    }
+    else
+    {
+      [self performSelectorOnMainThread:@selector(engineMatchFailed)
+                             withObject:nil
+                          waitUntilDone:NO];
+    }
+  }];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Informs the user that the engine match could not be played.
+// -----------------------------------------------------------------------------
+- (void) engineMatchFailed
+{
+  [self presentOkAlertWithTitle:@"Engine match"
+                        message:@"The engine match could not be played because no GTP engine was available. Please try again later."];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Displays the results of the engine match that has just finished.
+// -----------------------------------------------------------------------------
+- (void) viewEngineMatchReport:(NSString*)report
+{
+  [self viewReport:report withTitle:@"Engine match"];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Lets the GTP engine analyze all games in the archive and store the
+/// results in the archived .sgf files, after the user has confirmed that this
+/// is what they want.
+// -----------------------------------------------------------------------------
+- (void) analyzeArchiveGames
+{
+  NSArray* games = [ApplicationDelegate sharedDelegate].archiveViewModel.gameList;
+  if (games.count == 0)
+  {
+    [self presentOkAlertWithTitle:@"Analyze archived games" message:@"The archive contains no games."];
+    return;
+  }
+  // Without secondary GTP engines the games are analyzed by the GTP engine
+  // that also plays the current game, which therefore must be idle
+  if ([ApplicationDelegate sharedDelegate].gtpEnginePool.engines.count < 2 && [self shouldDisableBugReportSection])
+  {
+    [self presentOkAlertWithTitle:@"Analyze archived games"
+                          message:@"The app currently uses only one GTP engine, and the analysis must use the same engine as your current game. Please pause the game, or wait until the computer player has finished thinking, and try again."];
+    return;
+  }
+
+  void (^yesActionBlock) (UIAlertAction*) = ^(UIAlertAction* action)
+  {
+    AnalyzeArchiveGamesCommand* command = [[[AnalyzeArchiveGamesCommand alloc] initWithGames:games] autorelease];
+    [command submitWithCompletionHandler:^(NSObject<Command>* command, bool success)
+     {
+      // UIKit manipulations must occur on the main thread. This completion
+      // handler is not invoked on the main thread because
+      // AnalyzeArchiveGamesCommand is an asynchronous command.
+      if (success)
+      {
+        [self performSelectorOnMainThread:@selector(viewBatchAnalysisReport:)
+                               withObject:((AnalyzeArchiveGamesCommand*)command).report
+                            waitUntilDone:NO];
+      }
+      else
+      {
+        [self performSelectorOnMainThread:@selector(batchAnalysisFailed)
+                               withObject:nil
+                            waitUntilDone:NO];
+      }
+    }];
+  };
+
+  NSString* message = [NSString stringWithFormat:@"The computer player will analyze every board position of the %lu games in the archive. Estimated scores and suggested moves are added to the games, and the archived games are overwritten. Your current game is not affected.\n\nThis may take a long time. Do you want to continue?", (unsigned long)games.count];
+  [self presentYesNoAlertWithTitle:@"Please confirm"
+                           message:message
+                        yesHandler:yesActionBlock
+                         noHandler:nil];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Informs the user that the archived games could not be analyzed.
+// -----------------------------------------------------------------------------
+- (void) batchAnalysisFailed
+{
+  [self presentOkAlertWithTitle:@"Analyze archived games"
+                        message:@"The archived games could not be analyzed because no GTP engine was available. Please try again later."];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Displays the results of the batch analysis that has just finished.
+// -----------------------------------------------------------------------------
+- (void) viewBatchAnalysisReport:(NSString*)report
+{
+  [self viewReport:report withTitle:@"Batch analysis"];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Displays the plain text @a report in a
+/// DocumentViewController with title @a title.
+// -----------------------------------------------------------------------------
+- (void) viewReport:(NSString*)report withTitle:(NSString*)title
+{
+  report = [report stringByReplacingOccurrencesOfString:@"&" withString:@"&amp;"];
+  report = [report stringByReplacingOccurrencesOfString:@"<" withString:@"&lt;"];
+  report = [report stringByReplacingOccurrencesOfString:@">" withString:@"&gt;"];
+  NSString* htmlString = [NSString stringWithFormat:@"<html><body><pre>%@</pre></body></html>", report];
+  DocumentViewController* controller = [DocumentViewController controllerWithTitle:title
+                                                                        htmlString:htmlString];
+  [self.navigationController pushViewController:controller animated:YES];
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Displays CrashReportingSettingsController to allow the user to view
 /// and modify settings related to the crash reporting service.
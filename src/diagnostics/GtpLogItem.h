@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -25,12 +25,37 @@
 
 - (id) init;
 - (UIImage*) imageRepresentingResponseStatus;
+- (NSString*) latencyString;
 
 /// @brief The command that was submitted.
 @property(nonatomic, retain) NSString* commandString;
 /// @brief String representation of the timestamp when the command was
 /// submitted.
+///
+/// The string is formatted on demand from @e submissionDate the first time
+/// the property is accessed. Formatting is comparatively expensive, which is
+/// why it should happen only when the string is actually displayed.
 @property(nonatomic, retain) NSString* timeStamp;
+/// @brief The wall clock time when the command was submitted, as the number
+/// of seconds since the reference date (see CFAbsoluteTimeGetCurrent()).
+@property(nonatomic, assign) CFAbsoluteTime submissionDate;
+/// @brief The monotonic time when the command was submitted, as the number of
+/// seconds since the system was started (see NSProcessInfo).
+@property(nonatomic, assign) NSTimeInterval submissionTime;
+/// @brief The monotonic time when the response was received, as the number of
+/// seconds since the system was started (see NSProcessInfo).
+///
+/// If @e hasResponse is false the value of this property is undefined
+@property(nonatomic, assign) NSTimeInterval responseTime;
+/// @brief The round-trip latency of the command, i.e. the number of seconds
+/// between submitting the command and receiving the response.
+///
+/// If @e hasResponse is false the value of this property is undefined
+@property(nonatomic, assign, readonly) NSTimeInterval latency;
+/// @brief The position of this GtpLogItem in the sequence of all GtpLogItem
+/// objects that GtpLogModel has ever created. GtpLogModel uses this to locate
+/// the item in its ring buffer.
+@property(nonatomic, assign) long long sequenceNumber;
 /// @brief True if this GtpLogItem has response data for the command. If this
 /// property is false, the remaining response properties have undefined values.
 @property(nonatomic, assign) bool hasResponse;
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -37,6 +37,10 @@
 
   self.commandString = nil;
   self.timeStamp = nil;
+  self.submissionDate = 0;
+  self.submissionTime = 0;
+  self.responseTime = 0;
+  self.sequenceNumber = 0;
   self.hasResponse = false;
   self.responseStatus = false;
   self.parsedResponseString = nil;
@@ -87,6 +91,59 @@
   [super dealloc];
 }
 
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (NSString*) timeStamp
+{
+  if (! _timeStamp && self.submissionDate != 0)
+  {
+    NSDate* date = [NSDate dateWithTimeIntervalSinceReferenceDate:self.submissionDate];
+    _timeStamp = [[[GtpLogItem dateFormatter] stringFromDate:date] retain];
+  }
+  return _timeStamp;
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (NSTimeInterval) latency
+{
+  return self.responseTime - self.submissionTime;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a string that represents the round-trip latency of the
+/// command in a form that can be displayed to the user. Returns @e nil if
+/// the response has not been received yet.
+// -----------------------------------------------------------------------------
+- (NSString*) latencyString
+{
+  if (! self.hasResponse)
+    return nil;
+  return [NSString stringWithFormat:@"%.0f ms", self.latency * 1000];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the date formatter that is shared by all GtpLogItem objects
+/// to generate the value of the @e timeStamp property. Must be invoked in the
+/// context of the main thread only.
+// -----------------------------------------------------------------------------
++ (NSDateFormatter*) dateFormatter
+{
+  static NSDateFormatter* dateFormatter = nil;
+  if (! dateFormatter)
+  {
+    dateFormatter = [[NSDateFormatter alloc] init];
+    [dateFormatter setLocale:[NSLocale currentLocale]];
+    // Use medium format so that we can see seconds - this way we can better
+    // gauge how long the engine takes for calculating its moves.
+    [dateFormatter setTimeStyle:NSDateFormatterMediumStyle];
+    [dateFormatter setDateStyle:NSDateFormatterShortStyle];
+  }
+  return dateFormatter;
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Returns an image that is appropriate for representing the GTP
 /// response status of this GtpLogItem in a table view cell.
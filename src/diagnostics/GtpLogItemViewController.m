@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2021 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -52,6 +52,7 @@ enum CommandSectionItem
 enum ResponseSectionItem
 {
   ResponseStatusItem,
+  ResponseLatencyItem,
   MaxResponseSectionItem
 };
 
@@ -246,6 +247,13 @@ enum ResponseStringSectionItem
             }
           }
           break;
+        case ResponseLatencyItem:
+          cell.textLabel.text = @"Latency";
+          if (! self.logItem.hasResponse)
+            cell.detailTextLabel.text = @"No response received yet";
+          else
+            cell.detailTextLabel.text = [self.logItem latencyString];
+          break;
         default:
           assert(0);
           break;
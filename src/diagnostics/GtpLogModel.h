@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2015 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -43,6 +43,12 @@
 /// activities that occur around GTP client and engine. There is a guarantee,
 /// though, that items will pop up in the log in the same order that commands
 /// were submitted to the GTP engine.
+///
+/// The log is stored in a ring buffer with a fixed capacity of @e gtpLogSize
+/// items, so that adding an item to a full log merely overwrites the oldest
+/// item. Log items store raw timestamps that are captured when the GTP client
+/// posts its notifications. The timestamps are formatted only when an item is
+/// displayed (see GtpLogItem).
 // -----------------------------------------------------------------------------
 @interface GtpLogModel : NSObject
 {
@@ -52,21 +58,23 @@
 - (void) readUserDefaults;
 - (void) writeUserDefaults;
 - (GtpLogItem*) itemAtIndex:(int)index;
+- (int) indexOfItem:(GtpLogItem*)item;
 - (void) clearLog;
 
-/// @brief Number of objects in @e itemList.
-///
-/// This property exists purely as a convenience to clients, since the object
-/// count is also available from the itemList array.
+/// @brief Number of items in the log.
 @property(nonatomic, assign, readonly) int itemCount;
-/// @brief Array stores objects of type GtpLogItem. Items appear in the array
+/// @brief Array with objects of type GtpLogItem. Items appear in the array
 /// in the order that their corresponding commands were submitted.
-@property(nonatomic, retain, readonly) NSArray* itemList;
-/// @brief The size of the GTP log, i.e. the maximum number of objects that can
-/// be in @e itemList.
 ///
-/// If a new item is about to be added to @e itemList that would exceed the
-/// limit, the oldest item is discarded first.
+/// Each access copies all items out of the ring buffer into a new array,
+/// which costs O(n) time and memory for a log with n items. Clients that only
+/// need to access a single item should use itemAtIndex:() instead.
+@property(nonatomic, copy, readonly) NSArray* itemList;
+/// @brief The size of the GTP log, i.e. the maximum number of items that can
+/// be in the log.
+///
+/// This is the capacity of the ring buffer that stores the log. When a new
+/// item is added to a full log, it overwrites the oldest item.
 @property(nonatomic, assign) int gtpLogSize;
 /// @brief True if the "GTP Log" view currently displays the frontside view,
 /// false if it displays the backside view.
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2015 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -24,31 +24,29 @@
 
 // -----------------------------------------------------------------------------
 /// @brief Class extension with private properties for GtpLogModel.
+///
+/// The ring buffer consists of two C arrays with @e ringBufferCapacity
+/// elements each. @e ringBufferItems stores the GtpLogItem objects,
+/// @e ringBufferCommands stores the addresses of the GtpCommand objects that
+/// the items represent. The addresses are used only to correlate GTP responses
+/// with log items, they are never dereferenced.
+///
+/// Items are identified by their sequence number. The item with sequence
+/// number @e n is stored at index <tt>n % ringBufferCapacity</tt>.
 // -----------------------------------------------------------------------------
 @interface GtpLogModel()
-/// @name Re-declaration of properties to make them readwrite privately
-//@{
-@property(nonatomic, retain, readwrite) NSArray* itemList;
-//@}
+{
+@private
+  GtpLogItem** ringBufferItems;
+  const void** ringBufferCommands;
+  int ringBufferCapacity;
+}
 /// @name Private properties
 //@{
-/// @brief Stores GtpLogItem objects for which a GTP response is still
-/// outstanding.
-///
-/// The array acts as a fifo queue. enqueueItemWithNoResponse() and
-/// dequeueItemWithNoResponse() are used to modify the queue.
-///
-/// The assumption behind this is that the GTP engine also works as a queue: It
-/// processes GTP commands in the order that they are submitted, and does not
-/// start processing a new command before it has sent the response to the
-/// preceding command.
-///
-/// Based on this assumption, GtpLogItem objects can simply be added to the
-/// queue as the GTP command submissions are pouring in. Whenever a GTP response
-/// is received, the GtpLogItem object at the front of the queue must be the
-/// one with the command that the response belongs to.
-@property(nonatomic, retain) NSMutableArray* itemQueueNoResponses;
-@property(nonatomic, retain) NSDateFormatter* dateFormatter;
+/// @brief The sequence number of the oldest item in the log.
+@property(nonatomic, assign) long long sequenceNumberOfOldestItem;
+/// @brief The sequence number that the next item added to the log will get.
+@property(nonatomic, assign) long long nextSequenceNumber;
 //@}
 @end
 
@@ -76,17 +74,13 @@
                                                name:gtpResponseWasReceivedNotification
                                              object:nil];
 
-  self.itemList = [NSMutableArray arrayWithCapacity:0];
+  ringBufferItems = NULL;
+  ringBufferCommands = NULL;
+  ringBufferCapacity = 0;
+  self.sequenceNumberOfOldestItem = 0;
+  self.nextSequenceNumber = 0;
   self.gtpLogSize = 100;
   self.gtpLogViewFrontSideIsVisible = true;
-  self.itemQueueNoResponses = [NSMutableArray arrayWithCapacity:0];
-
-  self.dateFormatter = [[[NSDateFormatter alloc] init] autorelease];
-  [self.dateFormatter setLocale:[NSLocale currentLocale]];
-  // Use medium format so that we can see seconds - this way we can better
-  // gauge how long the engine takes for calculating its moves.
-  [self.dateFormatter setTimeStyle:NSDateFormatterMediumStyle];
-  [self.dateFormatter setDateStyle:NSDateFormatterShortStyle];
 
   return self;
 }
@@ -97,9 +91,9 @@
 - (void) dealloc
 {
   [[NSNotificationCenter defaultCenter] removeObserver:self];
-  self.itemList = nil;
-  self.itemQueueNoResponses = nil;
-  self.dateFormatter = nil;
+  [self removeItemsOlderThanSequenceNumber:self.nextSequenceNumber];
+  free(ringBufferItems);
+  free(ringBufferCommands);
   [super dealloc];
 }
 
@@ -130,19 +124,27 @@
 // -----------------------------------------------------------------------------
 /// @brief Responds to the #gtpCommandWillBeSubmitted notification.
 ///
-/// This method is executed in a secondary thread. Delegates processing of the
-/// GtpCommand object associated with the notification to
-/// updateLogWithGtpCommand:(). See class documentation for details.
+/// This method is executed in a secondary thread. Captures the submission
+/// timestamps, then delegates processing of the GtpCommand object associated
+/// with the notification to gtpCommandWillBeSubmittedDelegate:(). See class
+/// documentation for details.
 // -----------------------------------------------------------------------------
 - (void) gtpCommandWillBeSubmitted:(NSNotification*)notification
 {
   GtpCommand* command = (GtpCommand*)[notification object];
-  // Retain to make sure that object is still alive when it "arrives" in
-  // the main thread
-  [command retain];
+
+  // The log item is not yet shared with anyone, so it is safe to create and
+  // populate it in this thread
+  GtpLogItem* logItem = [[[GtpLogItem alloc] init] autorelease];
+  logItem.commandString = command.command;
+  logItem.submissionDate = CFAbsoluteTimeGetCurrent();
+  logItem.submissionTime = [NSProcessInfo processInfo].systemUptime;
+
+  // The array retains the objects to make sure that they are still alive when
+  // they "arrive" in the main thread
   [self performSelector:@selector(gtpCommandWillBeSubmittedDelegate:)
                onThread:[NSThread mainThread]
-             withObject:command
+             withObject:@[logItem, command]
           waitUntilDone:NO];
 }
 
@@ -150,52 +152,49 @@
 /// @brief Delegate method of gtpCommandWillBeSubmitted:(). This method is
 /// executed in the main thread. See class documentation for details.
 // -----------------------------------------------------------------------------
-- (void) gtpCommandWillBeSubmittedDelegate:(GtpCommand*)command
+- (void) gtpCommandWillBeSubmittedDelegate:(NSArray*)logItemAndCommand
 {
-  // Undo retain message sent to the command object by
-  // gtpCommandWillBeSubmitted:()
-  [command autorelease];
-
-  [self addItemToLog:command];
-  [self trimLog];
+  GtpLogItem* logItem = [logItemAndCommand objectAtIndex:0];
+  GtpCommand* command = [logItemAndCommand objectAtIndex:1];
+  [self addItemToLog:logItem forCommand:command];
   [[NSNotificationCenter defaultCenter] postNotificationName:gtpLogContentChanged
                                                       object:nil];
 }
 
 // -----------------------------------------------------------------------------
 /// @brief Responds to the #gtpResponseWasReceived notification.
+///
+/// This method is executed in a secondary thread. Captures the response
+/// timestamp, then delegates processing of the GtpResponse object associated
+/// with the notification to gtpResponseWasReceivedDelegate:(). See class
+/// documentation for details.
 // -----------------------------------------------------------------------------
 - (void) gtpResponseWasReceived:(NSNotification*)notification
 {
   GtpResponse* response = (GtpResponse*)[notification object];
-  // Retain to make sure that object is still alive when it "arrives" in
-  // the main thread
-  [response retain];
+  NSNumber* responseTime = [NSNumber numberWithDouble:[NSProcessInfo processInfo].systemUptime];
+  // The array retains the objects to make sure that they are still alive when
+  // they "arrive" in the main thread
   [self performSelector:@selector(gtpResponseWasReceivedDelegate:)
                onThread:[NSThread mainThread]
-             withObject:response
+             withObject:@[response, responseTime]
           waitUntilDone:NO];
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Delegate method of gtpCommandWillBeSubmitted:(). This method is
+/// @brief Delegate method of gtpResponseWasReceived:(). This method is
 /// executed in the main thread. See class documentation for details.
 // -----------------------------------------------------------------------------
-- (void) gtpResponseWasReceivedDelegate:(GtpResponse*)response
+- (void) gtpResponseWasReceivedDelegate:(NSArray*)responseAndResponseTime
 {
-  // Undo retain message sent to the response object by
-  // gtpResponseWasReceived:()
-  [response autorelease];
-
-  GtpLogItem* logItem = [self dequeueItemWithNoResponse];
-  assert(logItem != nil);
-  if (! logItem)
-    DDLogError(@"%@: GtpLogItem object is nil", self);
+  GtpResponse* response = [responseAndResponseTime objectAtIndex:0];
+  NSNumber* responseTime = [responseAndResponseTime objectAtIndex:1];
 
   // Check if the item was kicked out of the log while the response was still
   // outstanding. Stuff like clearing the log, or a massive amount of trimming,
   // might have happened.
-  if (! [_itemList containsObject:logItem])
+  GtpLogItem* logItem = [self itemWithNoResponseForCommand:response.command];
+  if (! logItem)
   {
     DDLogInfo(@"Discarding GTP response");
     return;
@@ -203,6 +202,7 @@
 
   logItem.hasResponse = true;
   logItem.responseStatus = response.status;
+  logItem.responseTime = [responseTime doubleValue];
   logItem.parsedResponseString = [response parsedResponse];
   logItem.rawResponseString = response.rawResponse;
 
@@ -215,10 +215,19 @@
 // -----------------------------------------------------------------------------
 - (int) itemCount
 {
-  // Cast is required because NSUInteger and int differ in size in 64-bit. Cast
-  // is safe because this app was not made to handle more than pow(2, 31) log
-  // items.
-  return (int)_itemList.count;
+  // Cast is safe because the log never has more than gtpLogSizeMaximum items
+  return (int)(self.nextSequenceNumber - self.sequenceNumberOfOldestItem);
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (NSArray*) itemList
+{
+  NSMutableArray* itemList = [NSMutableArray arrayWithCapacity:self.itemCount];
+  for (long long sequenceNumber = self.sequenceNumberOfOldestItem; sequenceNumber < self.nextSequenceNumber; ++sequenceNumber)
+    [itemList addObject:ringBufferItems[sequenceNumber % ringBufferCapacity]];
+  return itemList;
 }
 
 // -----------------------------------------------------------------------------
@@ -232,13 +241,32 @@
     DDLogError(@"%@: Attempting to set illegal log size %d", self, newSize);
     return;
   }
+  if (newSize == _gtpLogSize)
+    return;
 
   int oldSize = _gtpLogSize;
   _gtpLogSize = newSize;
 
+  // Discard the oldest items that no longer fit, then move the remaining items
+  // into a ring buffer with the new capacity. This happens only if the user
+  // changes the log size, so it's not worth optimizing.
+  if (self.itemCount > newSize)
+    [self removeItemsOlderThanSequenceNumber:self.nextSequenceNumber - newSize];
+  GtpLogItem** newRingBufferItems = calloc(newSize, sizeof(GtpLogItem*));
+  const void** newRingBufferCommands = calloc(newSize, sizeof(void*));
+  for (long long sequenceNumber = self.sequenceNumberOfOldestItem; sequenceNumber < self.nextSequenceNumber; ++sequenceNumber)
+  {
+    newRingBufferItems[sequenceNumber % newSize] = ringBufferItems[sequenceNumber % ringBufferCapacity];
+    newRingBufferCommands[sequenceNumber % newSize] = ringBufferCommands[sequenceNumber % ringBufferCapacity];
+  }
+  free(ringBufferItems);
+  free(ringBufferCommands);
+  ringBufferItems = newRingBufferItems;
+  ringBufferCommands = newRingBufferCommands;
+  ringBufferCapacity = newSize;
+
   if (newSize < oldSize)
   {
-    [self trimLog];
     [[NSNotificationCenter defaultCenter] postNotificationName:gtpLogContentChanged
                                                         object:nil];
   }
@@ -246,81 +274,87 @@
 
 // -----------------------------------------------------------------------------
 /// @brief Returns the log item object located at position @a index in the
-/// itemList array.
+/// log. The oldest item is located at position 0.
 // -----------------------------------------------------------------------------
 - (GtpLogItem*) itemAtIndex:(int)index
 {
-  return [_itemList objectAtIndex:index];
+  if (index < 0 || index >= self.itemCount)
+  {
+    NSString* errorMessage = [NSString stringWithFormat:@"Index %d is out of range, log has %d items", index, self.itemCount];
+    DDLogError(@"%@: %@", self, errorMessage);
+    NSException* exception = [NSException exceptionWithName:NSRangeException
+                                                      reason:errorMessage
+                                                    userInfo:nil];
+    @throw exception;
+  }
+  return ringBufferItems[(self.sequenceNumberOfOldestItem + index) % ringBufferCapacity];
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Adds an item that represents @a command to the log.
+/// @brief Returns the position of @a item in the log. Returns -1 if @a item
+/// is no longer in the log.
 // -----------------------------------------------------------------------------
-- (void) addItemToLog:(GtpCommand*)command
+- (int) indexOfItem:(GtpLogItem*)item
 {
-  GtpLogItem* logItem = [[GtpLogItem alloc] init];
-  [(NSMutableArray*)_itemList addObject:logItem];  // _itemList has ownership
-  [logItem release];
-
-  [self enqueueItemWithNoResponse:logItem];
-
-  logItem.commandString = command.command;
-  logItem.timeStamp = [self.dateFormatter stringFromDate:[NSDate date]];
+  long long sequenceNumber = item.sequenceNumber;
+  if (sequenceNumber < self.sequenceNumberOfOldestItem || sequenceNumber >= self.nextSequenceNumber)
+    return -1;
+  if (ringBufferItems[sequenceNumber % ringBufferCapacity] != item)
+    return -1;
+  return (int)(sequenceNumber - self.sequenceNumberOfOldestItem);
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Removes as many of the oldest items from the log as are needed to
-/// bring the log size down to its maximum allowed size (property
-/// @e gtpLogSize).
-///
-/// Does nothing if the log size currently does not exceed the limit.
+/// @brief Adds @a logItem, which represents @a command, to the log. If the log
+/// is full, the oldest item is discarded.
 // -----------------------------------------------------------------------------
-- (void) trimLog
+- (void) addItemToLog:(GtpLogItem*)logItem forCommand:(GtpCommand*)command
 {
-  // Cast is required because NSUInteger and int differ in size in 64-bit. Cast
-  // is safe because this app was not made to handle more than pow(2, 31) log
-  // items.
-  int numberOfItemsToDiscard = (int)_itemList.count - self.gtpLogSize;
-  if (numberOfItemsToDiscard <= 0)
-    return;
-
-  NSRange rangeToRemove;
-  rangeToRemove.location = 0;  // oldest items are at the front of the array
-  rangeToRemove.length = numberOfItemsToDiscard;
-  [(NSMutableArray*)_itemList removeObjectsInRange:rangeToRemove];
+  if (self.itemCount == ringBufferCapacity)
+    [self removeItemsOlderThanSequenceNumber:self.sequenceNumberOfOldestItem + 1];
+
+  long long sequenceNumber = self.nextSequenceNumber;
+  logItem.sequenceNumber = sequenceNumber;
+  ringBufferItems[sequenceNumber % ringBufferCapacity] = [logItem retain];  // the ring buffer has ownership
+  ringBufferCommands[sequenceNumber % ringBufferCapacity] = command;
+  self.nextSequenceNumber = sequenceNumber + 1;
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Adds @a item to the end of the queue with log items for which the
-/// response is still outstanding.
+/// @brief Removes all items from the log whose sequence number is less than
+/// @a sequenceNumber.
 // -----------------------------------------------------------------------------
-- (void) enqueueItemWithNoResponse:(GtpLogItem*)logItem
+- (void) removeItemsOlderThanSequenceNumber:(long long)sequenceNumber
 {
-  [_itemQueueNoResponses addObject:logItem];
+  for (; self.sequenceNumberOfOldestItem < sequenceNumber; self.sequenceNumberOfOldestItem++)
+  {
+    int index = (int)(self.sequenceNumberOfOldestItem % ringBufferCapacity);
+    [ringBufferItems[index] release];
+    ringBufferItems[index] = nil;
+    ringBufferCommands[index] = NULL;
+  }
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Removes an item from the front of the queue with log items for which
-/// the response is still outstanding, then returns that item.
+/// @brief Returns the log item that represents @a command and for which the
+/// response is still outstanding. Returns nil if there is no such item in the
+/// log.
 ///
-/// Returns nil if the queue is currently empty.
+/// Items are searched from newest to oldest. Usually the response belongs to
+/// one of the most recent items, so the search is short. Searching from newest
+/// to oldest also guarantees that an outdated item whose response was never
+/// received cannot be confused with a newer item whose GtpCommand object
+/// happens to have the same address.
 // -----------------------------------------------------------------------------
-- (GtpLogItem*) dequeueItemWithNoResponse
+- (GtpLogItem*) itemWithNoResponseForCommand:(GtpCommand*)command
 {
-  if (_itemQueueNoResponses.count == 0)
-    return nil;
-  GtpLogItem* logItem = [_itemQueueNoResponses objectAtIndex:0];
-  [_itemQueueNoResponses removeObjectAtIndex:0];
-  return logItem;
-}
-
-// -----------------------------------------------------------------------------
-/// @brief Removes all items from the queue with items for which the GTP
-/// response is still outstanding.
-// -----------------------------------------------------------------------------
-- (void) clearItemQueueWithNoResponse
-{
-  [_itemQueueNoResponses removeAllObjects];
+  for (long long sequenceNumber = self.nextSequenceNumber - 1; sequenceNumber >= self.sequenceNumberOfOldestItem; --sequenceNumber)
+  {
+    int index = (int)(sequenceNumber % ringBufferCapacity);
+    if (ringBufferCommands[index] == command && ! ringBufferItems[index].hasResponse)
+      return ringBufferItems[index];
+  }
+  return nil;
 }
 
 // -----------------------------------------------------------------------------
@@ -328,10 +362,7 @@
 // -----------------------------------------------------------------------------
 - (void) clearLog
 {
-  [(NSMutableArray*)_itemList removeAllObjects];
-  // Note: _itemQueueNoResponses is not modified by design! If we were removing
-  // items from that queue, outstanding responses might become associated with
-  // the wrong GtpLogItem objects when they come in.
+  [self removeItemsOlderThanSequenceNumber:self.nextSequenceNumber];
 
   [[NSNotificationCenter defaultCenter] postNotificationName:gtpLogContentChanged
                                                       object:nil];
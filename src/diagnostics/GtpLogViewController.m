@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -363,7 +363,10 @@
   cell.accessoryType = UITableViewCellAccessoryDisclosureIndicator;
   GtpLogItem* logItem = [self.model itemAtIndex:row];
   cell.textLabel.text = logItem.commandString;
-  cell.detailTextLabel.text = logItem.timeStamp;
+  if (logItem.hasResponse)
+    cell.detailTextLabel.text = [NSString stringWithFormat:@"%@ (%@)", logItem.timeStamp, [logItem latencyString]];
+  else
+    cell.detailTextLabel.text = logItem.timeStamp;
   cell.imageView.image = [logItem imageRepresentingResponseStatus];
 
   return cell;
@@ -443,8 +446,15 @@
   // single item (not for scrolling).
   self.updateScheduledByGtpLogItemChanged = true;
 
+  // The item may have been discarded in the meantime
+  int indexOfItem = [self.model indexOfItem:logItem];
+  if (-1 == indexOfItem)
+  {
+    self.updateScheduledByGtpLogItemChanged = false;
+    return;
+  }
+
   NSUInteger sectionIndex = 0;
-  NSUInteger indexOfItem = [self.model.itemList indexOfObject:logItem];
   NSIndexPath* indexPath = [NSIndexPath indexPathForRow:indexOfItem inSection:sectionIndex];
   NSArray* indexPaths = [NSArray arrayWithObject:indexPath];
   [self.frontSideView reloadRowsAtIndexPaths:indexPaths
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -61,6 +61,7 @@
 - (int) size;
 - (void) addPoint:(GoPoint*)point;
 - (void) removePoint:(GoPoint*)point;
+- (void) removeAllPoints;
 - (void) joinRegion:(GoBoardRegion*)region;
 - (bool) isStoneGroup;
 - (enum GoColor) color;
@@ -72,9 +73,6 @@
 /// @brief List of GoPoint objects in this GoBoardRegion. The list is
 /// unordered.
 @property(nonatomic, readonly, retain) NSArray* points;
-/// @brief A random color that can be used to mark GoPoints in this
-/// GoBoardRegion. This is intended as a debugging aid.
-@property(nonatomic, retain) UIColor* randomColor;
 /// @brief Flag is true if scoring mode is enabled. See class documentation for
 /// details.
 @property(nonatomic, assign) bool scoringMode;
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -18,7 +18,6 @@
 // Project includes
 #import "GoBoardRegion.h"
 #import "GoPoint.h"
-#import "../utility/UIColorAdditions.h"
 
 
 // -----------------------------------------------------------------------------
@@ -98,7 +97,6 @@
     return nil;
 
   self.points = [NSMutableArray arrayWithCapacity:0];
-  self.randomColor = [UIColor randomColor];
   _scoringMode = false;  // don't use self, otherwise we trigger the setter!
   self.territoryColor = GoColorNone;
   self.territoryInconsistencyFound = false;
@@ -121,7 +119,6 @@
     return nil;
 
   self.points = [decoder decodeObjectOfClasses:[NSSet setWithArray:@[[NSMutableArray class], [GoPoint class]]] forKey:goBoardRegionPointsKey];
-  self.randomColor = [UIColor randomColor];
   // Don't use self.scoringMode, otherwise we trigger the setter!
   if ([decoder containsValueForKey:goBoardRegionScoringModeKey])
     _scoringMode = true;
@@ -177,7 +174,6 @@
 - (void) dealloc
 {
   self.points = nil;
-  self.randomColor = nil;
   [self invalidateCache];
   [super dealloc];
 }
@@ -304,6 +300,30 @@
     [self splitRegionAfterRemovingPoint:point];
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Removes all GoPoint objects from this GoBoardRegion.
+///
+/// The GoBoardRegion reference of all GoPoint objects is updated to nil.
+/// Unlike removePoint:(), this method does not apply any region-fragmentation
+/// logic. It is intended to be used by clients that rebuild the regions of an
+/// entire area of the board in one go, such as
+/// GoUtilities::movePointsToNewRegions:().
+///
+/// @note Because GoBoardRegion is retained by its GoPoint objects, this
+/// GoBoardRegion is deallocated when this method returns unless the client
+/// holds its own reference to it.
+// -----------------------------------------------------------------------------
+- (void) removeAllPoints
+{
+  // Retain/autorelease to make sure that we survive until the end of this
+  // method even if the GoPoint objects hold the only references to us
+  [[self retain] autorelease];
+  NSArray* points = [NSArray arrayWithArray:_points];
+  [(NSMutableArray*)_points removeAllObjects];
+  for (GoPoint* point in points)
+    point.region = nil;
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Joins @a region with this GoBoardRegion, i.e. all GoPoint objects
 /// in @a region are added to this GoBoardRegion.
@@ -0,0 +1,70 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Forward declarations
+@class GoBoard;
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GoDeadStoneEstimator class estimates which stone groups on a
+/// Go board are dead, without asking the GTP engine.
+///
+/// @ingroup go
+///
+/// GoDeadStoneEstimator works on the graph of GoBoardRegion objects and their
+/// adjacent regions. It is fast enough to be used synchronously when scoring
+/// mode is enabled, so that the user immediately sees an initial set of dead
+/// stones. GoScore then asks the GTP engine for a more accurate set of dead
+/// stones in the background.
+///
+/// The estimate is made in two steps.
+///
+/// In the first step, GoDeadStoneEstimator determines for each color which
+/// stone groups are alive:
+/// - Stone groups that are unconditionally alive according to Benson's
+///   algorithm. These groups cannot be captured even if the opponent is allowed
+///   to play an unlimited number of moves in a row.
+/// - Stone groups that are adjacent to two or more empty regions that are
+///   enclosed by stones of their own color only, or to one such empty region
+///   that is large enough to form two eyes.
+///
+/// In the second step, GoDeadStoneEstimator splits the board into areas that
+/// are separated by the living stone groups of one color, and estimates that
+/// the stone groups of the other color within an area are dead if
+/// - the area borders on living stone groups of the first color, and
+/// - the area contains no living stone group of the other color, and
+/// - the area contains less than two empty regions that are enclosed by
+///   stones of the other color only (i.e. potential eyes), and
+/// - the area is not larger than a quarter of the board.
+///
+/// The estimate is a heuristic. In unclear situations (e.g. semeai, seki, or
+/// large unsettled areas) GoDeadStoneEstimator errs on the side of declaring
+/// stone groups alive.
+///
+/// @note The GoBoardRegion objects should be in scoring mode when
+/// GoDeadStoneEstimator is used, because in scoring mode GoBoardRegion caches
+/// the information that GoDeadStoneEstimator queries.
+// -----------------------------------------------------------------------------
+@interface GoDeadStoneEstimator : NSObject
+{
+}
+
+- (id) initWithBoard:(GoBoard*)board;
+- (NSArray*) deadStoneGroups;
+
+@end
@@ -0,0 +1,467 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Project includes
+#import "GoDeadStoneEstimator.h"
+#import "GoBoard.h"
+#import "GoBoardRegion.h"
+#import "GoPoint.h"
+
+
+/// @brief An empty region that is enclosed by stones of a single color and
+/// has at least this many points is large enough to form two eyes.
+static const int minimumEyeSpaceForTwoEyes = 7;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GoDeadStoneEstimator.
+///
+/// The region graph is stored in plain C arrays that are indexed by region
+/// index. Adjacent regions are stored in compressed form: The indexes of the
+/// regions adjacent to region @e i are stored in @e adjacencyList, starting at
+/// index @e adjacencyStart[i] and ending before index @e adjacencyStart[i + 1].
+// -----------------------------------------------------------------------------
+@interface GoDeadStoneEstimator()
+{
+@private
+  int numberOfRegions;
+  enum GoColor* regionColors;
+  int* regionSizes;
+  int* adjacencyStart;
+  int* adjacencyList;
+}
+@property(nonatomic, assign) int boardSize;
+/// @brief The GoBoardRegion objects on the board. The index of a region in this
+/// array is the region index.
+@property(nonatomic, retain) NSArray* regions;
+/// @brief Maps GoBoardRegion objects to their region index.
+@property(nonatomic, retain) NSMapTable* regionIndexes;
+@end
+
+
+@implementation GoDeadStoneEstimator
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GoDeadStoneEstimator object that estimates the dead
+/// stone groups on @a board, in the board's current state.
+///
+/// @note This is the designated initializer of GoDeadStoneEstimator.
+// -----------------------------------------------------------------------------
+- (id) initWithBoard:(GoBoard*)board
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.boardSize = board.size;
+  self.regions = [NSArray arrayWithArray:board.regions];
+  self.regionIndexes = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality
+                                             valueOptions:NSPointerFunctionsStrongMemory];
+  numberOfRegions = (int)self.regions.count;
+  regionColors = malloc(numberOfRegions * sizeof(enum GoColor));
+  regionSizes = malloc(numberOfRegions * sizeof(int));
+  adjacencyStart = malloc((numberOfRegions + 1) * sizeof(int));
+
+  int indexOfRegion = 0;
+  for (GoBoardRegion* region in self.regions)
+  {
+    [self.regionIndexes setObject:[NSNumber numberWithInt:indexOfRegion] forKey:region];
+    regionColors[indexOfRegion] = [region color];
+    regionSizes[indexOfRegion] = [region size];
+    indexOfRegion++;
+  }
+
+  NSMutableArray* adjacentRegionsOfAllRegions = [NSMutableArray arrayWithCapacity:numberOfRegions];
+  int numberOfAdjacencies = 0;
+  for (GoBoardRegion* region in self.regions)
+  {
+    NSArray* adjacentRegions = [region adjacentRegions];
+    [adjacentRegionsOfAllRegions addObject:adjacentRegions];
+    numberOfAdjacencies += (int)adjacentRegions.count;
+  }
+  adjacencyList = malloc(numberOfAdjacencies * sizeof(int));
+  int indexOfAdjacency = 0;
+  for (indexOfRegion = 0; indexOfRegion < numberOfRegions; ++indexOfRegion)
+  {
+    adjacencyStart[indexOfRegion] = indexOfAdjacency;
+    for (GoBoardRegion* adjacentRegion in [adjacentRegionsOfAllRegions objectAtIndex:indexOfRegion])
+      adjacencyList[indexOfAdjacency++] = [self indexOfRegion:adjacentRegion];
+  }
+  adjacencyStart[numberOfRegions] = indexOfAdjacency;
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GoDeadStoneEstimator object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  free(regionColors);
+  free(regionSizes);
+  free(adjacencyStart);
+  free(adjacencyList);
+  self.regions = nil;
+  self.regionIndexes = nil;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the stone groups (GoBoardRegion objects) that are estimated
+/// to be dead. See the class documentation for details. Returns an empty array
+/// if no stone groups are estimated to be dead.
+// -----------------------------------------------------------------------------
+- (NSArray*) deadStoneGroups
+{
+  bool* aliveBlack = [self newAliveFlagsForColor:GoColorBlack];
+  bool* aliveWhite = [self newAliveFlagsForColor:GoColorWhite];
+
+  NSMutableArray* deadStoneGroups = [NSMutableArray array];
+  [self addDeadStoneGroupsOfColor:GoColorBlack alive:aliveBlack opponentAlive:aliveWhite toArray:deadStoneGroups];
+  [self addDeadStoneGroupsOfColor:GoColorWhite alive:aliveWhite opponentAlive:aliveBlack toArray:deadStoneGroups];
+
+  free(aliveBlack);
+  free(aliveWhite);
+  return deadStoneGroups;
+}
+
+#pragma mark - Private helpers
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns the region index of @a region.
+// -----------------------------------------------------------------------------
+- (int) indexOfRegion:(GoBoardRegion*)region
+{
+  return [[self.regionIndexes objectForKey:region] intValue];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns the root of the union-find tree in
+/// @a parents that contains @a index. Compresses the path along the way.
+// -----------------------------------------------------------------------------
+static int findRoot(int* parents, int index)
+{
+  while (parents[index] != index)
+  {
+    parents[index] = parents[parents[index]];
+    index = parents[index];
+  }
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns a newly allocated array of flags, indexed by
+/// region index, that are true for the stone groups of color @a color that
+/// are considered to be alive. The caller is responsible for freeing the
+/// array.
+// -----------------------------------------------------------------------------
+- (bool*) newAliveFlagsForColor:(enum GoColor)color
+{
+  bool* alive = calloc(numberOfRegions, sizeof(bool));
+  [self markUnconditionallyAliveStoneGroupsOfColor:color alive:alive];
+
+  // Heuristic: Count the empty regions that are enclosed by stones of the
+  // color only, i.e. the eyes (or the territory) of the stone groups
+  int* numberOfEnclosedRegions = calloc(numberOfRegions, sizeof(int));
+  bool* hasLargeEnclosedRegion = calloc(numberOfRegions, sizeof(bool));
+  for (int indexOfRegion = 0; indexOfRegion < numberOfRegions; ++indexOfRegion)
+  {
+    if (! [self isEmptyRegion:indexOfRegion enclosedByColor:color])
+      continue;
+    for (int indexOfAdjacency = adjacencyStart[indexOfRegion]; indexOfAdjacency < adjacencyStart[indexOfRegion + 1]; ++indexOfAdjacency)
+    {
+      int indexOfStoneGroup = adjacencyList[indexOfAdjacency];
+      numberOfEnclosedRegions[indexOfStoneGroup]++;
+      if (regionSizes[indexOfRegion] >= minimumEyeSpaceForTwoEyes)
+        hasLargeEnclosedRegion[indexOfStoneGroup] = true;
+    }
+  }
+  for (int indexOfRegion = 0; indexOfRegion < numberOfRegions; ++indexOfRegion)
+  {
+    if (regionColors[indexOfRegion] != color)
+      continue;
+    if (numberOfEnclosedRegions[indexOfRegion] >= 2 || hasLargeEnclosedRegion[indexOfRegion])
+      alive[indexOfRegion] = true;
+  }
+
+  free(numberOfEnclosedRegions);
+  free(hasLargeEnclosedRegion);
+  return alive;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns true if the region with index
+/// @a indexOfRegion is an empty region whose adjacent regions are all stone
+/// groups of color @a color.
+// -----------------------------------------------------------------------------
+- (bool) isEmptyRegion:(int)indexOfRegion enclosedByColor:(enum GoColor)color
+{
+  if (regionColors[indexOfRegion] != GoColorNone)
+    return false;
+  if (adjacencyStart[indexOfRegion] == adjacencyStart[indexOfRegion + 1])
+    return false;  // the entire board is empty
+  for (int indexOfAdjacency = adjacencyStart[indexOfRegion]; indexOfAdjacency < adjacencyStart[indexOfRegion + 1]; ++indexOfAdjacency)
+  {
+    if (regionColors[adjacencyList[indexOfAdjacency]] != color)
+      return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Sets the flags in @a alive to true for the stone
+/// groups of color @a color that are unconditionally alive according to
+/// Benson's algorithm.
+///
+/// The regions that are not stone groups of color @a color are combined into
+/// maximal connected components (Benson's "regions", which can contain empty
+/// points and opposing stones). A component is vital to an adjacent stone
+/// group if all of its empty points are liberties of the stone group. Stone
+/// groups with less than two vital components, and components that are
+/// adjacent to such stone groups, are removed repeatedly until nothing
+/// changes anymore. The remaining stone groups are unconditionally alive.
+// -----------------------------------------------------------------------------
+- (void) markUnconditionallyAliveStoneGroupsOfColor:(enum GoColor)color alive:(bool*)alive
+{
+  int* components = malloc(numberOfRegions * sizeof(int));
+  for (int indexOfRegion = 0; indexOfRegion < numberOfRegions; ++indexOfRegion)
+    components[indexOfRegion] = indexOfRegion;
+  for (int indexOfRegion = 0; indexOfRegion < numberOfRegions; ++indexOfRegion)
+  {
+    if (regionColors[indexOfRegion] == color)
+      continue;
+    for (int indexOfAdjacency = adjacencyStart[indexOfRegion]; indexOfAdjacency < adjacencyStart[indexOfRegion + 1]; ++indexOfAdjacency)
+    {
+      int indexOfAdjacentRegion = adjacencyList[indexOfAdjacency];
+      if (regionColors[indexOfAdjacentRegion] == color)
+        continue;
+      components[findRoot(components, indexOfRegion)] = findRoot(components, indexOfAdjacentRegion);
+    }
+  }
+  for (int indexOfRegion = 0; indexOfRegion < numberOfRegions; ++indexOfRegion)
+    components[indexOfRegion] = findRoot(components, indexOfRegion);
+
+  // Pairs of component and adjacent stone group. There can be no more pairs
+  // than there are adjacencies.
+  int maximumNumberOfPairs = adjacencyStart[numberOfRegions];
+  int* pairComponents = malloc(maximumNumberOfPairs * sizeof(int));
+  int* pairStoneGroups = malloc(maximumNumberOfPairs * sizeof(int));
+  bool* pairIsVital = malloc(maximumNumberOfPairs * sizeof(bool));
+  int numberOfPairs = 0;
+
+  // Scratch arrays, indexed by region index
+  int* lastComponentSeen = malloc(numberOfRegions * sizeof(int));
+  int* numberOfLiberties = calloc(numberOfRegions, sizeof(int));
+  int* numberOfEmptyPoints = calloc(numberOfRegions, sizeof(int));
+  for (int indexOfRegion = 0; indexOfRegion < numberOfRegions; ++indexOfRegion)
+    lastComponentSeen[indexOfRegion] = -1;
+
+  for (int component = 0; component < numberOfRegions; ++component)
+  {
+    if (regionColors[component] == color || components[component] != component)
+      continue;
+    int indexOfFirstPair = numberOfPairs;
+    for (int indexOfRegion = 0; indexOfRegion < numberOfRegions; ++indexOfRegion)
+    {
+      if (components[indexOfRegion] != component || regionColors[indexOfRegion] == color)
+        continue;
+      for (int indexOfAdjacency = adjacencyStart[indexOfRegion]; indexOfAdjacency < adjacencyStart[indexOfRegion + 1]; ++indexOfAdjacency)
+      {
+        int indexOfStoneGroup = adjacencyList[indexOfAdjacency];
+        if (regionColors[indexOfStoneGroup] != color || lastComponentSeen[indexOfStoneGroup] == component)
+          continue;
+        lastComponentSeen[indexOfStoneGroup] = component;
+        pairComponents[numberOfPairs] = component;
+        pairStoneGroups[numberOfPairs] = indexOfStoneGroup;
+        numberOfPairs++;
+      }
+      if (regionColors[indexOfRegion] == GoColorNone)
+        [self countLibertiesInEmptyRegion:indexOfRegion ofColor:color numberOfLiberties:numberOfLiberties numberOfEmptyPoints:&numberOfEmptyPoints[component]];
+    }
+    for (int indexOfPair = indexOfFirstPair; indexOfPair < numberOfPairs; ++indexOfPair)
+    {
+      int indexOfStoneGroup = pairStoneGroups[indexOfPair];
+      pairIsVital[indexOfPair] = (numberOfEmptyPoints[component] > 0 &&
+                                  numberOfLiberties[indexOfStoneGroup] == numberOfEmptyPoints[component]);
+      numberOfLiberties[indexOfStoneGroup] = 0;
+    }
+  }
+
+  bool* componentIsValid = malloc(numberOfRegions * sizeof(bool));
+  int* numberOfVitalComponents = malloc(numberOfRegions * sizeof(int));
+  for (int indexOfRegion = 0; indexOfRegion < numberOfRegions; ++indexOfRegion)
+  {
+    componentIsValid[indexOfRegion] = true;
+    if (regionColors[indexOfRegion] == color)
+      alive[indexOfRegion] = true;
+  }
+
+  bool changed = true;
+  while (changed)
+  {
+    changed = false;
+    memset(numberOfVitalComponents, 0, numberOfRegions * sizeof(int));
+    for (int indexOfPair = 0; indexOfPair < numberOfPairs; ++indexOfPair)
+    {
+      if (pairIsVital[indexOfPair] && componentIsValid[pairComponents[indexOfPair]])
+        numberOfVitalComponents[pairStoneGroups[indexOfPair]]++;
+    }
+    for (int indexOfRegion = 0; indexOfRegion < numberOfRegions; ++indexOfRegion)
+    {
+      if (alive[indexOfRegion] && regionColors[indexOfRegion] == color && numberOfVitalComponents[indexOfRegion] < 2)
+      {
+        alive[indexOfRegion] = false;
+        changed = true;
+      }
+    }
+    for (int indexOfPair = 0; indexOfPair < numberOfPairs; ++indexOfPair)
+    {
+      int component = pairComponents[indexOfPair];
+      if (componentIsValid[component] && ! alive[pairStoneGroups[indexOfPair]])
+      {
+        componentIsValid[component] = false;
+        changed = true;
+      }
+    }
+  }
+
+  free(components);
+  free(pairComponents);
+  free(pairStoneGroups);
+  free(pairIsVital);
+  free(lastComponentSeen);
+  free(numberOfLiberties);
+  free(numberOfEmptyPoints);
+  free(componentIsValid);
+  free(numberOfVitalComponents);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Adds the number of points in the empty region with
+/// index @a indexOfRegion to @a numberOfEmptyPoints. For each stone group of
+/// color @a color, adds the number of these points that are liberties of the
+/// stone group to the element of @a numberOfLiberties with the stone group's
+/// region index.
+// -----------------------------------------------------------------------------
+- (void) countLibertiesInEmptyRegion:(int)indexOfRegion
+                             ofColor:(enum GoColor)color
+                   numberOfLiberties:(int*)numberOfLiberties
+                 numberOfEmptyPoints:(int*)numberOfEmptyPoints
+{
+  GoBoardRegion* region = [self.regions objectAtIndex:indexOfRegion];
+  for (GoPoint* point in region.points)
+  {
+    (*numberOfEmptyPoints)++;
+    // A point has at most 4 neighbours. A stone group that is adjacent on
+    // more than one side must be counted only once.
+    int stoneGroupsCounted[4];
+    int numberOfStoneGroupsCounted = 0;
+    for (GoPoint* neighbour in point.neighbours)
+    {
+      if (neighbour.stoneState != color)
+        continue;
+      int indexOfStoneGroup = [self indexOfRegion:neighbour.region];
+      bool alreadyCounted = false;
+      for (int indexOfCounted = 0; indexOfCounted < numberOfStoneGroupsCounted; ++indexOfCounted)
+      {
+        if (stoneGroupsCounted[indexOfCounted] == indexOfStoneGroup)
+          alreadyCounted = true;
+      }
+      if (alreadyCounted)
+        continue;
+      stoneGroupsCounted[numberOfStoneGroupsCounted++] = indexOfStoneGroup;
+      numberOfLiberties[indexOfStoneGroup]++;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Adds the stone groups of color @a color that are
+/// estimated to be dead to @a deadStoneGroups. @a alive and @a opponentAlive
+/// are the flags that were generated by newAliveFlagsForColor:() for color
+/// @a color and for the opposing color.
+// -----------------------------------------------------------------------------
+- (void) addDeadStoneGroupsOfColor:(enum GoColor)color
+                             alive:(bool*)alive
+                     opponentAlive:(bool*)opponentAlive
+                           toArray:(NSMutableArray*)deadStoneGroups
+{
+  // Areas are connected components of all regions except the living stone
+  // groups of the opponent
+  int* areas = malloc(numberOfRegions * sizeof(int));
+  for (int indexOfRegion = 0; indexOfRegion < numberOfRegions; ++indexOfRegion)
+    areas[indexOfRegion] = indexOfRegion;
+  for (int indexOfRegion = 0; indexOfRegion < numberOfRegions; ++indexOfRegion)
+  {
+    if (opponentAlive[indexOfRegion])
+      continue;
+    for (int indexOfAdjacency = adjacencyStart[indexOfRegion]; indexOfAdjacency < adjacencyStart[indexOfRegion + 1]; ++indexOfAdjacency)
+    {
+      int indexOfAdjacentRegion = adjacencyList[indexOfAdjacency];
+      if (opponentAlive[indexOfAdjacentRegion])
+        continue;
+      areas[findRoot(areas, indexOfRegion)] = findRoot(areas, indexOfAdjacentRegion);
+    }
+  }
+
+  bool* bordersOnOpponentAlive = calloc(numberOfRegions, sizeof(bool));
+  bool* containsAlive = calloc(numberOfRegions, sizeof(bool));
+  int* numberOfEyes = calloc(numberOfRegions, sizeof(int));
+  int* numberOfPoints = calloc(numberOfRegions, sizeof(int));
+  for (int indexOfRegion = 0; indexOfRegion < numberOfRegions; ++indexOfRegion)
+  {
+    if (opponentAlive[indexOfRegion])
+      continue;
+    int area = findRoot(areas, indexOfRegion);
+    areas[indexOfRegion] = area;
+    numberOfPoints[area] += regionSizes[indexOfRegion];
+    if (alive[indexOfRegion])
+      containsAlive[area] = true;
+    if ([self isEmptyRegion:indexOfRegion enclosedByColor:color])
+      numberOfEyes[area]++;
+    for (int indexOfAdjacency = adjacencyStart[indexOfRegion]; indexOfAdjacency < adjacencyStart[indexOfRegion + 1]; ++indexOfAdjacency)
+    {
+      if (opponentAlive[adjacencyList[indexOfAdjacency]])
+        bordersOnOpponentAlive[area] = true;
+    }
+  }
+
+  int maximumNumberOfPoints = self.boardSize * self.boardSize / 4;
+  for (int indexOfRegion = 0; indexOfRegion < numberOfRegions; ++indexOfRegion)
+  {
+    if (regionColors[indexOfRegion] != color)
+      continue;
+    int area = areas[indexOfRegion];
+    if (bordersOnOpponentAlive[area] &&
+        ! containsAlive[area] &&
+        numberOfEyes[area] < 2 &&
+        numberOfPoints[area] <= maximumNumberOfPoints)
+    {
+      [deadStoneGroups addObject:[self.regions objectAtIndex:indexOfRegion]];
+    }
+  }
+
+  free(areas);
+  free(bordersOnOpponentAlive);
+  free(containsAlive);
+  free(numberOfEyes);
+  free(numberOfPoints);
+}
+
+@end
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -73,6 +73,8 @@
              isIllegalReason:(enum GoBoardSetupIsIllegalReason*)reason
   createsIllegalStoneOrGroup:(GoPoint**)illegalStoneOrGroupPoint;
 - (bool) isLegalBoardSetup:(NSString**)errorMessage;
+- (bool) isLegalBoardSetupAfterChangingPoints:(NSArray*)points
+                  suicidalIntersectionsString:(NSString**)suicidalIntersectionsString;
 - (bool) isLegalMove:(GoPoint*)point isIllegalReason:(enum GoMoveIsIllegalReason*)reason;
 - (bool) isLegalMove:(GoPoint*)point byColor:(enum GoColor)color isIllegalReason:(enum GoMoveIsIllegalReason*)reason;
 - (bool) isLegalMove:(GoPoint*)point byColor:(enum GoColor)color afterNode:(GoNode*)node isIllegalReason:(enum GoMoveIsIllegalReason*)reason;
@@ -87,6 +89,9 @@
 - (void) changeSetupFirstMoveColor:(enum GoColor)newValue;
 - (void) changeSetupPoint:(GoPoint*)point toStoneState:(enum GoColor)stoneState;
 - (void) discardAllSetup;
+- (long long) zobristHashOfHypotheticalMoveAtPoint:(GoPoint*)point
+                                           byColor:(enum GoColor)color
+                                         afterNode:(GoNode*)node;
 
 /// @brief The type of this GoGame object.
 @property(nonatomic, assign) enum GoGameType type;
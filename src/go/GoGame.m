@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -928,11 +928,69 @@
 /// returns @e true, the value of @a reason is undefined.
 // -----------------------------------------------------------------------------
 - (bool) isLegalBoardSetup:(NSString**)suicidalIntersectionsString
+{
+  return [self areLegalStoneGroups:self.board.regions
+       suicidalIntersectionsString:suicidalIntersectionsString];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns @e true if the entire board in its current state would be
+/// legal during board setup, under the assumption that the board was legal
+/// before the stone state of the GoPoint objects in @a points was changed.
+/// Returns @e false if the board is not legal.
+///
+/// This is an optimized variant of isLegalBoardSetup:() for when the board was
+/// modified by applying a GoNodeSetup. Only a stone group that contains one of
+/// the GoPoint objects in @a points, or that is adjacent to one of them, can
+/// have lost its last liberty, so only these stone groups are examined. The
+/// out parameter @a suicidalIntersectionsString is filled in the same way as by
+/// isLegalBoardSetup:().
+///
+/// @a points may contain duplicates. GoBoardRegion objects must already have
+/// been updated to reflect the changed stone states.
+// -----------------------------------------------------------------------------
+- (bool) isLegalBoardSetupAfterChangingPoints:(NSArray*)points
+                  suicidalIntersectionsString:(NSString**)suicidalIntersectionsString
+{
+  NSMutableArray* stoneGroups = [NSMutableArray array];
+  NSMutableSet* stoneGroupsSet = [NSMutableSet set];
+  for (GoPoint* point in points)
+  {
+    for (GoPoint* affectedPoint in [point.neighbours arrayByAddingObject:point])
+    {
+      if (! [affectedPoint hasStone])
+        continue;
+      GoBoardRegion* stoneGroup = affectedPoint.region;
+      if ([stoneGroupsSet containsObject:stoneGroup])
+        continue;
+      [stoneGroupsSet addObject:stoneGroup];
+      [stoneGroups addObject:stoneGroup];
+    }
+  }
+
+  return [self areLegalStoneGroups:stoneGroups
+       suicidalIntersectionsString:suicidalIntersectionsString];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns @e true if all stone groups in @a regions have at least one
+/// liberty. Returns @e false if one or more stone groups have no liberties.
+/// GoBoardRegion objects in @a regions that are not stone groups are ignored.
+///
+/// If this method returns @e false, the out parameter
+/// @a suicidalIntersectionsString is filled with a comma-separated list of
+/// vertices that contain suicidal stones with no liberties.
+///
+/// This is an internal helper method for isLegalBoardSetup:() and
+/// isLegalBoardSetupAfterChangingPoints:suicidalIntersectionsString:().
+// -----------------------------------------------------------------------------
+- (bool) areLegalStoneGroups:(NSArray*)regions
+ suicidalIntersectionsString:(NSString**)suicidalIntersectionsString
 {
   int numberOfSuicidalIntersections = 0;
   *suicidalIntersectionsString = @"";
 
-  for (GoBoardRegion* region in self.board.regions)
+  for (GoBoardRegion* region in regions)
   {
     if (! region.isStoneGroup)
       continue;
@@ -1301,8 +1359,8 @@ nodeWithMostRecentMove:(GoNode*)nodeWithMostRecentMove
 /// @brief Generates the Zobrist hash for a hypothetical move played by @a color
 /// on the intersection @a point, after the previous move @a move.
 ///
-/// This is a private helper for
-/// isKoMove:moveColor:checkSuperkoOnly:isSuperko:().
+/// The hash is the same as the one that a new node would get if the move were
+/// actually played. The board must be in the state of @a node.
 // -----------------------------------------------------------------------------
 - (long long) zobristHashOfHypotheticalMoveAtPoint:(GoPoint*)point
                                            byColor:(enum GoColor)color
@@ -0,0 +1,64 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Forward declarations
+@class GoGame;
+@class GoNode;
+@class GoPoint;
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GoLegalMoveTable class remembers which intersections are legal
+/// moves in one board position, for the player whose turn it is in that board
+/// position.
+///
+/// @ingroup go
+///
+/// GoLegalMoveTable is a cache in front of GoGame::isLegalMove:isIllegalReason:().
+/// It is filled lazily: The first query for an intersection delegates to
+/// GoGame and remembers the outcome, including the reason why a move is
+/// illegal. All further queries for the same intersection are a single array
+/// read. This is useful when the same intersections are queried over and over
+/// again, e.g. while the user pans a stone across the board.
+///
+/// A GoLegalMoveTable is bound to the board position that is current when it
+/// is created, and to the color of the player who is to move in that board
+/// position. isValidForGame:() tells whether the board position or the color
+/// have changed since then. Whoever owns a GoLegalMoveTable is responsible for
+/// discarding it when it is no longer valid, typically in response to
+/// #currentBoardPositionDidChange.
+///
+/// GoLegalMoveTable must be used on the same thread as the GoGame it was
+/// created for, because GoGame and its associated objects are not thread-safe.
+// -----------------------------------------------------------------------------
+@interface GoLegalMoveTable : NSObject
+{
+}
+
+- (id) initWithGame:(GoGame*)game;
+- (bool) isValidForGame:(GoGame*)game;
+- (bool) isLegalMove:(GoPoint*)point isIllegalReason:(enum GoMoveIsIllegalReason*)reason;
+
+/// @brief The node that represents the board position for which this
+/// GoLegalMoveTable was created.
+@property(nonatomic, assign, readonly) GoNode* node;
+/// @brief The color of the player for whom this GoLegalMoveTable answers
+/// queries.
+@property(nonatomic, assign, readonly) enum GoColor color;
+
+@end
@@ -0,0 +1,170 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Project includes
+#import "GoLegalMoveTable.h"
+#import "GoBoard.h"
+#import "GoBoardPosition.h"
+#import "GoGame.h"
+#import "GoNode.h"
+#import "GoPoint.h"
+#import "GoVertex.h"
+#import "../utility/ExceptionUtility.h"
+
+
+/// @brief Enumerates the states of an entry in GoLegalMoveTable.
+enum LegalMoveTableEntry
+{
+  LegalMoveTableEntryUnknown = 0,   ///< @brief GoGame has not been asked yet.
+  LegalMoveTableEntryLegal,         ///< @brief The move is legal.
+  LegalMoveTableEntryIllegal        ///< @brief The move is illegal, the reason is stored separately.
+};
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GoLegalMoveTable.
+// -----------------------------------------------------------------------------
+@interface GoLegalMoveTable()
+@property(nonatomic, assign) GoGame* game;
+@property(nonatomic, assign, readwrite) GoNode* node;
+@property(nonatomic, assign, readwrite) enum GoColor color;
+/// @brief The Zobrist hash of @e node at the time the table was created. Is
+/// used to detect that @e node was deallocated and a new node was allocated
+/// at the same address.
+@property(nonatomic, assign) long long zobristHash;
+@property(nonatomic, assign) int boardSize;
+/// @brief One LegalMoveTableEntry value per intersection.
+@property(nonatomic, assign) unsigned char* entries;
+/// @brief One GoMoveIsIllegalReason value per intersection. Is only
+/// meaningful if the corresponding entry is #LegalMoveTableEntryIllegal.
+@property(nonatomic, assign) unsigned char* illegalReasons;
+@end
+
+
+@implementation GoLegalMoveTable
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GoLegalMoveTable object for the current board position
+/// of @a game and the player who is to move in that board position. All
+/// entries are initially unknown.
+///
+/// @note This is the designated initializer of GoLegalMoveTable.
+///
+/// @exception NSInvalidArgumentException Is raised if @a game is @e nil.
+// -----------------------------------------------------------------------------
+- (id) initWithGame:(GoGame*)game
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  if (! game)
+  {
+    [self release];
+    [ExceptionUtility throwInvalidArgumentExceptionWithErrorMessage:@"initWithGame: failed: Game is nil"];
+  }
+
+  self.game = game;
+  self.node = game.boardPosition.currentNode;
+  self.color = game.nextMoveColor;
+  self.zobristHash = self.node.zobristHash;
+  self.boardSize = game.board.size;
+  int numberOfIntersections = self.boardSize * self.boardSize;
+  self.entries = calloc(numberOfIntersections, sizeof(unsigned char));
+  self.illegalReasons = calloc(numberOfIntersections, sizeof(unsigned char));
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GoLegalMoveTable object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  free(self.entries);
+  self.entries = NULL;
+  free(self.illegalReasons);
+  self.illegalReasons = NULL;
+  self.game = nil;
+  self.node = nil;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if this GoLegalMoveTable still answers queries for the
+/// current board position of @a game, and for the player who is to move in
+/// that board position. Returns false if not.
+// -----------------------------------------------------------------------------
+- (bool) isValidForGame:(GoGame*)game
+{
+  if (game != self.game)
+    return false;
+  GoNode* currentNode = game.boardPosition.currentNode;
+  if (currentNode != self.node || currentNode.zobristHash != self.zobristHash)
+    return false;
+  return (game.nextMoveColor == self.color);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if playing a stone on the intersection represented by
+/// @a point is legal in the board position for which this GoLegalMoveTable
+/// was created. See GoGame::isLegalMove:byColor:afterNode:isIllegalReason:()
+/// for details.
+///
+/// If this method returns false, the out parameter @a reason is filled with
+/// the reason why the move is not legal. If this method returns true, the
+/// value of @a reason is undefined.
+///
+/// @exception NSInvalidArgumentException Is raised if @a point is @e nil.
+// -----------------------------------------------------------------------------
+- (bool) isLegalMove:(GoPoint*)point isIllegalReason:(enum GoMoveIsIllegalReason*)reason
+{
+  if (! point)
+    [ExceptionUtility throwInvalidArgumentExceptionWithErrorMessage:@"isLegalMove:isIllegalReason: failed: Point is nil"];
+
+  struct GoVertexNumeric numericVertex = point.vertex.numeric;
+  int index = (numericVertex.y - 1) * self.boardSize + (numericVertex.x - 1);
+
+  unsigned char entry = self.entries[index];
+  if (LegalMoveTableEntryUnknown == entry)
+  {
+    enum GoMoveIsIllegalReason illegalReason = GoMoveIsIllegalReasonUnknown;
+    bool isLegalMove = [self.game isLegalMove:point
+                                      byColor:self.color
+                                    afterNode:self.node
+                              isIllegalReason:&illegalReason];
+    if (isLegalMove)
+    {
+      entry = LegalMoveTableEntryLegal;
+    }
+    else
+    {
+      entry = LegalMoveTableEntryIllegal;
+      self.illegalReasons[index] = illegalReason;
+    }
+    self.entries[index] = entry;
+  }
+
+  if (LegalMoveTableEntryLegal == entry)
+    return true;
+  *reason = self.illegalReasons[index];
+  return false;
+}
+
+@end
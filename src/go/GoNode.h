@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2022-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2022-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -37,10 +37,22 @@
 /// The linking between nodes in the game tree is effected by the three
 /// primitive properties @e firstChild, @e nextSibling and @e parent. These
 /// three primitive properties are cheap to use and do not incur any calculation
-/// overhead. All other properties (e.g. @e previousSibling, @e lastChild,
-/// @e children) and methods (e.g. isDescendantOfNode:(), isAncestorOfNode:())
-/// are in some way or other based on the three primitive properties and require
-/// a certain amount of processing time for calculation.
+/// overhead. The same is true for @e previousSibling, which is backed by a
+/// link that the tree building methods keep in sync with @e nextSibling. Most
+/// other properties (e.g. @e lastChild, @e children) are in some way or other
+/// based on the primitive properties and require a certain amount of
+/// processing time for calculation.
+///
+/// GoNode also maintains an ancestry index that answers questions about the
+/// node's ancestors without walking up the parent chain: The properties
+/// @e depth, @e numberOfMovesUpToAndIncludingNode, @e nodeWithMostRecentMove
+/// and @e nodeWithMostRecentBoardStateChange are stored values, and
+/// ancestorAtDepth:(), isDescendantOfNode:() and isAncestorOfNode:() use
+/// so-called "jump pointers" to find an ancestor in logarithmic time. The
+/// index is updated by the GoNodeAdditions tree building methods whenever a
+/// sub tree is attached to or detached from a parent, and by the setters of
+/// the properties @e goMove and @e goNodeSetup whenever the node gains or loses
+/// a move or setup.
 // -----------------------------------------------------------------------------
 @interface GoNode : NSObject <NSSecureCoding>
 {
@@ -64,8 +76,19 @@
 /// @brief Returns a collection of child nodes of the node. The collection
 /// is ordered, beginning with the first child node and ending with the
 /// last child node. The collection is empty if the node has no children.
+///
+/// Every access of this property allocates a new collection. Code that is
+/// invoked frequently should use enumerateChildrenUsingBlock:() instead.
 @property(nonatomic, retain, readonly) NSArray* children;
 
+/// @brief Invokes @a block once for each child node of the node, beginning
+/// with the first child node and ending with the last child node. @a block
+/// receives the child node, the zero-based index position of the child node
+/// among its siblings, and a stop flag that @a block can set to @e true to end
+/// the enumeration early. Unlike the @e children property, this method does
+/// not allocate any memory.
+- (void) enumerateChildrenUsingBlock:(void (^)(GoNode* child, int indexOfChild, bool* stop))block;
+
 /// @brief Returns @e true if the node has one or more children. Returns
 /// @e false if the node has no children, i.e. if it is a leaf node.
 @property(nonatomic, readonly) bool hasChildren;
@@ -88,18 +111,13 @@
 /// the node has no previous sibling node, i.e. if the node is the first
 /// child of its parent.
 ///
-/// Use this property with care. Unlike the properties @e firstChild,
-/// @e nextSibling and @e parent the implementation of this property has
-/// a substantial processing cost.
-@property(nonatomic, retain, readonly) GoNode* previousSibling;
+/// The reference to the previous sibling node is weak for the same reason
+/// that the reference to the parent node is weak.
+@property(nonatomic, assign, readonly) GoNode* previousSibling;
 
 /// @brief Returns @e true if the node has a previous sibling node. Returns
 /// @e false if the node has no previous sibling node, i.e. if the node is the
 /// first child of its parent.
-///
-/// Use this property with care. Unlike the properties @e hasFirstChild,
-/// @e hasNextSibling and @e hasParent the implementation of this property has
-/// a substantial processing cost.
 @property(nonatomic, readonly) bool hasPreviousSibling;
 
 /// @brief Returns the node's parent node. Returns @e nil if the node
@@ -119,6 +137,8 @@
 /// node is anywhere below @a node in the node tree. Returns @e false if the
 /// node is not a descendant of @a node.
 ///
+/// This method runs in logarithmic time, it does not walk up the parent chain.
+///
 /// @exception NSInvalidArgumentException Is raised if @a node is @e nil.
 - (bool) isDescendantOfNode:(GoNode*)node;
 
@@ -126,6 +146,8 @@
 /// node is a direct or indirect parent of @a node. Returns @e false if the
 /// node is not an ancestor of @a node.
 ///
+/// This method runs in logarithmic time, it does not walk up the parent chain.
+///
 /// @exception NSInvalidArgumentException Is raised if @a node is @e nil.
 - (bool) isAncestorOfNode:(GoNode*)node;
 
@@ -139,6 +161,37 @@
 @property(nonatomic, readonly) bool isLeaf;
 //@}
 
+/// @name Ancestry index
+//@{
+/// @brief The number of ancestors that the node has. The root node of a node
+/// tree has depth 0 (zero), its children have depth 1, and so on.
+@property(nonatomic, assign, readonly) int depth;
+
+/// @brief The number of nodes that contain a move on the path from the root
+/// node of the node tree down to and including the node.
+@property(nonatomic, assign, readonly) int numberOfMovesUpToAndIncludingNode;
+
+/// @brief The node itself if it contains a move, otherwise the nearest
+/// ancestor that contains a move. @e nil if neither the node nor any of its
+/// ancestors contain a move.
+@property(nonatomic, assign, readonly) GoNode* nodeWithMostRecentMove;
+
+/// @brief The node itself if it changes the board state, otherwise the nearest
+/// ancestor that changes the board state. @e nil if neither the node nor any
+/// of its ancestors change the board state. A node is considered to change the
+/// board state if it contains either setup information (i.e. a GoNodeSetup
+/// object) or a move.
+@property(nonatomic, assign, readonly) GoNode* nodeWithMostRecentBoardStateChange;
+
+/// @brief Returns the ancestor of the node whose @e depth is equal to
+/// @a depth. Returns the node itself if @a depth is equal to the node's
+/// @e depth. Returns @e nil if @a depth is negative or greater than the node's
+/// @e depth.
+///
+/// This method runs in logarithmic time, it does not walk up the parent chain.
+- (GoNode*) ancestorAtDepth:(int)depth;
+//@}
+
 /// @name Node data
 //@{
 /// @brief @e true if the node is empty and contains no data, @e false if the
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2022-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2022-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -35,6 +35,20 @@
 @property(nonatomic, assign) unsigned int firstChildNodeID;
 @property(nonatomic, assign) unsigned int nextSiblingNodeID;
 @property(nonatomic, assign) unsigned int parentNodeID;
+/// @brief Jump pointer used by ancestorAtDepth:(). Refers to the node itself
+/// if the node is a root node, otherwise to a strict ancestor of the node.
+@property(nonatomic, assign) GoNode* jumpAncestor;
+/// @name Re-declaration of properties to make them readwrite privately
+//@{
+@property(nonatomic, assign, readwrite) int depth;
+@property(nonatomic, assign, readwrite) int numberOfMovesUpToAndIncludingNode;
+@property(nonatomic, assign, readwrite) GoNode* nodeWithMostRecentMove;
+@property(nonatomic, assign, readwrite) GoNode* nodeWithMostRecentBoardStateChange;
+//@}
+/// @name Ancestry index maintenance
+//@{
+- (void) updateAncestryIndexOfSubtree;
+//@}
 @end
 
 
@@ -67,8 +81,17 @@
   // Don't use "self" to avoid the setter methods
   _firstChild = nil;
   _nextSibling = nil;
+  _previousSibling = nil;
   _parent = nil;
 
+  // Must be initialized before the goNodeSetup and goMove setters are invoked
+  // because these update the ancestry index
+  self.depth = 0;
+  self.jumpAncestor = self;
+  self.numberOfMovesUpToAndIncludingNode = 0;
+  self.nodeWithMostRecentMove = nil;
+  self.nodeWithMostRecentBoardStateChange = nil;
+
   self.goNodeSetup = nil;
   self.goMove = nil;
   self.goNodeAnnotation = nil;
@@ -106,6 +129,8 @@
     // retain it to avoid a retain cycle between a parent and its first child
     _parent = nil;
   }
+  // Same for the previous sibling
+  _previousSibling = nil;
 
   self.goNodeSetup = nil;
   self.goMove = nil;
@@ -153,6 +178,7 @@
   // Note: Don't use "self" to avoid the setter methods.
   _firstChild = nil;
   _nextSibling = nil;
+  _previousSibling = nil;
   _parent = nil;
 
   // When a node ID is not present in the archive, decodeIntForKey will return
@@ -163,6 +189,17 @@
   self.nextSiblingNodeID = [decoder decodeIntForKey:goNodeNextSiblingKey];
   self.parentNodeID = [decoder decodeIntForKey:goNodeParentKey];
 
+  // The ancestry index was not archived because it can only be calculated
+  // once the tree links are restored. Whoever is unarchiving this GoNode is
+  // responsible for invoking restoreAncestryIndex() on the root node of the
+  // node tree. The initial values must be set before the goNodeSetup and
+  // goMove setters are invoked because these update the ancestry index.
+  self.depth = 0;
+  self.jumpAncestor = self;
+  self.numberOfMovesUpToAndIncludingNode = 0;
+  self.nodeWithMostRecentMove = nil;
+  self.nodeWithMostRecentBoardStateChange = nil;
+
   self.goNodeSetup = [decoder decodeObjectOfClass:[GoNodeSetup class] forKey:goNodeGoNodeSetupKey];
   self.goMove = [decoder decodeObjectOfClass:[GoMove class] forKey:goNodeGoMoveKey];
   self.goNodeAnnotation = [decoder decodeObjectOfClass:[GoNodeAnnotation class] forKey:goNodeGoNodeAnnotationKey];
@@ -260,6 +297,30 @@
   return children;
 }
 
+// -----------------------------------------------------------------------------
+// Method is documented in the header file.
+// -----------------------------------------------------------------------------
+- (void) enumerateChildrenUsingBlock:(void (^)(GoNode* child, int indexOfChild, bool* stop))block
+{
+  GoNode* child = self.firstChild;
+  int indexOfChild = 0;
+  bool stop = false;
+
+  while (child)
+  {
+    // Get the next sibling before invoking the block, in case the block
+    // modifies the node tree
+    GoNode* nextSibling = child.nextSibling;
+
+    block(child, indexOfChild, &stop);
+    if (stop)
+      break;
+
+    child = nextSibling;
+    indexOfChild++;
+  }
+}
+
 // -----------------------------------------------------------------------------
 // Property is documented in the header file.
 // -----------------------------------------------------------------------------
@@ -285,31 +346,6 @@
   return (self.nextSibling != nil);
 }
 
-// -----------------------------------------------------------------------------
-// Property is documented in the header file.
-// -----------------------------------------------------------------------------
-- (GoNode*) previousSibling
-{
-  GoNode* parent = self.parent;
-  if (! parent)
-    return nil;
-
-  GoNode* child = parent.firstChild;
-  if (child == self)
-    return nil;
-
-  while (child)
-  {
-    GoNode* nextSibling = child.nextSibling;
-    if (nextSibling == self)
-      return child;
-    else
-      child = nextSibling;
-  }
-
-  return nil;
-}
-
 // -----------------------------------------------------------------------------
 // Property is documented in the header file.
 // -----------------------------------------------------------------------------
@@ -339,17 +375,11 @@
     return false;
   }
 
-  GoNode* parent = self.parent;
-
-  while (parent)
-  {
-    if (parent == node)
-      return true;
-    else
-      parent = parent.parent;
-  }
+  int depthOfNode = node.depth;
+  if (depthOfNode >= self.depth)
+    return false;
 
-  return false;
+  return ([self ancestorAtDepth:depthOfNode] == node);
 }
 
 // -----------------------------------------------------------------------------
@@ -365,17 +395,11 @@
     return false;
   }
 
-  GoNode* parent = node.parent;
-
-  while (parent)
-  {
-    if (parent == self)
-      return true;
-    else
-      parent = parent.parent;
-  }
+  int depthOfSelf = self.depth;
+  if (depthOfSelf >= node.depth)
+    return false;
 
-  return false;
+  return ([node ancestorAtDepth:depthOfSelf] == self);
 }
 
 // -----------------------------------------------------------------------------
@@ -394,7 +418,33 @@
   return (self.firstChild == nil);
 }
 
-#pragma mark - Public API - Node tree navigation
+#pragma mark - Public API - Ancestry index
+
+// -----------------------------------------------------------------------------
+// Method is documented in the header file.
+// -----------------------------------------------------------------------------
+- (GoNode*) ancestorAtDepth:(int)depth
+{
+  if (depth < 0 || depth > self.depth)
+    return nil;
+
+  // Each jump pointer skips over a number of ancestors that is either 1 or
+  // the length of a complete skew-binary "block", so that at most O(log n)
+  // jumps or parent steps are required to reach any ancestor (Myers 1983).
+  GoNode* node = self;
+  while (node.depth > depth)
+  {
+    GoNode* jumpAncestor = node.jumpAncestor;
+    if (jumpAncestor.depth >= depth)
+      node = jumpAncestor;
+    else
+      node = node.parent;
+  }
+
+  return node;
+}
+
+#pragma mark - Public API - Node data
 
 // -----------------------------------------------------------------------------
 // Property is documented in the header file.
@@ -407,6 +457,40 @@
           (! self.goNodeMarkup || ! self.goNodeMarkup.hasMarkup));
 }
 
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (void) setGoNodeSetup:(GoNodeSetup*)goNodeSetup
+{
+  if (_goNodeSetup == goNodeSetup)
+    return;
+
+  bool didChangeBoardStateChange = ((_goNodeSetup == nil) != (goNodeSetup == nil));
+
+  [_goNodeSetup release];
+  _goNodeSetup = [goNodeSetup retain];
+
+  if (didChangeBoardStateChange)
+    [self updateAncestryIndexOfSubtree];
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (void) setGoMove:(GoMove*)goMove
+{
+  if (_goMove == goMove)
+    return;
+
+  bool didChangeMove = ((_goMove == nil) != (goMove == nil));
+
+  [_goMove release];
+  _goMove = [goMove retain];
+
+  if (didChangeMove)
+    [self updateAncestryIndexOfSubtree];
+}
+
 #pragma mark - Public API - Changing the board based upon the node's data
 
 // -----------------------------------------------------------------------------
@@ -444,6 +528,72 @@
                                                    inGame:game];
 }
 
+#pragma mark - Private helpers - Ancestry index maintenance
+
+// -----------------------------------------------------------------------------
+/// @brief Updates the ancestry index of the receiver node from the ancestry
+/// index of its parent node. The parent node's ancestry index must be up to
+/// date.
+// -----------------------------------------------------------------------------
+- (void) updateAncestryIndexOfNode
+{
+  GoNode* parent = self.parent;
+  if (! parent)
+  {
+    self.depth = 0;
+    self.jumpAncestor = self;
+    self.numberOfMovesUpToAndIncludingNode = (self.goMove ? 1 : 0);
+    self.nodeWithMostRecentMove = (self.goMove ? self : nil);
+    self.nodeWithMostRecentBoardStateChange = ((self.goMove || self.goNodeSetup) ? self : nil);
+    return;
+  }
+
+  int depthOfParent = parent.depth;
+  GoNode* jumpAncestorOfParent = parent.jumpAncestor;
+  int depthOfJumpAncestorOfParent = jumpAncestorOfParent.depth;
+  GoNode* jumpAncestorOfJumpAncestorOfParent = jumpAncestorOfParent.jumpAncestor;
+
+  self.depth = depthOfParent + 1;
+  if (depthOfParent - depthOfJumpAncestorOfParent == depthOfJumpAncestorOfParent - jumpAncestorOfJumpAncestorOfParent.depth)
+    self.jumpAncestor = jumpAncestorOfJumpAncestorOfParent;
+  else
+    self.jumpAncestor = parent;
+
+  self.numberOfMovesUpToAndIncludingNode = parent.numberOfMovesUpToAndIncludingNode + (self.goMove ? 1 : 0);
+  self.nodeWithMostRecentMove = (self.goMove ? self : parent.nodeWithMostRecentMove);
+  self.nodeWithMostRecentBoardStateChange = ((self.goMove || self.goNodeSetup) ? self : parent.nodeWithMostRecentBoardStateChange);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Updates the ancestry index of the receiver node and of the entire
+/// sub tree dangling from it. The ancestry index of the receiver node's parent
+/// node must be up to date.
+///
+/// The sub tree is traversed iteratively in depth-first order, a recursive
+/// implementation would risk a stack overflow in a deep node tree.
+// -----------------------------------------------------------------------------
+- (void) updateAncestryIndexOfSubtree
+{
+  GoNode* node = self;
+  while (node)
+  {
+    [node updateAncestryIndexOfNode];
+
+    GoNode* firstChild = node.firstChild;
+    if (firstChild)
+    {
+      node = firstChild;
+      continue;
+    }
+
+    while (node != self && ! node.nextSibling)
+      node = node.parent;
+    if (node == self)
+      break;
+    node = node.nextSibling;
+  }
+}
+
 @end
 
 #pragma mark - Implementation of GoNodeAdditions
@@ -619,6 +769,7 @@
     [ExceptionUtility throwInvalidArgumentExceptionWithErrorMessage:@"removeChild: failed: Child is not a child of node"];
 
   [child removeNodeFromCurrentLocation];
+  [child updateAncestryIndexOfSubtree];
 }
 
 // -----------------------------------------------------------------------------
@@ -664,6 +815,7 @@
   [newChild insertNodeAsChildOfNewParent:newParent beforeNewNextSibling:newNextSibling];
 
   [oldChild removeNodeFromCurrentLocation];
+  [oldChild updateAncestryIndexOfSubtree];
 }
 
 // -----------------------------------------------------------------------------
@@ -773,6 +925,10 @@
     GoNode* newNextSibling = nil;
     [self insertNodeAsChildOfNewParent:newParent beforeNewNextSibling:newNextSibling];
   }
+  else
+  {
+    [self updateAncestryIndexOfSubtree];
+  }
 }
 
 #pragma mark - Internal helper methods of GoNodeAdditions
@@ -784,6 +940,12 @@
 /// When control returns to the caller, the receiver node has no parent and no
 /// next sibling but retains its first child.
 ///
+/// This method does not update the ancestry index of the receiver node
+/// because in most cases the receiver node is immediately re-inserted with
+/// insertNodeAsChildOfNewParent:beforeNewNextSibling:(), which updates the
+/// ancestry index. Callers that do not re-insert the receiver node must
+/// invoke updateAncestryIndexOfSubtree() themselves.
+///
 /// This is an internal helper method of GoNodeAdditions.
 // -----------------------------------------------------------------------------
 - (void) removeNodeFromCurrentLocation
@@ -829,9 +991,6 @@
   if (previousSibling)
     [previousSibling setNextSiblingInternal:nil];
 
-  // We must set the parent's first child only after GetPreviousSibling()
-  // has been invoked (see above). Reason: GetPreviousSibling() requires the
-  // parent-to-first child link to be intact.
   GoNode* parent = self.parent;
   if (parent)
   {
@@ -846,6 +1005,7 @@
 
     [node setParentInternal:nil];
     [node setNextSiblingInternal:nil];
+    [node updateAncestryIndexOfSubtree];
 
     node = nextSibling;
   }
@@ -855,7 +1015,8 @@
 /// @brief Inserts the receiver node at the location in the game tree that is
 /// defined by @a newParent and @a newNextSibling and relinks the game tree to
 /// accommodate the receiver node in its new location. If @a newNextSibling is
-/// @e nil the receiver node becomes the last child of @a newParent.
+/// @e nil the receiver node becomes the last child of @a newParent. Finally
+/// updates the ancestry index of the receiver node and its sub tree.
 ///
 /// This method expects that removeNodeFromCurrentLocation() has been
 /// previously invoked on the receiver node, i.e. that the receiver node is
@@ -885,6 +1046,8 @@
 
   [self setParentInternal:newParent];
   [self setNextSiblingInternal:newNextSibling];
+
+  [self updateAncestryIndexOfSubtree];
 }
 
 #pragma mark - Internal property setters without logic
@@ -942,6 +1105,9 @@
   {
     _firstChild = child;
     [_firstChild retain];
+
+    // A first child by definition has no previous sibling
+    [_firstChild setPreviousSiblingInternal:nil];
   }
 }
 
@@ -960,6 +1126,11 @@
 {
   if (_nextSibling)
   {
+    // The old next sibling may already have been linked to a new previous
+    // sibling, in which case we must not touch its back link
+    if (_nextSibling.previousSibling == self)
+      [_nextSibling setPreviousSiblingInternal:nil];
+
     // See the implementation of setFirstChildInternal:() for the detailed
     // reason why we use autorelease here instead of release.
     [_nextSibling autorelease];
@@ -970,6 +1141,8 @@
   {
     _nextSibling = nextSibling;
     [_nextSibling retain];
+
+    [_nextSibling setPreviousSiblingInternal:self];
   }
 }
 
@@ -991,6 +1164,24 @@
   _parent = parent;
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Sets the previous sibling node of the receiver node to
+/// @a previousSibling. @a previousSibling may be @e nil.
+///
+/// Unlike the other three core setter methods this setter is not invoked
+/// directly by the GoNodeAdditions methods. Instead setFirstChildInternal:()
+/// and setNextSiblingInternal:() invoke it to keep the back link from a node
+/// to its previous sibling in sync with the forward link from the previous
+/// sibling to the node. This makes the @e previousSibling property as cheap
+/// as @e nextSibling.
+// -----------------------------------------------------------------------------
+- (void) setPreviousSiblingInternal:(GoNode*)previousSibling
+{
+  // Like setParentInternal:() this does NOT retain the previous sibling, to
+  // avoid a retain cycle between a node and its next sibling.
+  _previousSibling = previousSibling;
+}
+
 #pragma mark - GoNodeAdditions - NSCoding support
 
 // -----------------------------------------------------------------------------
@@ -1007,7 +1198,10 @@
   if (self.firstChildNodeID > gNoObjectReferenceNodeID)
     _firstChild = [nodeDictionary[[NSNumber numberWithUnsignedInt:self.firstChildNodeID]] retain];
   if (self.nextSiblingNodeID > gNoObjectReferenceNodeID)
+  {
     _nextSibling = [nodeDictionary[[NSNumber numberWithUnsignedInt:self.nextSiblingNodeID]] retain];
+    [_nextSibling setPreviousSiblingInternal:self];  // the back link was not archived
+  }
   if (self.parentNodeID > gNoObjectReferenceNodeID)
     _parent = nodeDictionary[[NSNumber numberWithUnsignedInt:self.parentNodeID]];  // do not retain to avoid retain cycle between parent and its first child
 
@@ -1016,4 +1210,17 @@
   // the unsigned integer values will still be used.
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Rebuilds the ancestry index of the receiver node and of the entire
+/// sub tree dangling from it.
+///
+/// Whoever causes a node tree to be unarchived must invoke this method on the
+/// root node of the node tree after restoreTreeLinks:() has been invoked on
+/// all GoNode objects in the tree.
+// -----------------------------------------------------------------------------
+- (void) restoreAncestryIndex
+{
+  [self updateAncestryIndexOfSubtree];
+}
+
 @end
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2022-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2022-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -48,6 +48,7 @@
 //@{
 - (void) setNodeID:(int)nodeID;
 - (void) restoreTreeLinks:(NSDictionary*)nodeDictionary;
+- (void) restoreAncestryIndex;
 //@}
 
 @end
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2022-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2022-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -32,10 +32,55 @@
 @end
 
 
+// -----------------------------------------------------------------------------
+/// @brief Dictionary values for the @e labels property that are shared by all
+/// GoNodeMarkup objects. Key = label text of a letter or number marker, value =
+/// NSArray that consists of an NSNumber encapsulating the marker's
+/// #GoMarkupLabel value, and the label text.
+///
+/// Problem collections and joseki dictionaries use the same few letter and
+/// number markers over and over again. Sharing the immutable dictionary values
+/// for these markers avoids allocating an array and a string for every marker
+/// label in a large game tree.
+// -----------------------------------------------------------------------------
+static NSDictionary* sharedMarkerLabelValues = nil;
+
+
 @implementation GoNodeMarkup
 
 #pragma mark - Initialization and deallocation
 
+// -----------------------------------------------------------------------------
+/// @brief Initializes the class-level data shared by all GoNodeMarkup objects.
+///
+/// The runtime invokes this method in a thread-safe manner before the class
+/// receives its first message, so the shared data can be read from any thread
+/// without locking.
+// -----------------------------------------------------------------------------
++ (void) initialize
+{
+  if (self != [GoNodeMarkup class])
+    return;
+
+  NSMutableDictionary* markerLabelValues = [NSMutableDictionary dictionary];
+  NSNumber* letterMarkerAsNumber = [NSNumber numberWithInt:GoMarkupLabelMarkerLetter];
+  for (char letter = 'A'; letter <= 'Z'; ++letter)
+  {
+    NSString* uppercaseLabelText = [NSString stringWithFormat:@"%c", letter];
+    NSString* lowercaseLabelText = uppercaseLabelText.lowercaseString;
+    markerLabelValues[uppercaseLabelText] = @[letterMarkerAsNumber, uppercaseLabelText];
+    markerLabelValues[lowercaseLabelText] = @[letterMarkerAsNumber, lowercaseLabelText];
+  }
+  NSNumber* numberMarkerAsNumber = [NSNumber numberWithInt:GoMarkupLabelMarkerNumber];
+  for (int number = gMinimumNumberMarkerValue; number <= gMaximumNumberMarkerValue; ++number)
+  {
+    NSString* labelText = [NSString stringWithFormat:@"%d", number];
+    markerLabelValues[labelText] = @[numberMarkerAsNumber, labelText];
+  }
+
+  sharedMarkerLabelValues = [[NSDictionary alloc] initWithDictionary:markerLabelValues];
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Initializes a GoNodeMarkup object with default values.
 ///
@@ -424,7 +469,13 @@
     return;
   }
 
-  NSArray* dictionaryValue = @[[NSNumber numberWithInt:label], labelText];
+  NSArray* dictionaryValue = nil;
+  if (label != GoMarkupLabelLabel)
+    dictionaryValue = sharedMarkerLabelValues[labelText];
+  // Not all marker label texts are shared, e.g. "07" is a number marker but
+  // is not in the dictionary
+  if (! dictionaryValue)
+    dictionaryValue = @[[NSNumber numberWithInt:label], labelText];
 
   if (self.mutableLabels)
     self.mutableLabels[vertex] = dictionaryValue;
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2012-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2012-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -98,6 +98,7 @@
 
   self.game = [decoder decodeObjectOfClass:[GoGame class] forKey:goNodeModelGameKey];
   self.rootNode = [decoder decodeObjectOfClass:[GoNode class] forKey:goNodeModelRootNodeKey];
+  [self.rootNode restoreAncestryIndex];
   self.nodeList = [decoder decodeObjectOfClasses:[NSSet setWithArray:@[[NSMutableArray class], [GoNode class]]] forKey:goNodeModelNodeListKey];
   self.numberOfNodes = [decoder decodeIntForKey:goNodeModelNumberOfNodesKey];
   self.numberOfMoves = [decoder decodeIntForKey:goNodeModelNumberOfMovesKey];
@@ -296,21 +297,7 @@
     return;
   }
 
-  NSMutableArray* newNodeList = [NSMutableArray arrayWithObject:node];
-  int newNumberOfMoves = node.goMove ? 1 : 0;
-
-  GoNode* parent = node.parent;
-  while (parent)
-  {
-    [newNodeList insertObject:parent atIndex:0];
-
-    if (parent.goMove)
-      newNumberOfMoves++;
-
-    parent = parent.parent;
-  }
-
-  if (newNodeList.firstObject != self.rootNode)
+  if ([node ancestorAtDepth:0] != self.rootNode)
   {
     [ExceptionUtility throwInvalidArgumentExceptionWithErrorMessage:@"changeToVariationContainingNode: failed: root node is not at the variation start"];
     // Dummy return to make compiler happy (compiler does not see that an
@@ -318,23 +305,36 @@
     return;
   }
 
+  // The old and the new variation share all nodes up to and including the
+  // nearest ancestor of node that is in the old variation. Only the nodes
+  // after that common ancestor need to be replaced. When switching between
+  // two sibling variations deep in a long game this is just a few nodes.
+  GoNode* commonAncestor = [self ancestorOfNodeInCurrentVariation:node];
+  NSUInteger numberOfNodesToKeep = commonAncestor.depth + 1;
+  if (numberOfNodesToKeep < _nodeList.count)
+    [_nodeList removeObjectsInRange:NSMakeRange(numberOfNodesToKeep, _nodeList.count - numberOfNodesToKeep)];
+
+  if (node != commonAncestor)
+  {
+    NSMutableArray* ancestorsBelowCommonAncestor = [NSMutableArray arrayWithCapacity:node.depth - commonAncestor.depth];
+    for (GoNode* ancestor = node; ancestor != commonAncestor; ancestor = ancestor.parent)
+      [ancestorsBelowCommonAncestor addObject:ancestor];
+    [_nodeList addObjectsFromArray:ancestorsBelowCommonAncestor.reverseObjectEnumerator.allObjects];
+  }
+
   GoNode* firstChild = node.firstChild;
   while (firstChild)
   {
-    [newNodeList addObject:firstChild];
-
-    if (firstChild.goMove)
-      newNumberOfMoves++;
-
+    [_nodeList addObject:firstChild];
     firstChild = firstChild.firstChild;
   }
 
-  int newNumberOfNodes = (int)newNodeList.count;
-
-  self.nodeList = newNodeList;
-
-  self.numberOfNodes = newNumberOfNodes;
-  self.numberOfMoves = newNumberOfMoves;
+  // Cast is required because NSUInteger and int differ in size in 64-bit. Cast
+  // is safe because this app was not made to handle more than pow(2, 31) nodes.
+  self.numberOfNodes = (int)_nodeList.count;
+  // The ancestry index of the leaf node holds the number of moves from the
+  // root node down to the leaf node, so there is no need to count the moves
+  self.numberOfMoves = ((GoNode*)_nodeList.lastObject).numberOfMovesUpToAndIncludingNode;
 }
 
 // -----------------------------------------------------------------------------
@@ -357,12 +357,25 @@
     return nil;
   }
 
-  while (node)
+  // The node at index i of the current variation has depth i, so the current
+  // variation and the ancestors of the node share a common prefix. Because the
+  // ancestry index finds an ancestor at a given depth in logarithmic time we
+  // can binary search for the end of the common prefix instead of walking up
+  // the parent chain and looking up every ancestor in the current variation.
+  if ([node ancestorAtDepth:0] == _nodeList.firstObject)
   {
-    NSUInteger index = [_nodeList indexOfObject:node];
-    if (index != NSNotFound)
-      return node;
-    node = node.parent;
+    int lowDepth = 0;
+    int highDepth = MIN(node.depth, (int)_nodeList.count - 1);
+    while (lowDepth < highDepth)
+    {
+      int middleDepth = lowDepth + (highDepth - lowDepth + 1) / 2;
+      if ([node ancestorAtDepth:middleDepth] == [_nodeList objectAtIndex:middleDepth])
+        lowDepth = middleDepth;
+      else
+        highDepth = middleDepth - 1;
+    }
+
+    return [node ancestorAtDepth:lowDepth];
   }
 
   [ExceptionUtility throwInvalidArgumentExceptionWithErrorMessage:@"ancestorOfNodeInCurrentVariation: failed: node is not in the game tree that contains the current variation"];
@@ -404,14 +417,14 @@
     return -1;
   }
 
-  NSUInteger index = [_nodeList indexOfObject:node];
-  if (index == NSNotFound)
+  // The depth of a node is the same as its index position in every variation
+  // that contains the node. This allows a constant time lookup instead of a
+  // linear search of the node list.
+  int index = node.depth;
+  if (index < _nodeList.count && [_nodeList objectAtIndex:index] == node)
+    return index;
+  else
     return -1;
-
-  // Cast is required because NSUInteger and int differ in size in 64-bit.
-  // Cast is safe because this app was not made to handle more than
-  // pow(2, 31) nodes.
-  return (int)index;
 }
 
 // -----------------------------------------------------------------------------
@@ -485,14 +498,6 @@
     @throw exception;
   }
 
-  int numberOfMovesToDiscard = 0;
-  for (int indexOfNodeToDiscard = index; indexOfNodeToDiscard < _nodeList.count; ++indexOfNodeToDiscard)
-  {
-    GoNode* node = [_nodeList objectAtIndex:indexOfNodeToDiscard];
-    if (node.goMove)
-      numberOfMovesToDiscard++;
-  }
-
   // Variation support: Discarding node B not only removes the node and its
   // child nodes, it also causes all variations that shared the same path up to
   // node B to be discarded. Node H (the next sibling of node B) and its
@@ -539,10 +544,6 @@
   while (nodeToAdd)
   {
     [_nodeList addObject:nodeToAdd];
-
-    if (nodeToAdd.goMove)
-      numberOfMovesToDiscard--;  // can become negative
-
     nodeToAdd = nodeToAdd.firstChild;
   }
 
@@ -551,8 +552,12 @@
   // Cast is required because NSUInteger and int differ in size in 64-bit. Cast
   // is safe because this app was not made to handle more than pow(2, 31) nodes.
   self.numberOfNodes = (int)_nodeList.count;
-  if (numberOfMovesToDiscard != 0)
-    self.numberOfMoves = self.numberOfMoves - numberOfMovesToDiscard;
+  // The ancestry index of the new leaf node holds the number of moves from the
+  // root node down to the new leaf node, so there is no need to count the
+  // moves that were discarded and added
+  int newNumberOfMoves = ((GoNode*)_nodeList.lastObject).numberOfMovesUpToAndIncludingNode;
+  if (newNumberOfMoves != self.numberOfMoves)
+    self.numberOfMoves = newNumberOfMoves;
 }
 
 // -----------------------------------------------------------------------------
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2022-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2022-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -88,7 +88,10 @@
 ///
 /// Invoking this method is a comparatively expensive operation, because this
 /// method manipulates the entire board to reflect the position that exists
-/// after the setup stones in this GoNodeSetup were placed or removed.
+/// after the setup stones in this GoNodeSetup were placed or removed. To keep
+/// the cost down, GoBoardRegion objects are updated only once, after all
+/// setup stones were placed or removed, and only in the areas of the board
+/// that are affected by the setup.
 ///
 /// @note applySetup() must never be invoked twice in a row. It can be invoked
 /// in alternation with revertSetup() any number of times.
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2022-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2022-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -236,9 +236,11 @@
     self.previousSetupInformationWasCaptured = true;
   }
 
-  [self setupPoints:self.mutableBlackSetupStones withStoneState:GoColorBlack];
-  [self setupPoints:self.mutableWhiteSetupStones withStoneState:GoColorWhite];
-  [self setupPoints:self.mutableNoSetupStones withStoneState:GoColorNone];
+  NSMutableArray* changedPoints = [NSMutableArray array];
+  [self setupPoints:self.mutableBlackSetupStones withStoneState:GoColorBlack changedPoints:changedPoints];
+  [self setupPoints:self.mutableWhiteSetupStones withStoneState:GoColorWhite changedPoints:changedPoints];
+  [self setupPoints:self.mutableNoSetupStones withStoneState:GoColorNone changedPoints:changedPoints];
+  [GoUtilities movePointsToNewRegions:changedPoints];
 
   if (self.setupFirstMoveColor != GoColorNone)
     self.game.setupFirstMoveColor = self.setupFirstMoveColor;
@@ -255,9 +257,11 @@
     [ExceptionUtility throwInternalInconsistencyExceptionWithErrorMessage:errorMessage];
   }
 
-  [self revertPoints:self.mutableBlackSetupStones];
-  [self revertPoints:self.mutableWhiteSetupStones];
-  [self revertPoints:self.mutableNoSetupStones];
+  NSMutableArray* changedPoints = [NSMutableArray array];
+  [self revertPoints:self.mutableBlackSetupStones changedPoints:changedPoints];
+  [self revertPoints:self.mutableWhiteSetupStones changedPoints:changedPoints];
+  [self revertPoints:self.mutableNoSetupStones changedPoints:changedPoints];
+  [GoUtilities movePointsToNewRegions:changedPoints];
 
   self.game.setupFirstMoveColor = self.previousSetupFirstMoveColor;
 }
@@ -602,18 +606,25 @@
 /// a stone of the opposite color. If @a newStoneState is #GoColorNone this
 /// removes an existing setup stone.
 ///
+/// The GoPoint objects are added to @a changedPoints. The caller is responsible
+/// for updating the GoBoardRegion objects of all changed GoPoint objects in
+/// one go once it has finished changing stone states.
+///
 /// This is an internal helper method for applySetup().
 ///
 /// Raises @e NSInternalInconsistencyException if one or more GoPoint objects
 /// already have the desired @e newStoneState property value.
 // -----------------------------------------------------------------------------
-- (void) setupPoints:(NSArray*)points withStoneState:(enum GoColor)newStoneState
+- (void) setupPoints:(NSArray*)points
+      withStoneState:(enum GoColor)newStoneState
+       changedPoints:(NSMutableArray*)changedPoints
 {
   if (! points)
     return;
 
   for (GoPoint* point in points)
     [self changePoint:point toStoneState:newStoneState];
+  [changedPoints addObjectsFromArray:points];
 }
 
 // -----------------------------------------------------------------------------
@@ -622,12 +633,15 @@
 /// GoNodeSetup was applied. @a points may be @e nil, in which case this method
 /// does nothing.
 ///
+/// The GoPoint objects are added to @a changedPoints, as in
+/// setupPoints:withStoneState:changedPoints:().
+///
 /// This is an internal helper method for revertSetup().
 ///
 /// Raises @e NSInternalInconsistencyException if one or more GoPoint objects
 /// already have the previous @e stoneState value.
 // -----------------------------------------------------------------------------
-- (void) revertPoints:(NSArray*)points
+- (void) revertPoints:(NSArray*)points changedPoints:(NSMutableArray*)changedPoints
 {
   if (! points)
     return;
@@ -637,6 +651,7 @@
     enum GoColor previousStoneState = [self stoneStatePreviousToSetup:point];
     [self changePoint:point toStoneState:previousStoneState];
   }
+  [changedPoints addObjectsFromArray:points];
 }
 
 // -----------------------------------------------------------------------------
@@ -648,6 +663,10 @@
 /// a stone of the opposite color. If @a newStoneState is #GoColorNone this
 /// removes an existing setup stone.
 ///
+/// This method does not update the GoBoardRegion of @a point, this is left to
+/// the caller. While stone states are being changed, GoBoardRegion objects are
+/// therefore temporarily out of sync with the board.
+///
 /// This is an internal helper method for both applySetup() and revertSetup().
 ///
 /// Raises @e NSInvalidArgumentException if @a point is @e nil.
@@ -677,7 +696,6 @@
   }
 
   point.stoneState = newStoneState;
-  [GoUtilities movePointToNewRegion:point];
 }
 
 @end
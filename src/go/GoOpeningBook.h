@@ -0,0 +1,66 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Forward declarations
+@class GoGame;
+@class GoPoint;
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GoOpeningBook class provides opening book moves from a binary
+/// opening book file that is memory mapped.
+///
+/// @ingroup go
+///
+/// The opening book that is shipped with the application is a text file in
+/// the format that Fuego's "book_load" GTP command understands. Each line
+/// consists of the board size, a sequence of moves that starts with black and
+/// alternates colors, a "|" separator, and one or more moves that are good
+/// replies in the position that results from the sequence.
+///
+/// compileTextBookAtPath:toBinaryBookAtPath:() converts such a text file into
+/// a binary file. The binary file contains one entry for every distinct
+/// position in the text file, sorted by a 64-bit position key, and the reply
+/// moves of all entries. The position key is a Zobrist hash of the stones on
+/// the board, the board size and the color to move. The position key is
+/// normalized over the 8 symmetries of the board (rotations and reflections):
+/// The key is calculated for every symmetry, and the smallest value is used.
+/// The reply moves are stored in the coordinate system of the symmetry that
+/// produced the smallest value. As a result, positions that differ only by
+/// symmetry share a single entry.
+///
+/// initWithContentsOfFile:() maps a binary file into memory without reading
+/// or parsing it. Lookups do a binary search on the mapped entries, so only
+/// the pages that are actually touched are loaded, and they can be discarded
+/// by the operating system at any time.
+///
+/// Unlike Fuego's own opening book, which every GTP engine parses into its
+/// own heap, a single GoOpeningBook serves all GTP engines.
+// -----------------------------------------------------------------------------
+@interface GoOpeningBook : NSObject
+{
+}
+
++ (bool) compileTextBookAtPath:(NSString*)textBookPath toBinaryBookAtPath:(NSString*)binaryBookPath;
+- (id) initWithContentsOfFile:(NSString*)binaryBookPath;
+- (GoPoint*) moveForGame:(GoGame*)game;
+
+/// @brief The number of distinct positions in the opening book.
+@property(nonatomic, assign, readonly) int numberOfPositions;
+
+@end
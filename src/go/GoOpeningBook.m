@@ -0,0 +1,509 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Project includes
+#import "GoOpeningBook.h"
+#import "GoBoard.h"
+#import "GoGame.h"
+#import "GoPoint.h"
+#import "GoUtilities.h"
+#import "GoVertex.h"
+
+
+/// @brief Identifies a binary opening book file.
+static const char openingBookMagic[8] = "LGBOOK1";
+/// @brief The version of the binary opening book file format. Must be
+/// increased when the format or the position key calculation changes.
+static const uint32_t openingBookFormatVersion = 1;
+/// @brief Array sizes used by the opening book compiler and the lookup.
+enum
+{
+  /// @brief The number of symmetries of a square board.
+  numberOfSymmetries = 8,
+  /// @brief The maximum number of intersections on a board.
+  maximumNumberOfPoints = GoBoardSizeMax * GoBoardSizeMax
+};
+
+/// @brief The header at the beginning of a binary opening book file. The
+/// header is followed by @e numberOfEntries entries, which are followed by
+/// @e numberOfMoves moves.
+struct GoOpeningBookHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t numberOfEntries;
+  uint32_t numberOfMoves;
+  uint32_t reserved;
+};
+
+/// @brief An entry in a binary opening book file. Entries are sorted by
+/// @e positionKey.
+struct GoOpeningBookEntry
+{
+  uint64_t positionKey;
+  uint32_t indexOfFirstMove;
+  uint16_t numberOfMoves;
+  uint16_t reserved;
+};
+
+/// @brief A move in a binary opening book file is stored as a 16-bit value.
+/// The upper 8 bits are the zero-based x coordinate, the lower 8 bits are the
+/// zero-based y coordinate.
+typedef uint16_t GoOpeningBookMove;
+
+
+// -----------------------------------------------------------------------------
+/// @brief Transforms the zero-based coordinates @a x and @a y on a board of
+/// size @a boardSize according to @a symmetry.
+// -----------------------------------------------------------------------------
+static void TransformCoordinates(int symmetry, int boardSize, int x, int y, int* transformedX, int* transformedY)
+{
+  int n = boardSize - 1;
+  switch (symmetry)
+  {
+    case 0: *transformedX = x;     *transformedY = y;     break;
+    case 1: *transformedX = n - x; *transformedY = y;     break;
+    case 2: *transformedX = x;     *transformedY = n - y; break;
+    case 3: *transformedX = n - x; *transformedY = n - y; break;
+    case 4: *transformedX = y;     *transformedY = x;     break;
+    case 5: *transformedX = n - y; *transformedY = x;     break;
+    case 6: *transformedX = y;     *transformedY = n - x; break;
+    default: *transformedX = n - y; *transformedY = n - x; break;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the symmetry that reverses @a symmetry. The two rotations by
+/// 90 degrees reverse each other, all other symmetries reverse themselves.
+// -----------------------------------------------------------------------------
+static int InverseSymmetry(int symmetry)
+{
+  if (5 == symmetry)
+    return 6;
+  else if (6 == symmetry)
+    return 5;
+  else
+    return symmetry;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the normalized position key for the board @a stones of size
+/// @a boardSize on which @a colorToMove is to play next. Stores the symmetry
+/// that produced the key in @a symmetry.
+///
+/// @a stones contains one GoColor value per intersection, at index
+/// y * boardSize + x.
+// -----------------------------------------------------------------------------
+static uint64_t NormalizedPositionKey(const uint8_t* stones, int boardSize, enum GoColor colorToMove, int* symmetry)
+{
+  uint64_t positionKeys[numberOfSymmetries];
+  uint64_t baseKey = GoUtilitiesMixBits(((uint64_t)colorToMove << 32) | (uint64_t)boardSize);
+  for (int indexOfSymmetry = 0; indexOfSymmetry < numberOfSymmetries; ++indexOfSymmetry)
+    positionKeys[indexOfSymmetry] = baseKey;
+
+  for (int y = 0; y < boardSize; ++y)
+  {
+    for (int x = 0; x < boardSize; ++x)
+    {
+      uint8_t color = stones[y * boardSize + x];
+      if (GoColorNone == color)
+        continue;
+      for (int indexOfSymmetry = 0; indexOfSymmetry < numberOfSymmetries; ++indexOfSymmetry)
+      {
+        int transformedX;
+        int transformedY;
+        TransformCoordinates(indexOfSymmetry, boardSize, x, y, &transformedX, &transformedY);
+        positionKeys[indexOfSymmetry] ^= GoUtilitiesMixBits(((uint64_t)color << 16) | (uint64_t)(transformedX << 8) | (uint64_t)transformedY);
+      }
+    }
+  }
+
+  *symmetry = 0;
+  for (int indexOfSymmetry = 1; indexOfSymmetry < numberOfSymmetries; ++indexOfSymmetry)
+  {
+    if (positionKeys[indexOfSymmetry] < positionKeys[*symmetry])
+      *symmetry = indexOfSymmetry;
+  }
+  return positionKeys[*symmetry];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if the stone group that contains the intersection at
+/// @a startIndex has at least one liberty. Stores the indexes of the group's
+/// intersections in @a group and their number in @a groupSize.
+// -----------------------------------------------------------------------------
+static bool FindGroup(const uint8_t* stones, int boardSize, int startIndex, int* group, int* groupSize)
+{
+  bool visited[maximumNumberOfPoints] = { false };
+  uint8_t color = stones[startIndex];
+  bool hasLiberty = false;
+
+  *groupSize = 0;
+  group[(*groupSize)++] = startIndex;
+  visited[startIndex] = true;
+  for (int indexInGroup = 0; indexInGroup < *groupSize; ++indexInGroup)
+  {
+    int index = group[indexInGroup];
+    int x = index % boardSize;
+    int y = index / boardSize;
+    int neighbourIndexes[4] =
+    {
+      (x > 0) ? index - 1 : -1,
+      (x < boardSize - 1) ? index + 1 : -1,
+      (y > 0) ? index - boardSize : -1,
+      (y < boardSize - 1) ? index + boardSize : -1
+    };
+    for (int indexOfNeighbour = 0; indexOfNeighbour < 4; ++indexOfNeighbour)
+    {
+      int neighbourIndex = neighbourIndexes[indexOfNeighbour];
+      if (neighbourIndex < 0 || visited[neighbourIndex])
+        continue;
+      if (GoColorNone == stones[neighbourIndex])
+      {
+        hasLiberty = true;
+      }
+      else if (color == stones[neighbourIndex])
+      {
+        visited[neighbourIndex] = true;
+        group[(*groupSize)++] = neighbourIndex;
+      }
+    }
+  }
+  return hasLiberty;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Places a stone of color @a color on the intersection at @a index and
+/// removes the opponent stone groups that are captured by the stone.
+// -----------------------------------------------------------------------------
+static void PlayStone(uint8_t* stones, int boardSize, int index, enum GoColor color)
+{
+  stones[index] = color;
+  enum GoColor opponentColor = (GoColorBlack == color) ? GoColorWhite : GoColorBlack;
+
+  int x = index % boardSize;
+  int y = index / boardSize;
+  int neighbourIndexes[4] =
+  {
+    (x > 0) ? index - 1 : -1,
+    (x < boardSize - 1) ? index + 1 : -1,
+    (y > 0) ? index - boardSize : -1,
+    (y < boardSize - 1) ? index + boardSize : -1
+  };
+  int group[maximumNumberOfPoints];
+  int groupSize;
+  for (int indexOfNeighbour = 0; indexOfNeighbour < 4; ++indexOfNeighbour)
+  {
+    int neighbourIndex = neighbourIndexes[indexOfNeighbour];
+    if (neighbourIndex < 0 || opponentColor != stones[neighbourIndex])
+      continue;
+    if (FindGroup(stones, boardSize, neighbourIndex, group, &groupSize))
+      continue;
+    for (int indexInGroup = 0; indexInGroup < groupSize; ++indexInGroup)
+      stones[group[indexInGroup]] = GoColorNone;
+  }
+}
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GoOpeningBook.
+// -----------------------------------------------------------------------------
+@interface GoOpeningBook()
+/// @brief The memory mapped content of the binary opening book file.
+@property(nonatomic, retain) NSData* mappedData;
+@property(nonatomic, assign, readwrite) int numberOfPositions;
+@property(nonatomic, assign) const struct GoOpeningBookEntry* entries;
+@property(nonatomic, assign) const GoOpeningBookMove* moves;
+@end
+
+
+@implementation GoOpeningBook
+
+// -----------------------------------------------------------------------------
+/// @brief Converts the text opening book file at @a textBookPath into a binary
+/// opening book file and stores it at @a binaryBookPath. Returns true on
+/// success, false on failure.
+///
+/// Lines with invalid content are skipped. An existing file at
+/// @a binaryBookPath is overwritten.
+// -----------------------------------------------------------------------------
++ (bool) compileTextBookAtPath:(NSString*)textBookPath toBinaryBookAtPath:(NSString*)binaryBookPath
+{
+  NSError* error;
+  NSString* textBook = [NSString stringWithContentsOfFile:textBookPath encoding:NSUTF8StringEncoding error:&error];
+  if (! textBook)
+  {
+    DDLogError(@"GoOpeningBook: Failed to read text opening book %@: %@", textBookPath, [error localizedDescription]);
+    return false;
+  }
+
+  // Maps position keys to the reply moves for that position
+  NSMutableDictionary* movesByPositionKey = [NSMutableDictionary dictionary];
+  int numberOfSkippedLines = 0;
+  for (NSString* line in [textBook componentsSeparatedByCharactersInSet:[NSCharacterSet newlineCharacterSet]])
+  {
+    NSString* trimmedLine = [line stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+    if (0 == trimmedLine.length || [trimmedLine hasPrefix:@"#"])
+      continue;
+    if (! [self compileLine:trimmedLine intoDictionary:movesByPositionKey])
+      numberOfSkippedLines++;
+  }
+  if (numberOfSkippedLines > 0)
+    DDLogWarn(@"GoOpeningBook: Skipped %d invalid lines in text opening book %@", numberOfSkippedLines, textBookPath);
+
+  NSArray* positionKeys = [[movesByPositionKey allKeys] sortedArrayUsingSelector:@selector(compare:)];
+  NSMutableData* entriesData = [NSMutableData dataWithCapacity:positionKeys.count * sizeof(struct GoOpeningBookEntry)];
+  NSMutableData* movesData = [NSMutableData data];
+  uint32_t numberOfMoves = 0;
+  for (NSNumber* positionKey in positionKeys)
+  {
+    NSOrderedSet* movesOfPosition = [movesByPositionKey objectForKey:positionKey];
+    struct GoOpeningBookEntry entry;
+    entry.positionKey = positionKey.unsignedLongLongValue;
+    entry.indexOfFirstMove = numberOfMoves;
+    entry.numberOfMoves = (uint16_t)movesOfPosition.count;
+    entry.reserved = 0;
+    [entriesData appendBytes:&entry length:sizeof(entry)];
+    for (NSNumber* moveOfPosition in movesOfPosition)
+    {
+      GoOpeningBookMove move = moveOfPosition.unsignedShortValue;
+      [movesData appendBytes:&move length:sizeof(move)];
+    }
+    numberOfMoves += entry.numberOfMoves;
+  }
+
+  struct GoOpeningBookHeader header;
+  memcpy(header.magic, openingBookMagic, sizeof(header.magic));
+  header.version = openingBookFormatVersion;
+  header.numberOfEntries = (uint32_t)positionKeys.count;
+  header.numberOfMoves = numberOfMoves;
+  header.reserved = 0;
+
+  NSMutableData* binaryBook = [NSMutableData dataWithBytes:&header length:sizeof(header)];
+  [binaryBook appendData:entriesData];
+  [binaryBook appendData:movesData];
+  BOOL success = [binaryBook writeToFile:binaryBookPath options:NSDataWritingAtomic error:&error];
+  if (! success)
+  {
+    DDLogError(@"GoOpeningBook: Failed to write binary opening book %@: %@", binaryBookPath, [error localizedDescription]);
+    return false;
+  }
+
+  DDLogInfo(@"GoOpeningBook: Compiled %lu positions and %u moves into %@", (unsigned long)positionKeys.count, numberOfMoves, binaryBookPath);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for compileTextBookAtPath:toBinaryBookAtPath:().
+/// Replays the move sequence in @a line and adds the reply moves to
+/// @a movesByPositionKey. Returns false if @a line is invalid.
+// -----------------------------------------------------------------------------
++ (bool) compileLine:(NSString*)line intoDictionary:(NSMutableDictionary*)movesByPositionKey
+{
+  NSArray* lineParts = [line componentsSeparatedByString:@"|"];
+  if (2 != lineParts.count)
+    return false;
+  NSCharacterSet* whitespace = [NSCharacterSet whitespaceCharacterSet];
+  NSPredicate* notEmpty = [NSPredicate predicateWithFormat:@"length > 0"];
+  NSArray* sequence = [[[lineParts objectAtIndex:0] componentsSeparatedByCharactersInSet:whitespace] filteredArrayUsingPredicate:notEmpty];
+  NSArray* replies = [[[lineParts objectAtIndex:1] componentsSeparatedByCharactersInSet:whitespace] filteredArrayUsingPredicate:notEmpty];
+  if (0 == sequence.count || 0 == replies.count)
+    return false;
+
+  int boardSize = [[sequence objectAtIndex:0] intValue];
+  if (boardSize < 1 || boardSize > GoBoardSizeMax)
+    return false;
+
+  uint8_t stones[maximumNumberOfPoints] = { GoColorNone };
+  enum GoColor colorToMove = GoColorBlack;
+  for (NSUInteger indexOfMove = 1; indexOfMove < sequence.count; ++indexOfMove)
+  {
+    int index = [self indexOfVertex:[sequence objectAtIndex:indexOfMove] boardSize:boardSize];
+    if (index < 0 || GoColorNone != stones[index])
+      return false;
+    PlayStone(stones, boardSize, index, colorToMove);
+    colorToMove = (GoColorBlack == colorToMove) ? GoColorWhite : GoColorBlack;
+  }
+
+  int symmetry;
+  uint64_t positionKey = NormalizedPositionKey(stones, boardSize, colorToMove, &symmetry);
+  NSNumber* positionKeyAsNumber = [NSNumber numberWithUnsignedLongLong:positionKey];
+  NSMutableOrderedSet* movesOfPosition = [movesByPositionKey objectForKey:positionKeyAsNumber];
+  if (! movesOfPosition)
+  {
+    movesOfPosition = [NSMutableOrderedSet orderedSet];
+    [movesByPositionKey setObject:movesOfPosition forKey:positionKeyAsNumber];
+  }
+
+  for (NSString* reply in replies)
+  {
+    int index = [self indexOfVertex:reply boardSize:boardSize];
+    if (index < 0 || GoColorNone != stones[index])
+      return false;
+    int transformedX;
+    int transformedY;
+    TransformCoordinates(symmetry, boardSize, index % boardSize, index / boardSize, &transformedX, &transformedY);
+    GoOpeningBookMove move = (GoOpeningBookMove)((transformedX << 8) | transformedY);
+    [movesOfPosition addObject:[NSNumber numberWithUnsignedShort:move]];
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for compileLine:intoDictionary:(). Returns the index
+/// of the intersection @a vertex on a board of size @a boardSize, or -1 if
+/// @a vertex is invalid.
+// -----------------------------------------------------------------------------
++ (int) indexOfVertex:(NSString*)vertex boardSize:(int)boardSize
+{
+  struct GoVertexNumeric numericVertex;
+  @try
+  {
+    numericVertex = [GoVertex vertexFromString:vertex].numeric;
+  }
+  @catch (NSException* exception)
+  {
+    return -1;
+  }
+  if (numericVertex.x > boardSize || numericVertex.y > boardSize)
+    return -1;
+  return (numericVertex.y - 1) * boardSize + (numericVertex.x - 1);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GoOpeningBook object with the binary opening book file
+/// at @a binaryBookPath. Returns nil if the file does not exist, or if it is
+/// not a valid binary opening book file of the current format version.
+///
+/// @note This is the designated initializer of GoOpeningBook.
+// -----------------------------------------------------------------------------
+- (id) initWithContentsOfFile:(NSString*)binaryBookPath
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  NSError* error;
+  self.mappedData = [NSData dataWithContentsOfFile:binaryBookPath options:NSDataReadingMappedAlways error:&error];
+  if (! self.mappedData)
+  {
+    DDLogError(@"%@: Failed to map binary opening book %@: %@", self, binaryBookPath, [error localizedDescription]);
+    [self release];
+    return nil;
+  }
+
+  const struct GoOpeningBookHeader* header = (const struct GoOpeningBookHeader*)self.mappedData.bytes;
+  if (self.mappedData.length < sizeof(struct GoOpeningBookHeader) ||
+      0 != memcmp(header->magic, openingBookMagic, sizeof(header->magic)) ||
+      openingBookFormatVersion != header->version ||
+      self.mappedData.length != (sizeof(struct GoOpeningBookHeader)
+                                 + header->numberOfEntries * sizeof(struct GoOpeningBookEntry)
+                                 + header->numberOfMoves * sizeof(GoOpeningBookMove)))
+  {
+    DDLogError(@"%@: Invalid binary opening book %@", self, binaryBookPath);
+    [self release];
+    return nil;
+  }
+
+  self.numberOfPositions = header->numberOfEntries;
+  self.entries = (const struct GoOpeningBookEntry*)(header + 1);
+  self.moves = (const GoOpeningBookMove*)(self.entries + header->numberOfEntries);
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GoOpeningBook object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.mappedData = nil;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns an opening book move for the current board position of
+/// @a game and the color that is to move next. Returns nil if the opening book
+/// contains no legal move for the position.
+///
+/// If the opening book contains several moves for the position, one of them is
+/// chosen at random.
+// -----------------------------------------------------------------------------
+- (GoPoint*) moveForGame:(GoGame*)game
+{
+  GoBoard* board = game.board;
+  int boardSize = board.size;
+  uint8_t stones[maximumNumberOfPoints];
+  NSEnumerator* enumerator = [board pointEnumerator];
+  GoPoint* point;
+  while (point = [enumerator nextObject])
+  {
+    struct GoVertexNumeric numericVertex = point.vertex.numeric;
+    stones[(numericVertex.y - 1) * boardSize + (numericVertex.x - 1)] = point.stoneState;
+  }
+
+  int symmetry;
+  uint64_t positionKey = NormalizedPositionKey(stones, boardSize, game.nextMoveColor, &symmetry);
+  const struct GoOpeningBookEntry* entry = [self entryForPositionKey:positionKey];
+  if (! entry)
+    return nil;
+
+  NSMutableArray* legalMoves = [NSMutableArray arrayWithCapacity:entry->numberOfMoves];
+  int inverseSymmetry = InverseSymmetry(symmetry);
+  for (uint16_t indexOfMove = 0; indexOfMove < entry->numberOfMoves; ++indexOfMove)
+  {
+    GoOpeningBookMove move = self.moves[entry->indexOfFirstMove + indexOfMove];
+    struct GoVertexNumeric numericVertex;
+    TransformCoordinates(inverseSymmetry, boardSize, move >> 8, move & 0xff, &numericVertex.x, &numericVertex.y);
+    numericVertex.x++;
+    numericVertex.y++;
+    GoPoint* movePoint = [board pointAtVertex:[GoVertex vertexFromNumeric:numericVertex].string];
+    enum GoMoveIsIllegalReason illegalReason;
+    if (movePoint && [game isLegalMove:movePoint isIllegalReason:&illegalReason])
+      [legalMoves addObject:movePoint];
+  }
+  if (0 == legalMoves.count)
+    return nil;
+  return [legalMoves objectAtIndex:arc4random_uniform((uint32_t)legalMoves.count)];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for moveForGame:(). Returns the entry for
+/// @a positionKey, or NULL if there is no such entry.
+// -----------------------------------------------------------------------------
+- (const struct GoOpeningBookEntry*) entryForPositionKey:(uint64_t)positionKey
+{
+  const struct GoOpeningBookEntry* entries = self.entries;
+  int lowerIndex = 0;
+  int upperIndex = self.numberOfPositions - 1;
+  while (lowerIndex <= upperIndex)
+  {
+    int middleIndex = lowerIndex + (upperIndex - lowerIndex) / 2;
+    uint64_t middlePositionKey = entries[middleIndex].positionKey;
+    if (middlePositionKey == positionKey)
+      return &entries[middleIndex];
+    else if (middlePositionKey < positionKey)
+      lowerIndex = middleIndex + 1;
+    else
+      upperIndex = middleIndex - 1;
+  }
+  return NULL;
+}
+
+@end
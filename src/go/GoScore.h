@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -99,10 +99,14 @@
 ///   stores the values in GoScore's publicly accessible scoring and statistics
 ///   properties
 ///
-/// @note When GoScore calculates a score for the first time, it asks the GTP
-/// engine for an initial list of dead stones. It is expected that the GTP
-/// engine at least detects dead stones surrounded by unconditionally alive
-/// groups. This query can be suppressed by the user in the user preferences.
+/// @note When GoScore calculates a score for the first time, it sets up an
+/// initial list of dead stones. GoDeadStoneEstimator provides an immediate
+/// estimate that at least detects dead stones surrounded by unconditionally
+/// alive groups. The GTP engine is then queried asynchronously and, when it
+/// responds, its list of dead stones replaces the estimate and the score is
+/// calculated again - unless the user has started to mark dead stones in the
+/// meantime. This feature can be suppressed by the user in the user
+/// preferences.
 ///
 ///
 /// @par Mark dead stones intelligently
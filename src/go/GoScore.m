@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -20,6 +20,7 @@
 #import "GoBoard.h"
 #import "GoBoardPosition.h"
 #import "GoBoardRegion.h"
+#import "GoDeadStoneEstimator.h"
 #import "GoGame.h"
 #import "GoGameRules.h"
 #import "GoMove.h"
@@ -28,7 +29,9 @@
 #import "GoPlayer.h"
 #import "GoPoint.h"
 #import "GoUtilities.h"
+#import "GoVertex.h"
 #import "../main/ApplicationDelegate.h"
+#import "../gtp/GtpAnalysisCache.h"
 #import "../gtp/GtpCommand.h"
 #import "../gtp/GtpResponse.h"
 #import "../play/model/ScoringModel.h"
@@ -37,6 +40,10 @@
 #import "../utility/NSStringAdditions.h"
 
 
+/// @brief The GTP command used to query the GTP engine for dead stones.
+static NSString* const deadStonesGtpCommand = @"final_status_list dead";
+
+
 // -----------------------------------------------------------------------------
 /// @brief Class extension with private properties for GoScore.
 // -----------------------------------------------------------------------------
@@ -45,6 +52,11 @@
 @property(nonatomic, retain) NSOperationQueue* operationQueue;
 @property(nonatomic, assign) bool didAskGtpEngineForDeadStones;
 @property(nonatomic, assign) bool lastCalculationHadError;
+/// @brief The asynchronous GTP command that queries the GTP engine for dead
+/// stones. Is @e nil if no query is pending, or if the pending query was
+/// invalidated.
+@property(nonatomic, retain) GtpCommand* pendingDeadStonesCommand;
+@property(nonatomic, retain) NSString* pendingDeadStonesAnalysisCacheKey;
 @end
 
 
@@ -135,6 +147,8 @@
 {
   [[NSNotificationCenter defaultCenter] removeObserver:self];
   self.operationQueue = nil;
+  self.pendingDeadStonesCommand = nil;
+  self.pendingDeadStonesAnalysisCacheKey = nil;
   [super dealloc];
 }
 
@@ -171,9 +185,9 @@
 /// Invoking this method puts all GoBoardRegion objects that currently
 /// exist into scoring mode (see the GoBoardRegion class documentation for
 /// details) and initializes them to belong to no territory. Also, when
-/// calculateWaitUntilDone:() is invoked the next time, the GTP engine will be
-/// queried for an initial set of dead stones (unless suppressed by the user
-/// preference).
+/// calculateWaitUntilDone:() is invoked the next time, an initial set of dead
+/// stones is estimated and the GTP engine is queried asynchronously to refine
+/// the estimate (unless suppressed by the user preference).
 // -----------------------------------------------------------------------------
 - (void) enableScoring
 {
@@ -221,6 +235,7 @@
 // -----------------------------------------------------------------------------
 - (void) disableScoring
 {
+  [self invalidatePendingDeadStonesCommand];
   [self uninitializeRegions];
 
   [self postScoringModeNotification];
@@ -304,6 +319,7 @@
 {
   if ([ApplicationDelegate sharedDelegate].uiSettingsModel.uiAreaPlayMode != UIAreaPlayModeScoring)
     return;
+  [self invalidatePendingDeadStonesCommand];
   [self uninitializeRegions];
 }
 
@@ -378,7 +394,7 @@
 
     if ([ApplicationDelegate sharedDelegate].uiSettingsModel.uiAreaPlayMode == UIAreaPlayModeScoring)
     {
-      [self askGtpEngineForDeadStones];
+      [self seedDeadStones];
       bool success = [self updateTerritoryColor];
       DDLogVerbose(@"%@: updateTerritoryColor returned with result = %d", self, success);
       if (! success)
@@ -467,10 +483,16 @@
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Queries the GTP engine for an initial set of dead stones. Updates
-/// GoBoardRegion objects with the result of the query.
+/// @brief Sets up an initial set of dead stones. Updates GoBoardRegion objects
+/// with the result.
+///
+/// If the GTP engine was already queried for the current board position, and
+/// the result is still in the analysis cache, the cached result is used.
+/// Otherwise GoDeadStoneEstimator provides an immediate estimate, and the GTP
+/// engine is queried asynchronously to refine the estimate. See
+/// gtpResponseReceived:() for details.
 // -----------------------------------------------------------------------------
-- (void) askGtpEngineForDeadStones
+- (void) seedDeadStones
 {
   if (! [ApplicationDelegate sharedDelegate].scoringModel.askGtpEngineForDeadStones)
     return;
@@ -478,48 +500,150 @@
     return;
   self.didAskGtpEngineForDeadStones = true;
 
-  @try
+  NSString* analysisCacheKey = [GtpAnalysisCache keyForAnalysis:deadStonesGtpCommand];
+  NSData* cachedResponseData = [[ApplicationDelegate sharedDelegate].gtpAnalysisCache resultForKey:analysisCacheKey];
+  if (cachedResponseData)
   {
-    self.askGtpEngineForDeadStonesInProgress = true;
-    [self performSelector:@selector(postNotificationOnMainThread:)
-                 onThread:[NSThread mainThread]
-               withObject:askGtpEngineForDeadStonesStarts
-            waitUntilDone:YES];
-    GtpCommand* command = [GtpCommand command:@"final_status_list dead"];
-    [command submit];
-    if (command.response.status)
+    GtpCommand* command = [GtpCommand command:deadStonesGtpCommand];
+    command.response = [GtpResponse responseWithData:cachedResponseData toCommand:command];
+    [self applyDeadStonesGtpResponse:command.response];
+    return;
+  }
+
+  GoDeadStoneEstimator* estimator = [[[GoDeadStoneEstimator alloc] initWithBoard:self.game.board] autorelease];
+  NSArray* deadStoneGroups = [estimator deadStoneGroups];
+  DDLogVerbose(@"%@: dead stone estimator found %lu dead stone groups", self, (unsigned long)deadStoneGroups.count);
+  for (GoBoardRegion* deadStoneGroup in deadStoneGroups)
+    deadStoneGroup.stoneGroupState = GoStoneGroupStateDead;
+
+  // The response to an asynchronous command is delivered in the context of
+  // the submitting thread, which requires a run loop. This method may run in
+  // the context of a secondary thread of the operation queue, which has none.
+  [self performSelectorOnMainThread:@selector(askGtpEngineForDeadStones:)
+                         withObject:analysisCacheKey
+                      waitUntilDone:NO];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Asynchronously queries the GTP engine for an initial set of dead
+/// stones. Is invoked in the context of the main thread. @a analysisCacheKey
+/// is the key under which the GTP engine response is stored in the analysis
+/// cache.
+// -----------------------------------------------------------------------------
+- (void) askGtpEngineForDeadStones:(NSString*)analysisCacheKey
+{
+  GtpCommand* command = [GtpCommand asynchronousCommand:deadStonesGtpCommand
+                                         responseTarget:self
+                                               selector:@selector(gtpResponseReceived:)];
+  command.kind = GtpCommandKindAnalysis;
+  self.pendingDeadStonesCommand = command;
+  self.pendingDeadStonesAnalysisCacheKey = analysisCacheKey;
+
+  self.askGtpEngineForDeadStonesInProgress = true;
+  [self postNotificationOnMainThread:askGtpEngineForDeadStonesStarts];
+
+  [command submit];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Is invoked in the context of the main thread when the GTP engine
+/// has responded to the query for dead stones.
+///
+/// The GTP engine's list of dead stones replaces the estimate made by
+/// GoDeadStoneEstimator, and the score is calculated again. The response is
+/// discarded if the query has been invalidated in the meantime, e.g. because
+/// the user has already started to mark dead stones, or because the board
+/// position has changed.
+// -----------------------------------------------------------------------------
+- (void) gtpResponseReceived:(GtpResponse*)response
+{
+  // A stale response must not end a query that is still in progress.
+  // invalidatePendingDeadStonesCommand() already ended the query to which
+  // the stale response belongs.
+  if (response.command != self.pendingDeadStonesCommand)
+    return;
+  NSString* analysisCacheKey = [[self.pendingDeadStonesAnalysisCacheKey retain] autorelease];
+  [self invalidatePendingDeadStonesCommand];
+
+  if (! response.status)
+  {
+    DDLogError(@"%@: Querying GTP engine for initial set of dead stones failed", self);
+    return;
+  }
+  [[ApplicationDelegate sharedDelegate].gtpAnalysisCache storeResult:response.rawResponseData forKey:analysisCacheKey];
+
+  // If a calculation is in progress the board must not be touched. The
+  // estimate remains in place.
+  if (self.scoringInProgress)
+    return;
+  if ([ApplicationDelegate sharedDelegate].uiSettingsModel.uiAreaPlayMode != UIAreaPlayModeScoring)
+    return;
+
+  for (GoBoardRegion* region in self.game.board.regions)
+  {
+    if (region.isStoneGroup)
+      region.stoneGroupState = GoStoneGroupStateAlive;
+  }
+  [self applyDeadStonesGtpResponse:response];
+  [self calculateWaitUntilDone:false];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Invalidates the query for dead stones that is
+/// currently in progress, if there is one. gtpResponseReceived:() discards
+/// the response to an invalidated query.
+// -----------------------------------------------------------------------------
+- (void) invalidatePendingDeadStonesCommand
+{
+  self.pendingDeadStonesCommand = nil;
+  self.pendingDeadStonesAnalysisCacheKey = nil;
+  if (! self.askGtpEngineForDeadStonesInProgress)
+    return;
+  self.askGtpEngineForDeadStonesInProgress = false;
+  [self postNotificationOnMainThread:askGtpEngineForDeadStonesEnds];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Marks the stone groups in the vertex list of
+/// @a response as dead.
+// -----------------------------------------------------------------------------
+- (void) applyDeadStonesGtpResponse:(GtpResponse*)response
+{
+  // Decode the vertices into a C array instead of a list of NSString
+  // objects. A vertex can appear at most once, so the number of
+  // intersections is an upper bound for the number of vertices.
+  int boardSize = self.game.board.size;
+  int capacity = boardSize * boardSize;
+  struct GoVertexNumeric deadStoneVertices[capacity];
+  int numberOfDeadStoneVertices = [response decodeVertexList:deadStoneVertices capacity:capacity];
+  if (numberOfDeadStoneVertices < 0)
+  {
+    DDLogError(@"%@: GTP engine response to query for dead stones is malformed: %@", self, response.parsedResponse);
+    assert(0);
+    numberOfDeadStoneVertices = 0;
+  }
+  for (int indexOfVertex = 0; indexOfVertex < numberOfDeadStoneVertices; ++indexOfVertex)
+  {
+    struct GoVertexNumeric deadStoneVertex = deadStoneVertices[indexOfVertex];
+    if (deadStoneVertex.x > boardSize || deadStoneVertex.y > boardSize)
     {
-      NSArray* deadStoneVertexList = [self parseDeadStoneGtpResponse:command.response.parsedResponse];
-      for (NSString* vertex in deadStoneVertexList)
-      {
-        GoPoint* point = [self.game.board pointAtVertex:vertex];
-        if (! [point hasStone])
-        {
-          DDLogError(@"%@: GTP engine reports vertex %@ is dead stone, but point %@ has no stone", self, vertex, point);
-          assert(0);
-          continue;
-        }
-        // TODO The next statement is problematic in two respects: 1) If the
-        // region has more than one point, we repeatedly set it to be dead,
-        // once for each vertex reported by the GTP engine. 2) We don't perform
-        // any kind of check if the vertex list reported by the GTP engine
-        // matches our regions.
-        point.region.stoneGroupState = GoStoneGroupStateDead;
-      }
+      DDLogError(@"%@: GTP engine reports vertex %d/%d is dead stone, but vertex is not on the board", self, deadStoneVertex.x, deadStoneVertex.y);
+      assert(0);
+      continue;
     }
-    else
+    GoPoint* point = [self.game.board pointAtVertex:[GoVertex vertexFromNumeric:deadStoneVertex].string];
+    if (! [point hasStone])
     {
-      DDLogError(@"%@: Querying GTP engine for initial set of dead stones failed", self);
+      DDLogError(@"%@: GTP engine reports vertex %@ is dead stone, but point %@ has no stone", self, point.vertex.string, point);
       assert(0);
+      continue;
     }
-  }
-  @finally
-  {
-    self.askGtpEngineForDeadStonesInProgress = false;
-    [self performSelector:@selector(postNotificationOnMainThread:)
-                 onThread:[NSThread mainThread]
-               withObject:askGtpEngineForDeadStonesEnds
-            waitUntilDone:YES];
+    // TODO The next statement is problematic in two respects: 1) If the
+    // region has more than one point, we repeatedly set it to be dead,
+    // once for each vertex reported by the GTP engine. 2) We don't perform
+    // any kind of check if the vertex list reported by the GTP engine
+    // matches our regions.
+    point.region.stoneGroupState = GoStoneGroupStateDead;
   }
 }
 
@@ -580,32 +704,6 @@
   [[NSNotificationCenter defaultCenter] postNotificationName:notificationName object:nil];
 }
 
-// -----------------------------------------------------------------------------
-/// @brief Parses @a gtpResponse, which is expected to be the response to the
-/// command "final_status_list dead", for strings that denote vertexes. Returns
-/// a list with all vertexes found.
-// -----------------------------------------------------------------------------
-- (NSArray*) parseDeadStoneGtpResponse:(NSString*)gtpResponse
-{
-  NSMutableArray* deadStoneVertexList = [NSMutableArray arrayWithCapacity:0];
-  if (0 == gtpResponse.length)
-    return deadStoneVertexList;
-  NSArray* responseLines = [gtpResponse componentsSeparatedByString:@"\n"];
-  for (NSString* responseLine in responseLines)
-  {
-    if (0 == responseLine.length)
-      continue;
-    NSArray* vertexList = [responseLine componentsSeparatedByString:@" "];
-    for (NSString* vertex in vertexList)
-    {
-      if (0 == vertex.length)
-        continue;
-      [deadStoneVertexList addObject:vertex];
-    }
-  }
-  return deadStoneVertexList;
-}
-
 // -----------------------------------------------------------------------------
 /// @brief Toggles the status of the stone group @a stoneGroup from alive to
 /// dead, or vice versa. If @a stoneGroup is in seki, its status is changed to
@@ -633,6 +731,8 @@
     return;
   if (! [stoneGroup isStoneGroup])
     return;
+  // The user's decision takes precedence over the GTP engine's response
+  [self invalidatePendingDeadStonesCommand];
 
   bool markDeadStonesIntelligently = [ApplicationDelegate sharedDelegate].scoringModel.markDeadStonesIntelligently;
 
@@ -748,6 +848,8 @@
     return;
   if (! [stoneGroup isStoneGroup])
     return;
+  // The user's decision takes precedence over the GTP engine's response
+  [self invalidatePendingDeadStonesCommand];
   enum GoStoneGroupState newStoneGroupState;
   switch (stoneGroup.stoneGroupState)
   {
@@ -776,7 +878,7 @@
 /// objects. For details see the class documentation, paragraph "Determining
 /// territory color".
 ///
-/// Initial dead stones are set up by askGtpEngineForDeadStones(). User
+/// Initial dead stones are set up by seedDeadStones(). User
 /// interaction during scoring invokes toggleDeadStateOfStoneGroup:() to add
 /// more dead stones, or turn them back to alive.
 // -----------------------------------------------------------------------------
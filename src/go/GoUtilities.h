@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -38,6 +38,7 @@
 }
 
 + (void) movePointToNewRegion:(GoPoint*)thePoint;
++ (void) movePointsToNewRegions:(NSArray*)points;
 + (NSArray*) verticesForHandicap:(int)handicap boardSize:(enum GoBoardSize)boardSize;
 + (NSArray*) pointsForHandicap:(int)handicap inGame:(GoGame*)game;
 + (int) maximumHandicapForBoardSize:(enum GoBoardSize)boardSize;
@@ -68,5 +69,13 @@
 + (bool) showInfoIndicatorForNode:(GoNode*)node;
 + (bool) showHotspotIndicatorForNode:(GoNode*)node;
 + (enum NodeTreeViewCellSymbol) symbolForNode:(GoNode*)node inGame:(GoGame*)game;
++ (uint64_t) positionKeyForGame:(GoGame*)game;
++ (uint64_t) positionKeyForGame:(GoGame*)game afterMoveAtPoint:(GoPoint*)point byColor:(enum GoColor)color;
++ (GoPoint*) koPointForGame:(GoGame*)game;
++ (GoPoint*) koPointForGame:(GoGame*)game afterMoveAtPoint:(GoPoint*)point byColor:(enum GoColor)color;
++ (uint64_t) historyKeyForGame:(GoGame*)game;
++ (uint64_t) historyKeyForGame:(GoGame*)game afterMoveAtPoint:(GoPoint*)point byColor:(enum GoColor)color;
 
 @end
+
+extern uint64_t GoUtilitiesMixBits(uint64_t value);
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -94,6 +94,160 @@
     [GoBoardRegion regionWithPoint:thePoint];
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Moves the GoPoint objects in @a points to new GoBoardRegion objects
+/// in response to a change of GoPoint.stoneState. This is the bulk variant of
+/// movePointToNewRegion:(), to be used when the stone state of many points
+/// changes at once, e.g. when board setup is applied or reverted.
+///
+/// The stone state of all GoPoint objects in @a points already must have its
+/// new value at the time this method is invoked. @a points may contain
+/// duplicates.
+///
+/// Instead of updating regions point by point, which may fragment and merge the
+/// same GoBoardRegion objects over and over again, this method rebuilds the
+/// regions that are affected by the change in one go. A region is affected if
+/// it contains one of the GoPoint objects in @a points, or one of their
+/// neighbours. The GoPoint objects of all affected regions are redistributed by
+/// a single flood fill. Regions that are not affected are left untouched.
+///
+/// Each rebuilt region re-uses the GoBoardRegion object that contributed the
+/// most unchanged GoPoint objects to it. This keeps GoBoardRegion objects
+/// stable in the same way as movePointToNewRegion:() does, e.g. clearing a
+/// setup stone does not replace the GoBoardRegion object of the surrounding
+/// empty area.
+// -----------------------------------------------------------------------------
++ (void) movePointsToNewRegions:(NSArray*)points
+{
+  if (points.count == 0)
+    return;
+
+  // Step 1: Collect the affected regions. The collections retain the regions
+  // so that they survive step 3 even if they are not re-used.
+  NSMutableArray* affectedRegions = [NSMutableArray array];
+  NSMutableSet* affectedRegionsSet = [NSMutableSet set];
+  for (GoPoint* point in points)
+  {
+    for (GoPoint* affectedPoint in [point.neighbours arrayByAddingObject:point])
+    {
+      GoBoardRegion* affectedRegion = affectedPoint.region;
+      if ([affectedRegionsSet containsObject:affectedRegion])
+        continue;
+      [affectedRegionsSet addObject:affectedRegion];
+      [affectedRegions addObject:affectedRegion];
+    }
+  }
+
+  // Step 2: Flood fill the GoPoint objects of the affected regions to find the
+  // new regions. The GoPoint objects still reference their old regions, which
+  // is required to find the GoBoardRegion objects that can be re-used.
+  NSSet* changedPoints = [NSSet setWithArray:points];
+  NSMutableSet* visitedPoints = [NSMutableSet set];
+  NSMutableSet* reusedRegions = [NSMutableSet set];
+  NSMutableArray* subRegions = [NSMutableArray array];
+  NSMutableArray* targetRegions = [NSMutableArray array];
+  for (GoBoardRegion* affectedRegion in affectedRegions)
+  {
+    for (GoPoint* point in affectedRegion.points)
+    {
+      if ([visitedPoints containsObject:point])
+        continue;
+
+      NSMutableArray* subRegion = [NSMutableArray array];
+      [GoUtilities fillSubRegion:subRegion containingPoint:point visitedPoints:visitedPoints];
+      [subRegions addObject:subRegion];
+
+      GoBoardRegion* targetRegion = [GoUtilities reusableRegionForSubRegion:subRegion
+                                                              changedPoints:changedPoints
+                                                              reusedRegions:reusedRegions];
+      if (targetRegion)
+        [reusedRegions addObject:targetRegion];
+      else
+        targetRegion = [GoBoardRegion region];
+      [targetRegions addObject:targetRegion];
+    }
+  }
+
+  // Step 3: Empty the affected regions, then populate the new regions. None of
+  // the GoBoardRegion objects are deallocated before the end of this method
+  // because they are still referenced by the collections.
+  for (GoBoardRegion* affectedRegion in affectedRegions)
+    [affectedRegion removeAllPoints];
+  NSUInteger numberOfSubRegions = subRegions.count;
+  for (NSUInteger indexOfSubRegion = 0; indexOfSubRegion < numberOfSubRegions; ++indexOfSubRegion)
+  {
+    GoBoardRegion* targetRegion = [targetRegions objectAtIndex:indexOfSubRegion];
+    for (GoPoint* point in [subRegions objectAtIndex:indexOfSubRegion])
+      [targetRegion addPoint:point];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Recursively adds GoPoint objects to @a subRegion that are connected
+/// with @a point and that have the same GoPoint.stoneState as @a point. Also
+/// adds the GoPoint objects to @a visitedPoints.
+///
+/// There is no need to check whether a neighbour belongs to one of the affected
+/// regions: A neighbour that has the same stone state as a GoPoint in an
+/// affected region either was in the same region before the change, or it is
+/// itself adjacent to a changed GoPoint. In both cases its region is affected.
+///
+/// This is an internal helper method for movePointsToNewRegions:().
+// -----------------------------------------------------------------------------
++ (void) fillSubRegion:(NSMutableArray*)subRegion
+       containingPoint:(GoPoint*)point
+         visitedPoints:(NSMutableSet*)visitedPoints
+{
+  [subRegion addObject:point];
+  [visitedPoints addObject:point];
+  enum GoColor stoneState = point.stoneState;
+  for (GoPoint* neighbour in point.neighbours)
+  {
+    if (neighbour.stoneState != stoneState)
+      continue;
+    if ([visitedPoints containsObject:neighbour])
+      continue;
+    [GoUtilities fillSubRegion:subRegion containingPoint:neighbour visitedPoints:visitedPoints];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the old GoBoardRegion object that contributed the most
+/// unchanged GoPoint objects to @a subRegion and that is not yet in
+/// @a reusedRegions. Returns @e nil if there is no such GoBoardRegion object.
+///
+/// This is an internal helper method for movePointsToNewRegions:().
+// -----------------------------------------------------------------------------
++ (GoBoardRegion*) reusableRegionForSubRegion:(NSArray*)subRegion
+                                changedPoints:(NSSet*)changedPoints
+                                reusedRegions:(NSSet*)reusedRegions
+{
+  NSCountedSet* oldRegions = [[[NSCountedSet alloc] init] autorelease];
+  for (GoPoint* point in subRegion)
+  {
+    // A changed point has a different stone state than its old region
+    if ([changedPoints containsObject:point])
+      continue;
+    [oldRegions addObject:point.region];
+  }
+
+  GoBoardRegion* reusableRegion = nil;
+  NSUInteger maximumCount = 0;
+  for (GoBoardRegion* oldRegion in oldRegions)
+  {
+    if ([reusedRegions containsObject:oldRegion])
+      continue;
+    NSUInteger count = [oldRegions countForObject:oldRegion];
+    if (count > maximumCount)
+    {
+      reusableRegion = oldRegion;
+      maximumCount = count;
+    }
+  }
+
+  return reusableRegion;
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Returns an (unordered) list of NSString objects that denote vertices
 /// for the specified @a handicap and @a boardSize.
@@ -844,13 +998,9 @@
 // -----------------------------------------------------------------------------
 + (GoNode*) nodeWithMostRecentMove:(GoNode*)node
 {
-  while (node)
-  {
-    if (node.goMove)
-      return node;
-    node = node.parent;
-  }
-  return nil;
+  // The ancestry index maintained by GoNode has the answer. Returns nil if
+  // node is nil.
+  return node.nodeWithMostRecentMove;
 }
 
 // -----------------------------------------------------------------------------
@@ -904,18 +1054,9 @@
 // -----------------------------------------------------------------------------
 + (int) numberOfMovesBeforeNode:(GoNode*)node
 {
-  int numberOfMovesBeforeNode = 0;
-
-  if (node)
-    node = node.parent;
-  while (node)
-  {
-    if (node.goMove)
-      numberOfMovesBeforeNode++;
-    node = node.parent;
-  }
-
-  return numberOfMovesBeforeNode;
+  // The ancestry index maintained by GoNode has the answer. Returns zero if
+  // node is nil or if node is the root node.
+  return node.parent.numberOfMovesUpToAndIncludingNode;
 }
 
 // -----------------------------------------------------------------------------
@@ -1002,13 +1143,9 @@
 // -----------------------------------------------------------------------------
 + (GoNode*) nodeWithMostRecentBoardStateChange:(GoNode*)node
 {
-  while (node)
-  {
-    if (node.goMove || node.goNodeSetup)
-      return node;
-    node = node.parent;
-  }
-  return nil;
+  // The ancestry index maintained by GoNode has the answer. Returns nil if
+  // node is nil.
+  return node.nodeWithMostRecentBoardStateChange;
 }
 
 // -----------------------------------------------------------------------------
@@ -1131,4 +1268,199 @@
   return NodeTreeViewCellSymbolEmpty;
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Returns a 64-bit key that identifies the stones that are currently
+/// on the board of @a game, and the board size.
+///
+/// Unlike the Zobrist hashes stored in GoNode, the key is the same on every
+/// device and in every application session, because it does not depend on the
+/// random values of a GoZobristTable. The key is therefore suitable for
+/// results that are stored in a file. The key is not normalized for board
+/// symmetries.
+// -----------------------------------------------------------------------------
++ (uint64_t) positionKeyForGame:(GoGame*)game
+{
+  GoBoard* board = game.board;
+  uint64_t positionKey = GoUtilitiesMixBits((uint64_t)board.size);
+  NSEnumerator* enumerator = [board pointEnumerator];
+  GoPoint* point;
+  while (point = [enumerator nextObject])
+  {
+    if (point.hasStone)
+      positionKey ^= [GoUtilities positionKeyComponentForStoneWithColor:point.stoneState atPoint:point];
+  }
+  return positionKey;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the 64-bit key that positionKeyForGame:() would return
+/// after @a color played a stone on the intersection @a point in the current
+/// board position of @a game. The key takes stones into account that the
+/// move would capture.
+///
+/// The caller is responsible for making sure that the move is legal.
+// -----------------------------------------------------------------------------
++ (uint64_t) positionKeyForGame:(GoGame*)game afterMoveAtPoint:(GoPoint*)point byColor:(enum GoColor)color
+{
+  uint64_t positionKey = [GoUtilities positionKeyForGame:game];
+  positionKey ^= [GoUtilities positionKeyComponentForStoneWithColor:color atPoint:point];
+
+  enum GoColor opponentColor = [GoUtilities alternatingColorForColor:color];
+  for (GoBoardRegion* neighbourRegion in [point neighbourRegionsWithColor:opponentColor])
+  {
+    if ([neighbourRegion liberties] != 1)
+      continue;
+    for (GoPoint* capturedPoint in neighbourRegion.points)
+      positionKey ^= [GoUtilities positionKeyComponentForStoneWithColor:opponentColor atPoint:capturedPoint];
+  }
+  return positionKey;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the intersection on which the simple ko rule forbids the
+/// player whose turn it is in the current board position of @a game to play.
+/// Returns @e nil if there is no such intersection.
+///
+/// The intersection is that of the single stone that the most recent move
+/// captured, if the stone that made the capture is itself a single stone with
+/// only one liberty.
+// -----------------------------------------------------------------------------
++ (GoPoint*) koPointForGame:(GoGame*)game
+{
+  GoNode* node = game.boardPosition.currentNode.nodeWithMostRecentBoardStateChange;
+  GoMove* move = node.goMove;
+  if (! move || move.type != GoMoveTypePlay || move.capturedStones.count != 1)
+    return nil;
+
+  GoBoardRegion* region = move.point.region;
+  if ([region size] != 1 || [region liberties] != 1)
+    return nil;
+  return move.capturedStones.firstObject;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the intersection that koPointForGame:() would return after
+/// @a color played a stone on the intersection @a point in the current board
+/// position of @a game.
+///
+/// The caller is responsible for making sure that the move is legal.
+// -----------------------------------------------------------------------------
++ (GoPoint*) koPointForGame:(GoGame*)game afterMoveAtPoint:(GoPoint*)point byColor:(enum GoColor)color
+{
+  // The new stone must be a single stone whose only liberty after the move is
+  // the intersection of the captured stone
+  if ([point liberties] != 0 || [point neighbourRegionsWithColor:color].count > 0)
+    return nil;
+
+  GoPoint* capturedPoint = nil;
+  enum GoColor opponentColor = [GoUtilities alternatingColorForColor:color];
+  for (GoBoardRegion* neighbourRegion in [point neighbourRegionsWithColor:opponentColor])
+  {
+    if ([neighbourRegion liberties] != 1)
+      continue;
+    if (capturedPoint || [neighbourRegion size] != 1)
+      return nil;
+    capturedPoint = neighbourRegion.points.firstObject;
+  }
+  return capturedPoint;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a 64-bit key that identifies the sequence of moves and setup
+/// stones on the path from the root node of @a game's node tree down to and
+/// including the node of the current board position, and the handicap stones.
+///
+/// Two board positions with the same key have the same history, which is what
+/// a superko rule needs to decide whether a move is legal. Like the key that
+/// positionKeyForGame:() returns, the key is the same on every device and in
+/// every application session.
+// -----------------------------------------------------------------------------
++ (uint64_t) historyKeyForGame:(GoGame*)game
+{
+  uint64_t historyKey = GoUtilitiesMixBits((uint64_t)game.board.size);
+  for (GoPoint* handicapPoint in game.handicapPoints)
+    historyKey ^= [GoUtilities positionKeyComponentForStoneWithColor:GoColorBlack atPoint:handicapPoint];
+
+  NSMutableArray* nodes = [NSMutableArray array];
+  for (GoNode* node = game.boardPosition.currentNode; node; node = node.parent)
+    [nodes addObject:node];
+
+  for (GoNode* node in [nodes reverseObjectEnumerator])
+  {
+    GoNodeSetup* nodeSetup = node.goNodeSetup;
+    if (nodeSetup)
+    {
+      uint64_t nodeKey = 0;
+      for (GoPoint* point in nodeSetup.blackSetupStones)
+        nodeKey ^= [GoUtilities positionKeyComponentForStoneWithColor:GoColorBlack atPoint:point];
+      for (GoPoint* point in nodeSetup.whiteSetupStones)
+        nodeKey ^= [GoUtilities positionKeyComponentForStoneWithColor:GoColorWhite atPoint:point];
+      for (GoPoint* point in nodeSetup.noSetupStones)
+        nodeKey ^= [GoUtilities positionKeyComponentForStoneWithColor:GoColorNone atPoint:point];
+      historyKey = GoUtilitiesMixBits(historyKey ^ nodeKey);
+    }
+
+    GoMove* move = node.goMove;
+    if (move)
+      historyKey = [GoUtilities historyKey:historyKey afterMoveAtPoint:move.point byColor:move.player.color];
+  }
+  return historyKey;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the 64-bit key that historyKeyForGame:() would return after
+/// @a color played a stone on the intersection @a point in the current board
+/// position of @a game. @a point is @e nil for a pass move.
+// -----------------------------------------------------------------------------
++ (uint64_t) historyKeyForGame:(GoGame*)game afterMoveAtPoint:(GoPoint*)point byColor:(enum GoColor)color
+{
+  return [GoUtilities historyKey:[GoUtilities historyKeyForGame:game]
+                afterMoveAtPoint:point
+                         byColor:color];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for historyKeyForGame:() and
+/// historyKeyForGame:afterMoveAtPoint:byColor:(). Returns the history key
+/// @a historyKey extended by the move of @a color on the intersection
+/// @a point. @a point is @e nil for a pass move.
+// -----------------------------------------------------------------------------
++ (uint64_t) historyKey:(uint64_t)historyKey afterMoveAtPoint:(GoPoint*)point byColor:(enum GoColor)color
+{
+  uint64_t moveKey;
+  if (point)
+    moveKey = [GoUtilities positionKeyComponentForStoneWithColor:color atPoint:point];
+  else
+    moveKey = GoUtilitiesMixBits((uint64_t)color);
+  return GoUtilitiesMixBits(historyKey ^ moveKey);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for positionKeyForGame:() and
+/// positionKeyForGame:afterMoveAtPoint:byColor:(). Returns the part of a
+/// position key that represents a stone of color @a color on the
+/// intersection @a point. The value is the same as the one that GoOpeningBook
+/// uses for the untransformed board.
+// -----------------------------------------------------------------------------
++ (uint64_t) positionKeyComponentForStoneWithColor:(enum GoColor)color atPoint:(GoPoint*)point
+{
+  struct GoVertexNumeric numericVertex = point.vertex.numeric;
+  uint64_t x = (uint64_t)(numericVertex.x - 1);
+  uint64_t y = (uint64_t)(numericVertex.y - 1);
+  return GoUtilitiesMixBits(((uint64_t)color << 16) | (x << 8) | y);
+}
+
 @end
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a well-mixed 64-bit value for @a value (SplitMix64). The
+/// result is the same on every device and in every application session, which
+/// is why GoZobristTable cannot be used for keys that are stored in a file.
+// -----------------------------------------------------------------------------
+uint64_t GoUtilitiesMixBits(uint64_t value)
+{
+  value += 0x9e3779b97f4a7c15ULL;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+  return value ^ (value >> 31);
+}
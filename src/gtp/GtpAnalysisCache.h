@@ -0,0 +1,91 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Forward declarations
+@class GoPoint;
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpAnalysisCache class stores the results of analysis GTP
+/// commands (e.g. move suggestions, dead stones, territory statistics), so
+/// that the GTP engine does not have to be queried again when the user
+/// revisits a board position.
+///
+/// @ingroup gtp
+///
+/// A result is stored under a key that identifies both the analysis and the
+/// conditions under which the analysis was made. keyForAnalysis:() generates
+/// such a key for the current board position. The key consists of
+/// - The position key that GoUtilities::positionKeyForGame:() generates for
+///   the current board position, and the board size. Unlike the Zobrist
+///   hashes in GoNode, the position key does not change from one application
+///   session to the next, so results that are restored from a file can be
+///   found again.
+/// - The color that is to move next.
+/// - The intersection on which the simple ko rule forbids the color that is to
+///   move next to play, if there is one.
+/// - If a superko rule is in effect, the key that
+///   GoUtilities::historyKeyForGame:() generates for the history of the
+///   current board position, because under a superko rule the legal moves
+///   depend on all board positions that occurred before.
+/// - Komi and the rules of the game.
+/// - The UUID and the analysis-relevant settings of the active
+///   GtpEngineProfile. The memory settings are those that
+///   GtpEngineMemoryGovernor actually applied to the GTP engines.
+/// - The analysis, which usually is the GTP command string.
+///
+/// The key must be generated at the time the analysis is requested, not when
+/// the result arrives, because the current board position may have changed in
+/// the meantime.
+///
+/// Results are stored as raw byte buffers. The cache is bounded: When the total
+/// size of all results exceeds the maximum size, the results that were least
+/// recently used are evicted.
+///
+/// The content of the cache can be saved to and restored from a file, which
+/// allows the cache to survive an application restart.
+///
+/// All methods in GtpAnalysisCache are thread-safe.
+// -----------------------------------------------------------------------------
+@interface GtpAnalysisCache : NSObject
+{
+}
+
+- (id) initWithMaximumSize:(NSUInteger)maximumSize;
+
++ (NSString*) keyForAnalysis:(NSString*)analysis;
++ (NSString*) keyForAnalysis:(NSString*)analysis afterMoveAtPoint:(GoPoint*)point;
+- (NSData*) resultForKey:(NSString*)key;
+- (void) storeResult:(NSData*)result forKey:(NSString*)key;
+- (void) removeAllResults;
+
+- (bool) writeToFile:(NSString*)path;
+- (bool) readFromFile:(NSString*)path;
+
+/// @brief The maximum total size in bytes of all results in the cache.
+@property(nonatomic, assign, readonly) NSUInteger maximumSize;
+/// @brief The current total size in bytes of all results in the cache.
+@property(atomic, assign, readonly) NSUInteger size;
+/// @brief The number of results in the cache.
+@property(atomic, assign, readonly) NSUInteger numberOfResults;
+/// @brief The number of lookups with resultForKey:() that found a result.
+@property(atomic, assign, readonly) NSUInteger numberOfHits;
+/// @brief The number of lookups with resultForKey:() that did not find a
+/// result.
+@property(atomic, assign, readonly) NSUInteger numberOfMisses;
+
+@end
@@ -0,0 +1,378 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Project includes
+#import "GtpAnalysisCache.h"
+#import "../go/GoBoard.h"
+#import "../go/GoGame.h"
+#import "../go/GoGameRules.h"
+#import "../go/GoPoint.h"
+#import "../go/GoVertex.h"
+#import "../go/GoUtilities.h"
+#import "../main/ApplicationDelegate.h"
+#import "GtpEngineMemoryGovernor.h"
+#import "../player/GtpEngineProfile.h"
+#import "../player/GtpEngineProfileModel.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GtpAnalysisCache.
+// -----------------------------------------------------------------------------
+@interface GtpAnalysisCache()
+@property(nonatomic, assign, readwrite) NSUInteger maximumSize;
+@property(atomic, assign, readwrite) NSUInteger size;
+@property(atomic, assign, readwrite) NSUInteger numberOfHits;
+@property(atomic, assign, readwrite) NSUInteger numberOfMisses;
+/// @brief Maps keys to results.
+@property(nonatomic, retain) NSMutableDictionary* results;
+/// @brief The keys of all results, ordered from least recently used to most
+/// recently used.
+@property(nonatomic, retain) NSMutableOrderedSet* keysInUsageOrder;
+@end
+
+
+@implementation GtpAnalysisCache
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpAnalysisCache object that stores results with a
+/// total size of up to @a maximumSize bytes.
+///
+/// @note This is the designated initializer of GtpAnalysisCache.
+// -----------------------------------------------------------------------------
+- (id) initWithMaximumSize:(NSUInteger)maximumSize
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.maximumSize = maximumSize;
+  self.size = 0;
+  self.numberOfHits = 0;
+  self.numberOfMisses = 0;
+  self.results = [NSMutableDictionary dictionary];
+  self.keysInUsageOrder = [NSMutableOrderedSet orderedSet];
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GtpAnalysisCache object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.results = nil;
+  self.keysInUsageOrder = nil;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a key for the analysis @a analysis of the current board
+/// position of the shared GoGame. Returns @e nil if there is no shared GoGame.
+///
+/// @a analysis is usually the GTP command string that performs the analysis,
+/// but it can be any string that uniquely identifies the analysis.
+///
+/// This method must be invoked in a thread context in which GoGame can be
+/// safely accessed.
+// -----------------------------------------------------------------------------
++ (NSString*) keyForAnalysis:(NSString*)analysis
+{
+  GoGame* game = [GoGame sharedGame];
+  if (! game)
+    return nil;
+
+  bool isSuperkoRule = (game.rules.koRule != GoKoRuleSimple);
+  return [GtpAnalysisCache keyForAnalysis:analysis
+                              positionKey:[GoUtilities positionKeyForGame:game]
+                                  koPoint:[GoUtilities koPointForGame:game]
+                               historyKey:(isSuperkoRule ? [GoUtilities historyKeyForGame:game] : 0)
+                            nextMoveColor:game.nextMoveColor
+                                   inGame:game];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a key for the analysis @a analysis of the board position
+/// that would result if the player whose turn it is in the shared GoGame
+/// played a stone on the intersection @a point. Returns @e nil if there is no
+/// shared GoGame.
+///
+/// This allows to store the result of an analysis of a hypothetical board
+/// position under the same key that keyForAnalysis:() generates after the
+/// move has actually been played.
+///
+/// This method must be invoked in a thread context in which GoGame can be
+/// safely accessed.
+// -----------------------------------------------------------------------------
++ (NSString*) keyForAnalysis:(NSString*)analysis afterMoveAtPoint:(GoPoint*)point
+{
+  GoGame* game = [GoGame sharedGame];
+  if (! game)
+    return nil;
+
+  enum GoColor moveColor = game.nextMoveColor;
+  uint64_t positionKey = [GoUtilities positionKeyForGame:game
+                                        afterMoveAtPoint:point
+                                                 byColor:moveColor];
+  GoPoint* koPoint = [GoUtilities koPointForGame:game
+                                 afterMoveAtPoint:point
+                                          byColor:moveColor];
+  uint64_t historyKey = 0;
+  if (game.rules.koRule != GoKoRuleSimple)
+  {
+    historyKey = [GoUtilities historyKeyForGame:game
+                               afterMoveAtPoint:point
+                                        byColor:moveColor];
+  }
+  return [GtpAnalysisCache keyForAnalysis:analysis
+                              positionKey:positionKey
+                                  koPoint:koPoint
+                               historyKey:historyKey
+                            nextMoveColor:[GoUtilities alternatingColorForColor:moveColor]
+                                   inGame:game];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for keyForAnalysis:() and
+/// keyForAnalysis:afterMoveAtPoint:(). Returns a key for the analysis
+/// @a analysis of the board position identified by @a positionKey in which
+/// @a nextMoveColor is to play next.
+///
+/// @a koPoint is the intersection on which the simple ko rule forbids
+/// @a nextMoveColor to play, or @e nil if there is no such intersection.
+/// @a historyKey identifies the history of the board position if a superko
+/// rule is in effect, otherwise it is zero.
+///
+/// The memory settings in the key are those that GtpEngineMemoryGovernor
+/// actually applied to the GTP engines, not those of the GtpEngineProfile.
+// -----------------------------------------------------------------------------
++ (NSString*) keyForAnalysis:(NSString*)analysis
+                 positionKey:(uint64_t)positionKey
+                     koPoint:(GoPoint*)koPoint
+                  historyKey:(uint64_t)historyKey
+               nextMoveColor:(enum GoColor)nextMoveColor
+                      inGame:(GoGame*)game
+{
+  GoGameRules* rules = game.rules;
+  NSString* profileFingerprint = @"-";
+  ApplicationDelegate* applicationDelegate = [ApplicationDelegate sharedDelegate];
+  GtpEngineProfile* profile = applicationDelegate.gtpEngineProfileModel.activeProfile;
+  if (profile)
+  {
+    int maxMemory = profile.fuegoMaxMemory;
+    bool reuseSubtree = profile.fuegoReuseSubtree;
+    GtpEngineMemoryGovernor* memoryGovernor = applicationDelegate.gtpEngineMemoryGovernor;
+    if (memoryGovernor.activeMemoryBudget > 0)
+    {
+      maxMemory = memoryGovernor.activeMemoryBudget;
+      reuseSubtree = memoryGovernor.reuseSubtree;
+    }
+    profileFingerprint = [NSString stringWithFormat:@"%@/%d/%d/%d/%u/%llu",
+                          profile.uuid,
+                          maxMemory,
+                          profile.fuegoThreadCount,
+                          reuseSubtree,
+                          profile.fuegoMaxThinkingTime,
+                          profile.fuegoMaxGames];
+  }
+
+  return [NSString stringWithFormat:@"%llx/%d/%d/%@/%llx/%.1f/%d%d%d%d%d/%@/%@",
+          positionKey,
+          game.board.size,
+          nextMoveColor,
+          (koPoint ? koPoint.vertex.string : @"-"),
+          historyKey,
+          game.komi,
+          rules.koRule,
+          rules.scoringSystem,
+          rules.lifeAndDeathSettlingRule,
+          rules.disputeResolutionRule,
+          rules.fourPassesRule,
+          profileFingerprint,
+          analysis];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the result that is stored under @a key. Returns @e nil if no
+/// result is stored under @a key, or if @a key is @e nil.
+// -----------------------------------------------------------------------------
+- (NSData*) resultForKey:(NSString*)key
+{
+  if (! key)
+    return nil;
+  @synchronized(self)
+  {
+    NSData* result = [self.results objectForKey:key];
+    if (result)
+    {
+      self.numberOfHits++;
+      [self.keysInUsageOrder removeObject:key];
+      [self.keysInUsageOrder addObject:key];
+    }
+    else
+    {
+      self.numberOfMisses++;
+    }
+    return [[result retain] autorelease];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Stores @a result under @a key. Replaces the result that is already
+/// stored under @a key, if there is one. Does nothing if @a key or @a result
+/// is @e nil, or if @a result alone is larger than the maximum size of the
+/// cache.
+///
+/// Evicts the least recently used results if the total size of all results
+/// exceeds the maximum size of the cache after @a result has been stored.
+// -----------------------------------------------------------------------------
+- (void) storeResult:(NSData*)result forKey:(NSString*)key
+{
+  if (! key || ! result)
+    return;
+  if (result.length > self.maximumSize)
+    return;
+
+  @synchronized(self)
+  {
+    [self removeResultForKey:key];
+    [self.results setObject:[[result copy] autorelease] forKey:key];
+    [self.keysInUsageOrder addObject:key];
+    self.size += result.length;
+
+    while (self.size > self.maximumSize)
+      [self removeResultForKey:self.keysInUsageOrder.firstObject];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Removes all results from the cache.
+// -----------------------------------------------------------------------------
+- (void) removeAllResults
+{
+  @synchronized(self)
+  {
+    [self.results removeAllObjects];
+    [self.keysInUsageOrder removeAllObjects];
+    self.size = 0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Removes the result that is stored under @a key, if
+/// there is one.
+///
+/// The caller must hold the lock on @e self.
+// -----------------------------------------------------------------------------
+- (void) removeResultForKey:(NSString*)key
+{
+  NSData* result = [self.results objectForKey:key];
+  if (! result)
+    return;
+  self.size -= result.length;
+  // Must retain because removing the object from the ordered set might
+  // deallocate the key
+  [[key retain] autorelease];
+  [self.results removeObjectForKey:key];
+  [self.keysInUsageOrder removeObject:key];
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (NSUInteger) numberOfResults
+{
+  @synchronized(self)
+  {
+    return self.results.count;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Writes the content of the cache to the file @a path. Returns true on
+/// success, false on failure.
+///
+/// The file is a property list that contains the keys and the results in the
+/// order in which they were used, so that readFromFile:() can restore the
+/// usage order.
+// -----------------------------------------------------------------------------
+- (bool) writeToFile:(NSString*)path
+{
+  NSMutableArray* entries = [NSMutableArray array];
+  @synchronized(self)
+  {
+    for (NSString* key in self.keysInUsageOrder)
+      [entries addObject:@[key, [self.results objectForKey:key]]];
+  }
+
+  NSError* error = nil;
+  NSData* data = [NSPropertyListSerialization dataWithPropertyList:entries
+                                                            format:NSPropertyListBinaryFormat_v1_0
+                                                           options:0
+                                                             error:&error];
+  if (! data)
+  {
+    DDLogError(@"%@: Failed to serialize analysis results, error = %@", self, error);
+    return false;
+  }
+  BOOL success = [data writeToFile:path atomically:YES];
+  if (! success)
+    DDLogError(@"%@: Failed to write analysis results to file %@", self, path);
+  return success;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Replaces the content of the cache with the content of the file
+/// @a path, which must have been written by writeToFile:(). Returns true on
+/// success, false on failure. The cache is empty after a failure.
+///
+/// If the file contains more results than fit into the cache, the least
+/// recently used results are evicted.
+// -----------------------------------------------------------------------------
+- (bool) readFromFile:(NSString*)path
+{
+  [self removeAllResults];
+
+  NSData* data = [NSData dataWithContentsOfFile:path];
+  if (! data)
+    return false;
+  NSError* error = nil;
+  id entries = [NSPropertyListSerialization propertyListWithData:data
+                                                         options:NSPropertyListImmutable
+                                                          format:NULL
+                                                           error:&error];
+  if (! [entries isKindOfClass:[NSArray class]])
+  {
+    DDLogError(@"%@: Failed to deserialize analysis results from file %@, error = %@", self, path, error);
+    return false;
+  }
+
+  for (id entry in entries)
+  {
+    if (! [entry isKindOfClass:[NSArray class]] || [entry count] != 2)
+      continue;
+    id key = [entry objectAtIndex:0];
+    id result = [entry objectAtIndex:1];
+    if (! [key isKindOfClass:[NSString class]] || ! [result isKindOfClass:[NSData class]])
+      continue;
+    [self storeResult:result forKey:key];
+  }
+  return true;
+}
+
+@end
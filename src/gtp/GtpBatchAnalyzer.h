@@ -0,0 +1,148 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+
+// Forward declarations
+@class GtpEngineProfile;
+@class GtpStatistics;
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpBatchAnalysisResult class holds the result of the analysis of
+/// a single board position by GtpBatchAnalyzer.
+///
+/// @ingroup gtp
+// -----------------------------------------------------------------------------
+@interface GtpBatchAnalysisResult : NSObject
+{
+}
+
+/// @brief True if the board position could be analyzed, false if one of the
+/// GTP commands failed. If this is false the other properties have no meaning.
+@property(nonatomic, assign) bool valid;
+/// @brief The move that the GTP engine suggests for the player whose turn it
+/// is, as a GTP vertex (e.g. "D4"), or "PASS" or "resign".
+@property(nonatomic, retain) NSString* suggestedMove;
+/// @brief The estimated area score, from Black's point of view and including
+/// komi. A positive value means that Black is ahead, a negative value means
+/// that White is ahead.
+///
+/// This is an approximation, not a score that was counted: It is the sum of
+/// the territory statistics of the search, i.e. the expected difference in
+/// area, minus komi. Intersections whose owner the search has not settled
+/// contribute a fraction of a point, prisoners are not counted, and the
+/// estimate is only as good as the search that produced it. The GTP command
+/// "final_score" is not used because it is meant to score finished games, not
+/// board positions in the middle of a game.
+@property(nonatomic, assign) double estimatedScore;
+
+@end
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpBatchAnalyzer class lets a number of GTP engines analyze all
+/// board positions of a game in parallel, without involving GoGame or the UI.
+///
+/// @ingroup gtp
+///
+/// When start() is invoked, GtpBatchAnalyzer reserves up to @e numberOfWorkers
+/// secondary GtpClients of the application's GtpEnginePool (see
+/// GtpEnginePool::reserveSecondaryClients:()). Each reserved GtpClient is
+/// driven by a worker thread. Secondary GTP engines are opt-in (user default
+/// NumberOfGtpEngines). If the application uses only the primary GTP engine,
+/// GtpBatchAnalyzer reserves the primary GtpClient instead (see
+/// GtpEnginePool::reservePrimaryClient()) and analyzes with a single worker
+/// thread. The primary GTP engine must not be needed by the application while
+/// it is reserved. GtpBatchAnalyzer never creates additional GTP engines
+/// and never submits "quit", because the GTP engines share the process with
+/// the application. The GTP engines are configured with the settings of a
+/// GtpEngineProfile, except that pondering is always off and territory
+/// statistics are always on. The memory limit and the subtree reuse setting
+/// come from the application's GtpEngineMemoryGovernor, not from the profile.
+/// stop() releases the GtpClients, which restores the configuration of the
+/// application, and in the case of the primary GTP engine also its board
+/// position and the pondering setting.
+///
+/// A game is described by its board size, the GTP setup commands that are
+/// sent after the board was cleared (komi, setup stones, setup player), and
+/// the moves of the game in the normalized form of GtpEnginePositionTracker
+/// (e.g. "B D4"). This is the same information that
+/// GtpEnginePositionTracker::commandsToReproducePosition() returns.
+/// analyzeGameWithSetupCommands:moves:boardSize:() analyzes the board position
+/// before the first move and after every move. The board positions are handed
+/// out to the worker threads in ascending order. Like SyncGTPEngineCommand,
+/// each worker thread asks the GtpEnginePositionTracker of its GtpClient which
+/// moves the GTP engine has already played, so that it usually only has to
+/// play the few moves that lie between the previous board position it
+/// analyzed and the next one, instead of replaying the game from the start.
+///
+/// For each board position the GTP engine first generates a move with
+/// "reg_genmove", which is the suggested move, then reports the territory
+/// statistics of that search with "uct_stat_territory". The estimated score is
+/// the sum of the territory statistics of all intersections, minus komi. This
+/// is an approximation, see GtpBatchAnalysisResult.
+///
+/// The results are the number of board positions analyzed, the elapsed time,
+/// and the GtpStatistics of the reserved GtpClients. report() formats the
+/// results as human-readable text.
+///
+/// Reserved GtpClients do not post public notifications, so the application's
+/// GTP log and other observers are not disturbed.
+// -----------------------------------------------------------------------------
+@interface GtpBatchAnalyzer : NSObject
+{
+}
+
+- (id) initWithProfile:(GtpEngineProfile*)profile;
+- (bool) start;
+- (NSArray*) analyzeGameWithSetupCommands:(NSArray*)setupCommands moves:(NSArray*)moves boardSize:(enum GoBoardSize)boardSize;
+- (void) stop;
+- (NSString*) report;
+
+/// @name Configuration
+//@{
+/// @brief The profile whose settings are used to configure the GTP engines.
+@property(nonatomic, retain, readonly) GtpEngineProfile* profile;
+/// @brief The number of GTP engines that analyze board positions in parallel.
+/// The default is 1. Is limited by the number of secondary GTP engines that
+/// are available, and is 1 if there are no secondary GTP engines. Changes have
+/// no effect after start() was invoked.
+@property(nonatomic, assign) int numberOfWorkers;
+/// @brief Is invoked after each board position, with the number of board
+/// positions of the current game that have been analyzed so far. Is invoked in
+/// the context of a secondary thread. The default is @e nil.
+@property(nonatomic, copy) void (^progressHandler)(int numberOfPositionsAnalyzed);
+//@}
+
+/// @name Results
+//@{
+/// @brief The number of board positions that have been analyzed since start()
+/// was invoked.
+@property(atomic, assign, readonly) int numberOfPositionsAnalyzed;
+/// @brief The number of board positions whose analysis failed since start()
+/// was invoked.
+@property(atomic, assign, readonly) int numberOfPositionsFailed;
+/// @brief The wall-clock time, in seconds, that was spent in
+/// analyzeGameWithSetupCommands:moves:boardSize:() since start() was invoked.
+@property(nonatomic, assign, readonly) NSTimeInterval elapsedTime;
+/// @brief Timing statistics of the GTP commands that were submitted since
+/// start() was invoked. Is @e nil before start() is invoked.
+@property(nonatomic, retain, readonly) GtpStatistics* statistics;
+//@}
+
+@end
@@ -0,0 +1,616 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+
+// Project includes
+#import "GtpBatchAnalyzer.h"
+#import "GtpClient.h"
+#import "GtpCommand.h"
+#import "GtpEngineMemoryGovernor.h"
+#import "GtpEnginePool.h"
+#import "GtpEnginePositionTracker.h"
+#import "GtpResponse.h"
+#import "GtpStatistics.h"
+#import "GtpUtilities.h"
+#import "../main/ApplicationDelegate.h"
+#import "../player/GtpEngineProfile.h"
+#import "../utility/ExceptionUtility.h"
+
+
+@implementation GtpBatchAnalysisResult
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpBatchAnalysisResult object that is not valid.
+///
+/// @note This is the designated initializer of GtpBatchAnalysisResult.
+// -----------------------------------------------------------------------------
+- (id) init
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.valid = false;
+  self.suggestedMove = nil;
+  self.estimatedScore = 0;
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GtpBatchAnalysisResult object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.suggestedMove = nil;
+  [super dealloc];
+}
+
+@end
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GtpBatchAnalyzer.
+// -----------------------------------------------------------------------------
+@interface GtpBatchAnalyzer()
+@property(nonatomic, retain, readwrite) GtpEngineProfile* profile;
+@property(atomic, assign, readwrite) int numberOfPositionsAnalyzed;
+@property(atomic, assign, readwrite) int numberOfPositionsFailed;
+@property(nonatomic, assign, readwrite) NSTimeInterval elapsedTime;
+@property(nonatomic, retain, readwrite) GtpStatistics* statistics;
+/// @brief The GtpClients that are reserved between start() and stop(). Is
+/// @e nil if the GtpClients are not reserved.
+@property(nonatomic, retain) NSArray* clients;
+/// @brief True if @e clients contains the primary GtpClient instead of
+/// secondary GtpClients.
+@property(nonatomic, assign) bool usesPrimaryClient;
+/// @brief The number of worker threads that the most recent invocation of
+/// start() has launched.
+@property(nonatomic, assign) int numberOfWorkersStarted;
+/// @name Properties that describe the game that is currently being analyzed.
+/// Access is protected by @e positionsCondition.
+//@{
+@property(nonatomic, retain) NSArray* setupCommands;
+@property(nonatomic, retain) NSArray* moves;
+@property(nonatomic, assign) enum GoBoardSize boardSize;
+@property(nonatomic, assign) double komi;
+@property(nonatomic, retain) NSMutableArray* results;
+@property(nonatomic, assign) int numberOfPositions;
+@property(nonatomic, assign) int numberOfPositionsStarted;
+@property(nonatomic, assign) int numberOfPositionsFinished;
+//@}
+/// @brief True if the worker threads should terminate. Access is protected by
+/// @e positionsCondition.
+@property(nonatomic, assign) bool stopRequested;
+/// @brief The number of worker threads that are still running. Access is
+/// protected by @e positionsCondition.
+@property(nonatomic, assign) int numberOfRunningThreads;
+/// @brief Is signalled when a new game is ready to be analyzed, when a board
+/// position has been analyzed, and when a worker thread terminates.
+@property(nonatomic, retain) NSCondition* positionsCondition;
+@end
+
+
+@implementation GtpBatchAnalyzer
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpBatchAnalyzer object that configures the GTP
+/// engines with the settings of @a profile.
+///
+/// @note This is the designated initializer of GtpBatchAnalyzer.
+///
+/// @exception NSInvalidArgumentException Is raised if @a profile is @e nil.
+// -----------------------------------------------------------------------------
+- (id) initWithProfile:(GtpEngineProfile*)profile
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  if (! profile)
+  {
+    [self release];
+    [ExceptionUtility throwInvalidArgumentExceptionWithErrorMessage:@"initWithProfile: failed: Profile is nil"];
+  }
+
+  self.profile = profile;
+  self.numberOfWorkers = 1;
+  self.progressHandler = nil;
+  self.numberOfPositionsAnalyzed = 0;
+  self.numberOfPositionsFailed = 0;
+  self.elapsedTime = 0;
+  self.statistics = nil;
+  self.clients = nil;
+  self.usesPrimaryClient = false;
+  self.numberOfWorkersStarted = 0;
+  self.setupCommands = nil;
+  self.moves = nil;
+  self.boardSize = GoBoardSizeUndefined;
+  self.komi = 0;
+  self.results = nil;
+  self.numberOfPositions = 0;
+  self.numberOfPositionsStarted = 0;
+  self.numberOfPositionsFinished = 0;
+  self.stopRequested = false;
+  self.numberOfRunningThreads = 0;
+  self.positionsCondition = [[[NSCondition alloc] init] autorelease];
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GtpBatchAnalyzer object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.profile = nil;
+  self.progressHandler = nil;
+  self.statistics = nil;
+  self.clients = nil;
+  self.setupCommands = nil;
+  self.moves = nil;
+  self.results = nil;
+  self.positionsCondition = nil;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Reserves secondary GTP engines of the application's GtpEnginePool,
+/// or the primary GTP engine if there are no secondary GTP engines, and
+/// launches the worker threads. Returns true on success, false if no GTP
+/// engine is available. Does nothing and returns true if the GTP engines are
+/// already reserved.
+///
+/// Must not be invoked in the context of the main thread, because this method
+/// waits until the reserved GTP engines have become idle.
+// -----------------------------------------------------------------------------
+- (bool) start
+{
+  if (self.clients)
+    return true;
+
+  GtpEnginePool* enginePool = [ApplicationDelegate sharedDelegate].gtpEnginePool;
+  NSArray* clients = [enginePool reserveSecondaryClients:MAX(1, self.numberOfWorkers)];
+  self.usesPrimaryClient = (0 == clients.count);
+  if (self.usesPrimaryClient)
+  {
+    GtpClient* primaryClient = [enginePool reservePrimaryClient];
+    if (! primaryClient)
+    {
+      DDLogError(@"%@: Neither a secondary nor the primary GTP engine is available", self);
+      self.usesPrimaryClient = false;
+      return false;
+    }
+    DDLogInfo(@"%@: No secondary GTP engine is available, analyzing on the primary GTP engine", self);
+    clients = @[primaryClient];
+  }
+
+  DDLogInfo(@"%@: Starting %lu workers", self, (unsigned long)clients.count);
+
+  self.clients = clients;
+  self.statistics = [[[GtpStatistics alloc] init] autorelease];
+  for (GtpClient* client in clients)
+    client.statistics = self.statistics;
+
+  self.numberOfPositionsAnalyzed = 0;
+  self.numberOfPositionsFailed = 0;
+  self.elapsedTime = 0;
+  self.stopRequested = false;
+  self.numberOfWorkersStarted = (int)clients.count;
+  self.numberOfRunningThreads = (int)clients.count;
+
+  for (GtpClient* client in clients)
+  {
+    NSThread* thread = [[[NSThread alloc] initWithTarget:self selector:@selector(analyzePositionsWithClient:) object:client] autorelease];
+    [thread start];
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Analyzes the board position before the first move and after every
+/// move of the game described by @a setupCommands, @a moves and
+/// @a boardSize. Blocks until all board positions have been analyzed.
+///
+/// Returns an array with GtpBatchAnalysisResult objects. The array has one
+/// element more than @a moves. The first element is the result for the board
+/// position before the first move, the element at index @e n is the result
+/// for the board position after move @e n.
+///
+/// Must not be invoked in the context of the main thread, because this method
+/// may block for a long time. start() must have been invoked before.
+///
+/// @exception NSInternalInconsistencyException Is raised if start() has not
+/// been invoked.
+// -----------------------------------------------------------------------------
+- (NSArray*) analyzeGameWithSetupCommands:(NSArray*)setupCommands moves:(NSArray*)moves boardSize:(enum GoBoardSize)boardSize
+{
+  if (! self.clients)
+    [ExceptionUtility throwInternalInconsistencyExceptionWithErrorMessage:@"analyzeGameWithSetupCommands:moves:boardSize: failed: GTP engines are not reserved"];
+
+  int numberOfPositions = (int)moves.count + 1;
+  NSMutableArray* results = [NSMutableArray arrayWithCapacity:numberOfPositions];
+  for (int indexOfPosition = 0; indexOfPosition < numberOfPositions; ++indexOfPosition)
+    [results addObject:[[[GtpBatchAnalysisResult alloc] init] autorelease]];
+
+  NSTimeInterval startTime = [NSProcessInfo processInfo].systemUptime;
+
+  [self.positionsCondition lock];
+  self.setupCommands = setupCommands;
+  self.moves = moves;
+  self.boardSize = boardSize;
+  self.komi = [GtpBatchAnalyzer komiInSetupCommands:setupCommands];
+  self.results = results;
+  self.numberOfPositions = numberOfPositions;
+  self.numberOfPositionsStarted = 0;
+  self.numberOfPositionsFinished = 0;
+  [self.positionsCondition broadcast];
+  while (self.numberOfPositionsFinished < numberOfPositions && self.numberOfRunningThreads > 0)
+    [self.positionsCondition wait];
+  self.setupCommands = nil;
+  self.moves = nil;
+  self.results = nil;
+  self.numberOfPositions = 0;
+  [self.positionsCondition unlock];
+
+  self.elapsedTime += [NSProcessInfo processInfo].systemUptime - startTime;
+  return results;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Terminates the worker threads and releases the GTP engines. Blocks
+/// until the worker threads have terminated. Does nothing if the GTP engines
+/// are not reserved.
+// -----------------------------------------------------------------------------
+- (void) stop
+{
+  if (! self.clients)
+    return;
+
+  [self.positionsCondition lock];
+  self.stopRequested = true;
+  [self.positionsCondition broadcast];
+  while (self.numberOfRunningThreads > 0)
+    [self.positionsCondition wait];
+  [self.positionsCondition unlock];
+
+  // Territory statistics are off unless the application has turned them on,
+  // in which case releasing the GTP engines turns them on again
+  for (GtpClient* client in self.clients)
+    [client submit:[GtpCommand command:@"uct_param_globalsearch territory_statistics 0"]];
+  GtpEnginePool* enginePool = [ApplicationDelegate sharedDelegate].gtpEnginePool;
+  if (self.usesPrimaryClient)
+  {
+    [enginePool releasePrimaryClient:self.clients.firstObject];
+    [GtpUtilities restorePondering];
+  }
+  else
+  {
+    [enginePool releaseSecondaryClients:self.clients];
+  }
+  self.clients = nil;
+  self.usesPrimaryClient = false;
+
+  DDLogInfo(@"%@: Finished\n%@", self, [self report]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the results collected since start() was invoked as
+/// human-readable text.
+// -----------------------------------------------------------------------------
+- (NSString*) report
+{
+  NSTimeInterval elapsedTime = self.elapsedTime;
+  double positionsPerSecond = 0;
+  if (elapsedTime > 0)
+    positionsPerSecond = self.numberOfPositionsAnalyzed / elapsedTime;
+
+  NSMutableString* report = [NSMutableString string];
+  [report appendFormat:@"Profile: %@\n", self.profile.name];
+  [report appendFormat:@"Workers: %d\n", self.numberOfWorkersStarted];
+  [report appendFormat:@"Analysis time: %.3f s\n", elapsedTime];
+  [report appendFormat:@"Positions: %d (%.2f/s), failed: %d\n", self.numberOfPositionsAnalyzed, positionsPerSecond, self.numberOfPositionsFailed];
+  if (self.statistics && [self.statistics countForCommandName:@"reg_genmove"] > 0)
+  {
+    [report appendFormat:@"Position latency: p50 %.3f s, p95 %.3f s, p99 %.3f s\n",
+     [self.statistics percentile:50 ofStage:GtpCommandStageTotal forCommandName:@"reg_genmove"],
+     [self.statistics percentile:95 ofStage:GtpCommandStageTotal forCommandName:@"reg_genmove"],
+     [self.statistics percentile:99 ofStage:GtpCommandStageTotal forCommandName:@"reg_genmove"]];
+  }
+  if (self.statistics)
+    [report appendFormat:@"\n%@", [self.statistics report]];
+  return report;
+}
+
+#pragma mark - Private helpers
+
+// -----------------------------------------------------------------------------
+/// @brief Thread entry point. Analyzes board positions using @a client until
+/// stop() is invoked.
+// -----------------------------------------------------------------------------
+- (void) analyzePositionsWithClient:(GtpClient*)client
+{
+  // Create an autorelease pool as the very first thing in this thread
+  NSAutoreleasePool* mainPool = [[NSAutoreleasePool alloc] init];
+
+  [client submit:[GtpCommand command:@"uct_param_player ponder 0"]];
+  [client submit:[GtpCommand command:@"uct_param_globalsearch territory_statistics 1"]];
+  enum GoBoardSize configuredBoardSize = GoBoardSizeUndefined;
+
+  while (true)
+  {
+    NSAutoreleasePool* positionPool = [[NSAutoreleasePool alloc] init];
+
+    [self.positionsCondition lock];
+    while (! self.stopRequested && self.numberOfPositionsStarted >= self.numberOfPositions)
+      [self.positionsCondition wait];
+    if (self.stopRequested)
+    {
+      [self.positionsCondition unlock];
+      [positionPool drain];
+      break;
+    }
+    int indexOfPosition = self.numberOfPositionsStarted++;
+    NSArray* setupCommands = [[self.setupCommands retain] autorelease];
+    NSArray* moves = [[self.moves retain] autorelease];
+    enum GoBoardSize boardSize = self.boardSize;
+    double komi = self.komi;
+    GtpBatchAnalysisResult* result = [[[self.results objectAtIndex:indexOfPosition] retain] autorelease];
+    [self.positionsCondition unlock];
+
+    bool forceFullSetup = false;
+    if (boardSize != configuredBoardSize)
+    {
+      GtpEngineMemoryGovernor* memoryGovernor = [ApplicationDelegate sharedDelegate].gtpEngineMemoryGovernor;
+      for (NSString* commandString in [self.profile engineConfigurationCommandsForBoardSize:boardSize memoryGovernor:memoryGovernor])
+        [client submit:[GtpCommand command:commandString]];
+      configuredBoardSize = boardSize;
+      forceFullSetup = true;
+    }
+
+    NSArray* movesUpToPosition = [moves subarrayWithRange:NSMakeRange(0, indexOfPosition)];
+    if ([self setupPosition:movesUpToPosition setupCommands:setupCommands boardSize:boardSize client:client forceFullSetup:forceFullSetup])
+    {
+      NSString* color = [GtpBatchAnalyzer colorOfNextMoveAfterMoves:movesUpToPosition inGame:moves setupCommands:setupCommands];
+      [self analyzePositionWithClient:client color:color boardSize:boardSize komi:komi result:result];
+    }
+    else
+    {
+      DDLogError(@"%@: Failed to set up board position %d", self, indexOfPosition);
+    }
+
+    @synchronized(self)
+    {
+      if (result.valid)
+        self.numberOfPositionsAnalyzed++;
+      else
+        self.numberOfPositionsFailed++;
+    }
+
+    // The result is complete, analyzeGameWithSetupCommands:moves:boardSize:()
+    // may return it as soon as the lock is released
+    int numberOfPositionsFinished;
+    [self.positionsCondition lock];
+    numberOfPositionsFinished = ++self.numberOfPositionsFinished;
+    [self.positionsCondition broadcast];
+    [self.positionsCondition unlock];
+
+    if (self.progressHandler)
+      self.progressHandler(numberOfPositionsFinished);
+
+    [positionPool drain];
+  }
+
+  [mainPool drain];
+
+  [self.positionsCondition lock];
+  self.numberOfRunningThreads--;
+  [self.positionsCondition broadcast];
+  [self.positionsCondition unlock];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for analyzePositionsWithClient:(). Brings the GTP
+/// engine behind @a client to the board position that results from playing
+/// @a moves on top of @a setupCommands. Returns true on success, false on
+/// failure.
+///
+/// If the GTP engine was set up with the same @a setupCommands, and unless
+/// @a forceFullSetup is true, the GTP engine takes back the moves that are not
+/// shared with @a moves and then plays the remaining moves. Otherwise, or if
+/// this fails, the board is set up from scratch.
+// -----------------------------------------------------------------------------
+- (bool) setupPosition:(NSArray*)moves
+         setupCommands:(NSArray*)setupCommands
+             boardSize:(enum GoBoardSize)boardSize
+                client:(GtpClient*)client
+        forceFullSetup:(bool)forceFullSetup
+{
+  NSArray* movesInGtpEngine = nil;
+  if (! forceFullSetup)
+    movesInGtpEngine = [client.positionTracker movesIfSetupCommandsMatch:setupCommands];
+
+  if (movesInGtpEngine)
+  {
+    NSUInteger numberOfCommonMoves = 0;
+    NSUInteger maximumNumberOfCommonMoves = MIN(movesInGtpEngine.count, moves.count);
+    while (numberOfCommonMoves < maximumNumberOfCommonMoves &&
+           [movesInGtpEngine[numberOfCommonMoves] isEqualToString:moves[numberOfCommonMoves]])
+    {
+      numberOfCommonMoves++;
+    }
+
+    bool success = true;
+    NSUInteger numberOfMovesToUndo = movesInGtpEngine.count - numberOfCommonMoves;
+    if (numberOfMovesToUndo > 0)
+    {
+      NSString* commandString = [NSString stringWithFormat:@"gg-undo %lu", (unsigned long)numberOfMovesToUndo];
+      success = [self submitCommandString:commandString client:client];
+    }
+    if (success)
+    {
+      NSArray* movesToPlay = [moves subarrayWithRange:NSMakeRange(numberOfCommonMoves, moves.count - numberOfCommonMoves)];
+      success = [self playMoves:movesToPlay client:client];
+    }
+    if (success)
+      return true;
+  }
+
+  // "boardsize" also clears the board
+  NSString* boardSizeCommandString = [NSString stringWithFormat:@"boardsize %d", boardSize];
+  if (! [self submitCommandString:boardSizeCommandString client:client])
+    return false;
+  for (NSString* setupCommand in setupCommands)
+  {
+    if (! [self submitCommandString:setupCommand client:client])
+      return false;
+  }
+  return [self playMoves:moves client:client];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for setupPosition:setupCommands:boardSize:client:forceFullSetup:().
+/// Plays @a moves in a single "gogui-play_sequence" command. Returns true on
+/// success, false on failure.
+// -----------------------------------------------------------------------------
+- (bool) playMoves:(NSArray*)moves client:(GtpClient*)client
+{
+  if (moves.count == 0)
+    return true;
+
+  NSMutableString* commandString = [NSMutableString stringWithString:@"gogui-play_sequence"];
+  for (NSString* move in moves)
+    [commandString appendFormat:@" %@", move];
+  return [self submitCommandString:commandString client:client];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for analyzePositionsWithClient:(). Lets the GTP
+/// engine behind @a client analyze the board position it currently has, with
+/// @a color to move. Stores the results in @a result.
+// -----------------------------------------------------------------------------
+- (void) analyzePositionWithClient:(GtpClient*)client
+                             color:(NSString*)color
+                         boardSize:(enum GoBoardSize)boardSize
+                              komi:(double)komi
+                            result:(GtpBatchAnalysisResult*)result
+{
+  GtpCommand* genmoveCommand = [GtpCommand command:[@"reg_genmove " stringByAppendingString:color]];
+  [client submit:genmoveCommand];
+  if (! genmoveCommand.response.status)
+  {
+    DDLogError(@"%@: %@ failed, response = %@", self, genmoveCommand.command, genmoveCommand.response.parsedResponse);
+    return;
+  }
+
+  struct GoVertexNumeric vertex;
+  enum GtpMoveResponseType moveResponseType = [genmoveCommand.response decodeMove:&vertex];
+  if (GtpMoveResponseTypeInvalid == moveResponseType)
+  {
+    DDLogError(@"%@: %@ returned an invalid move, response = %@", self, genmoveCommand.command, genmoveCommand.response.parsedResponse);
+    return;
+  }
+
+  GtpCommand* territoryCommand = [GtpCommand command:@"uct_stat_territory"];
+  [client submit:territoryCommand];
+  if (! territoryCommand.response.status)
+  {
+    DDLogError(@"%@: %@ failed, response = %@", self, territoryCommand.command, territoryCommand.response.parsedResponse);
+    return;
+  }
+
+  int numberOfScores = boardSize * boardSize;
+  float scores[numberOfScores];
+  if (! [territoryCommand.response decodeFloatGrid:scores numberOfRows:boardSize numberOfColumns:boardSize])
+  {
+    DDLogError(@"%@: GTP response does not contain %d lines with %d elements each", self, boardSize, boardSize);
+    return;
+  }
+
+  // Each score is between -1 (the intersection certainly belongs to White)
+  // and 1 (the intersection certainly belongs to Black), so the sum is the
+  // expected difference in area. This is only an approximation of the score,
+  // see the documentation of GtpBatchAnalysisResult.
+  double estimatedArea = 0;
+  for (int indexOfScore = 0; indexOfScore < numberOfScores; ++indexOfScore)
+    estimatedArea += scores[indexOfScore];
+
+  result.suggestedMove = [genmoveCommand.response.parsedResponse uppercaseString];
+  if (GtpMoveResponseTypeResign == moveResponseType)
+    result.suggestedMove = @"resign";
+  result.estimatedScore = estimatedArea - komi;
+  result.valid = true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Submits the GTP command @a commandString
+/// synchronously to @a client. Returns true on success, false on failure.
+// -----------------------------------------------------------------------------
+- (bool) submitCommandString:(NSString*)commandString client:(GtpClient*)client
+{
+  GtpCommand* command = [GtpCommand command:commandString];
+  [client submit:command];
+  if (! command.response.status)
+    DDLogError(@"%@: %@ failed, response = %@", self, commandString, command.response.parsedResponse);
+  return command.response.status;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns the GTP color ("B" or "W") of the player who
+/// is to move after @a movesUpToPosition have been played. @a moves are all
+/// moves of the game, of which @a movesUpToPosition is a prefix.
+///
+/// If the game continues after @a movesUpToPosition, the color is the one
+/// that actually played the next move in the game. Otherwise the color is the
+/// opposite of the last move's color, or, if no moves were played at all, the
+/// setup player, or Black if there is no setup player.
+// -----------------------------------------------------------------------------
++ (NSString*) colorOfNextMoveAfterMoves:(NSArray*)movesUpToPosition inGame:(NSArray*)moves setupCommands:(NSArray*)setupCommands
+{
+  if (movesUpToPosition.count < moves.count)
+    return [moves[movesUpToPosition.count] substringToIndex:1];
+
+  NSString* lastMove = movesUpToPosition.lastObject;
+  if (lastMove)
+    return [lastMove hasPrefix:@"B"] ? @"W" : @"B";
+
+  for (NSString* setupCommand in setupCommands)
+  {
+    if ([setupCommand hasPrefix:@"gogui-setup_player "])
+      return [[setupCommand substringFromIndex:@"gogui-setup_player ".length] uppercaseString];
+  }
+  return @"B";
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns the komi that is set up by the "komi"
+/// command in @a setupCommands. Returns 0 if there is no such command.
+// -----------------------------------------------------------------------------
++ (double) komiInSetupCommands:(NSArray*)setupCommands
+{
+  for (NSString* setupCommand in setupCommands)
+  {
+    if ([setupCommand hasPrefix:@"komi "])
+      return [[setupCommand substringFromIndex:@"komi ".length] doubleValue];
+  }
+  return 0;
+}
+
+@end
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2019 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -20,6 +20,8 @@
 
 // Forward declarations
 @class GtpCommand;
+@class GtpEnginePositionTracker;
+@class GtpStatistics;
 
 
 // -----------------------------------------------------------------------------
@@ -72,6 +74,34 @@
 ///
 /// Specification of a response target is optional. If no response target is
 /// specified for a GtpCommand, no private notification is sent.
+///
+///
+/// @par Command queue
+///
+/// Submitted commands are placed into a queue. The secondary thread takes the
+/// command with the highest priority out of the queue when it is ready to
+/// process the next command. Commands with the same priority are processed in
+/// the order in which they were submitted. See GtpCommand's @e priority
+/// property.
+///
+/// A command is dropped instead of being passed on to the GtpEngine if it is
+/// cancelled while it is still in the queue, or if a newer command with the
+/// same coalescing key is submitted (see GtpCommand's @e coalescingKey
+/// property). GtpClient generates a response with status "failed" for a
+/// dropped command and notifies the response target, but no public
+/// notifications are sent for a dropped command.
+///
+/// The properties @e numberOfPendingCommands,
+/// @e maximumNumberOfPendingCommands and @e numberOfDroppedCommands are metrics
+/// that are displayed in the diagnostics view.
+///
+///
+/// @par Board position tracking
+///
+/// GtpClient lets its GtpEnginePositionTracker know about every response that
+/// it receives, before it notifies anyone else. Clients that want to know
+/// which board position the GtpEngine currently has can query the tracker
+/// via the property @e positionTracker.
 // -----------------------------------------------------------------------------
 @interface GtpClient : NSObject
 {
@@ -80,9 +110,45 @@
 + (GtpClient*) clientWithStreamBuffers:(NSArray*)streamBuffers;
 - (void) submit:(GtpCommand*)command;
 - (void) interrupt;
+- (void) cancelCommandsWithCoalescingKey:(NSString*)coalescingKey;
 
 /// @brief Set this property to true to trigger termination of the secondary
 /// thread.
 @property(assign, getter=shouldExit, setter=exit:) bool shouldExit;
 
+/// @brief The number of times that interrupt() has been invoked so far.
+///
+/// Clients that submit a series of commands can compare the value of this
+/// property before and after a command to find out whether the user has
+/// interrupted the GtpEngine in the meantime.
+@property(assign, readonly) unsigned int numberOfInterrupts;
+
+/// @brief The number of commands that are currently waiting in the queue to be
+/// processed. The command that is currently being processed is not counted.
+@property(assign, readonly) int numberOfPendingCommands;
+
+/// @brief The largest value that @e numberOfPendingCommands has had so far.
+@property(assign, readonly) int maximumNumberOfPendingCommands;
+
+/// @brief The number of commands that were dropped so far because they were
+/// cancelled or superseded before they could be processed.
+@property(assign, readonly) int numberOfDroppedCommands;
+
+/// @brief The object that keeps track of the GtpEngine's board position.
+@property(retain, readonly) GtpEnginePositionTracker* positionTracker;
+
+/// @brief The object that records timing statistics of the commands that have
+/// been processed. No statistics are recorded if this is @e nil. The default
+/// is @e nil.
+@property(retain) GtpStatistics* statistics;
+
+/// @brief True if GtpClient posts the public notifications
+/// #gtpCommandWillBeSubmitted and #gtpResponseWasReceived. The default is
+/// true.
+///
+/// GtpClients whose GtpEngine is not used to play the application's game
+/// (e.g. the ones used by GtpMatchRunner) set this to false, so that observers
+/// such as the GTP log do not see their commands.
+@property(assign) bool postsNotifications;
+
 @end
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2019 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -25,24 +25,50 @@
 // Project includes
 #import "GtpClient.h"
 #import "GtpCommand.h"
+#import "GtpEnginePositionTracker.h"
 #import "GtpResponse.h"
+#import "GtpStatistics.h"
 
 // System includes
+#include <cstring>
 #include <istream>
 #include <ostream>
 #include <streambuf>
-
-// It would be much nicer to make these variables members of the GtpClient
-// class, but they are C++ and GtpClient.h is also #import'ed by pure
-// Objective-C implementations.
-static std::ostream* commandStream = nullptr;
-static std::istream* responseStream = nullptr;
+#include <string>
 
 // -----------------------------------------------------------------------------
 /// @brief Class extension with private properties for GtpClient.
+///
+/// The streams are member variables of the class extension, not of the public
+/// interface, because they are C++ and GtpClient.h is also #import'ed by pure
+/// Objective-C implementations. They must not be static because more than one
+/// GtpClient can exist at the same time (see GtpEnginePool).
 // -----------------------------------------------------------------------------
 @interface GtpClient()
+{
+@private
+  /// @brief Stream to write commands for the GTP engine. Points to an object
+  /// that lives on the stack of the secondary thread's main loop.
+  std::ostream* commandStream;
+  /// @brief Stream to read responses from the GTP engine. Points to an object
+  /// that lives on the stack of the secondary thread's main loop.
+  std::istream* responseStream;
+}
 @property(retain) NSThread* thread;
+@property(retain, readwrite) GtpEnginePositionTracker* positionTracker;
+@property(assign, readwrite) unsigned int numberOfInterrupts;
+@property(assign, readwrite) int maximumNumberOfPendingCommands;
+@property(assign, readwrite) int numberOfDroppedCommands;
+/// @brief The queue with commands that are waiting to be processed, ordered by
+/// priority. Access is protected by @e queueCondition.
+@property(retain) NSMutableArray* pendingCommands;
+/// @brief The command that is currently being processed, or @e nil. Access is
+/// protected by @e queueCondition.
+@property(retain) GtpCommand* currentCommand;
+/// @brief Protects access to @e pendingCommands and @e currentCommand. Is
+/// signalled whenever a command is removed from the queue or has finished
+/// processing, so that synchronous submitters can wake up.
+@property(retain) NSCondition* queueCondition;
 @end
 
 
@@ -71,7 +97,18 @@ static std::istream* responseStream = nullptr;
   if (! self)
     return nil;
 
+  commandStream = nullptr;
+  responseStream = nullptr;
   self.shouldExit = false;
+  self.numberOfInterrupts = 0;
+  self.maximumNumberOfPendingCommands = 0;
+  self.numberOfDroppedCommands = 0;
+  self.pendingCommands = [NSMutableArray array];
+  self.currentCommand = nil;
+  self.queueCondition = [[[NSCondition alloc] init] autorelease];
+  self.statistics = nil;
+  self.postsNotifications = true;
+  self.positionTracker = [[[GtpEnginePositionTracker alloc] init] autorelease];
 
   // Create and start the thread
   self.thread = [[[NSThread alloc] initWithTarget:self selector:@selector(mainLoop:) object:streamBuffers] autorelease];
@@ -91,6 +128,11 @@ static std::istream* responseStream = nullptr;
 {
   // TODO implement stuff
   self.thread = nil;
+  self.positionTracker = nil;
+  self.pendingCommands = nil;
+  self.currentCommand = nil;
+  self.queueCondition = nil;
+  self.statistics = nil;
   [super dealloc];
 }
 
@@ -139,7 +181,7 @@ static std::istream* responseStream = nullptr;
   }
 
   // The local objects are auto-destroyed when they go out of scope. Here we
-  // forget the global references to these local objects
+  // forget the references to these local objects
   commandStream = nullptr;
   responseStream = nullptr;
 
@@ -147,6 +189,52 @@ static std::istream* responseStream = nullptr;
   [mainPool drain];
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Takes the command with the highest priority out of the queue and
+/// processes it. This method is executed in the secondary thread's context.
+///
+/// Commands that were cancelled while they were waiting in the queue are
+/// dropped. Does nothing if the queue is empty, which happens if commands
+/// were dropped before this method was invoked.
+// -----------------------------------------------------------------------------
+- (void) processNextCommand
+{
+  NSMutableArray* droppedCommands = [NSMutableArray array];
+  GtpCommand* command = nil;
+
+  [self.queueCondition lock];
+  while (self.pendingCommands.count > 0)
+  {
+    GtpCommand* nextCommand = [[[self.pendingCommands objectAtIndex:0] retain] autorelease];
+    [self.pendingCommands removeObjectAtIndex:0];
+    if (nextCommand.isCancelled)
+    {
+      [self dropCommand:nextCommand];
+      [droppedCommands addObject:nextCommand];
+    }
+    else
+    {
+      command = nextCommand;
+      break;
+    }
+  }
+  self.currentCommand = command;
+  if (droppedCommands.count > 0)
+    [self.queueCondition broadcast];
+  [self.queueCondition unlock];
+
+  [self notifyResponseTargetsOfDroppedCommands:droppedCommands];
+  if (! command)
+    return;
+
+  [self processCommand:command];
+
+  [self.queueCondition lock];
+  self.currentCommand = nil;
+  [self.queueCondition broadcast];
+  [self.queueCondition unlock];
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Processes the GTP command @a command. This method is executed in the
 /// secondary thread's context.
@@ -156,44 +244,58 @@ static std::istream* responseStream = nullptr;
 /// - Wait for the response from the GtpEngine (blocks)
 /// - Creates a GtpResponse object using the response received from the
 ///   GtpEngine
+/// - Lets the GtpEnginePositionTracker know about the response
 /// - If requested, invokes notifyResponseTarget:() to notify an observer
 ///   object that the response has been received; the notification occurs in
 ///   the context of the thread that submitted the command
 // -----------------------------------------------------------------------------
 - (void) processCommand:(GtpCommand*)command
 {
-  // Undo retain message sent to the command object by submit:()
-  [command autorelease];
+  command.processingStartTime = [NSProcessInfo processInfo].systemUptime;
 
   // Notify observers in the secondary thread context
-  [[NSNotificationCenter defaultCenter] postNotificationName:gtpCommandWillBeSubmittedNotification
-                                                      object:command];
+  if (self.postsNotifications)
+  {
+    [[NSNotificationCenter defaultCenter] postNotificationName:gtpCommandWillBeSubmittedNotification
+                                                        object:command];
+  }
 
   // Send the command to the engine
   if (nil == command.command || 0 == [command.command length])
     return;
   const char* pchCommand = [command.command cStringUsingEncoding:[NSString defaultCStringEncoding]];
   (*commandStream) << pchCommand << std::endl;  // this wakes up the engine
-  
-  // Read the engine's response (blocking if necessary)
-  std::string fullResponse;
+  command.writeEndTime = [NSProcessInfo processInfo].systemUptime;
+
+  // Read the engine's response (blocking if necessary). The lines are appended
+  // directly to the byte buffer that is handed over to GtpResponse, without
+  // converting the response to an NSString. GtpResponse creates the string
+  // only if someone asks for it, and clients with a performance-critical
+  // response format use its typed decoding methods instead.
+  NSMutableData* responseData = [NSMutableData data];
   std::string singleLineResponse;
   while (true)
   {
     getline(*responseStream, singleLineResponse);
+    if (0 == command.firstResponseLineTime)
+      command.firstResponseLineTime = [NSProcessInfo processInfo].systemUptime;
     if (singleLineResponse.empty())
       break;
-    if (! fullResponse.empty())
-      fullResponse += "\n";
-    fullResponse += singleLineResponse;
+    if (responseData.length > 0)
+      [responseData appendBytes:"\n" length:1];
+    [responseData appendBytes:singleLineResponse.data() length:singleLineResponse.size()];
   }
+  command.responseEndTime = [NSProcessInfo processInfo].systemUptime;
 
   // Create the response object
-  NSString* nsResponse = [NSString stringWithCString:fullResponse.c_str()
-                                            encoding:[NSString defaultCStringEncoding]];
-  GtpResponse* response = [GtpResponse response:nsResponse toCommand:command];
+  GtpResponse* response = [GtpResponse responseWithData:responseData toCommand:command];
   command.response = response;
 
+  // Must happen before anyone is notified, especially before a synchronous
+  // submitter is unblocked, so that the tracked board position is always up
+  // to date from the point of view of the submitter
+  [self.positionTracker trackResponse:response];
+
   if (response.command.responseTarget)
   {
     // Retain to make sure that object is still alive when it "arrives" in
@@ -207,10 +309,19 @@ static std::istream* responseStream = nullptr;
                withObject:command
             waitUntilDone:NO];
   }
+  else
+  {
+    // Commands with a response target are recorded when the response target
+    // is notified, so that the callback stage can be measured
+    [self.statistics recordCommand:command];
+  }
 
   // Notify observers in the secondary thread context
-  [[NSNotificationCenter defaultCenter] postNotificationName:gtpResponseWasReceivedNotification
-                                                      object:response];
+  if (self.postsNotifications)
+  {
+    [[NSNotificationCenter defaultCenter] postNotificationName:gtpResponseWasReceivedNotification
+                                                        object:response];
+  }
 
   if (NSOrderedSame == [command.command compare:@"quit"])
   {
@@ -227,24 +338,151 @@ static std::istream* responseStream = nullptr;
 /// context. One notable example where this is executed in a secondary thread's
 /// context is the backup task just before the application is suspended.
 ///
+/// The command is placed into the queue according to its priority. If the
+/// command has a coalescing key, all pending commands with the same coalescing
+/// key are dropped.
+///
 /// If @a command.waitUntilDone is false, this method returns immediately and
 /// does not wait for the GtpEngine's response.
 // -----------------------------------------------------------------------------
 - (void) submit:(GtpCommand*)command
 {
+  // Waiting for the secondary thread while in the secondary thread's context
+  // would block forever
+  assert(! command.waitUntilDone || [NSThread currentThread] != self.thread);
+
   command.submittingThread = [NSThread currentThread];
-  // Retain to make sure that object is still alive when it "arrives" in
-  // the secondary thread
-  [command retain];
-  [self performSelector:@selector(processCommand:)
+  command.submissionTime = [NSProcessInfo processInfo].systemUptime;
+
+  [self.queueCondition lock];
+  NSArray* droppedCommands = [self dropPendingCommandsWithCoalescingKey:command.coalescingKey];
+  NSUInteger index = self.pendingCommands.count;
+  while (index > 0 && ((GtpCommand*)[self.pendingCommands objectAtIndex:index - 1]).priority < command.priority)
+    index--;
+  [self.pendingCommands insertObject:command atIndex:index];
+  int numberOfPendingCommands = (int)self.pendingCommands.count;
+  if (numberOfPendingCommands > self.maximumNumberOfPendingCommands)
+    self.maximumNumberOfPendingCommands = numberOfPendingCommands;
+  [self.queueCondition unlock];
+
+  [self notifyResponseTargetsOfDroppedCommands:droppedCommands];
+
+  // Every submitted command triggers exactly one invocation of
+  // processNextCommand(). Because commands can be dropped, but never added
+  // without such a trigger, the queue can never contain a command for which
+  // no invocation is pending.
+  [self performSelector:@selector(processNextCommand)
                onThread:self.thread
-             withObject:command
-          waitUntilDone:command.waitUntilDone];
+             withObject:nil
+          waitUntilDone:NO];
+
+  if (command.waitUntilDone)
+  {
+    [self.queueCondition lock];
+    while (self.currentCommand == command || NSNotFound != [self.pendingCommands indexOfObjectIdenticalTo:command])
+      [self.queueCondition wait];
+    [self.queueCondition unlock];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Drops all commands with coalescing key @a coalescingKey that are
+/// waiting in the queue. Commands that are already being processed are not
+/// affected.
+///
+/// This method can be invoked from any thread.
+// -----------------------------------------------------------------------------
+- (void) cancelCommandsWithCoalescingKey:(NSString*)coalescingKey
+{
+  [self.queueCondition lock];
+  NSArray* droppedCommands = [self dropPendingCommandsWithCoalescingKey:coalescingKey];
+  [self.queueCondition unlock];
+  [self notifyResponseTargetsOfDroppedCommands:droppedCommands];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Removes all commands with coalescing key
+/// @a coalescingKey from the queue and drops them. Returns the dropped
+/// commands. Returns an empty array if @a coalescingKey is @e nil.
+///
+/// The caller must hold the lock of @e queueCondition.
+// -----------------------------------------------------------------------------
+- (NSArray*) dropPendingCommandsWithCoalescingKey:(NSString*)coalescingKey
+{
+  NSMutableArray* droppedCommands = [NSMutableArray array];
+  if (! coalescingKey)
+    return droppedCommands;
+  for (GtpCommand* pendingCommand in self.pendingCommands)
+  {
+    if ([pendingCommand.coalescingKey isEqualToString:coalescingKey])
+      [droppedCommands addObject:pendingCommand];
+  }
+  if (droppedCommands.count == 0)
+    return droppedCommands;
+  for (GtpCommand* droppedCommand in droppedCommands)
+  {
+    [self.pendingCommands removeObjectIdenticalTo:droppedCommand];
+    [self dropCommand:droppedCommand];
+  }
+  [self.queueCondition broadcast];
+  return droppedCommands;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Marks @a command as cancelled and generates a
+/// response with status "failed". @a command must already have been removed
+/// from the queue.
+///
+/// The caller must hold the lock of @e queueCondition. The response is
+/// generated while the lock is held so that a synchronous submitter that wakes
+/// up when the command disappears from the queue always finds a response.
+// -----------------------------------------------------------------------------
+- (void) dropCommand:(GtpCommand*)command
+{
+  DDLogInfo(@"Dropping %@", command);
+  [command cancel];
+  const char* responseBytes = "? command was dropped before it was processed";
+  NSData* responseData = [NSData dataWithBytes:responseBytes length:strlen(responseBytes)];
+  command.response = [GtpResponse responseWithData:responseData toCommand:command];
+  self.numberOfDroppedCommands = self.numberOfDroppedCommands + 1;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Notifies the response targets of the dropped
+/// commands in @a droppedCommands in the context of the thread that submitted
+/// the respective command.
+// -----------------------------------------------------------------------------
+- (void) notifyResponseTargetsOfDroppedCommands:(NSArray*)droppedCommands
+{
+  for (GtpCommand* droppedCommand in droppedCommands)
+  {
+    if (! droppedCommand.responseTarget)
+      continue;
+    // Retain to make sure that object is still alive when it "arrives" in
+    // the submitting thread
+    [droppedCommand retain];
+    [self performSelector:@selector(notifyResponseTarget:)
+                 onThread:droppedCommand.submittingThread
+               withObject:droppedCommand
+            waitUntilDone:NO];
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (int) numberOfPendingCommands
+{
+  [self.queueCondition lock];
+  int numberOfPendingCommands = (int)self.pendingCommands.count;
+  [self.queueCondition unlock];
+  return numberOfPendingCommands;
 }
 
 // -----------------------------------------------------------------------------
 /// @brief Notifies the observer object @e command.responseTarget that a
-/// response to @a command has been received from the GtpEngine.
+/// response to @a command has been received from the GtpEngine, or that
+/// @a command has been dropped.
 ///
 /// The method invoked is @e command.responseTargetSelector, the argument
 /// passed is the GtpResponse object.
@@ -254,11 +492,15 @@ static std::istream* responseStream = nullptr;
 // -----------------------------------------------------------------------------
 - (void) notifyResponseTarget:(GtpCommand*)command
 {
-  // Undo retain message sent to the command object by processCommand:()
+  // Undo retain message sent to the command object by processCommand:() or
+  // notifyResponseTargetsOfDroppedCommands:()
   [command autorelease];
   id responseTarget = command.responseTarget;
   if (responseTarget)
   {
+    command.responseTargetNotificationTime = [NSProcessInfo processInfo].systemUptime;
+    // Does nothing for dropped commands, which have never been processed
+    [self.statistics recordCommand:command];
     [responseTarget performSelector:command.responseTargetSelector
                          withObject:command.response];
   }
@@ -292,6 +534,7 @@ static std::istream* responseStream = nullptr;
 {
   const char* pchCommand = "# interrupt";
   (*commandStream) << pchCommand << std::endl;
+  self.numberOfInterrupts = self.numberOfInterrupts + 1;
 }
 
 @end
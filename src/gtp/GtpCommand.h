@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -19,6 +19,38 @@
 @class GtpResponse;
 
 
+/// @brief Enumerates the kinds of GTP commands that GtpEnginePool
+/// distinguishes when it decides which GTP engine processes a command.
+enum GtpCommandKind
+{
+  /// @brief The command belongs to the game that is being played, or it
+  /// configures the GTP engine. The command is always processed by the primary
+  /// GTP engine.
+  GtpCommandKindGame,
+  /// @brief The command analyzes the current board position (e.g. a move
+  /// suggestion or territory statistics). The command may be processed by a
+  /// secondary GTP engine that has been set up with the board position of the
+  /// primary GTP engine.
+  GtpCommandKindAnalysis
+};
+
+/// @brief Enumerates the priorities that GtpClient uses to order GTP commands
+/// that are waiting to be processed.
+enum GtpCommandPriority
+{
+  /// @brief The command is processed after all pending commands with a higher
+  /// priority. Use this only for commands whose result is not important if it
+  /// refers to a board position that is no longer current (e.g. intermediate
+  /// territory statistics).
+  GtpCommandPriorityLow,
+  /// @brief The default priority.
+  GtpCommandPriorityNormal,
+  /// @brief The command is processed before all pending commands with a lower
+  /// priority.
+  GtpCommandPriorityHigh
+};
+
+
 // -----------------------------------------------------------------------------
 /// @brief The GtpCommand class represents a Go Text Protocol (GTP) command.
 ///
@@ -28,14 +60,24 @@
 /// command, including all of the command's arguments.
 ///
 /// GtpCommand conveniently knows how to submit itself to the application's
-/// GtpClient, thus clients do not have to concern themselves with where to
-/// obtain a GtpClient instance.
+/// GtpEnginePool, thus clients do not have to concern themselves with where to
+/// obtain a GtpClient instance. The GtpEnginePool selects the GtpClient based
+/// on the command's @e kind.
 ///
 /// GtpCommand can be executed synchronously (the default) or asynchronously.
 /// In the latter case, a target object and selector may be specified that
 /// are invoked when the response to the command has been received. This
 /// callback always occurs in the context of the thread that the command was
 /// submitted in.
+///
+/// GtpClient does not necessarily process commands in the order in which they
+/// are submitted. A command with a higher @e priority overtakes pending
+/// commands with a lower priority. A command that is still pending can be
+/// dropped, either because it is cancelled explicitly, or because a newer
+/// command with the same @e coalescingKey is submitted. A dropped command never
+/// reaches the GTP engine. Its response is generated by GtpClient and has
+/// the status "failed". The response target is notified as usual, and a
+/// synchronous submitter is unblocked as usual.
 // -----------------------------------------------------------------------------
 @interface GtpCommand : NSObject
 {
@@ -44,6 +86,7 @@
 + (GtpCommand*) command:(NSString*)command;
 + (GtpCommand*) asynchronousCommand:(NSString*)command responseTarget:(id)target selector:(SEL)selector;
 - (void) submit;
+- (void) cancel;
 
 /// @brief The GTP command string, including arguments.
 @property(nonatomic, retain) NSString* command;
@@ -72,5 +115,51 @@
 /// for this command is received. The selector must take a single GtpResponse*
 /// argument.
 @property(nonatomic, assign) SEL responseTargetSelector;
+/// @brief The kind of the GTP command. GtpEnginePool uses this to decide
+/// which GTP engine processes the command.
+///
+/// The default for this property is #GtpCommandKindGame.
+@property(nonatomic, assign) enum GtpCommandKind kind;
+/// @brief The priority of the GTP command. GtpClient uses this to decide
+/// which pending GTP command is processed next. Commands with the same
+/// priority are processed in the order in which they were submitted.
+///
+/// The default for this property is #GtpCommandPriorityNormal.
+@property(nonatomic, assign) enum GtpCommandPriority priority;
+/// @brief A key that identifies GTP commands whose results supersede each
+/// other. When a command is submitted, GtpClient drops all pending commands
+/// that have the same coalescing key, so that only the newest of these
+/// commands is processed.
+///
+/// The default for this property is @e nil, i.e. the command is never
+/// superseded by another command.
+@property(nonatomic, retain) NSString* coalescingKey;
+/// @brief True if the GTP command has been cancelled, or if it has been
+/// superseded by a newer command with the same @e coalescingKey.
+///
+/// This property can be accessed from any thread.
+@property(atomic, assign, readonly, getter=isCancelled) bool cancelled;
+
+/// @name Timing probes
+///
+/// @brief GtpClient records these timestamps as the command passes through
+/// the stages enumerated by #GtpCommandStage. All timestamps are monotonic,
+/// in seconds since the system was started (see NSProcessInfo). A timestamp
+/// is 0 if the command has not (yet) reached the corresponding stage.
+//@{
+/// @brief The time when the command was submitted to GtpClient.
+@property(nonatomic, assign) NSTimeInterval submissionTime;
+/// @brief The time when GtpClient's thread started to process the command.
+@property(nonatomic, assign) NSTimeInterval processingStartTime;
+/// @brief The time when the command had been written to, and flushed from,
+/// the GTP engine's input stream.
+@property(nonatomic, assign) NSTimeInterval writeEndTime;
+/// @brief The time when the first line of the response had been read.
+@property(nonatomic, assign) NSTimeInterval firstResponseLineTime;
+/// @brief The time when the entire response had been read.
+@property(nonatomic, assign) NSTimeInterval responseEndTime;
+/// @brief The time when the response target was about to be notified.
+@property(nonatomic, assign) NSTimeInterval responseTargetNotificationTime;
+//@}
 
 @end
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2013 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -17,10 +17,18 @@
 
 // Project includes
 #import "GtpCommand.h"
-#import "GtpClient.h"
+#import "GtpEnginePool.h"
 #import "../main/ApplicationDelegate.h"
 
 
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GtpCommand.
+// -----------------------------------------------------------------------------
+@interface GtpCommand()
+@property(atomic, assign, readwrite, getter=isCancelled) bool cancelled;
+@end
+
+
 @implementation GtpCommand
 
 // -----------------------------------------------------------------------------
@@ -75,6 +83,16 @@
   self.response = nil;
   self.responseTarget = nil;
   self.responseTargetSelector = nil;
+  self.kind = GtpCommandKindGame;
+  self.priority = GtpCommandPriorityNormal;
+  self.coalescingKey = nil;
+  self.cancelled = false;
+  self.submissionTime = 0;
+  self.processingStartTime = 0;
+  self.writeEndTime = 0;
+  self.firstResponseLineTime = 0;
+  self.responseEndTime = 0;
+  self.responseTargetNotificationTime = 0;
 
   return self;
 }
@@ -89,6 +107,7 @@
   self.response = nil;
   self.responseTarget = nil;
   self.responseTargetSelector = nil;
+  self.coalescingKey = nil;
   [super dealloc];
 }
 
@@ -106,7 +125,7 @@
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Submits this GtpCommand instance to the application's GtpClient.
+/// @brief Submits this GtpCommand instance to the application's GtpEnginePool.
 ///
 /// This is a convenience method so that clients do not need to know GtpClient,
 /// or how to obtain an instance of GtpClient.
@@ -114,8 +133,23 @@
 - (void) submit
 {
   DDLogInfo(@"Submitting %@", self);
-  GtpClient* client = [ApplicationDelegate sharedDelegate].gtpClient;
-  [client submit:self];
+  GtpEnginePool* enginePool = [ApplicationDelegate sharedDelegate].gtpEnginePool;
+  [enginePool submit:self];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Cancels this GtpCommand instance.
+///
+/// If the command is still waiting to be processed, GtpClient drops the
+/// command instead of passing it on to the GTP engine. If the command has
+/// already been passed on to the GTP engine, cancelling has no effect. Use
+/// GtpClient::interrupt() to stop a command that is being processed.
+///
+/// This method can be invoked from any thread.
+// -----------------------------------------------------------------------------
+- (void) cancel
+{
+  self.cancelled = true;
 }
 
 @end
@@ -0,0 +1,76 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Forward declarations
+@class GtpEngineProfile;
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpEngineMemoryGovernor class adapts the amount of memory that
+/// the GTP engines may use for their search trees to the memory that is
+/// actually available to the application.
+///
+/// @ingroup gtp
+///
+/// The @e fuegoMaxMemory setting of a GtpEngineProfile is an upper limit that
+/// the user chooses once. GtpEngineMemoryGovernor turns it into the memory
+/// budget that is actually given to the GTP engines (the "uct_max_memory" GTP
+/// command):
+/// - When a profile is applied (e.g. at the start of a new game),
+///   GtpEngineMemoryGovernor limits the budget to half of the memory that the
+///   operating system said was available to the application when it was
+///   launched, shared among all GTP engines of the GtpEnginePool. The memory is
+///   not measured again, because by then the search trees of the GTP engines
+///   count against the available memory. Memory pressure from earlier games is
+///   forgotten at this point.
+/// - Each time the application receives a memory warning,
+///   GtpEngineMemoryGovernor increases the memory pressure level. Every level
+///   halves the budget, down to #fuegoMaxMemoryMinimum, and subtree reuse is
+///   disabled from the first level on, because a reused subtree keeps a second
+///   search tree alive. The new settings are submitted to the GTP engines
+///   immediately.
+/// - When the system reports that memory pressure has returned to normal,
+///   GtpEngineMemoryGovernor resets the memory pressure level and submits the
+///   restored budget and subtree reuse setting to the GTP engines.
+///
+/// GtpEngineProfile::applyProfile() invokes updateWithProfile:(), then uses
+/// the properties @e activeMemoryBudget and @e reuseSubtree instead of its own
+/// settings. The active budget is shown in the diagnostics view.
+// -----------------------------------------------------------------------------
+@interface GtpEngineMemoryGovernor : NSObject
+{
+}
+
+- (id) init;
+- (void) updateWithProfile:(GtpEngineProfile*)profile;
++ (int) availableMemoryMegabytes;
+
+/// @brief The memory budget in MB that the GTP engines should use for their
+/// search trees. Is 0 until updateWithProfile:() is invoked for the first
+/// time.
+@property(nonatomic, assign, readonly) int activeMemoryBudget;
+/// @brief True if the GTP engines should reuse the subtree of the previous
+/// search.
+@property(nonatomic, assign, readonly) bool reuseSubtree;
+/// @brief The number of memory warnings that have been received since
+/// updateWithProfile:() was last invoked, or since memory pressure last
+/// returned to normal. The value stops increasing when the budget cannot be
+/// halved anymore.
+@property(nonatomic, assign, readonly) int memoryPressureLevel;
+
+@end
@@ -0,0 +1,253 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Project includes
+#import "GtpEngineMemoryGovernor.h"
+#import "GtpCommand.h"
+#import "GtpEnginePool.h"
+#import "../main/ApplicationDelegate.h"
+#import "../player/GtpEngineProfile.h"
+
+// System includes
+#include <os/proc.h>
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GtpEngineMemoryGovernor.
+// -----------------------------------------------------------------------------
+@interface GtpEngineMemoryGovernor()
+@property(nonatomic, assign, readwrite) int activeMemoryBudget;
+@property(nonatomic, assign, readwrite) bool reuseSubtree;
+@property(nonatomic, assign, readwrite) int memoryPressureLevel;
+/// @brief The @e fuegoMaxMemory setting of the profile that was most recently
+/// passed to updateWithProfile:().
+@property(nonatomic, assign) int profileMaxMemory;
+/// @brief The @e fuegoReuseSubtree setting of the profile that was most
+/// recently passed to updateWithProfile:().
+@property(nonatomic, assign) bool profileReuseSubtree;
+/// @brief The memory in MB that was available when this
+/// GtpEngineMemoryGovernor was created. Is 0 if the available memory is not
+/// known.
+///
+/// The memory is measured only once, right after the GTP engines were
+/// launched and before they built a search tree. Measuring again later would
+/// count the search trees of the GTP engines against the available memory,
+/// and every application of a profile would shrink the budget further.
+@property(nonatomic, assign) int availableMemoryAtLaunch;
+/// @brief The share in MB of each GTP engine of @e availableMemoryAtLaunch.
+/// Is 0 if the available memory is not known.
+@property(nonatomic, assign) int availableMemoryPerEngine;
+/// @brief Dispatch source that delivers memory pressure events, notably the
+/// event that memory pressure has returned to normal.
+@property(nonatomic, assign) dispatch_source_t memoryPressureSource;
+@end
+
+
+@implementation GtpEngineMemoryGovernor
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpEngineMemoryGovernor object.
+///
+/// @note This is the designated initializer of GtpEngineMemoryGovernor.
+// -----------------------------------------------------------------------------
+- (id) init
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.activeMemoryBudget = 0;
+  self.reuseSubtree = false;
+  self.memoryPressureLevel = 0;
+  self.profileMaxMemory = 0;
+  self.profileReuseSubtree = false;
+  self.availableMemoryAtLaunch = [GtpEngineMemoryGovernor availableMemoryMegabytes];
+  self.availableMemoryPerEngine = 0;
+
+  [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(didReceiveMemoryWarning:) name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+  [self setupMemoryPressureSource];
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GtpEngineMemoryGovernor object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  [[NSNotificationCenter defaultCenter] removeObserver:self];
+  if (self.memoryPressureSource)
+  {
+    dispatch_source_cancel(self.memoryPressureSource);
+    dispatch_release(self.memoryPressureSource);
+    self.memoryPressureSource = NULL;
+  }
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Calculates the memory budget and the subtree reuse setting for the
+/// GTP engines from the settings of @a profile and the memory that was
+/// available when the application was launched. Resets the memory pressure
+/// level.
+///
+/// Does not submit any GTP commands. The caller is expected to submit the
+/// settings along with the other settings of @a profile.
+// -----------------------------------------------------------------------------
+- (void) updateWithProfile:(GtpEngineProfile*)profile
+{
+  self.profileMaxMemory = profile.fuegoMaxMemory;
+  self.profileReuseSubtree = profile.fuegoReuseSubtree;
+  self.memoryPressureLevel = 0;
+
+  int numberOfEngines = (int)[ApplicationDelegate sharedDelegate].gtpEnginePool.engines.count;
+  // Leave half of the available memory to the rest of the application
+  self.availableMemoryPerEngine = self.availableMemoryAtLaunch / 2 / MAX(numberOfEngines, 1);
+
+  [self updateSettings];
+  DDLogInfo(@"%@: Available memory at launch was %d MB, memory budget is %d MB (profile %d MB)",
+            self, self.availableMemoryAtLaunch, self.activeMemoryBudget, self.profileMaxMemory);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the amount of memory in MB that the application can still
+/// allocate before the operating system terminates it. Returns 0 if the
+/// amount is not known.
+// -----------------------------------------------------------------------------
++ (int) availableMemoryMegabytes
+{
+  // Cast is safe, see UIDevice::physicalMemoryMegabytes()
+  return (int)(os_proc_available_memory() / 1024 / 1024);
+}
+
+#pragma mark - Memory management
+
+// -----------------------------------------------------------------------------
+/// @brief Responds to the system notification
+/// UIApplicationDidReceiveMemoryWarningNotification. Halves the memory budget
+/// and disables subtree reuse, then submits the new settings to the GTP
+/// engines.
+// -----------------------------------------------------------------------------
+- (void) didReceiveMemoryWarning:(NSNotification*)notification
+{
+  // Nothing to shrink if no profile has been applied yet, or if the budget
+  // is already at its minimum
+  if (0 == self.activeMemoryBudget)
+    return;
+  if (self.activeMemoryBudget <= fuegoMaxMemoryMinimum && ! self.reuseSubtree)
+    return;
+
+  self.memoryPressureLevel++;
+  int previousMemoryBudget = self.activeMemoryBudget;
+  bool previousReuseSubtree = self.reuseSubtree;
+  [self updateSettings];
+  DDLogWarn(@"%@: Memory warning, memory pressure level is %d, memory budget is %d MB",
+            self, self.memoryPressureLevel, self.activeMemoryBudget);
+
+  [self submitSettingsIfChangedFromMemoryBudget:previousMemoryBudget reuseSubtree:previousReuseSubtree];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Responds to the memory pressure of the system returning to normal.
+/// Resets the memory pressure level, which restores the memory budget and the
+/// subtree reuse setting that were in effect before the first memory warning,
+/// then submits the restored settings to the GTP engines.
+// -----------------------------------------------------------------------------
+- (void) memoryPressureDidReturnToNormal
+{
+  if (0 == self.memoryPressureLevel)
+    return;
+
+  self.memoryPressureLevel = 0;
+  int previousMemoryBudget = self.activeMemoryBudget;
+  bool previousReuseSubtree = self.reuseSubtree;
+  [self updateSettings];
+  DDLogInfo(@"%@: Memory pressure returned to normal, memory budget is %d MB",
+            self, self.activeMemoryBudget);
+
+  [self submitSettingsIfChangedFromMemoryBudget:previousMemoryBudget reuseSubtree:previousReuseSubtree];
+}
+
+#pragma mark - Private helpers
+
+// -----------------------------------------------------------------------------
+/// @brief Creates a dispatch source that invokes
+/// memoryPressureDidReturnToNormal() on the main thread when the memory
+/// pressure of the system returns to normal. The system posts no notification
+/// for this, only for memory warnings.
+// -----------------------------------------------------------------------------
+- (void) setupMemoryPressureSource
+{
+  self.memoryPressureSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE,
+                                                     0,
+                                                     DISPATCH_MEMORYPRESSURE_NORMAL | DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL,
+                                                     dispatch_get_main_queue());
+  if (! self.memoryPressureSource)
+    return;
+
+  // The block must not retain self, otherwise self would never be deallocated
+  __block GtpEngineMemoryGovernor* blockSelf = self;
+  dispatch_source_t memoryPressureSource = self.memoryPressureSource;
+  dispatch_source_set_event_handler(memoryPressureSource, ^{
+    if (dispatch_source_get_data(memoryPressureSource) & DISPATCH_MEMORYPRESSURE_NORMAL)
+      [blockSelf memoryPressureDidReturnToNormal];
+  });
+  dispatch_resume(memoryPressureSource);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Submits the properties @e activeMemoryBudget and @e reuseSubtree to
+/// the GTP engines if they differ from @a previousMemoryBudget and
+/// @a previousReuseSubtree.
+// -----------------------------------------------------------------------------
+- (void) submitSettingsIfChangedFromMemoryBudget:(int)previousMemoryBudget reuseSubtree:(bool)previousReuseSubtree
+{
+  // The commands are replicated to all GTP engines in the pool
+  if (previousReuseSubtree != self.reuseSubtree)
+  {
+    GtpCommand* command = [GtpCommand command:[NSString stringWithFormat:@"uct_param_player reuse_subtree %d", (self.reuseSubtree ? 1 : 0)]];
+    command.waitUntilDone = false;
+    [command submit];
+  }
+  if (previousMemoryBudget != self.activeMemoryBudget)
+  {
+    long long memoryBudgetInBytes = self.activeMemoryBudget * 1000000LL;
+    GtpCommand* command = [GtpCommand command:[NSString stringWithFormat:@"uct_max_memory %lld", memoryBudgetInBytes]];
+    command.waitUntilDone = false;
+    [command submit];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Recalculates the properties @e activeMemoryBudget and
+/// @e reuseSubtree from the profile settings, the available memory and the
+/// memory pressure level.
+// -----------------------------------------------------------------------------
+- (void) updateSettings
+{
+  int memoryBudget = self.profileMaxMemory;
+  if (self.availableMemoryPerEngine > 0)
+    memoryBudget = MIN(memoryBudget, self.availableMemoryPerEngine);
+  memoryBudget >>= self.memoryPressureLevel;
+  self.activeMemoryBudget = MAX(memoryBudget, fuegoMaxMemoryMinimum);
+
+  self.reuseSubtree = (self.profileReuseSubtree && 0 == self.memoryPressureLevel);
+}
+
+@end
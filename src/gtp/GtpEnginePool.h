@@ -0,0 +1,138 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// This file is #import'ed from pure Objective-C implementations, therefore it
+// must not contain any C++ syntax.
+
+// Forward declarations
+@class GtpClient;
+@class GtpCommand;
+@class GtpEngine;
+@class GtpStatistics;
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpEnginePool class manages one or more independent pairs of
+/// GtpClient and GtpEngine, and dispatches GTP commands to them.
+///
+/// @ingroup gtp
+///
+/// Each GtpEngine runs in its own thread and communicates with its own
+/// GtpClient via its own pair of pipe stream buffers. The first pair is the
+/// primary pair. The primary GtpEngine plays the game, ponders and receives
+/// all commands that change the board position. Additional pairs are secondary
+/// pairs that are used only to analyze board positions.
+///
+/// GtpEnginePool dispatches a GtpCommand according to its @e kind property:
+/// - Commands of kind #GtpCommandKindGame are always submitted to the primary
+///   GtpClient. If such a command configures the GTP engine (e.g. UCT
+///   parameters or the thinking time), GtpEnginePool in addition submits a
+///   copy of the command to all secondary GtpClients, so that all GTP engines
+///   are configured in the same way. The copies are processed asynchronously,
+///   their responses are ignored. Pondering is not replicated.
+/// - Commands of kind #GtpCommandKindAnalysis are submitted to a secondary
+///   GtpClient whose GtpEngine already has the same board position as the
+///   primary GtpEngine. If there is no such secondary GtpClient, GtpEnginePool
+///   first sets up a secondary GtpEngine with the board position that the
+///   primary GtpEnginePositionTracker knows about. If there is no secondary
+///   GtpClient at all, or if the primary board position is not known, the
+///   command is submitted to the primary GtpClient.
+///
+/// As a result, a move suggestion or territory statistics no longer need to
+/// wait until the primary GTP engine has finished playing a move, and they do
+/// not disturb the primary GTP engine's search tree.
+///
+/// submitAnalysisSequence:() submits several commands of kind
+/// #GtpCommandKindAnalysis to the same secondary GtpClient. This allows to
+/// analyze a hypothetical board position, e.g. with a "play" command, an
+/// analysis command and an "undo" command, without disturbing the primary
+/// GtpEngine.
+///
+/// reserveSecondaryClients:() gives the caller exclusive use of secondary
+/// GtpClients, e.g. to let GtpMatchRunner play games on their GtpEngines.
+/// GtpEnginePool does not dispatch commands of kind #GtpCommandKindAnalysis to
+/// a reserved GtpClient, interrupt() does not interrupt a reserved GtpClient,
+/// and a reserved GtpClient does not post public notifications. Replicated
+/// configuration commands still reach reserved GtpClients, so that e.g. a
+/// reduction of the memory budget takes effect everywhere.
+/// releaseSecondaryClients:() ends the reservation and resubmits the most
+/// recent replicated configuration commands to the released GtpClients, which
+/// undoes any configuration changes that the caller made. The board position
+/// of a released GtpEngine is set up again as usual when the next analysis
+/// command is dispatched to it.
+///
+/// reservePrimaryClient() is the fallback for a pool without secondary
+/// GtpClients. The reservation works in the same way, but because commands of
+/// kind #GtpCommandKindGame cannot be dispatched elsewhere, the caller must
+/// make sure that the game does not submit commands while the reservation
+/// lasts (e.g. by locking the UI). releasePrimaryClient:() in addition
+/// restores the board position that the primary GtpEngine had when it was
+/// reserved.
+///
+/// pinClientForAnalysisCommand:() is a lightweight variant of a reservation
+/// for a sequence of analysis commands that is submitted piece by piece, e.g.
+/// from response handlers. GtpEnginePool selects the secondary GtpClient for
+/// the first command as usual and then does not dispatch commands of other
+/// submitters to it until unpinClient:() is invoked.
+///
+/// A pool with a single GtpEngine behaves exactly like a single GtpClient. It
+/// has no secondary GtpClients that could be reserved, only the primary
+/// GtpClient.
+// -----------------------------------------------------------------------------
+@interface GtpEnginePool : NSObject
+{
+}
+
++ (GtpEnginePool*) poolWithNumberOfEngines:(int)numberOfEngines;
++ (GtpEnginePool*) poolWithClients:(NSArray*)clients;
+- (void) submit:(GtpCommand*)command;
+- (bool) submitAnalysisSequence:(NSArray*)commands;
+- (void) interrupt;
+- (void) cancelCommandsWithCoalescingKey:(NSString*)coalescingKey;
+- (NSArray*) reserveSecondaryClients:(int)numberOfClients;
+- (void) releaseSecondaryClients:(NSArray*)clients;
+- (GtpClient*) reservePrimaryClient;
+- (void) releasePrimaryClient:(GtpClient*)client;
+- (GtpClient*) pinClientForAnalysisCommand:(GtpCommand*)command;
+- (void) unpinClient:(GtpClient*)client;
+
+/// @brief The GtpClient objects in the pool. The primary GtpClient is the
+/// first element.
+@property(nonatomic, retain, readonly) NSArray* clients;
+/// @brief The GtpEngine objects in the pool. The primary GtpEngine is the
+/// first element. Is empty if the pool was created with poolWithClients:().
+@property(nonatomic, retain, readonly) NSArray* engines;
+/// @brief The primary GtpClient.
+@property(nonatomic, assign, readonly) GtpClient* primaryClient;
+/// @brief The primary GtpEngine. Is @e nil if the pool was created with
+/// poolWithClients:().
+@property(nonatomic, assign, readonly) GtpEngine* primaryEngine;
+/// @brief The total number of GTP commands that are currently waiting to be
+/// processed by the GtpClients in the pool.
+@property(nonatomic, assign, readonly) int numberOfPendingCommands;
+/// @brief The largest queue depth that any of the GtpClients in the pool has
+/// had so far.
+@property(nonatomic, assign, readonly) int maximumNumberOfPendingCommands;
+/// @brief The total number of GTP commands that the GtpClients in the pool
+/// have dropped so far.
+@property(nonatomic, assign, readonly) int numberOfDroppedCommands;
+/// @brief Timing and throughput statistics of the GTP commands that the
+/// GtpClients in the pool have processed so far.
+@property(nonatomic, retain, readonly) GtpStatistics* statistics;
+
+@end
@@ -0,0 +1,679 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Project includes
+#import "GtpEnginePool.h"
+#import "GtpClient.h"
+#import "GtpCommand.h"
+#import "GtpEngine.h"
+#import "GtpEnginePositionTracker.h"
+#import "GtpStatistics.h"
+#import "PipeStreamBuffer.h"
+#import "../utility/ExceptionUtility.h"
+
+// System includes
+#include <streambuf>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GtpEnginePool.
+// -----------------------------------------------------------------------------
+@interface GtpEnginePool()
+{
+@private
+  /// @brief The pipe stream buffers, two for each pair of GtpClient and
+  /// GtpEngine. They are member variables of the class extension because they
+  /// are C++ and GtpEnginePool.h is also #import'ed by pure Objective-C
+  /// implementations.
+  std::vector<std::streambuf*> pipeStreamBuffers;
+}
+@property(nonatomic, retain, readwrite) NSArray* clients;
+@property(nonatomic, retain, readwrite) NSArray* engines;
+@property(nonatomic, retain, readwrite) GtpStatistics* statistics;
+/// @brief Index into @e clients of the secondary GtpClient that is set up
+/// next if no secondary GtpClient has the primary board position.
+@property(nonatomic, assign) NSUInteger indexOfNextSecondaryClient;
+/// @brief The GtpClients that are currently reserved. Access is protected by
+/// the lock on @e self.
+@property(nonatomic, retain) NSMutableSet* reservedClients;
+/// @brief The secondary GtpClients that are currently pinned. Access is
+/// protected by the lock on @e self.
+@property(nonatomic, retain) NSMutableSet* pinnedClients;
+/// @brief The most recent replicated configuration command for each
+/// configuration parameter. Key = the command without its value, value = the
+/// entire command. Access is protected by the lock on @e self.
+@property(nonatomic, retain) NSMutableDictionary* configurationCommands;
+/// @brief The commands that reproduce the board position that the primary
+/// GtpEngine had when reservePrimaryClient() reserved it. Is @e nil if the
+/// primary GtpClient is not reserved, or if its board position was not known.
+@property(nonatomic, retain) NSArray* commandsToRestorePrimaryPosition;
+@end
+
+
+@implementation GtpEnginePool
+
+// -----------------------------------------------------------------------------
+/// @brief Convenience constructor. Creates a GtpEnginePool instance with
+/// @a numberOfEngines pairs of GtpClient and GtpEngine.
+///
+/// @exception NSInvalidArgumentException Is raised if @a numberOfEngines is
+/// less than 1.
+// -----------------------------------------------------------------------------
++ (GtpEnginePool*) poolWithNumberOfEngines:(int)numberOfEngines
+{
+  return [[[GtpEnginePool alloc] initWithNumberOfEngines:numberOfEngines] autorelease];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Convenience constructor. Creates a GtpEnginePool instance with the
+/// GtpClients in @a clients, which the caller has already connected to their
+/// GTP engines. The first element is the primary GtpClient. The pool has no
+/// GtpEngine objects, i.e. @e engines is empty.
+///
+/// This is useful for unit tests that play the role of the GTP engines.
+///
+/// @exception NSInvalidArgumentException Is raised if @a clients is empty.
+// -----------------------------------------------------------------------------
++ (GtpEnginePool*) poolWithClients:(NSArray*)clients
+{
+  return [[[GtpEnginePool alloc] initWithClients:clients engines:@[]] autorelease];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpEnginePool object with @a numberOfEngines pairs of
+/// GtpClient and GtpEngine.
+// -----------------------------------------------------------------------------
+- (id) initWithNumberOfEngines:(int)numberOfEngines
+{
+  if (numberOfEngines < 1)
+  {
+    [self release];
+    NSString* errorMessage = [NSString stringWithFormat:@"initWithNumberOfEngines: failed: Invalid number of engines %d", numberOfEngines];
+    [ExceptionUtility throwInvalidArgumentExceptionWithErrorMessage:errorMessage];
+  }
+
+  std::vector<std::streambuf*> pipeStreamBuffersOfEngines;
+  NSMutableArray* clients = [NSMutableArray arrayWithCapacity:numberOfEngines];
+  NSMutableArray* engines = [NSMutableArray arrayWithCapacity:numberOfEngines];
+  for (int indexOfEngine = 0; indexOfEngine < numberOfEngines; ++indexOfEngine)
+  {
+    // In a regular desktop environment, engine and client would be launched
+    // in separate processes, which would then communicate via stdin/stdout.
+    // Since there is no way to launch separate processes under iOS, engine
+    // and client run in separate threads, and they communicate via C++
+    // Standard Library I/O streams.
+    std::streambuf* inputPipeStreamBuffer = new PipeStreamBuffer();
+    std::streambuf* outputPipeStreamBuffer = new PipeStreamBuffer();
+    pipeStreamBuffersOfEngines.push_back(inputPipeStreamBuffer);
+    pipeStreamBuffersOfEngines.push_back(outputPipeStreamBuffer);
+
+    NSArray* streamBuffers = [NSArray arrayWithObjects:
+                              [NSValue valueWithPointer:inputPipeStreamBuffer],
+                              [NSValue valueWithPointer:outputPipeStreamBuffer],
+                              nil];
+
+    [clients addObject:[GtpClient clientWithStreamBuffers:streamBuffers]];
+    [engines addObject:[GtpEngine engineWithStreamBuffers:streamBuffers]];
+  }
+
+  self = [self initWithClients:clients engines:engines];
+  if (! self)
+  {
+    for (std::streambuf* pipeStreamBuffer : pipeStreamBuffersOfEngines)
+      delete pipeStreamBuffer;
+    return nil;
+  }
+  pipeStreamBuffers = pipeStreamBuffersOfEngines;
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpEnginePool object with the GtpClients in
+/// @a clients and the GtpEngines in @a engines. The first element of
+/// @a clients is the primary GtpClient.
+///
+/// @note This is the designated initializer of GtpEnginePool.
+///
+/// @exception NSInvalidArgumentException Is raised if @a clients is empty.
+// -----------------------------------------------------------------------------
+- (id) initWithClients:(NSArray*)clients engines:(NSArray*)engines
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  if (0 == clients.count)
+  {
+    [self release];
+    [ExceptionUtility throwInvalidArgumentExceptionWithErrorMessage:@"initWithClients:engines: failed: No clients"];
+  }
+
+  self.statistics = [[[GtpStatistics alloc] init] autorelease];
+  for (GtpClient* client in clients)
+    client.statistics = self.statistics;
+  self.clients = clients;
+  self.engines = engines;
+  self.indexOfNextSecondaryClient = 1;
+  self.reservedClients = [NSMutableSet set];
+  self.pinnedClients = [NSMutableSet set];
+  self.configurationCommands = [NSMutableDictionary dictionary];
+  self.commandsToRestorePrimaryPosition = nil;
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GtpEnginePool object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.clients = nil;
+  self.engines = nil;
+  self.statistics = nil;
+  self.reservedClients = nil;
+  self.pinnedClients = nil;
+  self.configurationCommands = nil;
+  self.commandsToRestorePrimaryPosition = nil;
+  for (std::streambuf* pipeStreamBuffer : pipeStreamBuffers)
+    delete pipeStreamBuffer;
+  pipeStreamBuffers.clear();
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (GtpClient*) primaryClient
+{
+  return [self.clients objectAtIndex:0];
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (GtpEngine*) primaryEngine
+{
+  return self.engines.firstObject;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Submits @a command to the GtpClient that is selected according to
+/// the rules described in the class documentation.
+///
+/// This method is usually (but not always) executed in the main thread's
+/// context. See GtpClient::submit:() for details.
+// -----------------------------------------------------------------------------
+- (void) submit:(GtpCommand*)command
+{
+  if (GtpCommandKindGame == command.kind && [self isReplicatedConfigurationCommand:command])
+  {
+    @synchronized(self)
+    {
+      [self.configurationCommands setObject:command.command
+                                     forKey:[GtpEnginePool parameterOfConfigurationCommand:command.command]];
+    }
+    for (NSUInteger indexOfClient = 1; indexOfClient < self.clients.count; ++indexOfClient)
+    {
+      GtpCommand* copyOfCommand = [GtpCommand asynchronousCommand:command.command
+                                                   responseTarget:nil
+                                                         selector:nil];
+      [[self.clients objectAtIndex:indexOfClient] submit:copyOfCommand];
+    }
+  }
+
+  // Selecting the client and queueing the board position setup commands must
+  // not be interleaved with another submitter
+  GtpClient* client;
+  @synchronized(self)
+  {
+    client = [self clientForCommand:command];
+  }
+  [client submit:command];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Submits the GtpCommand objects in @a commands to a single secondary
+/// GtpClient whose GtpEngine has the same board position as the primary
+/// GtpEngine. Returns true on success. Returns false if the pool has no
+/// secondary GtpClient, or if the primary board position is not known. In that
+/// case none of the commands is submitted.
+///
+/// The commands must be of kind #GtpCommandKindAnalysis. They are processed
+/// in the order in which they appear in @a commands. The sequence is not
+/// interleaved with commands that GtpEnginePool dispatches later, even if the
+/// sequence uses #GtpCommandPriorityLow, because GtpEnginePool does not
+/// dispatch a command with a higher priority to a secondary GtpClient that
+/// still has pending commands (see clientForCommand:()).
+///
+/// @exception NSInvalidArgumentException Is raised if @a commands is empty,
+/// or if one of the commands is not of kind #GtpCommandKindAnalysis.
+// -----------------------------------------------------------------------------
+- (bool) submitAnalysisSequence:(NSArray*)commands
+{
+  if (0 == commands.count)
+    [ExceptionUtility throwInvalidArgumentExceptionWithErrorMessage:@"submitAnalysisSequence: failed: Empty sequence"];
+  for (GtpCommand* command in commands)
+  {
+    if (GtpCommandKindAnalysis != command.kind)
+    {
+      NSString* errorMessage = [NSString stringWithFormat:@"submitAnalysisSequence: failed: Command %@ is not an analysis command", command.command];
+      [ExceptionUtility throwInvalidArgumentExceptionWithErrorMessage:errorMessage];
+    }
+  }
+
+  if (1 == self.clients.count)
+    return false;
+
+  // Like in submit:(), but in addition the commands of the sequence must not
+  // be interleaved with the commands of another submitter
+  @synchronized(self)
+  {
+    GtpClient* client = [self clientForCommand:[commands objectAtIndex:0]];
+    if (client == self.primaryClient)
+      return false;
+    for (GtpCommand* command in commands)
+      [client submit:command];
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Interrupts the GTP commands currently being processed by all
+/// GtpEngines in the pool, except the GtpEngines of reserved GtpClients.
+///
+/// GtpEngines that are idle are not affected. Reserved GtpClients are exempt
+/// because they process the commands of a background task (e.g. an engine
+/// match) that has nothing to do with the user's request to stop thinking.
+// -----------------------------------------------------------------------------
+- (void) interrupt
+{
+  NSMutableArray* clientsToInterrupt = [NSMutableArray array];
+  @synchronized(self)
+  {
+    for (GtpClient* client in self.clients)
+    {
+      if (! [self.reservedClients containsObject:client])
+        [clientsToInterrupt addObject:client];
+    }
+  }
+  for (GtpClient* client in clientsToInterrupt)
+    [client interrupt];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Drops the GTP commands with coalescing key @a coalescingKey that are
+/// waiting to be processed by any of the GtpEngines in the pool.
+///
+/// This method can be invoked from any thread.
+// -----------------------------------------------------------------------------
+- (void) cancelCommandsWithCoalescingKey:(NSString*)coalescingKey
+{
+  for (GtpClient* client in self.clients)
+    [client cancelCommandsWithCoalescingKey:coalescingKey];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Reserves up to @a numberOfClients secondary GtpClients for the
+/// exclusive use of the caller. Returns the reserved GtpClients. The array is
+/// empty if the pool has no secondary GtpClient, or if all of them are already
+/// reserved.
+///
+/// Blocks until the reserved GtpClients have processed all commands that were
+/// submitted to them before the reservation, so that the caller can rely on
+/// the GtpEngines being idle. This method must therefore not be invoked in
+/// the context of the main thread.
+///
+/// The caller may replace the @e statistics object of the reserved
+/// GtpClients. The caller must invoke releaseSecondaryClients:() when it no
+/// longer needs the GtpClients. The caller must not submit "quit" to a
+/// reserved GtpClient.
+// -----------------------------------------------------------------------------
+- (NSArray*) reserveSecondaryClients:(int)numberOfClients
+{
+  NSMutableArray* clients = [NSMutableArray array];
+  @synchronized(self)
+  {
+    for (NSUInteger indexOfClient = 1; indexOfClient < self.clients.count && (int)clients.count < numberOfClients; ++indexOfClient)
+    {
+      GtpClient* client = [self.clients objectAtIndex:indexOfClient];
+      if ([self.reservedClients containsObject:client])
+        continue;
+      [self.reservedClients addObject:client];
+      client.postsNotifications = false;
+      [clients addObject:client];
+    }
+  }
+
+  // Commands with the lowest priority are processed after all commands that
+  // are already pending, regardless of their priority
+  for (GtpClient* client in clients)
+  {
+    GtpCommand* command = [GtpCommand command:@"name"];
+    command.priority = GtpCommandPriorityLow;
+    [client submit:command];
+  }
+
+  DDLogInfo(@"%@: Reserved %lu secondary GTP engines", self, (unsigned long)clients.count);
+  return clients;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Selects the GtpClient to which the analysis command @a command
+/// should be submitted, like submit:() does, and pins it until unpinClient:()
+/// is invoked. Returns the pinned GtpClient. The caller then submits
+/// @a command and all further commands of its sequence directly to the pinned
+/// GtpClient.
+///
+/// GtpEnginePool does not dispatch commands of other submitters to a pinned
+/// secondary GtpClient, so the caller can change the engine's state (e.g. the
+/// time limit) for the duration of the sequence, and can submit the commands
+/// of the sequence one after another, e.g. from response handlers. Unlike a
+/// reserved GtpClient, a pinned GtpClient keeps posting public notifications
+/// and is interrupted by interrupt().
+///
+/// If the returned GtpClient is the primary GtpClient (e.g. because the pool
+/// has no secondary GtpClient) nothing is pinned, but the caller may still
+/// submit its commands to the returned GtpClient and must still invoke
+/// unpinClient:().
+///
+/// This method can be invoked from any thread.
+// -----------------------------------------------------------------------------
+- (GtpClient*) pinClientForAnalysisCommand:(GtpCommand*)command
+{
+  @synchronized(self)
+  {
+    GtpClient* client = [self clientForCommand:command];
+    if (client != self.primaryClient)
+      [self.pinnedClients addObject:client];
+    return client;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Unpins @a client, which must have been returned by
+/// pinClientForAnalysisCommand:().
+// -----------------------------------------------------------------------------
+- (void) unpinClient:(GtpClient*)client
+{
+  @synchronized(self)
+  {
+    [self.pinnedClients removeObject:client];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Ends the reservation of the GtpClients in @a clients, which must
+/// have been returned by reserveSecondaryClients:().
+///
+/// Resubmits the most recent replicated configuration commands to the
+/// released GtpClients, and restores their @e statistics object and their
+/// public notifications.
+// -----------------------------------------------------------------------------
+- (void) releaseSecondaryClients:(NSArray*)clients
+{
+  @synchronized(self)
+  {
+    NSArray* configurationCommands = [self.configurationCommands allValues];
+    for (GtpClient* client in clients)
+    {
+      if (! [self.reservedClients containsObject:client])
+        continue;
+      client.statistics = self.statistics;
+      client.postsNotifications = true;
+      for (NSString* commandString in configurationCommands)
+      {
+        GtpCommand* command = [GtpCommand asynchronousCommand:commandString
+                                               responseTarget:nil
+                                                     selector:nil];
+        [client submit:command];
+      }
+      [self.reservedClients removeObject:client];
+    }
+  }
+  DDLogInfo(@"%@: Released %lu secondary GTP engines", self, (unsigned long)clients.count);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Reserves the primary GtpClient for the exclusive use of the caller.
+/// Returns the primary GtpClient, or @e nil if it is already reserved.
+///
+/// This is intended for pools that have no secondary GtpClient. Like
+/// reserveSecondaryClients:() this method blocks until the primary GtpClient
+/// has processed all commands that were submitted to it before the
+/// reservation, and must therefore not be invoked in the context of the main
+/// thread. It then remembers the board position of the primary GtpEngine.
+///
+/// GtpEnginePool keeps submitting commands of kind #GtpCommandKindGame to the
+/// primary GtpClient, so the caller must make sure that the game does not
+/// submit commands while the reservation lasts. The caller must invoke
+/// releasePrimaryClient:() when it no longer needs the GtpClient. The caller
+/// must not submit "quit" to the reserved GtpClient.
+// -----------------------------------------------------------------------------
+- (GtpClient*) reservePrimaryClient
+{
+  GtpClient* client = self.primaryClient;
+  @synchronized(self)
+  {
+    if ([self.reservedClients containsObject:client])
+      return nil;
+    [self.reservedClients addObject:client];
+    client.postsNotifications = false;
+  }
+
+  GtpCommand* command = [GtpCommand command:@"name"];
+  command.priority = GtpCommandPriorityLow;
+  [client submit:command];
+
+  NSArray* commandsToReproducePosition = [client.positionTracker commandsToReproducePosition];
+  if (! commandsToReproducePosition)
+    DDLogWarn(@"%@: Board position of primary GTP engine is not known, it cannot be restored", self);
+  @synchronized(self)
+  {
+    self.commandsToRestorePrimaryPosition = commandsToReproducePosition;
+  }
+
+  DDLogInfo(@"%@: Reserved primary GTP engine", self);
+  return client;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Ends the reservation of the primary GtpClient @a client, which must
+/// have been returned by reservePrimaryClient().
+///
+/// Resubmits the most recent replicated configuration commands and the
+/// commands that restore the board position that the primary GtpEngine had
+/// when it was reserved, and restores the @e statistics object and the public
+/// notifications of @a client. Pondering is not restored, the caller must do
+/// this if it changed the pondering setting.
+// -----------------------------------------------------------------------------
+- (void) releasePrimaryClient:(GtpClient*)client
+{
+  @synchronized(self)
+  {
+    if (client != self.primaryClient || ! [self.reservedClients containsObject:client])
+      return;
+    NSMutableArray* commandStrings = [NSMutableArray arrayWithArray:[self.configurationCommands allValues]];
+    if (self.commandsToRestorePrimaryPosition)
+      [commandStrings addObjectsFromArray:self.commandsToRestorePrimaryPosition];
+    for (NSString* commandString in commandStrings)
+    {
+      GtpCommand* command = [GtpCommand asynchronousCommand:commandString
+                                             responseTarget:nil
+                                                   selector:nil];
+      [client submit:command];
+    }
+    client.statistics = self.statistics;
+    client.postsNotifications = true;
+    self.commandsToRestorePrimaryPosition = nil;
+    [self.reservedClients removeObject:client];
+  }
+  DDLogInfo(@"%@: Released primary GTP engine", self);
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (int) numberOfPendingCommands
+{
+  int numberOfPendingCommands = 0;
+  for (GtpClient* client in self.clients)
+    numberOfPendingCommands += client.numberOfPendingCommands;
+  return numberOfPendingCommands;
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (int) maximumNumberOfPendingCommands
+{
+  int maximumNumberOfPendingCommands = 0;
+  for (GtpClient* client in self.clients)
+    maximumNumberOfPendingCommands = MAX(maximumNumberOfPendingCommands, client.maximumNumberOfPendingCommands);
+  return maximumNumberOfPendingCommands;
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (int) numberOfDroppedCommands
+{
+  int numberOfDroppedCommands = 0;
+  for (GtpClient* client in self.clients)
+    numberOfDroppedCommands += client.numberOfDroppedCommands;
+  return numberOfDroppedCommands;
+}
+
+#pragma mark - Private helpers
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for submit:(). Returns the GtpClient to which
+/// @a command should be submitted. If the returned GtpClient is a secondary
+/// GtpClient whose GtpEngine does not yet have the primary board position,
+/// this method submits the commands that set up the board position before it
+/// returns.
+// -----------------------------------------------------------------------------
+- (GtpClient*) clientForCommand:(GtpCommand*)command
+{
+  GtpClient* primaryClient = self.primaryClient;
+  NSUInteger numberOfClients = self.clients.count;
+  if (GtpCommandKindAnalysis != command.kind || 1 == numberOfClients)
+    return primaryClient;
+
+  GtpEnginePositionTracker* primaryPositionTracker = primaryClient.positionTracker;
+  for (NSUInteger indexOfClient = 1; indexOfClient < numberOfClients; ++indexOfClient)
+  {
+    GtpClient* client = [self.clients objectAtIndex:indexOfClient];
+    if (! [self isSecondaryClientAvailable:client forCommand:command])
+      continue;
+    if ([client.positionTracker isSamePositionAsTracker:primaryPositionTracker])
+      return client;
+  }
+
+  NSArray* commandsToReproducePosition = [primaryPositionTracker commandsToReproducePosition];
+  if (! commandsToReproducePosition)
+  {
+    DDLogWarn(@"%@: Board position of primary GTP engine is not known, submitting %@ to primary GTP engine", self, command);
+    return primaryClient;
+  }
+
+  GtpClient* client = nil;
+  for (NSUInteger numberOfClientsTried = 1; numberOfClientsTried < numberOfClients && ! client; ++numberOfClientsTried)
+  {
+    GtpClient* candidateClient = [self.clients objectAtIndex:self.indexOfNextSecondaryClient];
+    self.indexOfNextSecondaryClient++;
+    if (self.indexOfNextSecondaryClient >= numberOfClients)
+      self.indexOfNextSecondaryClient = 1;
+    if ([self isSecondaryClientAvailable:candidateClient forCommand:command])
+      client = candidateClient;
+  }
+  if (! client)
+  {
+    DDLogWarn(@"%@: No secondary GTP engine is available, submitting %@ to primary GTP engine", self, command);
+    return primaryClient;
+  }
+
+  // The commands are queued in front of the analysis command. If one of them
+  // fails, the secondary GtpEnginePositionTracker invalidates its board
+  // position, so the next analysis command will set up the board position
+  // again.
+  for (NSString* commandString in commandsToReproducePosition)
+  {
+    GtpCommand* setupCommand = [GtpCommand asynchronousCommand:commandString
+                                                responseTarget:nil
+                                                      selector:nil];
+    setupCommand.kind = GtpCommandKindAnalysis;
+    // Must not be overtaken by the analysis command
+    setupCommand.priority = command.priority;
+    [client submit:setupCommand];
+  }
+
+  return client;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for clientForCommand:(). Returns true if @a command
+/// may be dispatched to the secondary GtpClient @a client.
+///
+/// A reserved or pinned GtpClient is never available. A GtpClient that still
+/// has pending commands is available only for commands with the lowest
+/// priority. A command with a higher priority would overtake the pending
+/// commands, which might be the remainder of an analysis sequence that must be
+/// processed on a different board position.
+// -----------------------------------------------------------------------------
+- (bool) isSecondaryClientAvailable:(GtpClient*)client forCommand:(GtpCommand*)command
+{
+  if ([self.reservedClients containsObject:client] || [self.pinnedClients containsObject:client])
+    return false;
+  return (GtpCommandPriorityLow == command.priority || 0 == client.numberOfPendingCommands);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for submit:(). Returns true if @a command is a
+/// configuration command that must be replicated to secondary GTP engines.
+/// Returns false if @a command is not a configuration command, or if it must
+/// not be replicated.
+// -----------------------------------------------------------------------------
+- (bool) isReplicatedConfigurationCommand:(GtpCommand*)command
+{
+  NSString* commandString = command.command;
+  // Pondering is only useful on the GTP engine that plays the game
+  if ([commandString hasPrefix:@"uct_param_player ponder "])
+    return false;
+  return ([commandString hasPrefix:@"uct_param_"] ||
+          [commandString hasPrefix:@"uct_max_memory "] ||
+          [commandString hasPrefix:@"go_param"]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for submit:(). Returns the part of the configuration
+/// command @a commandString that identifies the configured parameter, i.e. the
+/// command without its value (e.g. "uct_param_player reuse_subtree" for
+/// "uct_param_player reuse_subtree 1").
+// -----------------------------------------------------------------------------
++ (NSString*) parameterOfConfigurationCommand:(NSString*)commandString
+{
+  NSRange rangeOfLastSpace = [commandString rangeOfString:@" " options:NSBackwardsSearch];
+  if (NSNotFound == rangeOfLastSpace.location)
+    return commandString;
+  return [commandString substringToIndex:rangeOfLastSpace.location];
+}
+
+@end
@@ -0,0 +1,77 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// This file is #import'ed from pure Objective-C implementations, therefore it
+// must not contain any C++ syntax.
+
+// Forward declarations
+@class GtpResponse;
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpEnginePositionTracker class keeps track of the board position
+/// that the GTP engine currently has, based on the GTP commands that the GTP
+/// engine has processed.
+///
+/// @ingroup gtp
+///
+/// GtpEnginePositionTracker is owned by GtpClient. Every time that GtpClient
+/// receives the response to a GTP command, it invokes trackResponse:() so that
+/// GtpEnginePositionTracker can update its knowledge of the GTP engine's board
+/// position. This happens in the context of the secondary thread that
+/// processes GTP commands, before the submitter of a synchronous GTP command
+/// is unblocked.
+///
+/// The board position is tracked in two parts:
+/// - The setup commands, i.e. the commands that were sent after the board was
+///   last cleared and that configured komi, setup stones and the setup player.
+///   The setup commands are stored verbatim.
+/// - The moves that were played after the setup commands. Moves are stored in
+///   a normalized form, e.g. "B D4" or "W PASS", regardless of whether they
+///   were played with "play", "gogui-play_sequence" or "genmove".
+///
+/// Moves that are taken back with "undo" or "gg-undo" are removed from the
+/// list of tracked moves.
+///
+/// If GtpEnginePositionTracker sees a command that changes the board position
+/// in a way that it does not understand (e.g. "loadsgf"), or if a command that
+/// changes the board position fails, the tracked board position becomes
+/// invalid. It becomes valid again when the board is cleared the next time.
+/// The tracked board position is also invalid initially, before the board is
+/// cleared for the first time.
+///
+/// GtpEnginePositionTracker also remembers the last successful "boardsize"
+/// command. Together with the setup commands and the moves this is sufficient
+/// to reproduce the tracked board position on a different GTP engine (see
+/// commandsToReproducePosition()).
+///
+/// All methods in GtpEnginePositionTracker are thread-safe.
+// -----------------------------------------------------------------------------
+@interface GtpEnginePositionTracker : NSObject
+{
+}
+
+- (void) trackResponse:(GtpResponse*)response;
+- (void) invalidate;
+- (NSArray*) movesIfSetupCommandsMatch:(NSArray*)setupCommands;
+- (NSArray*) commandsToReproducePosition;
+- (bool) isSamePositionAsTracker:(GtpEnginePositionTracker*)otherTracker;
+
++ (NSString*) moveStringWithColor:(NSString*)color vertex:(NSString*)vertex;
+
+@end
@@ -0,0 +1,285 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Project includes
+#import "GtpEnginePositionTracker.h"
+#import "GtpCommand.h"
+#import "GtpResponse.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for
+/// GtpEnginePositionTracker.
+// -----------------------------------------------------------------------------
+@interface GtpEnginePositionTracker()
+@property(nonatomic, assign) bool valid;
+@property(nonatomic, retain) NSString* boardSizeCommand;
+@property(nonatomic, retain) NSMutableArray* setupCommands;
+@property(nonatomic, retain) NSMutableArray* moves;
+@end
+
+
+@implementation GtpEnginePositionTracker
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpEnginePositionTracker object. The tracked board
+/// position is initially invalid.
+///
+/// @note This is the designated initializer of GtpEnginePositionTracker.
+// -----------------------------------------------------------------------------
+- (id) init
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.valid = false;
+  self.boardSizeCommand = nil;
+  self.setupCommands = [NSMutableArray array];
+  self.moves = [NSMutableArray array];
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GtpEnginePositionTracker object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.boardSizeCommand = nil;
+  self.setupCommands = nil;
+  self.moves = nil;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Updates the tracked board position with the GTP command that
+/// @a response belongs to.
+///
+/// This method is invoked by GtpClient in the context of the secondary thread
+/// that processes GTP commands.
+// -----------------------------------------------------------------------------
+- (void) trackResponse:(GtpResponse*)response
+{
+  NSArray* tokens = [GtpEnginePositionTracker tokensFromCommandString:response.command.command];
+  if (tokens.count == 0)
+    return;
+
+  NSString* commandName = [tokens.firstObject lowercaseString];
+
+  @synchronized(self)
+  {
+    if ([commandName isEqualToString:@"clear_board"])
+    {
+      [self resetWithValidity:response.status];
+    }
+    else if ([commandName isEqualToString:@"boardsize"])
+    {
+      self.boardSizeCommand = response.status ? response.command.command : nil;
+      [self resetWithValidity:response.status];
+    }
+    else if ([commandName isEqualToString:@"komi"] ||
+             [commandName isEqualToString:@"gogui-setup"] ||
+             [commandName isEqualToString:@"gogui-setup_player"])
+    {
+      // The setup commands must be replayed verbatim when the position is
+      // synchronized, so we can remember them only while no moves have been
+      // played
+      if (! response.status || self.moves.count > 0)
+        [self invalidateInternal];
+      else
+        [self.setupCommands addObject:response.command.command];
+    }
+    else if ([commandName isEqualToString:@"play"])
+    {
+      if (response.status && tokens.count == 3)
+        [self.moves addObject:[GtpEnginePositionTracker moveStringWithColor:tokens[1] vertex:tokens[2]]];
+      else
+        [self invalidateInternal];
+    }
+    else if ([commandName isEqualToString:@"gogui-play_sequence"])
+    {
+      if (response.status && (tokens.count % 2) == 1)
+      {
+        for (NSUInteger indexOfToken = 1; indexOfToken < tokens.count; indexOfToken += 2)
+          [self.moves addObject:[GtpEnginePositionTracker moveStringWithColor:tokens[indexOfToken] vertex:tokens[indexOfToken + 1]]];
+      }
+      else
+      {
+        [self invalidateInternal];
+      }
+    }
+    else if ([commandName isEqualToString:@"genmove"] || [commandName isEqualToString:@"kgs-genmove_cleanup"])
+    {
+      NSString* vertex = [response.parsedResponse stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+      if (! response.status || tokens.count != 2)
+        [self invalidateInternal];
+      else if (NSOrderedSame != [vertex caseInsensitiveCompare:@"resign"])
+        [self.moves addObject:[GtpEnginePositionTracker moveStringWithColor:tokens[1] vertex:vertex]];
+    }
+    else if ([commandName isEqualToString:@"undo"] || [commandName isEqualToString:@"gg-undo"])
+    {
+      NSUInteger numberOfMovesToUndo = 1;
+      if (tokens.count > 1)
+        numberOfMovesToUndo = [tokens[1] intValue];
+
+      if (response.status && numberOfMovesToUndo <= self.moves.count)
+        [self.moves removeObjectsInRange:NSMakeRange(self.moves.count - numberOfMovesToUndo, numberOfMovesToUndo)];
+      else
+        [self invalidateInternal];
+    }
+    else if ([commandName isEqualToString:@"fixed_handicap"] ||
+             [commandName isEqualToString:@"place_free_handicap"] ||
+             [commandName isEqualToString:@"set_free_handicap"] ||
+             [commandName isEqualToString:@"loadsgf"] ||
+             [commandName isEqualToString:@"quit"])
+    {
+      // Commands that change the board position in a way that we don't want
+      // to replicate
+      [self invalidateInternal];
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Marks the tracked board position as invalid.
+// -----------------------------------------------------------------------------
+- (void) invalidate
+{
+  @synchronized(self)
+  {
+    [self invalidateInternal];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a copy of the list of moves that the GTP engine has played
+/// on top of the setup commands @a setupCommands. Returns @e nil if the tracked
+/// board position is invalid, or if the GTP engine was set up with different
+/// setup commands than @a setupCommands.
+///
+/// The returned list is ordered, i.e. the first element is the first move that
+/// was played. Elements are NSString objects with normalized moves, as
+/// generated by moveStringWithColor:vertex:().
+// -----------------------------------------------------------------------------
+- (NSArray*) movesIfSetupCommandsMatch:(NSArray*)setupCommands
+{
+  @synchronized(self)
+  {
+    if (! self.valid)
+      return nil;
+    if (! [self.setupCommands isEqualToArray:setupCommands])
+      return nil;
+    return [NSArray arrayWithArray:self.moves];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the list of GTP commands that must be submitted to a GTP
+/// engine with an unknown board position so that it ends up with the board
+/// position tracked by this GtpEnginePositionTracker. Returns @e nil if the
+/// tracked board position is invalid, or if the board size is not known.
+///
+/// The first command sets the board size, which also clears the board. The
+/// setup commands follow verbatim. The moves, if any, are played with a single
+/// final "gogui-play_sequence" command.
+// -----------------------------------------------------------------------------
+- (NSArray*) commandsToReproducePosition
+{
+  @synchronized(self)
+  {
+    if (! self.valid || ! self.boardSizeCommand)
+      return nil;
+
+    NSMutableArray* commands = [NSMutableArray arrayWithObject:self.boardSizeCommand];
+    [commands addObjectsFromArray:self.setupCommands];
+    if (self.moves.count > 0)
+    {
+      NSMutableString* playSequenceCommand = [NSMutableString stringWithString:@"gogui-play_sequence"];
+      for (NSString* move in self.moves)
+        [playSequenceCommand appendFormat:@" %@", move];
+      [commands addObject:playSequenceCommand];
+    }
+    return commands;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if this GtpEnginePositionTracker and @a otherTracker
+/// both track a valid board position, and the two board positions are the
+/// same. Returns false otherwise.
+// -----------------------------------------------------------------------------
+- (bool) isSamePositionAsTracker:(GtpEnginePositionTracker*)otherTracker
+{
+  NSArray* commands = [self commandsToReproducePosition];
+  if (! commands)
+    return false;
+  NSArray* otherCommands = [otherTracker commandsToReproducePosition];
+  if (! otherCommands)
+    return false;
+  return [commands isEqualToArray:otherCommands];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a move string in the normalized form that is used by
+/// GtpEnginePositionTracker, e.g. "B D4" or "W PASS". @a color is a GTP color
+/// ("b", "black", "W", etc.), @a vertex is a GTP vertex or "pass".
+// -----------------------------------------------------------------------------
++ (NSString*) moveStringWithColor:(NSString*)color vertex:(NSString*)vertex
+{
+  NSString* colorString = [[color substringToIndex:1] uppercaseString];
+  return [NSString stringWithFormat:@"%@ %@", colorString, [vertex uppercaseString]];
+}
+
+#pragma mark - Private helpers
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Forgets the tracked board position and marks it as
+/// valid or invalid depending on @a valid. The caller must hold the lock.
+// -----------------------------------------------------------------------------
+- (void) resetWithValidity:(bool)valid
+{
+  self.valid = valid;
+  [self.setupCommands removeAllObjects];
+  [self.moves removeAllObjects];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Marks the tracked board position as invalid. The
+/// caller must hold the lock.
+// -----------------------------------------------------------------------------
+- (void) invalidateInternal
+{
+  [self resetWithValidity:false];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Splits @a commandString into whitespace-separated
+/// tokens. Returns an empty array if @a commandString is @e nil.
+// -----------------------------------------------------------------------------
++ (NSArray*) tokensFromCommandString:(NSString*)commandString
+{
+  if (! commandString)
+    return @[];
+
+  NSArray* components = [commandString componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+  return [components filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"length > 0"]];
+}
+
+@end
@@ -0,0 +1,117 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Forward declarations
+@class GtpEngineProfile;
+@class GtpStatistics;
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpMatchRunner class lets the GTP engine play games against
+/// itself, without involving GoGame or the UI, and measures the throughput.
+///
+/// @ingroup gtp
+///
+/// GtpMatchRunner reserves one secondary GtpClient of the application's
+/// GtpEnginePool for each game that is played in parallel (see
+/// GtpEnginePool::reserveSecondaryClients:()). The number of games that are
+/// actually played in parallel is limited by the number of secondary GTP
+/// engines that are available. GtpMatchRunner never creates additional GTP
+/// engines and never submits "quit", because the GTP engines share the process
+/// with the application.
+///
+/// Secondary GTP engines are opt-in (user default NumberOfGtpEngines). If the
+/// application uses only the primary GTP engine, GtpMatchRunner reserves the
+/// primary GtpClient instead (see GtpEnginePool::reservePrimaryClient()) and
+/// plays one game at a time. The caller must make sure that the game does not
+/// submit GTP commands while the match is running. When the match is over,
+/// GtpEnginePool restores the board position and the configuration of the
+/// primary GTP engine, and GtpMatchRunner restores pondering.
+///
+/// GtpMatchRunner configures each GtpEngine with the settings of a
+/// GtpEngineProfile (except pondering, which is always off), then plays @e numberOfGames games by submitting "genmove"
+/// commands for alternating colors. A game ends when both colors have passed
+/// in a row, when a color resigns, or after @e maximumNumberOfMovesPerGame
+/// moves. No handicap is used.
+///
+/// After each move GtpMatchRunner submits "uct_stat_search" to find out how
+/// many playouts the search for the move has made. The number of playouts is
+/// only meaningful if the GTP engine does not use an opening book, which is
+/// the case because GtpMatchRunner never loads one.
+///
+/// The results are the number of games and moves played, the number of
+/// playouts, the elapsed time, and the GtpStatistics of the reserved
+/// GtpClients, which among other things contain the latency of the "genmove"
+/// command.
+/// report() formats all results as human-readable text.
+///
+/// Reserved GtpClients do not post public notifications, so the application's
+/// GTP log and other observers are not disturbed. The memory limit and the
+/// subtree reuse setting come from the application's GtpEngineMemoryGovernor,
+/// not from the profile, because the budget of the governor already accounts
+/// for all GTP engines in the pool.
+// -----------------------------------------------------------------------------
+@interface GtpMatchRunner : NSObject
+{
+}
+
+- (id) initWithProfile:(GtpEngineProfile*)profile;
+- (bool) run;
+- (NSString*) report;
+
+/// @name Configuration
+//@{
+/// @brief The profile whose settings are used to configure the GTP engines.
+@property(nonatomic, retain, readonly) GtpEngineProfile* profile;
+/// @brief The number of games to play. The default is 10.
+@property(nonatomic, assign) int numberOfGames;
+/// @brief The number of games to play in parallel. The default is 1. Is
+/// limited by the number of secondary GTP engines that are available, and is
+/// always 1 if there is no secondary GTP engine.
+@property(nonatomic, assign) int numberOfParallelGames;
+/// @brief The board size of the games. The default is #GoBoardSize9.
+@property(nonatomic, assign) enum GoBoardSize boardSize;
+/// @brief The komi of the games. The default is 7.5.
+@property(nonatomic, assign) double komi;
+/// @brief The maximum number of moves after which a game is stopped. The
+/// default is 0, which stands for twice the number of intersections on the
+/// board.
+@property(nonatomic, assign) int maximumNumberOfMovesPerGame;
+/// @brief Is invoked after each game, with the number of games played so far.
+/// Is invoked in the context of a secondary thread. The default is @e nil.
+@property(nonatomic, copy) void (^progressHandler)(int numberOfGamesPlayed);
+//@}
+
+/// @name Results
+//@{
+/// @brief The number of games that have been played.
+@property(atomic, assign, readonly) int numberOfGamesPlayed;
+/// @brief The number of moves (including pass moves) that have been played in
+/// all games.
+@property(atomic, assign, readonly) int numberOfMovesPlayed;
+/// @brief The number of playouts that the GTP engines have made while
+/// generating moves.
+@property(atomic, assign, readonly) long long numberOfPlayouts;
+/// @brief The wall-clock time, in seconds, that run() took.
+@property(nonatomic, assign, readonly) NSTimeInterval elapsedTime;
+/// @brief Timing statistics of the GTP commands that were submitted while
+/// run() was executing. Is @e nil before run() is invoked.
+@property(nonatomic, retain, readonly) GtpStatistics* statistics;
+//@}
+
+@end
@@ -0,0 +1,340 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Project includes
+#import "GtpMatchRunner.h"
+#import "GtpClient.h"
+#import "GtpCommand.h"
+#import "GtpEnginePool.h"
+#import "GtpResponse.h"
+#import "GtpEngineMemoryGovernor.h"
+#import "GtpStatistics.h"
+#import "GtpUtilities.h"
+#import "../main/ApplicationDelegate.h"
+#import "../player/GtpEngineProfile.h"
+#import "../utility/ExceptionUtility.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GtpMatchRunner.
+// -----------------------------------------------------------------------------
+@interface GtpMatchRunner()
+@property(nonatomic, retain, readwrite) GtpEngineProfile* profile;
+@property(atomic, assign, readwrite) int numberOfGamesPlayed;
+@property(atomic, assign, readwrite) int numberOfMovesPlayed;
+@property(atomic, assign, readwrite) long long numberOfPlayouts;
+@property(nonatomic, assign, readwrite) NSTimeInterval elapsedTime;
+@property(nonatomic, retain, readwrite) GtpStatistics* statistics;
+/// @brief The number of games that are played in parallel by the most recent
+/// invocation of run().
+@property(nonatomic, assign) int numberOfGamesPlayedInParallel;
+/// @brief The number of games that have been started so far. Access is
+/// protected by @e gamesCondition.
+@property(nonatomic, assign) int numberOfGamesStarted;
+/// @brief The number of threads that are still playing games. Access is
+/// protected by @e gamesCondition.
+@property(nonatomic, assign) int numberOfRunningThreads;
+/// @brief Is signalled when a thread has finished playing games, so that run()
+/// can wake up.
+@property(nonatomic, retain) NSCondition* gamesCondition;
+@end
+
+
+@implementation GtpMatchRunner
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpMatchRunner object that configures the GTP engines
+/// with the settings of @a profile.
+///
+/// @note This is the designated initializer of GtpMatchRunner.
+///
+/// @exception NSInvalidArgumentException Is raised if @a profile is @e nil.
+// -----------------------------------------------------------------------------
+- (id) initWithProfile:(GtpEngineProfile*)profile
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  if (! profile)
+  {
+    [self release];
+    [ExceptionUtility throwInvalidArgumentExceptionWithErrorMessage:@"initWithProfile: failed: Profile is nil"];
+  }
+
+  self.profile = profile;
+  self.numberOfGames = 10;
+  self.numberOfParallelGames = 1;
+  self.boardSize = GoBoardSize9;
+  self.komi = 7.5;
+  self.maximumNumberOfMovesPerGame = 0;
+  self.progressHandler = nil;
+  self.numberOfGamesPlayed = 0;
+  self.numberOfMovesPlayed = 0;
+  self.numberOfPlayouts = 0;
+  self.elapsedTime = 0;
+  self.statistics = nil;
+  self.numberOfGamesPlayedInParallel = 0;
+  self.numberOfGamesStarted = 0;
+  self.numberOfRunningThreads = 0;
+  self.gamesCondition = [[[NSCondition alloc] init] autorelease];
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GtpMatchRunner object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.profile = nil;
+  self.progressHandler = nil;
+  self.statistics = nil;
+  self.gamesCondition = nil;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Plays the configured number of games on secondary GTP engines of
+/// the application's GtpEnginePool, or on the primary GTP engine if there are
+/// no secondary GTP engines. Blocks until all games have been played. Returns
+/// true if the games were played, false if no GTP engine is available.
+///
+/// Must not be invoked in the context of the main thread, because this method
+/// may block for a long time.
+// -----------------------------------------------------------------------------
+- (bool) run
+{
+  GtpEnginePool* enginePool = [ApplicationDelegate sharedDelegate].gtpEnginePool;
+  int numberOfParallelGames = MAX(1, MIN(self.numberOfParallelGames, self.numberOfGames));
+  NSArray* clients = [enginePool reserveSecondaryClients:numberOfParallelGames];
+  bool usesPrimaryClient = (0 == clients.count);
+  if (usesPrimaryClient)
+  {
+    GtpClient* primaryClient = [enginePool reservePrimaryClient];
+    if (! primaryClient)
+    {
+      DDLogError(@"%@: Neither a secondary nor the primary GTP engine is available", self);
+      return false;
+    }
+    DDLogInfo(@"%@: No secondary GTP engine is available, playing on the primary GTP engine", self);
+    clients = @[primaryClient];
+  }
+
+  DDLogInfo(@"%@: Playing %d games, %lu in parallel", self, self.numberOfGames, (unsigned long)clients.count);
+
+  self.statistics = [[[GtpStatistics alloc] init] autorelease];
+  for (GtpClient* client in clients)
+    client.statistics = self.statistics;
+
+  self.numberOfGamesPlayedInParallel = (int)clients.count;
+  self.numberOfGamesPlayed = 0;
+  self.numberOfMovesPlayed = 0;
+  self.numberOfPlayouts = 0;
+  self.numberOfGamesStarted = 0;
+  self.numberOfRunningThreads = (int)clients.count;
+
+  NSTimeInterval startTime = [NSProcessInfo processInfo].systemUptime;
+  for (GtpClient* client in clients)
+  {
+    NSThread* thread = [[[NSThread alloc] initWithTarget:self selector:@selector(playGamesWithClient:) object:client] autorelease];
+    [thread start];
+  }
+
+  [self.gamesCondition lock];
+  while (self.numberOfRunningThreads > 0)
+    [self.gamesCondition wait];
+  [self.gamesCondition unlock];
+  self.elapsedTime = [NSProcessInfo processInfo].systemUptime - startTime;
+
+  if (usesPrimaryClient)
+  {
+    [enginePool releasePrimaryClient:clients.firstObject];
+    [GtpUtilities restorePondering];
+  }
+  else
+  {
+    [enginePool releaseSecondaryClients:clients];
+  }
+
+  DDLogInfo(@"%@: Finished\n%@", self, [self report]);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the results of the most recent invocation of run() as
+/// human-readable text.
+// -----------------------------------------------------------------------------
+- (NSString*) report
+{
+  NSTimeInterval elapsedTime = self.elapsedTime;
+  double gamesPerSecond = 0;
+  double movesPerSecond = 0;
+  double playoutsPerSecond = 0;
+  if (elapsedTime > 0)
+  {
+    gamesPerSecond = self.numberOfGamesPlayed / elapsedTime;
+    movesPerSecond = self.numberOfMovesPlayed / elapsedTime;
+    playoutsPerSecond = self.numberOfPlayouts / elapsedTime;
+  }
+
+  NSMutableString* report = [NSMutableString string];
+  [report appendFormat:@"Profile: %@\n", self.profile.name];
+  [report appendFormat:@"Board size: %d, komi: %.1f, parallel games: %d\n", self.boardSize, self.komi, self.numberOfGamesPlayedInParallel];
+  [report appendFormat:@"Elapsed time: %.3f s\n", elapsedTime];
+  [report appendFormat:@"Games: %d (%.3f/s)\n", self.numberOfGamesPlayed, gamesPerSecond];
+  [report appendFormat:@"Moves: %d (%.1f/s)\n", self.numberOfMovesPlayed, movesPerSecond];
+  [report appendFormat:@"Playouts: %lld (%.0f/s)\n", self.numberOfPlayouts, playoutsPerSecond];
+  if (self.statistics && [self.statistics countForCommandName:@"genmove"] > 0)
+  {
+    [report appendFormat:@"Move latency: p50 %.3f s, p95 %.3f s, p99 %.3f s\n",
+     [self.statistics percentile:50 ofStage:GtpCommandStageTotal forCommandName:@"genmove"],
+     [self.statistics percentile:95 ofStage:GtpCommandStageTotal forCommandName:@"genmove"],
+     [self.statistics percentile:99 ofStage:GtpCommandStageTotal forCommandName:@"genmove"]];
+  }
+  if (self.statistics)
+    [report appendFormat:@"\n%@", [self.statistics report]];
+  return report;
+}
+
+#pragma mark - Private helpers
+
+// -----------------------------------------------------------------------------
+/// @brief Thread entry point. Plays games using @a client until
+/// @e numberOfGames games have been started.
+// -----------------------------------------------------------------------------
+- (void) playGamesWithClient:(GtpClient*)client
+{
+  // Create an autorelease pool as the very first thing in this thread
+  NSAutoreleasePool* mainPool = [[NSAutoreleasePool alloc] init];
+
+  GtpEngineMemoryGovernor* memoryGovernor = [ApplicationDelegate sharedDelegate].gtpEngineMemoryGovernor;
+  for (NSString* commandString in [self.profile engineConfigurationCommandsForBoardSize:self.boardSize memoryGovernor:memoryGovernor])
+    [client submit:[GtpCommand command:commandString]];
+  [client submit:[GtpCommand command:@"uct_param_player ponder 0"]];
+
+  while ([self startNextGame])
+  {
+    NSAutoreleasePool* gamePool = [[NSAutoreleasePool alloc] init];
+    [self playGameWithClient:client];
+    [gamePool drain];
+
+    int numberOfGamesPlayed;
+    @synchronized(self)
+    {
+      numberOfGamesPlayed = ++self.numberOfGamesPlayed;
+    }
+    if (self.progressHandler)
+      self.progressHandler(numberOfGamesPlayed);
+  }
+
+  [mainPool drain];
+
+  [self.gamesCondition lock];
+  self.numberOfRunningThreads--;
+  [self.gamesCondition signal];
+  [self.gamesCondition unlock];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for playGamesWithClient:(). Returns true if another
+/// game should be played, false if all games have already been started.
+// -----------------------------------------------------------------------------
+- (bool) startNextGame
+{
+  [self.gamesCondition lock];
+  bool startNextGame = (self.numberOfGamesStarted < self.numberOfGames);
+  if (startNextGame)
+    self.numberOfGamesStarted++;
+  [self.gamesCondition unlock];
+  return startNextGame;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for playGamesWithClient:(). Plays a single game using
+/// @a client.
+// -----------------------------------------------------------------------------
+- (void) playGameWithClient:(GtpClient*)client
+{
+  [client submit:[GtpCommand command:[NSString stringWithFormat:@"boardsize %d", self.boardSize]]];
+  [client submit:[GtpCommand command:@"clear_board"]];
+  [client submit:[GtpCommand command:[NSString stringWithFormat:@"komi %.1f", self.komi]]];
+
+  int maximumNumberOfMoves = self.maximumNumberOfMovesPerGame;
+  if (maximumNumberOfMoves <= 0)
+    maximumNumberOfMoves = 2 * self.boardSize * self.boardSize;
+
+  int numberOfConsecutivePasses = 0;
+  for (int moveNumber = 0; moveNumber < maximumNumberOfMoves && numberOfConsecutivePasses < 2; ++moveNumber)
+  {
+    NSString* color = (0 == moveNumber % 2) ? @"B" : @"W";
+    GtpCommand* command = [GtpCommand command:[@"genmove " stringByAppendingString:color]];
+    [client submit:command];
+    if (! command.response.status)
+    {
+      DDLogError(@"%@: %@ failed, response = %@", self, command.command, command.response.parsedResponse);
+      break;
+    }
+
+    struct GoVertexNumeric vertex;
+    enum GtpMoveResponseType moveResponseType = [command.response decodeMove:&vertex];
+    if (GtpMoveResponseTypeResign == moveResponseType || GtpMoveResponseTypeInvalid == moveResponseType)
+      break;
+    if (GtpMoveResponseTypePass == moveResponseType)
+      numberOfConsecutivePasses++;
+    else
+      numberOfConsecutivePasses = 0;
+
+    long long numberOfPlayouts = [self numberOfPlayoutsOfLastSearchWithClient:client];
+    @synchronized(self)
+    {
+      self.numberOfMovesPlayed++;
+      self.numberOfPlayouts += numberOfPlayouts;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for playGameWithClient:(). Returns the number of
+/// playouts that the most recent search of the GTP engine behind @a client has
+/// made. Returns 0 if the number cannot be determined.
+// -----------------------------------------------------------------------------
+- (long long) numberOfPlayoutsOfLastSearchWithClient:(GtpClient*)client
+{
+  GtpCommand* command = [GtpCommand command:@"uct_stat_search"];
+  [client submit:command];
+
+  __block long long numberOfPlayouts = 0;
+  [command.response enumerateKeyValuePairsUsingBlock:^(const char* key, size_t keyLength, const char* value, size_t valueLength, bool* stop)
+  {
+    if (keyLength == strlen("GamesPlayed") && 0 == strncmp(key, "GamesPlayed", keyLength))
+    {
+      // The value is not NUL-terminated
+      char buffer[32];
+      size_t length = MIN(valueLength, sizeof(buffer) - 1);
+      memcpy(buffer, value, length);
+      buffer[length] = '\0';
+      numberOfPlayouts = strtoll(buffer, NULL, 10);
+      *stop = true;
+    }
+  }];
+  return numberOfPlayouts;
+}
+
+@end
@@ -0,0 +1,89 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Forward declarations
+@class GoGame;
+@class GoPoint;
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpMoveSpeculator class pre-computes the computer player's
+/// replies to the most likely moves of the human player while the human player
+/// is thinking.
+///
+/// @ingroup gtp
+///
+/// GtpMoveSpeculator becomes active when the computer player has played a
+/// move in a computer vs. human game and it is now the human player's turn.
+/// Speculation proceeds in two steps, both of which are processed by a
+/// secondary GTP engine, so that the primary GTP engine can keep pondering:
+/// - The candidate moves of the human player are determined by letting the GTP
+///   engine search the current board position from the human player's point
+///   of view ("reg_genmove"), and then querying the search statistics
+///   ("uct_gfx"). The candidates are the moves that the search visited most
+///   often.
+/// - For each candidate move, one after the other, the GTP engine plays the
+///   candidate move, generates a reply for the computer player
+///   ("reg_genmove") and takes back the candidate move again ("undo"). The
+///   reply is stored in GtpAnalysisCache under the key of the board position
+///   that results from the candidate move. The next candidate move is started
+///   when the response to "undo" arrives, at which point the secondary GTP
+///   engine is known to be back on the current board position.
+///
+/// All commands have the lowest priority, so that speculation never delays
+/// other analysis commands.
+///
+/// No new candidate move is started after the time budget has been used up.
+/// Speculation stops as soon as the board position changes, the game state
+/// changes, a new game is started, or the computer starts to think for other
+/// reasons, e.g. to generate a move suggestion.
+///
+/// When the human player actually plays one of the candidate moves,
+/// ComputerPlayMoveCommand obtains the reply from replyForGame:() and plays
+/// the reply without asking the GTP engine to search the board position
+/// again. Replies are stored under their own analysis key, separate from the
+/// key of a move suggestion for the same board position, so that replies and
+/// move suggestions never stand in for each other.
+///
+/// GtpMoveSpeculator requires a GtpEnginePool with at least one secondary
+/// GTP engine, and a GtpAnalysisCache.
+// -----------------------------------------------------------------------------
+@interface GtpMoveSpeculator : NSObject
+{
+}
+
+- (id) initWithNumberOfCandidates:(int)numberOfCandidates timeBudget:(NSTimeInterval)timeBudget;
+- (void) stop;
+- (GoPoint*) replyForGame:(GoGame*)game;
+
+/// @brief The maximum number of candidate moves for which a reply is
+/// pre-computed.
+@property(nonatomic, assign, readonly) int numberOfCandidates;
+/// @brief The time in seconds after which no new candidate move is started.
+@property(nonatomic, assign, readonly) NSTimeInterval timeBudget;
+/// @brief True if speculation is currently in progress.
+@property(nonatomic, assign, readonly, getter=isSpeculating) bool speculating;
+/// @brief The number of replies that were pre-computed so far.
+@property(nonatomic, assign, readonly) int numberOfReplies;
+/// @brief The number of times that replyForGame:() found a reply.
+@property(nonatomic, assign, readonly) int numberOfHits;
+/// @brief The number of times that replyForGame:() did not find a reply
+/// although a speculation had been started on the previous board position.
+@property(nonatomic, assign, readonly) int numberOfMisses;
+
+@end
@@ -0,0 +1,464 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Project includes
+#import "GtpMoveSpeculator.h"
+#import "GtpAnalysisCache.h"
+#import "GtpCommand.h"
+#import "GtpEnginePool.h"
+#import "GtpResponse.h"
+#import "../go/GoBoard.h"
+#import "../go/GoBoardPosition.h"
+#import "../go/GoGame.h"
+#import "../go/GoNode.h"
+#import "../go/GoPlayer.h"
+#import "../go/GoPoint.h"
+#import "../go/GoVertex.h"
+#import "../main/ApplicationDelegate.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GtpMoveSpeculator.
+// -----------------------------------------------------------------------------
+@interface GtpMoveSpeculator()
+@property(nonatomic, assign, readwrite) int numberOfCandidates;
+@property(nonatomic, assign, readwrite) NSTimeInterval timeBudget;
+@property(nonatomic, assign, readwrite, getter=isSpeculating) bool speculating;
+@property(nonatomic, assign, readwrite) int numberOfReplies;
+@property(nonatomic, assign, readwrite) int numberOfHits;
+@property(nonatomic, assign, readwrite) int numberOfMisses;
+/// @brief The time when the current speculation started, in seconds since the
+/// system was started.
+@property(nonatomic, assign) NSTimeInterval speculationStartTime;
+/// @brief The color of the human player in the current speculation, i.e. the
+/// color that plays the candidate moves.
+@property(nonatomic, retain) NSString* humanColorString;
+/// @brief The color of the computer player in the current speculation, i.e.
+/// the color that plays the replies.
+@property(nonatomic, retain) NSString* computerColorString;
+/// @brief The node of the board position on which the most recent speculation
+/// was started, i.e. the board position before the human player's move. Is
+/// @e nil if no speculation has been started since replyForGame:() was last
+/// invoked.
+@property(nonatomic, retain) GoNode* speculatedNode;
+/// @brief The candidate moves for which no reply has been requested yet.
+@property(nonatomic, retain) NSMutableArray* remainingCandidates;
+/// @brief The GtpCommand objects of the current speculation that may still be
+/// waiting to be processed.
+@property(nonatomic, retain) NSMutableArray* pendingCommands;
+/// @brief Maps reply commands to the GtpAnalysisCache key under which their
+/// result must be stored. The key is generated when the command is submitted,
+/// because the board position may have changed when the result arrives.
+@property(nonatomic, retain) NSMutableDictionary* analysisCacheKeys;
+@end
+
+
+@implementation GtpMoveSpeculator
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpMoveSpeculator object that pre-computes replies for
+/// up to @a numberOfCandidates candidate moves, and that does not start a new
+/// candidate move after @a timeBudget seconds.
+///
+/// @note This is the designated initializer of GtpMoveSpeculator.
+// -----------------------------------------------------------------------------
+- (id) initWithNumberOfCandidates:(int)numberOfCandidates timeBudget:(NSTimeInterval)timeBudget
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.numberOfCandidates = numberOfCandidates;
+  self.timeBudget = timeBudget;
+  self.speculating = false;
+  self.numberOfReplies = 0;
+  self.numberOfHits = 0;
+  self.numberOfMisses = 0;
+  self.speculationStartTime = 0;
+  self.humanColorString = nil;
+  self.computerColorString = nil;
+  self.speculatedNode = nil;
+  self.remainingCandidates = [NSMutableArray array];
+  self.pendingCommands = [NSMutableArray array];
+  self.analysisCacheKeys = [NSMutableDictionary dictionary];
+
+  NSNotificationCenter* center = [NSNotificationCenter defaultCenter];
+  [center addObserver:self selector:@selector(computerPlayerThinkingStops:) name:computerPlayerThinkingStops object:nil];
+  [center addObserver:self selector:@selector(stopSpeculation:) name:computerPlayerThinkingStarts object:nil];
+  [center addObserver:self selector:@selector(stopSpeculation:) name:currentBoardPositionDidChange object:nil];
+  [center addObserver:self selector:@selector(stopSpeculation:) name:goGameStateChanged object:nil];
+  [center addObserver:self selector:@selector(stopSpeculation:) name:goGameWillCreate object:nil];
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GtpMoveSpeculator object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  [[NSNotificationCenter defaultCenter] removeObserver:self];
+  self.humanColorString = nil;
+  self.computerColorString = nil;
+  self.speculatedNode = nil;
+  self.remainingCandidates = nil;
+  self.pendingCommands = nil;
+  self.analysisCacheKeys = nil;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Stops the current speculation. Drops the GTP commands of the current
+/// speculation that are still waiting to be processed.
+///
+/// A reply that the GTP engine is currently generating is still stored in
+/// GtpAnalysisCache when it arrives.
+// -----------------------------------------------------------------------------
+- (void) stop
+{
+  if (! self.speculating)
+    return;
+
+  for (GtpCommand* command in self.pendingCommands)
+    [command cancel];
+  [self.pendingCommands removeAllObjects];
+  [self.remainingCandidates removeAllObjects];
+  self.speculating = false;
+
+  NSTimeInterval duration = [NSProcessInfo processInfo].systemUptime - self.speculationStartTime;
+  DDLogVerbose(@"%@: Speculation stopped after %.1f seconds", self, duration);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the pre-computed reply of the computer player for the
+/// current board position of @a game. Returns @e nil if no reply is known, or
+/// if the reply is not a legal move. Pass and resign replies are never
+/// returned, the GTP engine must generate these itself.
+///
+/// A missing reply counts as a miss only if a speculation was started on the
+/// board position before the current board position, i.e. if the human
+/// player's move could have been one of the candidate moves.
+// -----------------------------------------------------------------------------
+- (GoPoint*) replyForGame:(GoGame*)game
+{
+  GoNode* speculatedNode = [[self.speculatedNode retain] autorelease];
+  self.speculatedNode = nil;
+
+  NSString* analysis = [self replyAnalysisForColorString:game.nextMovePlayer.colorString];
+  NSString* analysisCacheKey = [GtpAnalysisCache keyForAnalysis:analysis];
+  NSData* responseData = [[ApplicationDelegate sharedDelegate].gtpAnalysisCache resultForKey:analysisCacheKey];
+  NSString* vertex = [GtpMoveSpeculator vertexInsideResponseData:responseData];
+  GoPoint* point = vertex ? [game.board pointAtVertex:vertex] : nil;
+
+  enum GoMoveIsIllegalReason illegalReason;
+  if (! point || ! [game isLegalMove:point isIllegalReason:&illegalReason])
+  {
+    if (speculatedNode && speculatedNode == game.boardPosition.currentNode.parent)
+      self.numberOfMisses++;
+    return nil;
+  }
+
+  self.numberOfHits++;
+  DDLogInfo(@"%@: Found pre-computed reply %@", self, vertex);
+  return point;
+}
+
+#pragma mark - Notification responders
+
+// -----------------------------------------------------------------------------
+/// @brief Responds to the #computerPlayerThinkingStops notification. Starts a
+/// new speculation if it is now the human player's turn.
+// -----------------------------------------------------------------------------
+- (void) computerPlayerThinkingStops:(NSNotification*)notification
+{
+  [self stop];
+
+  GoGame* game = [GoGame sharedGame];
+  if (! [self canSpeculateInGame:game])
+    return;
+
+  self.speculating = true;
+  self.speculationStartTime = [NSProcessInfo processInfo].systemUptime;
+  self.speculatedNode = game.boardPosition.currentNode;
+  self.humanColorString = game.nextMovePlayer.colorString;
+  self.computerColorString = ([self.humanColorString isEqualToString:@"B"] ? @"W" : @"B");
+
+  NSString* searchCommandString = [self replyCommandStringForColorString:self.humanColorString];
+  NSArray* commands = @[[self commandWithString:searchCommandString selector:nil],
+                        [self commandWithString:@"uct_gfx" selector:@selector(candidatesReceived:)]];
+  [self submitCommands:commands];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Responds to notifications that invalidate the current speculation.
+// -----------------------------------------------------------------------------
+- (void) stopSpeculation:(NSNotification*)notification
+{
+  [self stop];
+}
+
+#pragma mark - GTP responses
+
+// -----------------------------------------------------------------------------
+/// @brief Is triggered when the GTP engine responds to the "uct_gfx" command
+/// submitted in computerPlayerThinkingStops:(). Selects the candidate moves
+/// and starts to pre-compute the first reply.
+// -----------------------------------------------------------------------------
+- (void) candidatesReceived:(GtpResponse*)response
+{
+  if (! [self isCurrentResponse:response])
+    return;
+  [self.pendingCommands removeAllObjects];
+
+  GoGame* game = [GoGame sharedGame];
+  GtpAnalysisCache* analysisCache = [ApplicationDelegate sharedDelegate].gtpAnalysisCache;
+  NSString* replyAnalysis = [self replyAnalysisForColorString:self.computerColorString];
+  for (NSString* vertex in [GtpMoveSpeculator candidateVerticesInsideResponse:response])
+  {
+    if ((int)self.remainingCandidates.count >= self.numberOfCandidates)
+      break;
+    GoPoint* point = [game.board pointAtVertex:vertex];
+    enum GoMoveIsIllegalReason illegalReason;
+    if (! point || ! [game isLegalMove:point isIllegalReason:&illegalReason])
+      continue;
+    // Don't compute again what is already known, e.g. from an earlier
+    // speculation that was interrupted by a move suggestion
+    if ([analysisCache resultForKey:[GtpAnalysisCache keyForAnalysis:replyAnalysis afterMoveAtPoint:point]])
+      continue;
+    [self.remainingCandidates addObject:point];
+  }
+
+  DDLogVerbose(@"%@: Speculating on %lu candidate moves", self, (unsigned long)self.remainingCandidates.count);
+  [self speculateOnNextCandidate];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Is triggered when the GTP engine responds to a "reg_genmove" command
+/// submitted in speculateOnNextCandidate(). Stores the reply.
+// -----------------------------------------------------------------------------
+- (void) replyReceived:(GtpResponse*)response
+{
+  NSValue* commandKey = [NSValue valueWithNonretainedObject:response.command];
+  NSString* analysisCacheKey = [[[self.analysisCacheKeys objectForKey:commandKey] retain] autorelease];
+  [self.analysisCacheKeys removeObjectForKey:commandKey];
+  if (analysisCacheKey && response.status)
+  {
+    [[ApplicationDelegate sharedDelegate].gtpAnalysisCache storeResult:response.rawResponseData forKey:analysisCacheKey];
+    self.numberOfReplies++;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Is triggered when the GTP engine responds to an "undo" command
+/// submitted in speculateOnNextCandidate(). Starts to pre-compute the next
+/// reply.
+///
+/// The next reply must not be submitted earlier, e.g. when the previous reply
+/// is received. The GtpEnginePositionTracker of the secondary GTP engine only
+/// knows that the candidate move has been taken back after it has seen the
+/// response to "undo". Until then GtpEnginePool would consider the secondary
+/// GTP engine to be out of sync and set up the board position from scratch.
+// -----------------------------------------------------------------------------
+- (void) undoReceived:(GtpResponse*)response
+{
+  if (! [self isCurrentResponse:response])
+    return;
+  [self speculateOnNextCandidate];
+}
+
+#pragma mark - Private helpers
+
+// -----------------------------------------------------------------------------
+/// @brief Submits the commands that pre-compute the reply to the next
+/// candidate move. Ends the speculation if there are no more candidate moves,
+/// or if the time budget has been used up.
+// -----------------------------------------------------------------------------
+- (void) speculateOnNextCandidate
+{
+  NSTimeInterval duration = [NSProcessInfo processInfo].systemUptime - self.speculationStartTime;
+  if (0 == self.remainingCandidates.count || duration >= self.timeBudget)
+  {
+    [self stop];
+    return;
+  }
+  [self.pendingCommands removeAllObjects];
+
+  GoPoint* candidate = [[[self.remainingCandidates objectAtIndex:0] retain] autorelease];
+  [self.remainingCandidates removeObjectAtIndex:0];
+
+  NSString* replyAnalysis = [self replyAnalysisForColorString:self.computerColorString];
+  NSString* replyCommandString = [self replyCommandStringForColorString:self.computerColorString];
+  NSString* playCommandString = [NSString stringWithFormat:@"play %@ %@", self.humanColorString, candidate.vertex.string];
+  GtpCommand* replyCommand = [self commandWithString:replyCommandString selector:@selector(replyReceived:)];
+  [self.analysisCacheKeys setObject:[GtpAnalysisCache keyForAnalysis:replyAnalysis afterMoveAtPoint:candidate]
+                             forKey:[NSValue valueWithNonretainedObject:replyCommand]];
+
+  NSArray* commands = @[[self commandWithString:playCommandString selector:nil],
+                        replyCommand,
+                        [self commandWithString:@"undo" selector:@selector(undoReceived:)]];
+  if (! [self submitCommands:commands])
+    [self.analysisCacheKeys removeObjectForKey:[NSValue valueWithNonretainedObject:replyCommand]];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Submits @a commands as a sequence to a secondary GTP engine. Returns
+/// true on success. Ends the speculation and returns false on failure.
+// -----------------------------------------------------------------------------
+- (bool) submitCommands:(NSArray*)commands
+{
+  [self.pendingCommands addObjectsFromArray:commands];
+  if ([[ApplicationDelegate sharedDelegate].gtpEnginePool submitAnalysisSequence:commands])
+    return true;
+
+  DDLogWarn(@"%@: No secondary GTP engine available, stopping speculation", self);
+  [self stop];
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a new asynchronous analysis command with command string
+/// @a commandString. The response is delivered to @a selector, or is ignored
+/// if @a selector is @e nil.
+// -----------------------------------------------------------------------------
+- (GtpCommand*) commandWithString:(NSString*)commandString selector:(SEL)selector
+{
+  GtpCommand* command = [GtpCommand asynchronousCommand:commandString
+                                         responseTarget:(selector ? self : nil)
+                                               selector:selector];
+  command.kind = GtpCommandKindAnalysis;
+  // Speculation must not delay other analysis commands. GtpEnginePool makes
+  // sure that the commands of a sequence are not interleaved with other
+  // commands.
+  command.priority = GtpCommandPriorityLow;
+  return command;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the GTP command string that generates a move for
+/// @a colorString.
+// -----------------------------------------------------------------------------
+- (NSString*) replyCommandStringForColorString:(NSString*)colorString
+{
+  return [@"reg_genmove " stringByAppendingString:colorString];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the analysis under which a reply for @a colorString is
+/// stored in GtpAnalysisCache.
+///
+/// The analysis deliberately differs from the GTP command string, which
+/// ComputerSuggestMoveCommand uses as its analysis. Separate entries make sure
+/// that the computer player never plays a move suggestion that it was not
+/// asked for, and that @e numberOfHits measures the speculation alone.
+// -----------------------------------------------------------------------------
+- (NSString*) replyAnalysisForColorString:(NSString*)colorString
+{
+  return [@"speculative_reply " stringByAppendingString:colorString];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if @a response belongs to the current speculation.
+// -----------------------------------------------------------------------------
+- (bool) isCurrentResponse:(GtpResponse*)response
+{
+  return (self.speculating && [self.pendingCommands containsObject:response.command]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if a speculation can be started in @a game.
+// -----------------------------------------------------------------------------
+- (bool) canSpeculateInGame:(GoGame*)game
+{
+  if (! game || ! [ApplicationDelegate sharedDelegate].gtpAnalysisCache)
+    return false;
+  if (GoGameTypeComputerVsHuman != game.type || GoGameStateGameHasStarted != game.state)
+    return false;
+  if (game.nextMovePlayerIsComputerPlayer || game.isComputerThinking || ! game.boardPosition.isLastPosition)
+    return false;
+  return (self.numberOfCandidates > 0 && self.timeBudget > 0);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the vertices inside the "LABEL" line of the "uct_gfx"
+/// @a response, ordered by the number of times the search visited them,
+/// beginning with the vertex that was visited most often. Returns an empty
+/// array if @a response contains no such vertices.
+// -----------------------------------------------------------------------------
++ (NSArray*) candidateVerticesInsideResponse:(GtpResponse*)response
+{
+  NSMutableArray* candidates = [NSMutableArray array];
+  if (! response.status)
+    return candidates;
+
+  NSCharacterSet* whitespace = [NSCharacterSet whitespaceCharacterSet];
+  NSMutableDictionary* counts = [NSMutableDictionary dictionary];
+  for (NSString* line in [response.parsedResponse componentsSeparatedByCharactersInSet:[NSCharacterSet newlineCharacterSet]])
+  {
+    NSArray* tokens = [line componentsSeparatedByCharactersInSet:whitespace];
+    if (0 == tokens.count || ! [[tokens objectAtIndex:0] isEqualToString:@"LABEL"])
+      continue;
+    // The line has the format "LABEL vertex count vertex count ..."
+    for (NSUInteger indexOfToken = 1; indexOfToken + 1 < tokens.count; indexOfToken += 2)
+    {
+      NSString* vertex = [[tokens objectAtIndex:indexOfToken] uppercaseString];
+      if ([vertex isEqualToString:@"PASS"])
+        continue;
+      [counts setObject:[NSNumber numberWithLongLong:[[tokens objectAtIndex:indexOfToken + 1] longLongValue]]
+                 forKey:vertex];
+    }
+  }
+
+  [candidates addObjectsFromArray:[counts keysSortedByValueUsingComparator:^(id count1, id count2)
+  {
+    // Descending order
+    return [count2 compare:count1];
+  }]];
+  return candidates;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the vertex inside the raw "reg_genmove" response
+/// @a responseData. Returns @e nil if @a responseData is @e nil, if it is not
+/// a success response, or if it does not contain a vertex (e.g. pass or
+/// resign).
+// -----------------------------------------------------------------------------
++ (NSString*) vertexInsideResponseData:(NSData*)responseData
+{
+  if (! responseData)
+    return nil;
+  NSString* responseString = [[[NSString alloc] initWithData:responseData encoding:NSUTF8StringEncoding] autorelease];
+  if (! [responseString hasPrefix:@"="])
+    return nil;
+
+  NSString* vertex = [[responseString substringFromIndex:1] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+  NSString* lowercaseVertex = [vertex lowercaseString];
+  if (0 == vertex.length || [lowercaseVertex isEqualToString:@"pass"] || [lowercaseVertex isEqualToString:@"resign"])
+    return nil;
+  @try
+  {
+    [GoVertex vertexFromString:vertex];
+  }
+  @catch (NSException* exception)
+  {
+    return nil;
+  }
+  return vertex;
+}
+
+@end
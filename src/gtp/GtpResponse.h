@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,27 +15,60 @@
 // -----------------------------------------------------------------------------
 
 
+// Project includes
+#import "../go/GoVertexNumeric.h"
+
 // Forward declarations
 @class GtpCommand;
 
 
+/// @brief Enumerates the types of moves that can be found in the response to
+/// a move generating GTP command such as "genmove".
+enum GtpMoveResponseType
+{
+  GtpMoveResponseTypeInvalid,   ///< @brief The response does not contain a move.
+  GtpMoveResponseTypeVertex,    ///< @brief The response contains a vertex.
+  GtpMoveResponseTypePass,      ///< @brief The response is "pass".
+  GtpMoveResponseTypeResign     ///< @brief The response is "resign".
+};
+
+
 // -----------------------------------------------------------------------------
 /// @brief The GtpResponse class represents a Go Text Protocol (GTP) response.
 ///
 /// @ingroup gtp
 ///
-/// GtpResponse is mainly a wrapper around a string that forms the actual GTP
+/// GtpResponse is mainly a wrapper around the bytes that form the actual GTP
 /// response. The raw response includes the status prefix, while the parsed
 /// response does not.
+///
+/// GtpResponse creates NSString objects only on demand, when the raw or the
+/// parsed response are requested for the first time. Clients that process
+/// the response of a frequently submitted command with a well-known response
+/// format should use one of the typed decoding methods instead. These methods
+/// work directly on the bytes received from the GTP engine and decode them into
+/// native C arrays, without allocating any Objective-C objects.
 // -----------------------------------------------------------------------------
 @interface GtpResponse : NSObject
 {
 }
 
-+ (GtpResponse*) response:(NSString*)response toCommand:(GtpCommand*)command;
++ (GtpResponse*) responseWithData:(NSData*)responseData toCommand:(GtpCommand*)command;
 - (NSString*) parsedResponse;
 
-/// @brief The raw response string, which includes the status prefix.
+/// @name Typed decoding
+//@{
+- (bool) decodeFloatGrid:(float*)values numberOfRows:(int)numberOfRows numberOfColumns:(int)numberOfColumns;
+- (int) decodeVertexList:(struct GoVertexNumeric*)vertices capacity:(int)capacity;
+- (enum GtpMoveResponseType) decodeMove:(struct GoVertexNumeric*)vertex;
+- (void) enumerateKeyValuePairsUsingBlock:(void (^)(const char* key, size_t keyLength, const char* value, size_t valueLength, bool* stop))block;
+//@}
+
+/// @brief The raw response bytes as they were received from the GTP engine,
+/// including the status prefix.
+@property(nonatomic, retain, readonly) NSData* rawResponseData;
+/// @brief The raw response string, which includes the status prefix. The
+/// string is created on demand from @e rawResponseData.
 @property(nonatomic, retain, readonly) NSString* rawResponse;
 /// @brief The GtpCommand object that this GtpResponse "belongs" to.
 ///
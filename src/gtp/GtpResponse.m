@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2013 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -18,6 +18,16 @@
 // Project includes
 #import "GtpResponse.h"
 
+// System includes
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/// @brief The maximum length of a single token (e.g. a floating point number)
+/// that the typed decoding methods of GtpResponse can handle.
+static const size_t maximumTokenLength = 63;
+
 
 // -----------------------------------------------------------------------------
 /// @brief Class extension with private properties for GtpResponse.
@@ -25,27 +35,122 @@
 @interface GtpResponse()
 /// @name Re-declaration of properties to make them readwrite privately
 //@{
+@property(nonatomic, retain, readwrite) NSData* rawResponseData;
 @property(nonatomic, retain, readwrite) NSString* rawResponse;
 @property(nonatomic, assign, readwrite) GtpCommand* command;
 //@}
 @end
 
 
+// -----------------------------------------------------------------------------
+/// @brief Private helper for the typed decoding methods. Finds the next
+/// whitespace-separated token in @a bytes, starting at @a position. Returns
+/// true if a token was found, false if the end of @a bytes was reached.
+///
+/// On success @a token and @a tokenLength refer to the token, @a position
+/// is advanced beyond the token, and @a isEndOfLine indicates whether the
+/// token is the last token on its line.
+// -----------------------------------------------------------------------------
+static bool nextToken(const char* bytes, size_t length, size_t* position, const char** token, size_t* tokenLength, bool* isEndOfLine)
+{
+  size_t tokenStart = *position;
+  while (tokenStart < length && isspace((unsigned char)bytes[tokenStart]))
+    tokenStart++;
+  if (tokenStart >= length)
+  {
+    *position = length;
+    return false;
+  }
+
+  size_t tokenEnd = tokenStart;
+  while (tokenEnd < length && ! isspace((unsigned char)bytes[tokenEnd]))
+    tokenEnd++;
+
+  size_t lookAhead = tokenEnd;
+  while (lookAhead < length && bytes[lookAhead] == ' ')
+    lookAhead++;
+
+  *token = bytes + tokenStart;
+  *tokenLength = tokenEnd - tokenStart;
+  *isEndOfLine = (lookAhead >= length || bytes[lookAhead] == '\n');
+  *position = tokenEnd;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for the typed decoding methods. Decodes the floating
+/// point number in @a token. Returns true on success, false on failure.
+// -----------------------------------------------------------------------------
+static bool decodeFloat(const char* token, size_t tokenLength, float* value)
+{
+  if (tokenLength == 0 || tokenLength > maximumTokenLength)
+    return false;
+
+  // strtof() requires a NUL-terminated string
+  char buffer[maximumTokenLength + 1];
+  memcpy(buffer, token, tokenLength);
+  buffer[tokenLength] = '\0';
+
+  char* end;
+  *value = strtof(buffer, &end);
+  return (end == buffer + tokenLength);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for the typed decoding methods. Decodes the vertex
+/// in @a token (e.g. "D4" or "q16"). Returns true on success, false on failure.
+/// The conversion rules are the same as in GoVertex::vertexFromString:().
+// -----------------------------------------------------------------------------
+static bool decodeVertex(const char* token, size_t tokenLength, struct GoVertexNumeric* vertex)
+{
+  if (tokenLength < 2 || tokenLength > 3)
+    return false;
+
+  char letterAxisCompound = toupper((unsigned char)token[0]);
+  if (letterAxisCompound < 'A' || letterAxisCompound > 'T' || letterAxisCompound == 'I')
+    return false;
+
+  int x = letterAxisCompound - 'A' + 1;  // +1 because vertex is not zero-based
+  if (letterAxisCompound > 'H')
+    x--;                                 // -1 because "I" is never used
+
+  int y = 0;
+  for (size_t index = 1; index < tokenLength; ++index)
+  {
+    if (! isdigit((unsigned char)token[index]))
+      return false;
+    y = y * 10 + (token[index] - '0');
+  }
+
+  if (y < 1 || y > 19)
+    return false;
+
+  vertex->x = x;
+  vertex->y = y;
+  return true;
+}
+
+
 @implementation GtpResponse
 
 // -----------------------------------------------------------------------------
 /// @brief Convenience constructor. Creates a GtpResponse instance that wraps
-/// the response string @a response, and is a response to @a command.
+/// the response bytes @a responseData, and is a response to @a command.
+/// @a responseData is expected to be encoded with the default C string
+/// encoding.
 // -----------------------------------------------------------------------------
-+ (GtpResponse*) response:(NSString*)response toCommand:(GtpCommand*)command
++ (GtpResponse*) responseWithData:(NSData*)responseData toCommand:(GtpCommand*)command
 {
   GtpResponse* resp = [[GtpResponse alloc] init];
   if (resp)
   {
-    resp.rawResponse = response;
+    resp.rawResponseData = responseData;
     resp.command = command;
     [resp autorelease];
-    DDLogInfo(@"Received %@ (to %@)", resp, command);
+    // Don't log the response itself, that would decode the response bytes
+    // into a string, which is exactly what we want to avoid for clients that
+    // use the typed decoding methods
+    DDLogInfo(@"Received GtpResponse(%p): %lu bytes (to %@)", resp, (unsigned long)responseData.length, command);
   }
   return resp;
 }
@@ -62,6 +167,7 @@
   if (! self)
     return nil;
 
+  self.rawResponseData = nil;
   self.rawResponse = nil;
   self.command = nil;
 
@@ -73,6 +179,7 @@
 // -----------------------------------------------------------------------------
 - (void) dealloc
 {
+  self.rawResponseData = nil;
   self.rawResponse = nil;
   self.command = nil;
   [super dealloc];
@@ -86,9 +193,31 @@
 // -----------------------------------------------------------------------------
 - (NSString*) description
 {
-  // Don't use self to access properties to avoid unnecessary overhead during
-  // debugging
-  return [NSString stringWithFormat:@"GtpResponse(%p): %@", self, _rawResponse];
+  // Don't use self to access the raw response, the property getter would
+  // decode the response bytes into a string if that has not happened yet
+  if (_rawResponse)
+    return [NSString stringWithFormat:@"GtpResponse(%p): %@", self, _rawResponse];
+  else
+    return [NSString stringWithFormat:@"GtpResponse(%p): %lu bytes", self, (unsigned long)_rawResponseData.length];
+}
+
+// -----------------------------------------------------------------------------
+// Property is documented in the header file.
+// -----------------------------------------------------------------------------
+- (NSString*) rawResponse
+{
+  // The response is created in the context of the secondary thread that
+  // processes GTP commands, but consumed in the context of other threads
+  @synchronized(self)
+  {
+    if (! _rawResponse && _rawResponseData)
+    {
+      _rawResponse = [[NSString alloc] initWithBytes:_rawResponseData.bytes
+                                              length:_rawResponseData.length
+                                            encoding:[NSString defaultCStringEncoding]];
+    }
+    return [[_rawResponse retain] autorelease];
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -109,13 +238,218 @@
 // -----------------------------------------------------------------------------
 - (bool) status
 {
-  if (! self.rawResponse)
+  if (! self.rawResponseData || self.rawResponseData.length == 0)
     return false;
-  NSString* statusString = [self.rawResponse substringWithRange:NSMakeRange(0, 1)];
-  if (NSOrderedSame == [statusString compare:@"="])
-    return true;
-  else
+  const char* bytes = self.rawResponseData.bytes;
+  return (bytes[0] == '=');
+}
+
+#pragma mark - Typed decoding
+
+// -----------------------------------------------------------------------------
+/// @brief Decodes a grid of floating point numbers that consists of
+/// @a numberOfRows lines with @a numberOfColumns numbers each. Stores the
+/// numbers in @a values, which must have room for at least
+/// @a numberOfRows * @a numberOfColumns elements. Returns true on success,
+/// false on failure (e.g. if the response contains too many or not enough
+/// numbers, or if the response is not a success response).
+///
+/// The numbers are stored in the order in which they appear in the response.
+/// For a GTP command such as "uct_stat_territory" that prints the board, this
+/// means that the first element of @a values is the number for the top-left
+/// intersection, and that elements are stored row by row, top to bottom.
+///
+/// Empty lines in the response are ignored.
+// -----------------------------------------------------------------------------
+- (bool) decodeFloatGrid:(float*)values numberOfRows:(int)numberOfRows numberOfColumns:(int)numberOfColumns
+{
+  if (! self.status)
     return false;
+
+  const char* bytes;
+  size_t length;
+  [self getBodyBytes:&bytes length:&length];
+
+  int numberOfValues = numberOfRows * numberOfColumns;
+  int valueIndex = 0;
+  int columnIndex = 0;
+  size_t position = 0;
+  while (true)
+  {
+    const char* token;
+    size_t tokenLength;
+    bool isEndOfLine;
+    if (! nextToken(bytes, length, &position, &token, &tokenLength, &isEndOfLine))
+      break;
+
+    if (valueIndex >= numberOfValues)
+      return false;
+
+    float value;
+    if (! decodeFloat(token, tokenLength, &value))
+      return false;
+    values[valueIndex] = value;
+    valueIndex++;
+    columnIndex++;
+
+    if (isEndOfLine)
+    {
+      if (columnIndex != numberOfColumns)
+        return false;
+      columnIndex = 0;
+    }
+  }
+
+  return (valueIndex == numberOfValues);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Decodes a list of vertices that are separated by whitespace (spaces
+/// or newlines). Stores the vertices in @a vertices, which must have room for
+/// at least @a capacity elements. Returns the number of vertices that were
+/// decoded. Returns -1 on failure (e.g. if the response contains something that
+/// is not a vertex, if it contains more than @a capacity vertices, or if the
+/// response is not a success response).
+///
+/// An empty response is valid and results in 0 (zero) being returned.
+// -----------------------------------------------------------------------------
+- (int) decodeVertexList:(struct GoVertexNumeric*)vertices capacity:(int)capacity
+{
+  if (! self.status)
+    return -1;
+
+  const char* bytes;
+  size_t length;
+  [self getBodyBytes:&bytes length:&length];
+
+  int numberOfVertices = 0;
+  size_t position = 0;
+  while (true)
+  {
+    const char* token;
+    size_t tokenLength;
+    bool isEndOfLine;
+    if (! nextToken(bytes, length, &position, &token, &tokenLength, &isEndOfLine))
+      break;
+
+    if (numberOfVertices >= capacity)
+      return -1;
+    if (! decodeVertex(token, tokenLength, &vertices[numberOfVertices]))
+      return -1;
+    numberOfVertices++;
+  }
+
+  return numberOfVertices;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Decodes the response to a move generating GTP command such as
+/// "genmove". If the response contains a vertex, the vertex is stored in
+/// @a vertex. Returns a value that indicates the type of move found in the
+/// response.
+// -----------------------------------------------------------------------------
+- (enum GtpMoveResponseType) decodeMove:(struct GoVertexNumeric*)vertex
+{
+  if (! self.status)
+    return GtpMoveResponseTypeInvalid;
+
+  const char* bytes;
+  size_t length;
+  [self getBodyBytes:&bytes length:&length];
+
+  const char* token;
+  size_t tokenLength;
+  bool isEndOfLine;
+  size_t position = 0;
+  if (! nextToken(bytes, length, &position, &token, &tokenLength, &isEndOfLine))
+    return GtpMoveResponseTypeInvalid;
+
+  const char* remainingToken;
+  size_t remainingTokenLength;
+  if (nextToken(bytes, length, &position, &remainingToken, &remainingTokenLength, &isEndOfLine))
+    return GtpMoveResponseTypeInvalid;
+
+  if (tokenLength == 4 && strncasecmp(token, "pass", 4) == 0)
+    return GtpMoveResponseTypePass;
+  else if (tokenLength == 6 && strncasecmp(token, "resign", 6) == 0)
+    return GtpMoveResponseTypeResign;
+  else if (decodeVertex(token, tokenLength, vertex))
+    return GtpMoveResponseTypeVertex;
+  else
+    return GtpMoveResponseTypeInvalid;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Invokes @a block once for every non-empty line in the response. The
+/// first whitespace-separated token on the line is passed to @a block as the
+/// key, the remainder of the line (with leading and trailing whitespace
+/// removed) is passed as the value. The value may be empty. Does nothing if the
+/// response is not a success response.
+///
+/// The key and value pointers refer directly to the response bytes. They are
+/// not NUL-terminated and are valid only for the duration of the block
+/// invocation. @a block can set @a stop to true to stop the enumeration.
+// -----------------------------------------------------------------------------
+- (void) enumerateKeyValuePairsUsingBlock:(void (^)(const char* key, size_t keyLength, const char* value, size_t valueLength, bool* stop))block
+{
+  if (! self.status)
+    return;
+
+  const char* bytes;
+  size_t length;
+  [self getBodyBytes:&bytes length:&length];
+
+  size_t lineStart = 0;
+  while (lineStart < length)
+  {
+    size_t lineEnd = lineStart;
+    while (lineEnd < length && bytes[lineEnd] != '\n')
+      lineEnd++;
+
+    size_t keyStart = lineStart;
+    while (keyStart < lineEnd && isspace((unsigned char)bytes[keyStart]))
+      keyStart++;
+    size_t keyEnd = keyStart;
+    while (keyEnd < lineEnd && ! isspace((unsigned char)bytes[keyEnd]))
+      keyEnd++;
+    size_t valueStart = keyEnd;
+    while (valueStart < lineEnd && isspace((unsigned char)bytes[valueStart]))
+      valueStart++;
+    size_t valueEnd = lineEnd;
+    while (valueEnd > valueStart && isspace((unsigned char)bytes[valueEnd - 1]))
+      valueEnd--;
+
+    if (keyEnd > keyStart)
+    {
+      bool stop = false;
+      block(bytes + keyStart, keyEnd - keyStart, bytes + valueStart, valueEnd - valueStart, &stop);
+      if (stop)
+        break;
+    }
+
+    lineStart = lineEnd + 1;
+  }
+}
+
+#pragma mark - Private helpers
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper for the typed decoding methods. Provides the bytes of
+/// the response body, i.e. the raw response without the status prefix.
+// -----------------------------------------------------------------------------
+- (void) getBodyBytes:(const char**)bytes length:(size_t*)length
+{
+  const char* rawBytes = self.rawResponseData.bytes;
+  size_t rawLength = self.rawResponseData.length;
+
+  // Skip the status character and the optional command ID. parsedResponse()
+  // does not support the command ID either, but we can do better at no cost.
+  size_t bodyStart = (rawLength > 0) ? 1 : 0;
+  while (bodyStart < rawLength && isdigit((unsigned char)rawBytes[bodyStart]))
+    bodyStart++;
+
+  *bytes = rawBytes + bodyStart;
+  *length = rawLength - bodyStart;
 }
 
 @end
@@ -0,0 +1,89 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Forward declarations
+@class GtpCommand;
+
+
+/// @brief Enumerates the stages that a GTP command passes through between
+/// being submitted and its response target being notified.
+enum GtpCommandStage
+{
+  /// @brief From GtpClient::submit:() until GtpClient's thread starts to
+  /// process the command. Includes the time the command spends in the queue
+  /// and the run loop dispatch to GtpClient's thread.
+  GtpCommandStageQueue,
+  /// @brief Writing the command to the GTP engine's input stream, including
+  /// the flush that wakes up the GTP engine.
+  GtpCommandStageWrite,
+  /// @brief From the flush until the first line of the response has been read.
+  /// This is mainly the time the GTP engine spends computing the response.
+  GtpCommandStageEngine,
+  /// @brief Reading the rest of the response from the GTP engine's output
+  /// stream.
+  GtpCommandStageRead,
+  /// @brief From the end of the response until the response target is
+  /// notified in the context of the submitting thread. Only commands with a
+  /// response target pass through this stage.
+  GtpCommandStageCallback,
+  /// @brief From GtpClient::submit:() until the response has been read, or
+  /// until the response target is notified if the command has one.
+  GtpCommandStageTotal,
+  GtpCommandStageMax  ///< @brief Pseudo stage, used as upper bound.
+};
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GtpStatistics class collects timing and throughput statistics
+/// about the GTP commands that have been processed by the GtpClients of a
+/// GtpEnginePool.
+///
+/// @ingroup gtp
+///
+/// GtpClient records timestamps in a GtpCommand as the command passes through
+/// the stages enumerated by #GtpCommandStage, then hands the command over to
+/// recordCommand:(). GtpStatistics aggregates the durations of the stages per
+/// command name (i.e. the first word of the GTP command string) into
+/// histograms, from which percentiles can be calculated. Histogram buckets
+/// grow exponentially, so percentiles are approximations with a relative error
+/// of less than 20%.
+///
+/// The statistics make it possible to tell apart the time that a command waits
+/// for its turn from the time that the GTP engine needs to compute the
+/// response. They are shown in the diagnostics view and are included in the
+/// diagnostics information file.
+///
+/// All methods in GtpStatistics are thread-safe.
+// -----------------------------------------------------------------------------
+@interface GtpStatistics : NSObject
+{
+}
+
+- (id) init;
+
+- (void) recordCommand:(GtpCommand*)command;
+
+- (NSArray*) commandNames;
+- (int) countForCommandName:(NSString*)commandName;
+- (long long) bytesSentForCommandName:(NSString*)commandName;
+- (long long) bytesReceivedForCommandName:(NSString*)commandName;
+- (NSTimeInterval) percentile:(int)percentile ofStage:(enum GtpCommandStage)stage forCommandName:(NSString*)commandName;
+
+- (NSString*) report;
+
+@end
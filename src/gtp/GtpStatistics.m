@@ -0,0 +1,323 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Project includes
+#import "GtpStatistics.h"
+#import "GtpCommand.h"
+#import "GtpResponse.h"
+
+
+/// @brief The number of buckets in a histogram.
+static const int numberOfHistogramBuckets = 96;
+/// @brief The upper bound, in seconds, of the first histogram bucket.
+static const double firstHistogramBucketUpperBound = 0.00001;
+/// @brief The number of histogram buckets that are needed to double the
+/// upper bound. The upper bound of bucket @e i is
+/// <tt>firstHistogramBucketUpperBound * 2^(i / 4)</tt>, so the upper bound of
+/// the last but one bucket (i = 94) is 0.00001 * 2^23.5, i.e. roughly 118
+/// seconds. The last bucket has no upper bound.
+static const int numberOfHistogramBucketsPerDoubling = 4;
+
+/// @brief Aggregated statistics of all commands with the same command name.
+struct GtpCommandNameStatistics
+{
+  int count;
+  long long bytesSent;
+  long long bytesReceived;
+  /// @brief The number of commands that passed through a stage. This is not
+  /// the same for all stages.
+  int stageCounts[GtpCommandStageMax];
+  int histograms[GtpCommandStageMax][numberOfHistogramBuckets];
+};
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GtpStatistics.
+// -----------------------------------------------------------------------------
+@interface GtpStatistics()
+/// @brief Maps command names to NSMutableData objects that each store a
+/// struct GtpCommandNameStatistics.
+@property(nonatomic, retain) NSMutableDictionary* statisticsByCommandName;
+@end
+
+
+@implementation GtpStatistics
+
+// -----------------------------------------------------------------------------
+/// @brief Initializes a GtpStatistics object with no statistics.
+///
+/// @note This is the designated initializer of GtpStatistics.
+// -----------------------------------------------------------------------------
+- (id) init
+{
+  // Call designated initializer of superclass (NSObject)
+  self = [super init];
+  if (! self)
+    return nil;
+
+  self.statisticsByCommandName = [NSMutableDictionary dictionary];
+
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Deallocates memory allocated by this GtpStatistics object.
+// -----------------------------------------------------------------------------
+- (void) dealloc
+{
+  self.statisticsByCommandName = nil;
+  [super dealloc];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Adds the timestamps recorded in @a command to the statistics.
+/// Ignores @a command if it has not been processed by the GTP engine, e.g.
+/// because it was dropped.
+// -----------------------------------------------------------------------------
+- (void) recordCommand:(GtpCommand*)command
+{
+  if (0 == command.responseEndTime)
+    return;
+
+  NSString* commandName = [GtpStatistics commandNameForCommand:command];
+  long long bytesSent = [command.command lengthOfBytesUsingEncoding:NSUTF8StringEncoding] + 1;  // + 1 for the newline
+  long long bytesReceived = command.response.rawResponseData.length;
+
+  NSTimeInterval durations[GtpCommandStageMax];
+  durations[GtpCommandStageQueue] = command.processingStartTime - command.submissionTime;
+  durations[GtpCommandStageWrite] = command.writeEndTime - command.processingStartTime;
+  durations[GtpCommandStageEngine] = command.firstResponseLineTime - command.writeEndTime;
+  durations[GtpCommandStageRead] = command.responseEndTime - command.firstResponseLineTime;
+  if (0 != command.responseTargetNotificationTime)
+  {
+    durations[GtpCommandStageCallback] = command.responseTargetNotificationTime - command.responseEndTime;
+    durations[GtpCommandStageTotal] = command.responseTargetNotificationTime - command.submissionTime;
+  }
+  else
+  {
+    durations[GtpCommandStageCallback] = -1;
+    durations[GtpCommandStageTotal] = command.responseEndTime - command.submissionTime;
+  }
+
+  @synchronized(self)
+  {
+    NSMutableData* data = [self.statisticsByCommandName objectForKey:commandName];
+    if (! data)
+    {
+      data = [NSMutableData dataWithLength:sizeof(struct GtpCommandNameStatistics)];  // zero-filled
+      [self.statisticsByCommandName setObject:data forKey:commandName];
+    }
+    struct GtpCommandNameStatistics* statistics = (struct GtpCommandNameStatistics*)data.mutableBytes;
+    statistics->count++;
+    statistics->bytesSent += bytesSent;
+    statistics->bytesReceived += bytesReceived;
+    for (int stage = 0; stage < GtpCommandStageMax; ++stage)
+    {
+      if (durations[stage] < 0)
+        continue;
+      statistics->stageCounts[stage]++;
+      statistics->histograms[stage][[GtpStatistics bucketForDuration:durations[stage]]]++;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the names of all commands for which statistics exist, in
+/// alphabetical order.
+// -----------------------------------------------------------------------------
+- (NSArray*) commandNames
+{
+  @synchronized(self)
+  {
+    return [[self.statisticsByCommandName allKeys] sortedArrayUsingSelector:@selector(compare:)];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the number of commands named @a commandName that have been
+/// recorded.
+// -----------------------------------------------------------------------------
+- (int) countForCommandName:(NSString*)commandName
+{
+  @synchronized(self)
+  {
+    struct GtpCommandNameStatistics* statistics = [self statisticsForCommandName:commandName];
+    return statistics ? statistics->count : 0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the total number of bytes that have been sent to the GTP
+/// engine for commands named @a commandName.
+// -----------------------------------------------------------------------------
+- (long long) bytesSentForCommandName:(NSString*)commandName
+{
+  @synchronized(self)
+  {
+    struct GtpCommandNameStatistics* statistics = [self statisticsForCommandName:commandName];
+    return statistics ? statistics->bytesSent : 0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the total number of bytes that have been received from the
+/// GTP engine in response to commands named @a commandName.
+// -----------------------------------------------------------------------------
+- (long long) bytesReceivedForCommandName:(NSString*)commandName
+{
+  @synchronized(self)
+  {
+    struct GtpCommandNameStatistics* statistics = [self statisticsForCommandName:commandName];
+    return statistics ? statistics->bytesReceived : 0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the approximate duration, in seconds, that @a percentile
+/// percent of the commands named @a commandName needed to pass through
+/// @a stage. Returns -1 if no command named @a commandName has passed through
+/// @a stage.
+///
+/// The value returned is the upper bound of the histogram bucket in which the
+/// percentile falls.
+// -----------------------------------------------------------------------------
+- (NSTimeInterval) percentile:(int)percentile ofStage:(enum GtpCommandStage)stage forCommandName:(NSString*)commandName
+{
+  @synchronized(self)
+  {
+    struct GtpCommandNameStatistics* statistics = [self statisticsForCommandName:commandName];
+    if (! statistics || 0 == statistics->stageCounts[stage])
+      return -1;
+
+    // The rank of the command that marks the percentile, e.g. the 95th of 100
+    // commands for the 95th percentile
+    long long rank = ((long long)statistics->stageCounts[stage] * percentile + 99) / 100;
+    if (rank < 1)
+      rank = 1;
+    long long cumulativeCount = 0;
+    for (int bucket = 0; bucket < numberOfHistogramBuckets; ++bucket)
+    {
+      cumulativeCount += statistics->histograms[stage][bucket];
+      if (cumulativeCount >= rank)
+        return [GtpStatistics upperBoundOfBucket:bucket];
+    }
+    return [GtpStatistics upperBoundOfBucket:numberOfHistogramBuckets - 1];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a multi-line string with the statistics of all commands.
+/// The string is intended to be read by humans.
+// -----------------------------------------------------------------------------
+- (NSString*) report
+{
+  NSArray* commandNames = [self commandNames];
+  if (0 == commandNames.count)
+    return @"No GTP commands have been processed yet.\n";
+
+  NSArray* stageNames = @[@"queue", @"write", @"engine", @"read", @"callback", @"total"];
+  NSMutableString* report = [NSMutableString string];
+  for (NSString* commandName in commandNames)
+  {
+    [report appendFormat:@"%@: %d commands, %lld bytes sent, %lld bytes received\n",
+     commandName,
+     [self countForCommandName:commandName],
+     [self bytesSentForCommandName:commandName],
+     [self bytesReceivedForCommandName:commandName]];
+    for (int stage = 0; stage < GtpCommandStageMax; ++stage)
+    {
+      NSTimeInterval p50 = [self percentile:50 ofStage:stage forCommandName:commandName];
+      if (p50 < 0)
+        continue;
+      NSTimeInterval p95 = [self percentile:95 ofStage:stage forCommandName:commandName];
+      NSTimeInterval p99 = [self percentile:99 ofStage:stage forCommandName:commandName];
+      NSString* stageName = [[stageNames objectAtIndex:stage] stringByPaddingToLength:8 withString:@" " startingAtIndex:0];
+      [report appendFormat:@"  %@  p50 %@  p95 %@  p99 %@\n",
+       stageName,
+       [GtpStatistics stringForDuration:p50],
+       [GtpStatistics stringForDuration:p95],
+       [GtpStatistics stringForDuration:p99]];
+    }
+  }
+  return report;
+}
+
+#pragma mark - Private helpers
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns the statistics of commands named
+/// @a commandName, or NULL if there are none. The caller must synchronize on
+/// self.
+// -----------------------------------------------------------------------------
+- (struct GtpCommandNameStatistics*) statisticsForCommandName:(NSString*)commandName
+{
+  NSMutableData* data = [self.statisticsByCommandName objectForKey:commandName];
+  if (! data)
+    return NULL;
+  return (struct GtpCommandNameStatistics*)data.mutableBytes;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns the command name of @a command, i.e. the
+/// first word of the GTP command string.
+// -----------------------------------------------------------------------------
++ (NSString*) commandNameForCommand:(GtpCommand*)command
+{
+  NSString* commandString = command.command;
+  NSRange range = [commandString rangeOfString:@" "];
+  if (NSNotFound == range.location)
+    return commandString;
+  return [commandString substringToIndex:range.location];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns the index of the histogram bucket into which
+/// @a duration falls.
+// -----------------------------------------------------------------------------
++ (int) bucketForDuration:(NSTimeInterval)duration
+{
+  if (duration <= firstHistogramBucketUpperBound)
+    return 0;
+  int bucket = (int)ceil(log2(duration / firstHistogramBucketUpperBound) * numberOfHistogramBucketsPerDoubling);
+  if (bucket >= numberOfHistogramBuckets)
+    bucket = numberOfHistogramBuckets - 1;
+  return bucket;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns the upper bound, in seconds, of the
+/// histogram bucket with index @a bucket.
+// -----------------------------------------------------------------------------
++ (NSTimeInterval) upperBoundOfBucket:(int)bucket
+{
+  return firstHistogramBucketUpperBound * exp2((double)bucket / numberOfHistogramBucketsPerDoubling);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns a string that represents @a duration in a
+/// form that can be displayed to the user.
+// -----------------------------------------------------------------------------
++ (NSString*) stringForDuration:(NSTimeInterval)duration
+{
+  if (duration < 1.0)
+    return [NSString stringWithFormat:@"%.2f ms", duration * 1000];
+  else
+    return [NSString stringWithFormat:@"%.2f s", duration];
+}
+
+@end
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -24,11 +24,16 @@
 @class CrashReportingModel;
 @class GameVariationModel;
 @class GoGame;
+@class GoOpeningBook;
+@class GtpAnalysisCache;
 @class GtpClient;
 @class GtpCommandModel;
 @class GtpEngine;
+@class GtpEngineMemoryGovernor;
+@class GtpEnginePool;
 @class GtpEngineProfileModel;
 @class GtpLogModel;
+@class GtpMoveSpeculator;
 @class LoggingModel;
 @class MagnifyingViewModel;
 @class MarkupModel;
@@ -105,10 +110,26 @@
 /// @brief The bundle that contains the application's resources. This property
 /// exists to make the application more testable.
 @property(nonatomic, assign) NSBundle* resourceBundle;
-/// @brief The GTP client instance.
+/// @brief The pool that manages all GTP client and GTP engine instances.
+@property(nonatomic, retain) GtpEnginePool* gtpEnginePool;
+/// @brief The primary GTP client instance.
 @property(nonatomic, retain) GtpClient* gtpClient;
-/// @brief The GTP engine instance.
+/// @brief The primary GTP engine instance.
 @property(nonatomic, retain) GtpEngine* gtpEngine;
+/// @brief The cache for the results of analysis GTP commands. Is @e nil if
+/// the cache is disabled in the user defaults.
+@property(nonatomic, retain) GtpAnalysisCache* gtpAnalysisCache;
+/// @brief The object that adapts the memory used by the GTP engines to the
+/// memory available to the application.
+@property(nonatomic, retain) GtpEngineMemoryGovernor* gtpEngineMemoryGovernor;
+/// @brief The object that pre-computes the computer player's replies while the
+/// human player is thinking. Is @e nil if speculation is disabled in the user
+/// defaults, or if it is not possible (no secondary GTP engine or no analysis
+/// cache).
+@property(nonatomic, retain) GtpMoveSpeculator* gtpMoveSpeculator;
+/// @brief The opening book that is shared by all GTP engines. Is @e nil if
+/// the opening book could not be loaded.
+@property(nonatomic, retain) GoOpeningBook* openingBook;
 /// @brief Model object that stores attributes of a new game.
 @property(nonatomic, retain) NewGameModel* theNewGameModel;
 /// @brief Model object that stores player data.
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -30,10 +30,13 @@
 // Project includes
 #import "ApplicationDelegate.h"
 #import "MainTabBarController.h"
+#import "../gtp/GtpAnalysisCache.h"
 #import "../gtp/GtpClient.h"
 #import "../gtp/GtpEngine.h"
+#import "../gtp/GtpEngineMemoryGovernor.h"
+#import "../gtp/GtpEnginePool.h"
+#import "../gtp/GtpMoveSpeculator.h"
 #import "../gtp/GtpUtilities.h"
-#import "../gtp/PipeStreamBuffer.h"
 #import "../newgame/NewGameModel.h"
 #import "../player/GtpEngineProfileModel.h"
 #import "../player/GtpEngineProfile.h"
@@ -96,8 +99,6 @@
 /// @brief Shared instance of ApplicationDelegate.
 // -----------------------------------------------------------------------------
 static ApplicationDelegate* sharedDelegate = nil;
-static std::streambuf* inputPipeStreamBuffer = nullptr;
-static std::streambuf* outputPipeStreamBuffer = nullptr;
 
 // -----------------------------------------------------------------------------
 /// @brief Returns the shared application delegate object.
@@ -140,6 +141,11 @@ static std::streambuf* outputPipeStreamBuffer = nullptr;
   self.documentInteractionURL = nil;
   self.gtpClient = nil;
   self.gtpEngine = nil;
+  self.gtpEnginePool = nil;
+  self.gtpAnalysisCache = nil;
+  self.gtpEngineMemoryGovernor = nil;
+  self.gtpMoveSpeculator = nil;
+  self.openingBook = nil;
   // Observes BoardViewModel, so must be deallocated first
   self.boardViewMetrics = nil;
   self.theNewGameModel = nil;
@@ -173,17 +179,6 @@ static std::streambuf* outputPipeStreamBuffer = nullptr;
   if (self == sharedDelegate)
     sharedDelegate = nil;
 
-  if (inputPipeStreamBuffer)
-  {
-    delete inputPipeStreamBuffer;
-    inputPipeStreamBuffer = nullptr;
-  }
-  if (outputPipeStreamBuffer)
-  {
-    delete outputPipeStreamBuffer;
-    outputPipeStreamBuffer = nullptr;
-  }
-
   [super dealloc];
 }
 
@@ -632,31 +627,43 @@ static std::streambuf* outputPipeStreamBuffer = nullptr;
 }
 
 // -----------------------------------------------------------------------------
-/// @brief Sets up the GTP engine and client (always Fuego).
+/// @brief Sets up the GTP engines and clients (always Fuego).
+///
+/// The number of GTP engines is taken from the user defaults. The first GTP
+/// engine and client are also made available via the properties @e gtpEngine
+/// and @e gtpClient. See GtpEnginePool for details.
 ///
-/// In a regular desktop environment, engine and client would be launched in
-/// separate processes, which would then communicate via stdin/stdout. Since
-/// there is no way to launch separate processes under iOS, engine and client
-/// run in separate threads, and they communicate via C++ Standard Library
-/// I/O streams.
+/// Also sets up the object that governs the memory used by the GTP engines,
+/// the cache for the results of analysis GTP commands, unless the cache is
+/// disabled in the user defaults, and the object that pre-computes the
+/// computer player's replies, unless speculation is disabled or not possible.
 // -----------------------------------------------------------------------------
 - (void) setupFuego
 {
-  // Create objects on the heap, not the stack, so that they remain alive after
-  // control leaves this method. It would be much nicer to make these variables
-  // members of the ApplicationDelegate class, but they are C++ and
-  // ApplicationDelegate.h is also #import'ed by pure Objective-C
-  // implementations.
-  inputPipeStreamBuffer = new PipeStreamBuffer();
-  outputPipeStreamBuffer = new PipeStreamBuffer();
-
-  NSArray* streamBuffers = [NSArray arrayWithObjects:
-                            [NSValue valueWithPointer:inputPipeStreamBuffer],
-                            [NSValue valueWithPointer:outputPipeStreamBuffer],
-                            nil];
-
-  self.gtpClient = [GtpClient clientWithStreamBuffers:streamBuffers];
-  self.gtpEngine = [GtpEngine engineWithStreamBuffers:streamBuffers];
+  NSUserDefaults* userDefaults = [NSUserDefaults standardUserDefaults];
+  NSDictionary* dictionary = [userDefaults dictionaryForKey:gtpEngineConfigurationKey];
+  int numberOfGtpEngines = [[dictionary valueForKey:numberOfGtpEnginesKey] intValue];
+  if (numberOfGtpEngines < 1)
+    numberOfGtpEngines = 1;
+
+  self.gtpEnginePool = [GtpEnginePool poolWithNumberOfEngines:numberOfGtpEngines];
+  self.gtpClient = self.gtpEnginePool.primaryClient;
+  self.gtpEngine = self.gtpEnginePool.primaryEngine;
+  self.gtpEngineMemoryGovernor = [[[GtpEngineMemoryGovernor alloc] init] autorelease];
+
+  int analysisCacheMaximumSize = [[dictionary valueForKey:analysisCacheMaximumSizeKey] intValue];
+  if (analysisCacheMaximumSize > 0)
+    self.gtpAnalysisCache = [[[GtpAnalysisCache alloc] initWithMaximumSize:analysisCacheMaximumSize] autorelease];
+
+  // Speculation needs a secondary GTP engine to compute the replies, and the
+  // analysis cache to store them
+  int numberOfSpeculativeReplies = [[dictionary valueForKey:numberOfSpeculativeRepliesKey] intValue];
+  int speculationTimeBudget = [[dictionary valueForKey:speculationTimeBudgetKey] intValue];
+  if (numberOfSpeculativeReplies > 0 && numberOfGtpEngines > 1 && self.gtpAnalysisCache)
+  {
+    self.gtpMoveSpeculator = [[[GtpMoveSpeculator alloc] initWithNumberOfCandidates:numberOfSpeculativeReplies
+                                                                         timeBudget:speculationTimeBudget] autorelease];
+  }
 }
 
 // -----------------------------------------------------------------------------
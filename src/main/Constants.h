@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -877,6 +877,9 @@ extern NSString* archiveBackupFileName;
 /// @brief Name of the secondary .sgf file used for the same purpose as
 /// @e archiveBackupFileName.
 extern NSString* sgfBackupFileName;
+/// @brief Name of the file in which the content of GtpAnalysisCache is saved
+/// together with the backup files. The file is stored in the Library folder.
+extern NSString* analysisCacheBackupFileName;
 /// @brief Name of the folder used by the document interaction system to pass
 /// files into the app. The folder is located in the Documents folder.
 extern NSString* inboxFolderName;
@@ -886,6 +889,12 @@ extern NSString* userManualFolderName;
 /// @brief Name of the marker file that is used during application launch to
 /// check whether the user manual is already set up.
 extern NSString* userManualSetupMarkerFileName;
+/// @brief Name of the binary opening book file that is compiled from the
+/// opening book resource. The file is stored in the Caches folder.
+extern NSString* openingBookBinaryFileName;
+/// @brief Name of the file in which AnalyzeArchiveGamesCommand records which
+/// games it has already analyzed. The file is stored in the Library folder.
+extern NSString* batchAnalysisProgressFileName;
 //@}
 
 // -----------------------------------------------------------------------------
@@ -908,6 +917,18 @@ extern NSString* gtpEngineRunningNotification;
 extern NSString* gtpEngineIdleNotification;
 //@}
 
+// -----------------------------------------------------------------------------
+/// @name GTP command queue constants
+// -----------------------------------------------------------------------------
+//@{
+/// @brief Coalescing key of GTP commands that generate a move suggestion. See
+/// GtpCommand for details about coalescing keys.
+extern NSString* moveSuggestionGtpCommandCoalescingKey;
+/// @brief Coalescing key of GTP commands that take an intermediate sample of
+/// the territory statistics while the player influence is being generated.
+extern NSString* territoryStatisticsSampleGtpCommandCoalescingKey;
+//@}
+
 // -----------------------------------------------------------------------------
 /// @name GoGame notifications
 // -----------------------------------------------------------------------------
@@ -1887,6 +1908,9 @@ extern NSString* bugReportScreenshotFileName;
 /// @brief Name of the bug report file that stores a depiction of the board as
 /// it is seen by the GTP engine.
 extern NSString* bugReportBoardAsSeenByGtpEngineFileName;
+/// @brief Name of the bug report file that stores the timing statistics of the
+/// GTP commands that have been processed.
+extern NSString* bugReportGtpStatisticsFileName;
 /// @brief Name of the .zip archive file that is used to collect the application
 /// log files.
 extern NSString* bugReportLogsArchiveFileName;
@@ -2083,6 +2107,12 @@ extern NSString* fuegoResignThresholdKey;
 // GTP engine configuration not related to profiles
 extern NSString* gtpEngineConfigurationKey;
 extern NSString* additiveKnowledgeMemoryThresholdKey;
+extern NSString* liveTerritoryStatisticsSamplingIntervalKey;
+extern NSString* numberOfGtpEnginesKey;
+extern NSString* analysisCacheMaximumSizeKey;
+extern NSString* persistAnalysisCacheKey;
+extern NSString* numberOfSpeculativeRepliesKey;
+extern NSString* speculationTimeBudgetKey;
 // Archive view settings
 extern NSString* archiveViewKey;
 extern NSString* sortCriteriaKey;
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -48,15 +48,21 @@ const unsigned int gNoObjectReferenceNodeID = 0;
 NSString* sgfTemporaryFileName = @"---tmp+++.sgf";
 NSString* archiveBackupFileName = @"backup.plist";
 NSString* sgfBackupFileName = @"backup.sgf";
+NSString* analysisCacheBackupFileName = @"analysiscache.plist";
 NSString* inboxFolderName = @"Inbox";
 NSString* userManualFolderName = @"usermanual";
 NSString* userManualSetupMarkerFileName = @"usermanual.setupmarker";
+NSString* openingBookBinaryFileName = @"book.bin";
+NSString* batchAnalysisProgressFileName = @"batchanalysis.plist";
 
 // GTP notifications
 NSString* gtpCommandWillBeSubmittedNotification = @"GtpCommandWillBeSubmitted";
 NSString* gtpResponseWasReceivedNotification = @"GtpResponseWasReceived";
 NSString* gtpEngineRunningNotification = @"GtpEngineRunning";
 NSString* gtpEngineIdleNotification = @"GtpEngineIdle";
+// GTP command queue constants
+NSString* moveSuggestionGtpCommandCoalescingKey = @"MoveSuggestion";
+NSString* territoryStatisticsSampleGtpCommandCoalescingKey = @"TerritoryStatisticsSample";
 // GoGame notifications
 NSString* goGameWillCreate = @"GoGameWillCreate";
 NSString* goGameDidCreate = @"GoGameDidCreate";
@@ -210,7 +216,7 @@ const int gtpLogSizeMinimum = 5;
 const int gtpLogSizeMaximum = 1000;
 
 // Bug reports constants
-const int bugReportFormatVersion = 12;
+const int bugReportFormatVersion = 13;
 NSString* bugReportDiagnosticsInformationFileName = @"littlego-bugreport.zip";
 NSString* bugReportDiagnosticsInformationFileMimeType = @"application/zip";
 NSString* bugReportInfoFileName = @"bugreport-info.plist";
@@ -219,6 +225,7 @@ NSString* bugReportUserDefaultsFileName = @ "userdefaults.plist";
 NSString* bugReportCurrentGameFileName = @ "currentgame.sgf";
 NSString* bugReportScreenshotFileName = @ "screenshot.png";
 NSString* bugReportBoardAsSeenByGtpEngineFileName = @ "showboard.txt";
+NSString* bugReportGtpStatisticsFileName = @ "gtpstatistics.txt";
 NSString* bugReportLogsArchiveFileName = @ "logs.zip";
 NSString* bugReportEmailRecipient = @"herzbube@herzbube.ch";
 NSString* bugReportEmailSubject = @"Little Go Bug Report";
@@ -373,6 +380,12 @@ NSString* fuegoResignThresholdKey = @"FuegoResignThreshold";
 // GTP engine configuration not related to profiles
 NSString* gtpEngineConfigurationKey = @"GtpEngineConfiguration";
 NSString* additiveKnowledgeMemoryThresholdKey = @"AdditiveKnowledgeMemoryThreshold";
+NSString* liveTerritoryStatisticsSamplingIntervalKey = @"LiveTerritoryStatisticsSamplingInterval";
+NSString* numberOfGtpEnginesKey = @"NumberOfGtpEngines";
+NSString* analysisCacheMaximumSizeKey = @"AnalysisCacheMaximumSize";
+NSString* persistAnalysisCacheKey = @"PersistAnalysisCache";
+NSString* numberOfSpeculativeRepliesKey = @"NumberOfSpeculativeReplies";
+NSString* speculationTimeBudgetKey = @"SpeculationTimeBudget";
 // Archive view settings
 NSString* archiveViewKey = @"ArchiveView";
 NSString* sortCriteriaKey = @"SortCriteria";
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2014-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2014-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,6 +15,10 @@
 // -----------------------------------------------------------------------------
 
 
+// Forward declarations
+@class BoardViewMetrics;
+
+
 /// @brief Enumerates all possible types of reusable CGLayer objects.
 ///
 /// Entries in this enumeration must start with numeric value 0 and have
@@ -71,6 +75,22 @@ BoardViewCGLayerCacheEntry;
 // -----------------------------------------------------------------------------
 /// @brief The BoardViewCGLayerCache class provides a cache of CGLayer objects
 /// that can be reused for drawing the Go board.
+///
+/// The content of a layer depends on the board geometry (e.g. the size of a
+/// stone), which changes when the user zooms or rotates the device, or when
+/// the board size changes. BoardViewCGLayerCache keeps the layers of a small
+/// number of board geometries, so that returning to a geometry that was in
+/// use recently (e.g. zooming back out, or rotating back) does not require
+/// re-drawing the layers. Because the geometry values are integral, many
+/// slightly different zoom scales also map to the same geometry.
+///
+/// Clients invoke updateWithMetrics:() whenever the board geometry changes,
+/// and when a layer delegate is created. layerOfType:() and setLayer:ofType:()
+/// then operate on the layers of the new geometry. Layers are not invalidated
+/// when a layer delegate is deallocated, because the layers of other
+/// geometries are still valid. When a new geometry is encountered and the maximum number of
+/// geometries is already cached, the layers of the least recently used
+/// geometry are discarded.
 // -----------------------------------------------------------------------------
 @interface BoardViewCGLayerCache : NSObject
 {
@@ -79,6 +99,7 @@ BoardViewCGLayerCacheEntry;
 + (BoardViewCGLayerCache*) sharedCache;
 + (void) releaseSharedCache;
 
+- (void) updateWithMetrics:(BoardViewMetrics*)metrics;
 - (BoardViewCGLayerCacheEntry) layerOfType:(enum LayerType)layerType;
 - (void) setLayer:(CGLayerRef)layer ofType:(enum LayerType)layerType;
 - (void) invalidateLayerOfType:(enum LayerType)layerType;
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2014-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2014-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -17,13 +17,23 @@
 
 // Project includes
 #import "BoardViewCGLayerCache.h"
+#import "../../model/BoardViewMetrics.h"
 
 
 // Store layers in a global array variable because access is by simple indexing
 // and therefore very fast. Since only one instance of BoardViewCGLayerCache
-// can exist, there are no array access conflicts to solve.
+// can exist, there are no array access conflicts to solve. The first dimension
+// of the array is the board geometry, the second dimension is the layer type.
+static const int maximumNumberOfGeometries = 3;
 static const int arraySizeLayers = MaxLayerType;
-static BoardViewCGLayerCacheEntry layers[arraySizeLayers];
+static BoardViewCGLayerCacheEntry layers[maximumNumberOfGeometries][arraySizeLayers];
+// Identifies the board geometry for which the layers in the corresponding row
+// of the layers array were drawn. An entry is nil if the row is not in use.
+static NSString* geometryKeys[maximumNumberOfGeometries];
+// Usage stamps to find the least recently used board geometry
+static unsigned long geometryLastUsed[maximumNumberOfGeometries];
+static unsigned long geometryUsageCounter = 0;
+static int currentGeometry = 0;
 
 
 @implementation BoardViewCGLayerCache
@@ -56,8 +66,15 @@ static BoardViewCGLayerCache* sharedCache = nil;
   self = [super init];
   if (! self)
     return nil;
-  for (int layerIndex = 0; layerIndex < arraySizeLayers; ++layerIndex)
-    layers[layerIndex] = (BoardViewCGLayerCacheEntry){false, NULL};
+  for (int geometryIndex = 0; geometryIndex < maximumNumberOfGeometries; ++geometryIndex)
+  {
+    for (int layerIndex = 0; layerIndex < arraySizeLayers; ++layerIndex)
+      layers[geometryIndex][layerIndex] = (BoardViewCGLayerCacheEntry){false, NULL};
+    geometryKeys[geometryIndex] = nil;
+    geometryLastUsed[geometryIndex] = 0;
+  }
+  geometryUsageCounter = 0;
+  currentGeometry = 0;
   [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(didReceiveMemoryWarning:) name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
   return self;
 }
@@ -65,7 +82,8 @@ static BoardViewCGLayerCache* sharedCache = nil;
 - (void) dealloc
 {
   [[NSNotificationCenter defaultCenter] removeObserver:self];
-  [self invalidateAllLayers];
+  for (int geometryIndex = 0; geometryIndex < maximumNumberOfGeometries; ++geometryIndex)
+    [self discardGeometry:geometryIndex];
   if (sharedCache == self)
     sharedCache = nil;
   [super dealloc];
@@ -80,30 +98,112 @@ static BoardViewCGLayerCache* sharedCache = nil;
 
 #pragma mark - Caching methods
 
+- (void) updateWithMetrics:(BoardViewMetrics*)metrics
+{
+  NSString* geometryKey = [BoardViewCGLayerCache geometryKeyForMetrics:metrics];
+  if ([geometryKey isEqualToString:geometryKeys[currentGeometry]])
+    return;
+
+  int newGeometry = -1;
+  int leastRecentlyUsedGeometry = 0;
+  for (int geometryIndex = 0; geometryIndex < maximumNumberOfGeometries; ++geometryIndex)
+  {
+    if ([geometryKey isEqualToString:geometryKeys[geometryIndex]])
+    {
+      newGeometry = geometryIndex;
+      break;
+    }
+    if (geometryLastUsed[geometryIndex] < geometryLastUsed[leastRecentlyUsedGeometry])
+      leastRecentlyUsedGeometry = geometryIndex;
+  }
+
+  if (newGeometry == -1)
+  {
+    newGeometry = leastRecentlyUsedGeometry;
+    [self discardGeometry:newGeometry];
+    geometryKeys[newGeometry] = [geometryKey retain];
+  }
+
+  currentGeometry = newGeometry;
+  geometryLastUsed[currentGeometry] = ++geometryUsageCounter;
+}
+
 - (BoardViewCGLayerCacheEntry) layerOfType:(enum LayerType)layerType
 {
-  return layers[layerType];
+  return layers[currentGeometry][layerType];
 }
 
 - (void) setLayer:(CGLayerRef)layer ofType:(enum LayerType)layerType
 {
-  [self invalidateLayerOfType:layerType];
+  [self invalidateLayerOfType:layerType inGeometry:currentGeometry];
   CGLayerRetain(layer);
-  layers[layerType] = (BoardViewCGLayerCacheEntry){true, layer};
+  layers[currentGeometry][layerType] = (BoardViewCGLayerCacheEntry){true, layer};
 }
 
+// Invalidates the layer in all geometries. Clients invoke this when the layer
+// content changes for reasons other than the board geometry, e.g. because the
+// user changed a drawing style.
 - (void) invalidateLayerOfType:(enum LayerType)layerType
 {
-  BoardViewCGLayerCacheEntry entry = layers[layerType];
+  for (int geometryIndex = 0; geometryIndex < maximumNumberOfGeometries; ++geometryIndex)
+    [self invalidateLayerOfType:layerType inGeometry:geometryIndex];
+}
+
+// Invalidates the layers of all geometries. The current geometry remains in
+// effect, the other geometries are discarded.
+- (void) invalidateAllLayers
+{
+  for (int geometryIndex = 0; geometryIndex < maximumNumberOfGeometries; ++geometryIndex)
+  {
+    if (geometryIndex == currentGeometry)
+    {
+      for (int layerIndex = 0; layerIndex < arraySizeLayers; ++layerIndex)
+        [self invalidateLayerOfType:layerIndex inGeometry:geometryIndex];
+    }
+    else
+    {
+      [self discardGeometry:geometryIndex];
+    }
+  }
+}
+
+#pragma mark - Private helpers
+
+- (void) invalidateLayerOfType:(enum LayerType)layerType inGeometry:(int)geometryIndex
+{
+  BoardViewCGLayerCacheEntry entry = layers[geometryIndex][layerType];
   if (entry.isValid && entry.layer)
     CGLayerRelease(entry.layer);
-  layers[layerType] = (BoardViewCGLayerCacheEntry){false, NULL};
+  layers[geometryIndex][layerType] = (BoardViewCGLayerCacheEntry){false, NULL};
 }
 
-- (void) invalidateAllLayers
+// Invalidates all layers of the geometry and marks the geometry as unused
+- (void) discardGeometry:(int)geometryIndex
 {
   for (int layerIndex = 0; layerIndex < arraySizeLayers; ++layerIndex)
-    [self invalidateLayerOfType:layerIndex];
+    [self invalidateLayerOfType:layerIndex inGeometry:geometryIndex];
+  [geometryKeys[geometryIndex] release];
+  geometryKeys[geometryIndex] = nil;
+  geometryLastUsed[geometryIndex] = 0;
+}
+
+// Returns a key that identifies the board geometry described by @a metrics.
+// The key consists of all BoardViewMetrics values that the layer creation
+// functions in BoardViewDrawingHelper depend on and that change when the board
+// geometry changes.
++ (NSString*) geometryKeyForMetrics:(BoardViewMetrics*)metrics
+{
+  return [NSString stringWithFormat:@"%d/%g/%g/%d/%g/%g/%d/%d/%d/%g",
+          metrics.boardSize,
+          metrics.pointCellSize.width,
+          metrics.pointCellSize.height,
+          metrics.stoneRadius,
+          metrics.stoneInnerSquareSize.width,
+          metrics.stoneInnerSquareSize.height,
+          metrics.normalLineWidth,
+          metrics.boundingLineWidth,
+          metrics.starPointRadius,
+          metrics.contentsScale];
 }
 
 @end
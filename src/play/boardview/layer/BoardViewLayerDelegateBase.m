@@ -17,6 +17,7 @@
 
 // Project includes
 #import "BoardViewLayerDelegateBase.h"
+#import "BoardViewCGLayerCache.h"
 #import "BoardViewDrawingHelper.h"
 #import "../../model/BoardViewMetrics.h"
 #import "../../../go/GoBoard.h"
@@ -53,6 +54,13 @@
   self.boardViewMetrics = metrics;
   self.dirty = false;
 
+  // Layer delegates that only exist temporarily (e.g. for territory or the
+  // selection rectangle) may have missed board geometry events while they
+  // did not exist. Catching up here makes sure that the cached CGLayers match
+  // the geometry this delegate draws. Does nothing if the geometry is already
+  // current.
+  [[BoardViewCGLayerCache sharedCache] updateWithMetrics:metrics];
+
   CGRect layerFrame = CGRectZero;
   layerFrame.size = self.boardViewMetrics.tileSize;
   self.layer.frame = layerFrame;
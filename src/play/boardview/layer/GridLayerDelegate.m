@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -62,7 +62,7 @@
     case BVLDEventBoardGeometryChanged:
     case BVLDEventBoardSizeChanged:
     {
-      [[BoardViewCGLayerCache sharedCache] invalidateLayerOfType:StarPointLayerType];
+      [[BoardViewCGLayerCache sharedCache] updateWithMetrics:self.boardViewMetrics];
       self.dirty = true;
       break;
     }
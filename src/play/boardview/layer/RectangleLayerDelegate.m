@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2022-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2022-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -90,12 +90,6 @@ enum DrawingArtifactType
 // -----------------------------------------------------------------------------
 - (void) dealloc
 {
-  // There are times when no RectangleLayerDelegate instances are around to
-  // react to events that invalidate the cached CGLayers, so the cached CGLayers
-  // will inevitably become out-of-date. To prevent this, we invalidate the
-  // CGLayers *NOW*.
-  [self invalidateLayers];
-
   self.drawingPointsOnTile = nil;
   self.fromPoint = nil;
   self.toPoint = nil;
@@ -106,17 +100,6 @@ enum DrawingArtifactType
 
 #pragma mark - State invalidation
 
-// -----------------------------------------------------------------------------
-/// @brief Invalidates the layers for drawing the selection rectangle.
-///
-/// When it is next invoked, drawLayer:inContext:() will re-create the layers.
-// -----------------------------------------------------------------------------
-- (void) invalidateLayers
-{
-  BoardViewCGLayerCache* cache = [BoardViewCGLayerCache sharedCache];
-  [cache invalidateLayerOfType:SelectionRectangleLayerType];
-}
-
 // -----------------------------------------------------------------------------
 /// @brief Invalidates the drawing rectangle.
 // -----------------------------------------------------------------------------
@@ -154,7 +137,7 @@ enum DrawingArtifactType
     case BVLDEventBoardGeometryChanged:
     case BVLDEventBoardSizeChanged:
     {
-      [self invalidateLayers];
+      [[BoardViewCGLayerCache sharedCache] updateWithMetrics:self.boardViewMetrics];
       [self invalidateDrawingRectangle];
       [self invalidateDirtyRect];
       [self invalidatePointsOnTileInSelectionRectangle];
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -59,6 +59,17 @@
 /// used by drawLayer:inContext:(). Is nil if drawing is not triggered because
 /// of a setup point change.
 @property(nonatomic, retain) GoPoint* dirtySetupPoint;
+/// @brief The dirty rect calculated by notify:eventInfo:() that later needs to
+/// be used by drawLayer(). Used only when drawing is required because of a
+/// board position change that changed the state of only some of the
+/// intersections on this tile.
+@property(nonatomic, assign) CGRect dirtyRectForBoardPositionChange;
+/// @brief The list of GoPoint objects whose stones intersect with
+/// @e dirtyRectForBoardPositionChange. Calculated by notify:eventInfo:() and
+/// later used by drawLayer:inContext:(). Is nil if drawing is not triggered
+/// because of a board position change, or if the entire layer needs to be
+/// redrawn.
+@property(nonatomic, retain) NSSet* dirtyPointsForBoardPositionChange;
 @end
 
 
@@ -82,6 +93,8 @@
   self.dirtyPointsForCrossHairPoint = nil;
   self.dirtyRectForSetupPoint = CGRectZero;
   self.dirtySetupPoint = nil;
+  self.dirtyRectForBoardPositionChange = CGRectZero;
+  self.dirtyPointsForBoardPositionChange = nil;
   return self;
 }
 
@@ -94,20 +107,10 @@
   self.currentCrossHairPoint = nil;
   self.dirtyPointsForCrossHairPoint = nil;
   self.dirtySetupPoint = nil;
+  self.dirtyPointsForBoardPositionChange = nil;
   [super dealloc];
 }
 
-// -----------------------------------------------------------------------------
-/// @brief Invalidates the stone layers.
-// -----------------------------------------------------------------------------
-- (void) invalidateLayers
-{
-  BoardViewCGLayerCache* cache = [BoardViewCGLayerCache sharedCache];
-  [cache invalidateLayerOfType:BlackStoneLayerType];
-  [cache invalidateLayerOfType:WhiteStoneLayerType];
-  [cache invalidateLayerOfType:CrossHairStoneLayerType];
-}
-
 // -----------------------------------------------------------------------------
 /// @brief Invalidates the cross-hair point.
 // -----------------------------------------------------------------------------
@@ -142,6 +145,16 @@
   self.dirtyRectForSetupPoint = CGRectZero;
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Invalidates the board position change dirty rectangle and the points
+/// that need to be redrawn within that rectangle.
+// -----------------------------------------------------------------------------
+- (void) invalidateDirtyDataForBoardPositionChange
+{
+  self.dirtyRectForBoardPositionChange = CGRectZero;
+  self.dirtyPointsForBoardPositionChange = nil;
+}
+
 // -----------------------------------------------------------------------------
 /// @brief BoardViewLayerDelegate method.
 // -----------------------------------------------------------------------------
@@ -152,11 +165,12 @@
     case BVLDEventBoardGeometryChanged:
     case BVLDEventBoardSizeChanged:
     {
-      [self invalidateLayers];
+      [[BoardViewCGLayerCache sharedCache] updateWithMetrics:self.boardViewMetrics];
       [self invalidateCrossHairPoint];
       [self invalidateDirtyRectForCrossHairPoint];
       [self invalidateDirtySetupPoint];
       [self invalidateDirtyRectForSetupPoint];
+      [self invalidateDirtyDataForBoardPositionChange];
       self.drawingPoints = [self calculateDrawingPoints];
       self.dirty = true;
       break;
@@ -168,6 +182,7 @@
       [self invalidateDirtyRectForCrossHairPoint];
       [self invalidateDirtySetupPoint];
       [self invalidateDirtyRectForSetupPoint];
+      [self invalidateDirtyDataForBoardPositionChange];
       self.drawingPoints = [self calculateDrawingPoints];
       self.dirty = true;
       break;
@@ -175,6 +190,10 @@
     case BVLDEventBoardPositionChanged:
     case BVLDEventAllSetupStonesDiscarded:
     {
+      // If a drawing cycle is already pending for some other reason we don't
+      // know which parts of the layer it needs, so we must re-draw the entire
+      // layer
+      bool redrawEntireLayer = self.dirty;
       [self invalidateCrossHairPoint];
       [self invalidateDirtyRectForCrossHairPoint];
       [self invalidateDirtySetupPoint];
@@ -185,10 +204,14 @@
       // dictionary comparison detects whether a stone was placed or captured
       if (! [oldDrawingPoints isEqualToDictionary:newDrawingPoints])
       {
+        if (! redrawEntireLayer)
+        {
+          redrawEntireLayer = ! [self updateDirtyDataForBoardPositionChangeWithOldDrawingPoints:oldDrawingPoints
+                                                                               newDrawingPoints:newDrawingPoints];
+        }
+        if (redrawEntireLayer)
+          [self invalidateDirtyDataForBoardPositionChange];
         self.drawingPoints = newDrawingPoints;
-        // Re-draw the entire layer. Further optimization could be made here
-        // by only drawing that rectangle which is actually affected by
-        // self.drawingPoints.
         self.dirty = true;
       }
       break;
@@ -322,15 +345,39 @@
   {
     self.dirty = false;
 
-    if (CGRectIsEmpty(self.dirtyRectForCrossHairPoint) && CGRectIsEmpty(self.dirtyRectForSetupPoint))
+    if (! CGRectIsEmpty(self.dirtyRectForBoardPositionChange))
+    {
+      if (CGRectIsEmpty(self.dirtyRectForCrossHairPoint) && CGRectIsEmpty(self.dirtyRectForSetupPoint))
+      {
+        [self.layer setNeedsDisplayInRect:self.dirtyRectForBoardPositionChange];
+      }
+      else
+      {
+        // A cross-hair or setup point change occurred after the board position
+        // change in the same drawing cycle. drawLayer:inContext:() can apply
+        // only one filter, so we redraw everything.
+        self.dirtyPointsForCrossHairPoint = nil;
+        [self invalidateDirtySetupPoint];
+        self.dirtyPointsForBoardPositionChange = nil;
+        [self.layer setNeedsDisplay];
+      }
+    }
+    else if (CGRectIsEmpty(self.dirtyRectForCrossHairPoint) && CGRectIsEmpty(self.dirtyRectForSetupPoint))
+    {
       [self.layer setNeedsDisplay];
+    }
     else if (CGRectIsEmpty(self.dirtyRectForCrossHairPoint))
+    {
       [self.layer setNeedsDisplayInRect:self.dirtyRectForSetupPoint];
+    }
     else
+    {
       [self.layer setNeedsDisplayInRect:self.dirtyRectForCrossHairPoint];
+    }
 
     [self invalidateDirtyRectForCrossHairPoint];
     [self invalidateDirtyRectForSetupPoint];
+    self.dirtyRectForBoardPositionChange = CGRectZero;
   }
 }
 
@@ -354,10 +401,11 @@
      // GoPoint object
      GoPoint* point = [board pointAtVertex:vertexString];
 
-     // If self.dirtyPointsForCrossHairPoint or self.dirtySetupPoint are set
-     // they act as a filter: We don't want to draw more points than those that
-     // are within the clipping path that was set up when our implementation of
-     // drawLayer() invoked setNeedsDisplayInRect:().
+     // If self.dirtyPointsForCrossHairPoint, self.dirtySetupPoint or
+     // self.dirtyPointsForBoardPositionChange are set they act as a filter: We
+     // don't want to draw more points than those that are within the clipping
+     // path that was set up when our implementation of drawLayer() invoked
+     // setNeedsDisplayInRect:().
      if (self.dirtyPointsForCrossHairPoint)
      {
        if (! [self.dirtyPointsForCrossHairPoint containsObject:point])
@@ -368,6 +416,11 @@
        if (self.dirtySetupPoint != point)
          return;
      }
+     else if (self.dirtyPointsForBoardPositionChange)
+     {
+       if (! [self.dirtyPointsForBoardPositionChange containsObject:point])
+         return;
+     }
 
      CGLayerRef stoneLayer;
      if (point == self.currentCrossHairPoint)
@@ -402,6 +455,74 @@
 
   self.dirtyPointsForCrossHairPoint = nil;
   self.dirtySetupPoint = nil;
+  self.dirtyPointsForBoardPositionChange = nil;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Updates @e dirtyRectForBoardPositionChange and
+/// @e dirtyPointsForBoardPositionChange so that the next drawing cycle
+/// redraws only those parts of the layer that are affected by the differences
+/// between @a oldDrawingPoints and @a newDrawingPoints.
+///
+/// A move typically changes the state of only a few intersections (the new
+/// stone plus captured stones), and most tiles are not affected at all. The
+/// dirty rectangle is the union of the drawing rectangles of all intersections
+/// on this tile whose state changed. Because clearing the dirty rectangle also
+/// clears any unchanged stones that happen to be located within the
+/// rectangle, all points whose stones intersect with the dirty rectangle are
+/// redrawn.
+///
+/// Returns @e true if the dirty data could be calculated. Returns @e false if
+/// the two dictionaries do not refer to the same set of intersections, in
+/// which case the entire layer must be redrawn.
+// -----------------------------------------------------------------------------
+- (bool) updateDirtyDataForBoardPositionChangeWithOldDrawingPoints:(NSDictionary*)oldDrawingPoints
+                                                  newDrawingPoints:(NSDictionary*)newDrawingPoints
+{
+  if (oldDrawingPoints.count != newDrawingPoints.count)
+    return false;
+
+  GoBoard* board = [GoGame sharedGame].board;
+  CGRect dirtyRect = CGRectZero;
+  for (NSString* vertexString in newDrawingPoints)
+  {
+    NSNumber* oldStoneStateAsNumber = [oldDrawingPoints objectForKey:vertexString];
+    if (! oldStoneStateAsNumber)
+      return false;
+    NSNumber* newStoneStateAsNumber = [newDrawingPoints objectForKey:vertexString];
+    if ([oldStoneStateAsNumber isEqualToNumber:newStoneStateAsNumber])
+      continue;
+
+    GoPoint* point = [board pointAtVertex:vertexString];
+    CGRect drawingRect = [BoardViewDrawingHelper drawingRectForTile:self.tile
+                                                    centeredAtPoint:point
+                                                        withMetrics:self.boardViewMetrics];
+    // The stone only touches this tile, there is nothing to draw
+    if (CGRectIsEmpty(drawingRect))
+      continue;
+    if (CGRectIsEmpty(dirtyRect))
+      dirtyRect = drawingRect;
+    else
+      dirtyRect = CGRectUnion(dirtyRect, drawingRect);
+  }
+
+  if (CGRectIsEmpty(dirtyRect))
+    return false;
+
+  NSMutableSet* dirtyPoints = [NSMutableSet setWithCapacity:0];
+  for (NSString* vertexString in newDrawingPoints)
+  {
+    GoPoint* point = [board pointAtVertex:vertexString];
+    CGRect drawingRect = [BoardViewDrawingHelper drawingRectForTile:self.tile
+                                                    centeredAtPoint:point
+                                                        withMetrics:self.boardViewMetrics];
+    if (CGRectIntersectsRect(dirtyRect, drawingRect))
+      [dirtyPoints addObject:point];
+  }
+
+  self.dirtyRectForBoardPositionChange = dirtyRect;
+  self.dirtyPointsForBoardPositionChange = dirtyPoints;
+  return true;
 }
 
 // -----------------------------------------------------------------------------
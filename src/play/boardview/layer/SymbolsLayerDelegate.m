@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -136,12 +136,6 @@
 // -----------------------------------------------------------------------------
 - (void) dealloc
 {
-  // There are times when no SymbolsLayerDelegate instances are around to react
-  // to events that invalidate the cached CGLayers, so the cached CGLayers will
-  // inevitably become out-of-date. To prevent this, we invalidate the CGLayers
-  // *NOW*.
-  [self invalidateLayers];
-
   self.boardViewModel = nil;
   self.boardPositionModel = nil;
   self.uiSettingsModel = nil;
@@ -161,26 +155,6 @@
 
 #pragma mark - State invalidation
 
-// -----------------------------------------------------------------------------
-/// @brief Invalidates layers with "last move" symbols.
-// -----------------------------------------------------------------------------
-- (void) invalidateLayers
-{
-  BoardViewCGLayerCache* cache = [BoardViewCGLayerCache sharedCache];
-  [cache invalidateLayerOfType:BlackLastMoveLayerType];
-  [cache invalidateLayerOfType:WhiteLastMoveLayerType];
-  [self.blackStrokeSymbolLayerTypes enumerateKeysAndObjectsUsingBlock:^(NSNumber* symbolAsNumber, NSNumber* layerTypeAsNumber, BOOL* stop)
-  {
-    enum LayerType layerType = layerTypeAsNumber.intValue;
-    [cache invalidateLayerOfType:layerType];
-  }];
-  [self.whiteStrokeSymbolLayerTypes enumerateKeysAndObjectsUsingBlock:^(NSNumber* symbolAsNumber, NSNumber* layerTypeAsNumber, BOOL* stop)
-  {
-    enum LayerType layerType = layerTypeAsNumber.intValue;
-    [cache invalidateLayerOfType:layerType];
-  }];
-}
-
 // -----------------------------------------------------------------------------
 /// @brief Invalidates all drawing rectangles.
 // -----------------------------------------------------------------------------
@@ -228,7 +202,7 @@
     case BVLDEventBoardGeometryChanged:
     case BVLDEventBoardSizeChanged:
     {
-      [self invalidateLayers];
+      [[BoardViewCGLayerCache sharedCache] updateWithMetrics:self.boardViewMetrics];
       [self invalidateDrawingRectangles];
       [self invalidateDirtyRects];
       [self invalidateDirtyData];
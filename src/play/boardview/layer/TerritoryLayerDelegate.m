@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -71,35 +71,12 @@
 // -----------------------------------------------------------------------------
 - (void) dealloc
 {
-  // There are times when no TerritoryLayerDelegate instances are around to
-  // react to events that invalidate the cached CGLayers, so the cached CGLayers
-  // will inevitably become out-of-date. To prevent this, we invalidate the
-  // CGLayers *NOW*.
-  [self invalidateLayers];
   self.scoringModel = nil;
   self.drawingPointsTerritory = nil;
   self.drawingPointsStoneGroupState = nil;
   [super dealloc];
 }
 
-// -----------------------------------------------------------------------------
-/// @brief Invalidates the layers for marking up territory, and for marking dead
-/// or seki stones.
-///
-/// When it is next invoked, drawLayer:inContext:() will re-create the layers.
-// -----------------------------------------------------------------------------
-- (void) invalidateLayers
-{
-  BoardViewCGLayerCache* cache = [BoardViewCGLayerCache sharedCache];
-  [cache invalidateLayerOfType:BlackTerritoryLayerType];
-  [cache invalidateLayerOfType:WhiteTerritoryLayerType];
-  [cache invalidateLayerOfType:InconsistentFillColorTerritoryLayerType];
-  [cache invalidateLayerOfType:InconsistentDotSymbolTerritoryLayerType];
-  [cache invalidateLayerOfType:DeadStoneSymbolLayerType];
-  [cache invalidateLayerOfType:BlackSekiStoneSymbolLayerType];
-  [cache invalidateLayerOfType:WhiteSekiStoneSymbolLayerType];
-}
-
 // -----------------------------------------------------------------------------
 /// @brief BoardViewLayerDelegate method.
 // -----------------------------------------------------------------------------
@@ -110,7 +87,7 @@
     case BVLDEventBoardGeometryChanged:
     case BVLDEventBoardSizeChanged:
     {
-      [self invalidateLayers];
+      [[BoardViewCGLayerCache sharedCache] updateWithMetrics:self.boardViewMetrics];
       self.drawingPointsTerritory = [self calculateDrawingPointsTerritory];
       self.drawingPointsStoneGroupState = [self calculateDrawingPointsStoneGroupState];
       self.dirty = true;
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2022-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2022-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -20,6 +20,7 @@
 #import "../../boardview/BoardView.h"
 #import "../../gameaction/GameActionManager.h"
 #import "../../../go/GoGame.h"
+#import "../../../go/GoLegalMoveTable.h"
 
 
 NS_ASSUME_NONNULL_BEGIN
@@ -30,6 +31,11 @@ NS_ASSUME_NONNULL_BEGIN
 // -----------------------------------------------------------------------------
 @interface PlayStonePanGestureHandler()
 @property(nonatomic, assign) BoardView* boardView;
+/// @brief Remembers which intersections are legal moves in the current board
+/// position, so that panning back and forth across the same intersections
+/// does not repeat the legality check. Is created on demand and discarded
+/// when the board position changes.
+@property(nonatomic, retain, nullable) GoLegalMoveTable* legalMoveTable;
 @end
 
 
@@ -50,6 +56,11 @@ NS_ASSUME_NONNULL_BEGIN
     return nil;
 
   self.boardView = boardView;
+  self.legalMoveTable = nil;
+
+  NSNotificationCenter* center = [NSNotificationCenter defaultCenter];
+  [center addObserver:self selector:@selector(goGameDidCreate:) name:goGameDidCreate object:nil];
+  [center addObserver:self selector:@selector(currentBoardPositionDidChange:) name:currentBoardPositionDidChange object:nil];
 
   return self;
 }
@@ -60,9 +71,29 @@ NS_ASSUME_NONNULL_BEGIN
 // -----------------------------------------------------------------------------
 - (void) dealloc
 {
+  [[NSNotificationCenter defaultCenter] removeObserver:self];
+  self.legalMoveTable = nil;
   [super dealloc];
 }
 
+#pragma mark - Notification responders
+
+// -----------------------------------------------------------------------------
+/// @brief Responds to the #goGameDidCreate notification.
+// -----------------------------------------------------------------------------
+- (void) goGameDidCreate:(NSNotification*)notification
+{
+  self.legalMoveTable = nil;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Responds to the #currentBoardPositionDidChange notification.
+// -----------------------------------------------------------------------------
+- (void) currentBoardPositionDidChange:(NSNotification*)notification
+{
+  self.legalMoveTable = nil;
+}
+
 #pragma mark - PanGestureHandler overrides
 
 // -----------------------------------------------------------------------------
@@ -84,7 +115,14 @@ NS_ASSUME_NONNULL_BEGIN
   bool isLegalMove = false;
   enum GoMoveIsIllegalReason illegalReason = GoMoveIsIllegalReasonUnknown;
   if (gestureCurrentPoint)
-    isLegalMove = [[GoGame sharedGame] isLegalMove:gestureCurrentPoint isIllegalReason:&illegalReason];
+  {
+    // The table is also validated here because the player who is to move can
+    // change without the board position changing, e.g. in board setup mode
+    GoGame* game = [GoGame sharedGame];
+    if (! self.legalMoveTable || ! [self.legalMoveTable isValidForGame:game])
+      self.legalMoveTable = [[[GoLegalMoveTable alloc] initWithGame:game] autorelease];
+    isLegalMove = [self.legalMoveTable isLegalMove:gestureCurrentPoint isIllegalReason:&illegalReason];
+  }
 
   if (recognizerState == UIGestureRecognizerStateEnded || recognizerState == UIGestureRecognizerStateCancelled)
   {
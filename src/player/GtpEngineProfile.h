@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2021 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,6 +15,10 @@
 // -----------------------------------------------------------------------------
 
 
+// Forward declarations
+@class GtpEngineMemoryGovernor;
+
+
 // -----------------------------------------------------------------------------
 /// @brief The GtpEngineProfile class collects settings that define the
 /// behaviour of the GTP engine.
@@ -90,6 +94,8 @@
 - (id) initWithDictionary:(NSDictionary*)dictionary;
 - (NSDictionary*) asDictionary;
 - (void) applyProfile;
+- (NSArray*) engineConfigurationCommandsForBoardSize:(enum GoBoardSize)boardSize;
+- (NSArray*) engineConfigurationCommandsForBoardSize:(enum GoBoardSize)boardSize memoryGovernor:(GtpEngineMemoryGovernor*)memoryGovernor;
 - (bool) isFallbackProfile;
 - (void) resetPlayingStrengthPropertiesToDefaultValues;
 - (void) resetResignBehaviourPropertiesToDefaultValues;
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2015 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -21,6 +21,7 @@
 #import "../go/GoBoard.h"
 #import "../go/GoGame.h"
 #import "../gtp/GtpCommand.h"
+#import "../gtp/GtpEngineMemoryGovernor.h"
 #import "../gtp/GtpUtilities.h"
 #import "../main/ApplicationDelegate.h"
 #import "../utility/NSStringAdditions.h"
@@ -175,47 +176,19 @@
 {
   DDLogInfo(@"Applying GTP profile settings: %@", [self description]);
 
-  NSString* commandString;
-  GtpCommand* command;
-
-  long long fuegoMaxMemoryInBytes = self.fuegoMaxMemory * 1000000;
-  commandString = [NSString stringWithFormat:@"uct_max_memory %lld", fuegoMaxMemoryInBytes];
-  command = [GtpCommand command:commandString];
-  command.waitUntilDone = false;
-  [command submit];
-  commandString = [NSString stringWithFormat:@"uct_param_search number_threads %d", self.fuegoThreadCount];
-  command = [GtpCommand command:commandString];
-  command.waitUntilDone = false;
-  [command submit];
-  commandString = [NSString stringWithFormat:@"uct_param_player reuse_subtree %d", (self.fuegoReuseSubtree ? 1 : 0)];
-  command = [GtpCommand command:commandString];
-  command.waitUntilDone = false;
-  [command submit];
+  enum GoBoardSize boardSize = [GoGame sharedGame].board.size;
+  GtpEngineMemoryGovernor* memoryGovernor = [ApplicationDelegate sharedDelegate].gtpEngineMemoryGovernor;
+  [memoryGovernor updateWithProfile:self];
+  for (NSString* commandString in [self engineConfigurationCommandsForBoardSize:boardSize memoryGovernor:memoryGovernor])
+  {
+    GtpCommand* command = [GtpCommand command:commandString];
+    command.waitUntilDone = false;
+    [command submit];
+  }
   if (self.fuegoPondering)
     [GtpUtilities startPondering];
   else
     [GtpUtilities stopPondering];
-  commandString = [NSString stringWithFormat:@"uct_param_player max_ponder_time %u", self.fuegoMaxPonderTime];
-  command = [GtpCommand command:commandString];
-  command.waitUntilDone = false;
-  [command submit];
-  commandString = [NSString stringWithFormat:@"go_param timelimit %u", self.fuegoMaxThinkingTime];
-  command = [GtpCommand command:commandString];
-  command.waitUntilDone = false;
-  [command submit];
-  commandString = [NSString stringWithFormat:@"uct_param_player max_games %llu", self.fuegoMaxGames];
-  command = [GtpCommand command:commandString];
-  command.waitUntilDone = false;
-  [command submit];
-  commandString = [NSString stringWithFormat:@"uct_param_player resign_min_games %llu", self.fuegoResignMinGames];
-  command = [GtpCommand command:commandString];
-  command.waitUntilDone = false;
-  [command submit];
-  int resignThreshold = [self resignThresholdForBoardSize:[GoGame sharedGame].board.size];
-  commandString = [NSString stringWithFormat:@"uct_param_player resign_threshold %f", resignThreshold / 100.0];
-  command = [GtpCommand command:commandString];
-  command.waitUntilDone = false;
-  [command submit];
 
   self.hasUnappliedChanges = false;
   if (! self.isActiveProfile)
@@ -234,6 +207,48 @@
   }
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Returns the GTP commands that configure a GTP engine with the
+/// settings in this profile, as an array of NSString objects. The resign
+/// threshold is the one for board size @a boardSize.
+///
+/// The returned commands do not include the pondering setting, because
+/// pondering is managed separately (see GtpUtilities). Unlike applyProfile(),
+/// this method neither submits the commands nor activates this profile. This
+/// allows to configure individual GTP engines, e.g. the secondary GTP engines
+/// that GtpMatchRunner reserves.
+// -----------------------------------------------------------------------------
+- (NSArray*) engineConfigurationCommandsForBoardSize:(enum GoBoardSize)boardSize
+{
+  return [self engineConfigurationCommandsForBoardSize:boardSize memoryGovernor:nil];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the same GTP commands as
+/// engineConfigurationCommandsForBoardSize:(), except that the memory limit
+/// and the subtree reuse setting are taken from @a memoryGovernor instead of
+/// from this profile. If @a memoryGovernor is @e nil, or if it has not yet
+/// determined a memory budget, the settings of this profile are used.
+// -----------------------------------------------------------------------------
+- (NSArray*) engineConfigurationCommandsForBoardSize:(enum GoBoardSize)boardSize memoryGovernor:(GtpEngineMemoryGovernor*)memoryGovernor
+{
+  bool useMemoryGovernor = (memoryGovernor && memoryGovernor.activeMemoryBudget > 0);
+  int maxMemory = (useMemoryGovernor ? memoryGovernor.activeMemoryBudget : self.fuegoMaxMemory);
+  bool reuseSubtree = (useMemoryGovernor ? memoryGovernor.reuseSubtree : self.fuegoReuseSubtree);
+  long long fuegoMaxMemoryInBytes = maxMemory * 1000000LL;
+  int resignThreshold = [self resignThresholdForBoardSize:boardSize];
+  return [NSArray arrayWithObjects:
+          [NSString stringWithFormat:@"uct_max_memory %lld", fuegoMaxMemoryInBytes],
+          [NSString stringWithFormat:@"uct_param_search number_threads %d", self.fuegoThreadCount],
+          [NSString stringWithFormat:@"uct_param_player reuse_subtree %d", (reuseSubtree ? 1 : 0)],
+          [NSString stringWithFormat:@"uct_param_player max_ponder_time %u", self.fuegoMaxPonderTime],
+          [NSString stringWithFormat:@"go_param timelimit %u", self.fuegoMaxThinkingTime],
+          [NSString stringWithFormat:@"uct_param_player max_games %llu", self.fuegoMaxGames],
+          [NSString stringWithFormat:@"uct_param_player resign_min_games %llu", self.fuegoResignMinGames],
+          [NSString stringWithFormat:@"uct_param_player resign_threshold %f", resignThreshold / 100.0],
+          nil];
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Returns true if this GtpEngineProfile object is the fallback profile.
 // -----------------------------------------------------------------------------
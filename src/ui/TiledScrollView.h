@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2014-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2014-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -61,6 +61,24 @@
 /// The formula for calculating the maximum number of tiles is this:
 ///   ceilf(boundsSize.width / tileSize.width) * ceilf(boundsSize.height / tileSize.height)
 ///
+/// If tile prefetching is enabled (see below), this number increases by at
+/// most one row and one column of tiles.
+///
+///
+/// @par Prefetching tiles
+///
+/// When the user scrolls, tiles that become visible at the leading edge of the
+/// visible bounds would normally be acquired and drawn only at the moment when
+/// they become visible. When the user pans quickly this shows up as blank
+/// tiles. To counter this, TiledScrollView by default acquires one additional
+/// row and/or column of tiles beyond the visible bounds, in the direction in
+/// which the user is scrolling. The tile views for these tiles are added to
+/// the tile container view so that they can draw their content before they
+/// become visible. Tiles are not prefetched while the user zooms.
+///
+/// The properties @e numberOfPrefetchHits and @e numberOfPrefetchMisses can be
+/// used to check how well prefetching works.
+///
 ///
 /// @par Credits
 ///
@@ -104,4 +122,16 @@
 /// indicator of how tiles are reused.
 @property(nonatomic, assign) bool annotateTiles;
 
+/// @brief Is true by default. Set this to false if tile views should be
+/// acquired only when they become visible.
+@property(nonatomic, assign) bool prefetchTiles;
+
+/// @brief The number of tiles that were already present because they had been
+/// prefetched at the time when they became visible.
+@property(nonatomic, assign, readonly) int numberOfPrefetchHits;
+
+/// @brief The number of tiles that had to be acquired from the data source at
+/// the time when they became visible.
+@property(nonatomic, assign, readonly) int numberOfPrefetchMisses;
+
 @end
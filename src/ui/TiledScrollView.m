@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2014-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2014-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -35,6 +35,23 @@
 @property(nonatomic, assign) int indexOfFirstVisibleColumn;
 @property(nonatomic, assign) int indexOfLastVisibleRow;
 @property(nonatomic, assign) int indexOfLastVisibleColumn;
+/// @brief The indexes of the tiles that are currently present in the tile
+/// container view. This is the visible range plus any tiles that were
+/// prefetched ahead of the scroll direction.
+@property(nonatomic, assign) int indexOfFirstLoadedRow;
+@property(nonatomic, assign) int indexOfFirstLoadedColumn;
+@property(nonatomic, assign) int indexOfLastLoadedRow;
+@property(nonatomic, assign) int indexOfLastLoadedColumn;
+/// @brief The origin of the visible bounds during the previous layout cycle.
+/// Used to determine the scroll direction.
+@property(nonatomic, assign) CGPoint previousVisibleBoundsOrigin;
+/// @brief The direction in which tiles are prefetched. Each component is -1,
+/// 0 or 1 and is the sign of the most recent non-zero scroll delta along that
+/// axis.
+@property(nonatomic, assign) CGPoint prefetchDirection;
+// Public properties are readonly, we re-declare them here as readwrite
+@property(nonatomic, assign, readwrite) int numberOfPrefetchHits;
+@property(nonatomic, assign, readwrite) int numberOfPrefetchMisses;
 @end
 
 
@@ -61,12 +78,14 @@
   [self addSubview:self.tileContainerView];
   self.tileSize = CGSizeZero;
   self.annotateTiles = false;
+  self.prefetchTiles = true;
+  self.numberOfPrefetchHits = 0;
+  self.numberOfPrefetchMisses = 0;
   self.reusableTiles = [[[NSMutableSet alloc] init] autorelease];
   self.tileViewClass = tileViewClass;
-  self.indexOfFirstVisibleRow = pow(2, 31);     // just any number higher than can ever occur in reality
-  self.indexOfFirstVisibleColumn = pow(2, 31);  // ditto
-  self.indexOfLastVisibleRow = -1;              // just any number lower than can ever occur in reality
-  self.indexOfLastVisibleColumn  = -1;          // ditto
+  [self invalidateTileIndexes];
+  self.previousVisibleBoundsOrigin = CGPointZero;
+  self.prefetchDirection = CGPointZero;
 
   [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(didReceiveMemoryWarning:) name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
 
@@ -133,10 +152,7 @@
     [self.reusableTiles addObject:tile];
     [tile removeFromSuperview];
   }
-  self.indexOfFirstVisibleRow = pow(2, 31);     // just any number higher than can ever occur in reality
-  self.indexOfFirstVisibleColumn = pow(2, 31);  // ditto
-  self.indexOfLastVisibleRow = -1;              // just any number lower than can ever occur in reality
-  self.indexOfLastVisibleColumn  = -1;          // ditto
+  [self invalidateTileIndexes];
   [self setNeedsLayout];
 }
 
@@ -185,8 +201,13 @@
   // The bounds rectangle is the visible part of the (possibly zoomed) content
   // of the scroll view
   CGRect visibleBounds = self.bounds;
+  // The loaded bounds rectangle is the part of the content for which tile
+  // views are present in the tile container view. It is larger than the
+  // visible bounds if tiles are prefetched.
+  CGRect loadedBounds = [self loadedBoundsForVisibleBounds:visibleBounds];
+  self.previousVisibleBoundsOrigin = visibleBounds.origin;
 
-  // Check if any tiles are no longer visible
+  // Check if any tiles are no longer visible or prefetched
   for (UIView* tile in [self.tileContainerView subviews])
   {
     if (! [tile isKindOfClass:self.tileViewClass])
@@ -197,56 +218,64 @@
     // Important: The tile view frame takes the current zoom scale into account
     // because of the transform that is in effect on self.tileContainerView.
     CGRect scaledTileFrame = [self.tileContainerView convertRect:tile.frame toView:self];
-    if (! CGRectIntersectsRect(scaledTileFrame, visibleBounds))
+    if (! CGRectIntersectsRect(scaledTileFrame, loadedBounds))
     {
       [self.reusableTiles addObject:tile];
       [tile removeFromSuperview];
     }
   }
 
-  // In order to compare the tile size with the transformed frame of
-  // self.tileContainerView, we need to take the zoom scale into account
-  CGFloat scaledTileWidth  = self.tileSize.width  * self.zoomScale;
-  CGFloat scaledTileHeight = self.tileSize.height * self.zoomScale;
-
-  // We take the container view size from its frame, not from its bounds, to
-  // get the transformed size that takes the zoom scale into account
-  CGSize tileContainerViewSize = self.tileContainerView.frame.size;
-  int totalNumberOfRows = ceilf(tileContainerViewSize.height / scaledTileHeight);
-  int totalNumberOfColumns = ceilf(tileContainerViewSize.width / scaledTileWidth);
-  int maximumRowIndex = totalNumberOfRows - 1;
-  int maximumColumnIndex = totalNumberOfColumns - 1;
-
   // Calculate the 0-based indexes of the tiles that we need
-  int indexOfFirstNeededRow = MAX(0, floorf(visibleBounds.origin.y / scaledTileHeight));
-  int indexOfFirstNeededCol = MAX(0, floorf(visibleBounds.origin.x / scaledTileWidth));
-  // The -1.0f adjustment makes sure that we don't get one tile too many if the
-  // right and/or bottom edge of visibleBounds is exactly aligned with the right
-  // and/or bottom edge of a tile. Example:
-  // - Tile size = 128,128
-  // - visibleBounds = 0,0,128,128
-  // - In other words: The visible bounds displays exactly 1 tile
-  // - The value for indexOfLastNeededRow and indexOfLastNeededColumn is
-  //   therefore expected to be 0 (because they hold 0-based index values)
-  // - CGRectGetMaxX(visibleBounds) and CGRectGetMaxY(visibleBounds) will both
-  //   give us 128
-  // - Without the -1.0f adjustment, the division would be floorf(128 / 128) = 1
-  // - In other words: indexOfLastNeededRow and indexOfLastNeededColumn would
-  //   get values that are 1 too high
-  // - With the -1.0f adjustment, the division is floorf(127 / 128) = 0
-  // - The -1.0f adjustment therefore compensates for the results of
-  //   CGRectGetMaxX and CGRectGetMaxY
-  int indexOfLastNeededRow = MIN(maximumRowIndex, floorf((CGRectGetMaxY(visibleBounds) - 1.0f) / scaledTileHeight));
-  int indexOfLastNeededColumn = MIN(maximumColumnIndex, floor((CGRectGetMaxX(visibleBounds) - 1.0f) / scaledTileWidth));
+  int indexOfFirstNeededRow;
+  int indexOfFirstNeededColumn;
+  int indexOfLastNeededRow;
+  int indexOfLastNeededColumn;
+  [self getTileIndexesForRect:loadedBounds
+                     firstRow:&indexOfFirstNeededRow
+                  firstColumn:&indexOfFirstNeededColumn
+                      lastRow:&indexOfLastNeededRow
+                   lastColumn:&indexOfLastNeededColumn];
+  int indexOfFirstVisibleRow;
+  int indexOfFirstVisibleColumn;
+  int indexOfLastVisibleRow;
+  int indexOfLastVisibleColumn;
+  [self getTileIndexesForRect:visibleBounds
+                     firstRow:&indexOfFirstVisibleRow
+                  firstColumn:&indexOfFirstVisibleColumn
+                      lastRow:&indexOfLastVisibleRow
+                   lastColumn:&indexOfLastVisibleColumn];
+
+  // Update the prefetch statistics. A tile that has just become visible is a
+  // hit if it was prefetched in a previous layout cycle, and a miss if it must
+  // be acquired now. Tiles acquired after reloadData() are not counted.
+  if (self.indexOfLastVisibleRow >= 0)
+  {
+    for (int rowIndex = indexOfFirstVisibleRow; rowIndex <= indexOfLastVisibleRow; ++rowIndex)
+    {
+      for (int columnIndex = indexOfFirstVisibleColumn; columnIndex <= indexOfLastVisibleColumn; ++columnIndex)
+      {
+        bool tileWasVisible = (self.indexOfFirstVisibleRow <= rowIndex && self.indexOfFirstVisibleColumn <= columnIndex &&
+                               self.indexOfLastVisibleRow  >= rowIndex && self.indexOfLastVisibleColumn  >= columnIndex);
+        if (tileWasVisible)
+          continue;
+        bool tileWasLoaded = (self.indexOfFirstLoadedRow <= rowIndex && self.indexOfFirstLoadedColumn <= columnIndex &&
+                              self.indexOfLastLoadedRow  >= rowIndex && self.indexOfLastLoadedColumn  >= columnIndex);
+        if (tileWasLoaded)
+          self.numberOfPrefetchHits++;
+        else
+          self.numberOfPrefetchMisses++;
+      }
+    }
+  }
 
   // Acquire any tiles that are missing from the data source and add them to
   // self.tileContainerView
   for (int rowIndex = indexOfFirstNeededRow; rowIndex <= indexOfLastNeededRow; ++rowIndex)
   {
-    for (int columnIndex = indexOfFirstNeededCol; columnIndex <= indexOfLastNeededColumn; ++columnIndex)
+    for (int columnIndex = indexOfFirstNeededColumn; columnIndex <= indexOfLastNeededColumn; ++columnIndex)
     {
-      bool tileIsMissing = (self.indexOfFirstVisibleRow > rowIndex || self.indexOfFirstVisibleColumn > columnIndex ||
-                            self.indexOfLastVisibleRow  < rowIndex || self.indexOfLastVisibleColumn  < columnIndex);
+      bool tileIsMissing = (self.indexOfFirstLoadedRow > rowIndex || self.indexOfFirstLoadedColumn > columnIndex ||
+                            self.indexOfLastLoadedRow  < rowIndex || self.indexOfLastLoadedColumn  < columnIndex);
       if (tileIsMissing)
       {
         UIView* tileView = [self.dataSource tiledScrollView:self
@@ -266,15 +295,138 @@
     }
   }
 
-  // Remember which tiles are visible
-  self.indexOfFirstVisibleRow = indexOfFirstNeededRow;
-  self.indexOfFirstVisibleColumn = indexOfFirstNeededCol;
-  self.indexOfLastVisibleRow = indexOfLastNeededRow;
-  self.indexOfLastVisibleColumn = indexOfLastNeededColumn;
+  // Remember which tiles are visible and which tiles are loaded
+  self.indexOfFirstVisibleRow = indexOfFirstVisibleRow;
+  self.indexOfFirstVisibleColumn = indexOfFirstVisibleColumn;
+  self.indexOfLastVisibleRow = indexOfLastVisibleRow;
+  self.indexOfLastVisibleColumn = indexOfLastVisibleColumn;
+  self.indexOfFirstLoadedRow = indexOfFirstNeededRow;
+  self.indexOfFirstLoadedColumn = indexOfFirstNeededColumn;
+  self.indexOfLastLoadedRow = indexOfLastNeededRow;
+  self.indexOfLastLoadedColumn = indexOfLastNeededColumn;
 }
 
 #pragma mark - Private helpers
 
+// -----------------------------------------------------------------------------
+/// @brief Resets the indexes of visible and loaded tiles so that the next
+/// layout cycle acquires a full set of tile views from the data source.
+// -----------------------------------------------------------------------------
+- (void) invalidateTileIndexes
+{
+  self.indexOfFirstVisibleRow = pow(2, 31);     // just any number higher than can ever occur in reality
+  self.indexOfFirstVisibleColumn = pow(2, 31);  // ditto
+  self.indexOfLastVisibleRow = -1;              // just any number lower than can ever occur in reality
+  self.indexOfLastVisibleColumn  = -1;          // ditto
+  self.indexOfFirstLoadedRow = pow(2, 31);
+  self.indexOfFirstLoadedColumn = pow(2, 31);
+  self.indexOfLastLoadedRow = -1;
+  self.indexOfLastLoadedColumn  = -1;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the rectangle for which tile views should be present in the
+/// tile container view. This is @a visibleBounds, extended by one tile in the
+/// direction in which the content was most recently scrolled.
+///
+/// A layout cycle in which the content did not move along an axis keeps the
+/// previous direction for that axis. Otherwise a layout pass that occurs
+/// without scrolling (e.g. when scrolling pauses for a moment) would drop the
+/// prefetched tiles, and they would have to be loaded again as soon as
+/// scrolling continues.
+///
+/// Tiles are prefetched only if the @e prefetchTiles property is true, and
+/// only while the user is scrolling, not while zooming.
+// -----------------------------------------------------------------------------
+- (CGRect) loadedBoundsForVisibleBounds:(CGRect)visibleBounds
+{
+  if (! self.prefetchTiles || self.zooming || self.indexOfLastVisibleRow < 0)
+    return visibleBounds;
+
+  CGFloat scaledTileWidth  = self.tileSize.width  * self.zoomScale;
+  CGFloat scaledTileHeight = self.tileSize.height * self.zoomScale;
+  CGFloat deltaX = visibleBounds.origin.x - self.previousVisibleBoundsOrigin.x;
+  CGFloat deltaY = visibleBounds.origin.y - self.previousVisibleBoundsOrigin.y;
+
+  CGPoint prefetchDirection = self.prefetchDirection;
+  if (deltaX > 0.0f)
+    prefetchDirection.x = 1.0f;
+  else if (deltaX < 0.0f)
+    prefetchDirection.x = -1.0f;
+  if (deltaY > 0.0f)
+    prefetchDirection.y = 1.0f;
+  else if (deltaY < 0.0f)
+    prefetchDirection.y = -1.0f;
+  self.prefetchDirection = prefetchDirection;
+
+  CGRect loadedBounds = visibleBounds;
+  if (prefetchDirection.x > 0.0f)
+  {
+    loadedBounds.size.width += scaledTileWidth;
+  }
+  else if (prefetchDirection.x < 0.0f)
+  {
+    loadedBounds.origin.x -= scaledTileWidth;
+    loadedBounds.size.width += scaledTileWidth;
+  }
+  if (prefetchDirection.y > 0.0f)
+  {
+    loadedBounds.size.height += scaledTileHeight;
+  }
+  else if (prefetchDirection.y < 0.0f)
+  {
+    loadedBounds.origin.y -= scaledTileHeight;
+    loadedBounds.size.height += scaledTileHeight;
+  }
+  return loadedBounds;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Calculates the 0-based indexes of the first and last rows and
+/// columns of tiles that intersect with @a rect. @a rect must be in the
+/// coordinate system of the scroll view. Indexes are clamped to the tiles
+/// that actually exist.
+// -----------------------------------------------------------------------------
+- (void) getTileIndexesForRect:(CGRect)rect
+                      firstRow:(int*)firstRow
+                   firstColumn:(int*)firstColumn
+                       lastRow:(int*)lastRow
+                    lastColumn:(int*)lastColumn
+{
+  // In order to compare the tile size with the transformed frame of
+  // self.tileContainerView, we need to take the zoom scale into account
+  CGFloat scaledTileWidth  = self.tileSize.width  * self.zoomScale;
+  CGFloat scaledTileHeight = self.tileSize.height * self.zoomScale;
+
+  // We take the container view size from its frame, not from its bounds, to
+  // get the transformed size that takes the zoom scale into account
+  CGSize tileContainerViewSize = self.tileContainerView.frame.size;
+  int totalNumberOfRows = ceilf(tileContainerViewSize.height / scaledTileHeight);
+  int totalNumberOfColumns = ceilf(tileContainerViewSize.width / scaledTileWidth);
+  int maximumRowIndex = totalNumberOfRows - 1;
+  int maximumColumnIndex = totalNumberOfColumns - 1;
+
+  *firstRow = MAX(0, floorf(rect.origin.y / scaledTileHeight));
+  *firstColumn = MAX(0, floorf(rect.origin.x / scaledTileWidth));
+  // The -1.0f adjustment makes sure that we don't get one tile too many if the
+  // right and/or bottom edge of rect is exactly aligned with the right and/or
+  // bottom edge of a tile. Example:
+  // - Tile size = 128,128
+  // - rect = 0,0,128,128
+  // - In other words: rect covers exactly 1 tile
+  // - The value for lastRow and lastColumn is therefore expected to be 0
+  //   (because they hold 0-based index values)
+  // - CGRectGetMaxX(rect) and CGRectGetMaxY(rect) will both give us 128
+  // - Without the -1.0f adjustment, the division would be floorf(128 / 128) = 1
+  // - In other words: lastRow and lastColumn would get values that are 1 too
+  //   high
+  // - With the -1.0f adjustment, the division is floorf(127 / 128) = 0
+  // - The -1.0f adjustment therefore compensates for the results of
+  //   CGRectGetMaxX and CGRectGetMaxY
+  *lastRow = MIN(maximumRowIndex, floorf((CGRectGetMaxY(rect) - 1.0f) / scaledTileHeight));
+  *lastColumn = MIN(maximumColumnIndex, floor((CGRectGetMaxX(rect) - 1.0f) / scaledTileWidth));
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Annotates the specified tile view to make it visible. This is a
 /// debugging aid. See the @e annotateTiles property documentation.
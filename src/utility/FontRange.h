@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2013-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2013-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -38,6 +38,13 @@
 ///   text specified at construction time with the UIFont that you just received
 ///   as the first result of the query.
 ///
+/// Measuring the text with all font sizes is the expensive part. FontRange
+/// therefore measures a given combination of text, font and font size range
+/// only once per process. All FontRange objects created with the same
+/// parameters share the measurement results. Queries do not measure text. They
+/// use a binary search, unless the measured widths turn out not to shrink with
+/// the font size, in which case they fall back to a linear search.
+///
 /// @note The use case that FontRange was originally developed for is the
 /// drawing of move numbers on a Go board. The client knows in advance the
 /// largest move number it will draw ("largest" in terms of space required for
@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2013-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2013-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -33,10 +33,38 @@
 ///
 /// Entries in @e precalculatedFonts appear ordered by font size. The first
 /// entry is the one with the largest font size.
+///
+/// The array is shared with all other FontRange objects that were created with
+/// the same parameters, see @e sharedPrecalculatedFonts.
 @property(nonatomic, retain) NSArray* precalculatedFonts;
+/// @brief True if the widths in @e precalculatedFonts never grow from one
+/// entry to the next. Queries use a binary search only if this is true.
+@property(nonatomic, assign) bool precalculatedFontsAreOrderedByWidth;
 @end
 
 
+/// @brief Caches the @e precalculatedFonts arrays of all FontRange objects that
+/// were ever created, so that text measurement for a given combination of
+/// text, font and font size range takes place only once per process.
+///
+/// Dictionary keys are strings that are generated by
+/// precalculatedFontsKeyForText:monospacedFont:minimumFontSize:maximumFontSize:().
+/// Dictionary values are immutable arrays in the format described for the
+/// @e precalculatedFonts property.
+///
+/// The cache is never purged. Only a handful of text/font combinations are in
+/// use, and the system caches the UIFont objects anyway.
+///
+/// Access is protected by @synchronized on the FontRange class object.
+static NSMutableDictionary* sharedPrecalculatedFonts = nil;
+
+/// @brief Contains the keys of the arrays in @e sharedPrecalculatedFonts whose
+/// widths are not ordered from widest to narrowest.
+///
+/// Access is protected by @synchronized on the FontRange class object.
+static NSMutableSet* unorderedPrecalculatedFontsKeys = nil;
+
+
 @implementation FontRange
 
 // -----------------------------------------------------------------------------
@@ -100,11 +128,78 @@
 
 // -----------------------------------------------------------------------------
 /// @brief Private helper for the initializer.
+///
+/// Re-uses the precalculated fonts of an earlier FontRange object that was
+/// created with the same parameters. Text measurement takes place only if
+/// there is no such FontRange object.
 // -----------------------------------------------------------------------------
 - (void) setupFontsWithText:(NSString*)text
              monospacedFont:(bool)monospacedFont
             minimumFontSize:(int)minimumFontSize
             maximumFontSize:(int)maximumFontSize
+{
+  NSString* key = [FontRange precalculatedFontsKeyForText:text
+                                           monospacedFont:monospacedFont
+                                          minimumFontSize:minimumFontSize
+                                          maximumFontSize:maximumFontSize];
+
+  @synchronized([FontRange class])
+  {
+    if (! sharedPrecalculatedFonts)
+    {
+      sharedPrecalculatedFonts = [[NSMutableDictionary alloc] init];
+      unorderedPrecalculatedFontsKeys = [[NSMutableSet alloc] init];
+    }
+
+    NSArray* precalculatedFonts = [sharedPrecalculatedFonts objectForKey:key];
+    if (! precalculatedFonts)
+    {
+      precalculatedFonts = [FontRange precalculateFontsWithText:text
+                                                 monospacedFont:monospacedFont
+                                                minimumFontSize:minimumFontSize
+                                                maximumFontSize:maximumFontSize];
+      [sharedPrecalculatedFonts setObject:precalculatedFonts forKey:key];
+      if (! [FontRange isOrderedByWidth:precalculatedFonts])
+      {
+        DDLogWarn(@"FontRange: Text widths do not shrink with the font size, falling back to linear search for key %@", key);
+        [unorderedPrecalculatedFontsKeys addObject:key];
+      }
+    }
+
+    self.precalculatedFonts = precalculatedFonts;
+    self.precalculatedFontsAreOrderedByWidth = ! [unorderedPrecalculatedFontsKeys containsObject:key];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns the key under which the precalculated fonts for the
+/// specified parameters are stored in @e sharedPrecalculatedFonts.
+///
+/// This is a private helper for
+/// setupFontsWithText:monospacedFont:minimumFontSize:maximumFontSize:().
+// -----------------------------------------------------------------------------
++ (NSString*) precalculatedFontsKeyForText:(NSString*)text
+                            monospacedFont:(bool)monospacedFont
+                           minimumFontSize:(int)minimumFontSize
+                           maximumFontSize:(int)maximumFontSize
+{
+  // The text goes last because it can contain any character, including the
+  // separator character
+  return [NSString stringWithFormat:@"%d/%d/%d/%@", monospacedFont ? 1 : 0, minimumFontSize, maximumFontSize, text];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures @a text with all font sizes from @a maximumFontSize down to
+/// @a minimumFontSize. Returns an immutable array in the format described for
+/// the @e precalculatedFonts property.
+///
+/// This is a private helper for
+/// setupFontsWithText:monospacedFont:minimumFontSize:maximumFontSize:().
+// -----------------------------------------------------------------------------
++ (NSArray*) precalculateFontsWithText:(NSString*)text
+                        monospacedFont:(bool)monospacedFont
+                       minimumFontSize:(int)minimumFontSize
+                       maximumFontSize:(int)maximumFontSize
 {
   NSMutableArray* precalculatedFonts = [NSMutableArray arrayWithCapacity:0];
   for (int fontSize = maximumFontSize; fontSize >= minimumFontSize; --fontSize)
@@ -128,7 +223,31 @@
                                                nil];
     [precalculatedFonts addObject:array];
   }
-  self.precalculatedFonts = precalculatedFonts;
+  return [NSArray arrayWithArray:precalculatedFonts];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Returns true if the widths in @a precalculatedFonts never grow from
+/// one entry to the next, i.e. if a binary search can be used to query
+/// @a precalculatedFonts. Returns false otherwise.
+///
+/// Text normally gets narrower as the font size shrinks, but font metrics
+/// (e.g. hinting at small sizes) do not strictly guarantee this.
+///
+/// This is a private helper for
+/// setupFontsWithText:monospacedFont:minimumFontSize:maximumFontSize:().
+// -----------------------------------------------------------------------------
++ (bool) isOrderedByWidth:(NSArray*)precalculatedFonts
+{
+  CGFloat previousWidth = CGFLOAT_MAX;
+  for (NSArray* array in precalculatedFonts)
+  {
+    CGFloat width = [[array objectAtIndex:1] floatValue];
+    if (width > previousWidth)
+      return false;
+    previousWidth = width;
+  }
+  return true;
 }
 
 // -----------------------------------------------------------------------------
@@ -163,17 +282,44 @@
                   font:(UIFont**)font
               textSize:(CGSize*)textSize
 {
-  for (NSArray* array in self.precalculatedFonts)
+  // The text usually gets wider as the font size increases, so the required
+  // widths in precalculatedFonts are ordered from widest to narrowest. A
+  // binary search finds the first entry that is not wider than the specified
+  // width. If the widths are not ordered the search must be linear.
+  NSArray* precalculatedFonts = self.precalculatedFonts;
+  NSUInteger lowerBound = 0;
+  NSUInteger upperBound = precalculatedFonts.count;
+  if (self.precalculatedFontsAreOrderedByWidth)
   {
-    CGFloat minimumRequiredWidth = [[array objectAtIndex:1] floatValue];
-    if (minimumRequiredWidth > width)
-      continue;
-    CGFloat minimumRequiredHeight = [[array objectAtIndex:2] floatValue];
-    *textSize = CGSizeMake(minimumRequiredWidth, minimumRequiredHeight);
-    *font = [array objectAtIndex:0];
-    return true;
+    while (lowerBound < upperBound)
+    {
+      NSUInteger middle = lowerBound + (upperBound - lowerBound) / 2;
+      CGFloat minimumRequiredWidth = [[[precalculatedFonts objectAtIndex:middle] objectAtIndex:1] floatValue];
+      if (minimumRequiredWidth > width)
+        lowerBound = middle + 1;
+      else
+        upperBound = middle;
+    }
   }
-  return false;
+  else
+  {
+    for (; lowerBound < upperBound; ++lowerBound)
+    {
+      CGFloat minimumRequiredWidth = [[[precalculatedFonts objectAtIndex:lowerBound] objectAtIndex:1] floatValue];
+      if (minimumRequiredWidth <= width)
+        break;
+    }
+  }
+
+  if (lowerBound == precalculatedFonts.count)
+    return false;
+
+  NSArray* array = [precalculatedFonts objectAtIndex:lowerBound];
+  CGFloat minimumRequiredWidth = [[array objectAtIndex:1] floatValue];
+  CGFloat minimumRequiredHeight = [[array objectAtIndex:2] floatValue];
+  *textSize = CGSizeMake(minimumRequiredWidth, minimumRequiredHeight);
+  *font = [array objectAtIndex:0];
+  return true;
 }
 
 @end
@@ -0,0 +1,115 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "FontRangeTest.h"
+
+// Application includes
+#import <utility/FontRange.h>
+
+
+@implementation FontRangeTest
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that FontRange objects created with the same parameters share
+/// their precalculated fonts, and that FontRange objects created with
+/// different parameters do not.
+// -----------------------------------------------------------------------------
+- (void) testSharedPrecalculatedFonts
+{
+  FontRange* fontRange1 = [[[FontRange alloc] initWithText:@"388" minimumFontSize:8 maximumFontSize:40] autorelease];
+  FontRange* fontRange2 = [[[FontRange alloc] initWithText:@"388" minimumFontSize:8 maximumFontSize:40] autorelease];
+  FontRange* fontRange3 = [[[FontRange alloc] initWithText:@"388" minimumFontSize:8 maximumFontSize:39] autorelease];
+  FontRange* fontRange4 = [[[FontRange alloc] initWithMonospacedFontAndText:@"388" minimumFontSize:8 maximumFontSize:40] autorelease];
+  FontRange* fontRange5 = [[[FontRange alloc] initWithText:@"389" minimumFontSize:8 maximumFontSize:40] autorelease];
+
+  NSArray* precalculatedFonts1 = [fontRange1 valueForKey:@"precalculatedFonts"];
+  XCTAssertEqual(33, precalculatedFonts1.count);
+  XCTAssertEqual(precalculatedFonts1, [fontRange2 valueForKey:@"precalculatedFonts"]);
+  XCTAssertNotEqual(precalculatedFonts1, [fontRange3 valueForKey:@"precalculatedFonts"]);
+  XCTAssertNotEqual(precalculatedFonts1, [fontRange4 valueForKey:@"precalculatedFonts"]);
+  XCTAssertNotEqual(precalculatedFonts1, [fontRange5 valueForKey:@"precalculatedFonts"]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the queryForWidth:font:textSize:() method. The result must
+/// be the largest font size whose text fits into the specified width.
+// -----------------------------------------------------------------------------
+- (void) testQueryForWidth
+{
+  NSString* text = @"388";
+  int minimumFontSize = 8;
+  int maximumFontSize = 40;
+  FontRange* fontRange = [[[FontRange alloc] initWithText:text minimumFontSize:minimumFontSize maximumFontSize:maximumFontSize] autorelease];
+
+  CGFloat minimumWidth = ceilf([text sizeWithAttributes:@{ NSFontAttributeName : [UIFont systemFontOfSize:minimumFontSize] }].width);
+  CGFloat maximumWidth = ceilf([text sizeWithAttributes:@{ NSFontAttributeName : [UIFont systemFontOfSize:maximumFontSize] }].width);
+
+  UIFont* font;
+  CGSize textSize;
+  XCTAssertFalse([fontRange queryForWidth:minimumWidth - 1 font:&font textSize:&textSize]);
+  XCTAssertNil([fontRange queryForWidth:minimumWidth - 1]);
+
+  XCTAssertTrue([fontRange queryForWidth:maximumWidth + 100 font:&font textSize:&textSize]);
+  XCTAssertEqual(maximumFontSize, font.pointSize);
+  XCTAssertEqual(maximumWidth, textSize.width);
+
+  for (CGFloat width = minimumWidth; width <= maximumWidth; width += 0.5)
+  {
+    XCTAssertTrue([fontRange queryForWidth:width font:&font textSize:&textSize]);
+    XCTAssertTrue(textSize.width <= width);
+
+    // The next larger font size does not fit
+    int fontSize = (int)font.pointSize;
+    if (fontSize < maximumFontSize)
+    {
+      UIFont* largerFont = [UIFont systemFontOfSize:fontSize + 1];
+      CGFloat largerWidth = ceilf([text sizeWithAttributes:@{ NSFontAttributeName : largerFont }].width);
+      XCTAssertTrue(largerWidth > width);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the queryForWidth:font:textSize:() method with widths that
+/// do not shrink with the font size. The result must be the largest font size
+/// whose text fits into the specified width, as if the search were linear.
+// -----------------------------------------------------------------------------
+- (void) testQueryForWidthWithUnorderedWidths
+{
+  FontRange* fontRange = [[[FontRange alloc] initWithText:@"388" minimumFontSize:10 maximumFontSize:12] autorelease];
+  UIFont* font12 = [UIFont systemFontOfSize:12];
+  UIFont* font11 = [UIFont systemFontOfSize:11];
+  UIFont* font10 = [UIFont systemFontOfSize:10];
+  NSArray* precalculatedFonts = @[@[font12, @20.0f, @14.0f],
+                                  @[font11, @21.0f, @13.0f],
+                                  @[font10, @15.0f, @12.0f]];
+  [fontRange setValue:precalculatedFonts forKey:@"precalculatedFonts"];
+  [fontRange setValue:@NO forKey:@"precalculatedFontsAreOrderedByWidth"];
+
+  UIFont* font;
+  CGSize textSize;
+  XCTAssertTrue([fontRange queryForWidth:20 font:&font textSize:&textSize]);
+  XCTAssertEqual(font12, font);
+  XCTAssertEqual(20, textSize.width);
+  XCTAssertEqual(14, textSize.height);
+  XCTAssertTrue([fontRange queryForWidth:19 font:&font textSize:&textSize]);
+  XCTAssertEqual(font10, font);
+  XCTAssertFalse([fontRange queryForWidth:14 font:&font textSize:&textSize]);
+}
+
+@end
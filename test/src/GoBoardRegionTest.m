@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2014 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -220,6 +220,32 @@
                               NSException, NSInvalidArgumentException, @"region reference already updated");
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Exercises the removeAllPoints() method.
+// -----------------------------------------------------------------------------
+- (void) testRemoveAllPoints
+{
+  GoBoard* board = m_game.board;
+  GoPoint* point1 = [board pointAtVertex:@"A1"];
+  GoPoint* point2 = [board pointAtVertex:@"T19"];
+  // Keep the region alive, it is otherwise deallocated when its last point
+  // drops its reference
+  GoBoardRegion* mainRegion = [[point1.region retain] autorelease];
+  XCTAssertTrue(point2.region == mainRegion);
+
+  int expectedMainRegionSize = 0;
+  NSUInteger expectedMainRegionPointsCount = expectedMainRegionSize;
+  [mainRegion removeAllPoints];
+  XCTAssertEqual(expectedMainRegionSize, [mainRegion size]);
+  XCTAssertEqual(expectedMainRegionPointsCount, mainRegion.points.count);
+  XCTAssertNil(point1.region);
+  XCTAssertNil(point2.region);
+
+  // Removing all points from an empty region does nothing
+  [mainRegion removeAllPoints];
+  XCTAssertEqual(expectedMainRegionSize, [mainRegion size]);
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Exercises the joinRegion:() method.
 // -----------------------------------------------------------------------------
@@ -0,0 +1,85 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Test includes
+#import "GoDeadStoneEstimatorTest.h"
+
+// Application includes
+#import <go/GoBoard.h>
+#import <go/GoBoardRegion.h>
+#import <go/GoDeadStoneEstimator.h>
+#import <go/GoGame.h>
+#import <go/GoPoint.h>
+
+
+@implementation GoDeadStoneEstimatorTest
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that no stone groups are dead on an empty board.
+// -----------------------------------------------------------------------------
+- (void) testEmptyBoard
+{
+  GoDeadStoneEstimator* estimator = [[[GoDeadStoneEstimator alloc] initWithBoard:m_game.board] autorelease];
+  NSUInteger expectedNumberOfDeadStoneGroups = 0;
+  XCTAssertNotNil([estimator deadStoneGroups]);
+  XCTAssertEqual(expectedNumberOfDeadStoneGroups, [estimator deadStoneGroups].count);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that a stone that is placed inside one of the eyes of an
+/// unconditionally alive group is dead.
+// -----------------------------------------------------------------------------
+- (void) testStoneInsideUnconditionallyAliveGroup
+{
+  [self setupUnconditionallyAliveWhiteGroup];
+  GoPoint* blackPoint = [m_game.board pointAtVertex:@"C2"];
+  [m_game changeSetupPoint:blackPoint toStoneState:GoColorBlack];
+
+  GoDeadStoneEstimator* estimator = [[[GoDeadStoneEstimator alloc] initWithBoard:m_game.board] autorelease];
+  NSArray* deadStoneGroups = [estimator deadStoneGroups];
+  NSUInteger expectedNumberOfDeadStoneGroups = 1;
+  XCTAssertEqual(expectedNumberOfDeadStoneGroups, deadStoneGroups.count);
+  XCTAssertEqual(blackPoint.region, deadStoneGroups.firstObject);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that a stone that is placed outside of an unconditionally
+/// alive group, in a large open area, is not dead.
+// -----------------------------------------------------------------------------
+- (void) testStoneOutsideUnconditionallyAliveGroup
+{
+  [self setupUnconditionallyAliveWhiteGroup];
+  [m_game changeSetupPoint:[m_game.board pointAtVertex:@"K10"] toStoneState:GoColorBlack];
+
+  GoDeadStoneEstimator* estimator = [[[GoDeadStoneEstimator alloc] initWithBoard:m_game.board] autorelease];
+  NSUInteger expectedNumberOfDeadStoneGroups = 0;
+  XCTAssertEqual(expectedNumberOfDeadStoneGroups, [estimator deadStoneGroups].count);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Sets up a white group in the lower left corner with
+/// two eyes, A1-A3 and C1-C3.
+// -----------------------------------------------------------------------------
+- (void) setupUnconditionallyAliveWhiteGroup
+{
+  NSArray* vertices = @[@"A4", @"B4", @"C4", @"D4", @"D3", @"D2", @"D1", @"B1", @"B2", @"B3"];
+  for (NSString* vertex in vertices)
+    [m_game changeSetupPoint:[m_game.board pointAtVertex:vertex] toStoneState:GoColorWhite];
+}
+
+@end
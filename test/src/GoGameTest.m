@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2011-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2011-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -1551,6 +1551,40 @@
   XCTAssertTrue([suicidalIntersectionsString isEqualToString:@"A1"]);
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Exercises the
+/// isLegalBoardSetupAfterChangingPoints:suicidalIntersectionsString:() method.
+// -----------------------------------------------------------------------------
+- (void) testIsLegalBoardSetupAfterChangingPoints
+{
+  NSString* suicidalIntersectionsString;
+
+  GoPoint* pointA1 = [m_game.board pointAtVertex:@"A1"];
+  GoPoint* pointB1 = [m_game.board pointAtVertex:@"B1"];
+  GoPoint* pointA2 = [m_game.board pointAtVertex:@"A2"];
+  GoPoint* pointQ16 = [m_game.board pointAtVertex:@"Q16"];
+
+  // No changes are always legal
+  XCTAssertTrue([m_game isLegalBoardSetupAfterChangingPoints:@[] suicidalIntersectionsString:&suicidalIntersectionsString]);
+
+  // Cannot use changeSetupPoint:toStoneState:() because that already checks
+  // whether the board setup is legal
+  pointA1.stoneState = GoColorBlack;
+  pointB1.stoneState = GoColorWhite;
+  [GoUtilities movePointsToNewRegions:@[pointA1, pointB1]];
+  XCTAssertTrue([m_game isLegalBoardSetupAfterChangingPoints:@[pointA1, pointB1] suicidalIntersectionsString:&suicidalIntersectionsString]);
+
+  // Black stone on A1 now no longer has liberties. A1 is not among the changed
+  // points, but it is adjacent to one of them.
+  pointA2.stoneState = GoColorWhite;
+  [GoUtilities movePointsToNewRegions:@[pointA2]];
+  XCTAssertFalse([m_game isLegalBoardSetupAfterChangingPoints:@[pointA2] suicidalIntersectionsString:&suicidalIntersectionsString]);
+  XCTAssertTrue([suicidalIntersectionsString isEqualToString:@"A1"]);
+
+  // Stone groups that are not affected by the changed points are not examined
+  XCTAssertTrue([m_game isLegalBoardSetupAfterChangingPoints:@[pointQ16] suicidalIntersectionsString:&suicidalIntersectionsString]);
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Exercises the isLegalMove:isIllegalReason:() method (including simple
 /// ko scenarios).
@@ -0,0 +1,99 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Test includes
+#import "GoLegalMoveTableTest.h"
+
+// Application includes
+#import <go/GoBoard.h>
+#import <go/GoBoardPosition.h>
+#import <go/GoGame.h>
+#import <go/GoGameAdditions.h>
+#import <go/GoLegalMoveTable.h>
+#import <go/GoPoint.h>
+
+
+@implementation GoLegalMoveTableTest
+
+// -----------------------------------------------------------------------------
+/// @brief Checks the initial state of a GoLegalMoveTable object after a new
+/// instance has been created.
+// -----------------------------------------------------------------------------
+- (void) testInitial
+{
+  GoLegalMoveTable* table = [[[GoLegalMoveTable alloc] initWithGame:m_game] autorelease];
+  XCTAssertEqual(table.node, m_game.boardPosition.currentNode);
+  XCTAssertEqual(table.color, GoColorBlack);
+  XCTAssertTrue([table isValidForGame:m_game]);
+
+  XCTAssertThrowsSpecificNamed([[[GoLegalMoveTable alloc] initWithGame:nil] autorelease],
+                               NSException, NSInvalidArgumentException, @"game is nil");
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the isLegalMove:isIllegalReason:() method. The answers
+/// must be the same as those of GoGame, also when the same intersection is
+/// queried repeatedly.
+// -----------------------------------------------------------------------------
+- (void) testIsLegalMove
+{
+  enum GoMoveIsIllegalReason illegalReason;
+  GoPoint* point1 = [m_game.board pointAtVertex:@"T1"];
+  GoPoint* point2 = [m_game.board pointAtVertex:@"S1"];
+  GoPoint* point3 = [m_game.board pointAtVertex:@"T2"];
+  [m_game play:point2];
+  [m_game pass];
+  [m_game play:point3];
+
+  // point1 would be suicide for white, point2 is occupied
+  GoLegalMoveTable* table = [[[GoLegalMoveTable alloc] initWithGame:m_game] autorelease];
+  XCTAssertEqual(table.color, GoColorWhite);
+  for (int query = 0; query < 2; ++query)
+  {
+    XCTAssertFalse([table isLegalMove:point1 isIllegalReason:&illegalReason]);
+    XCTAssertEqual(illegalReason, GoMoveIsIllegalReasonSuicide);
+    XCTAssertFalse([table isLegalMove:point2 isIllegalReason:&illegalReason]);
+    XCTAssertEqual(illegalReason, GoMoveIsIllegalReasonIntersectionOccupied);
+    XCTAssertTrue([table isLegalMove:[m_game.board pointAtVertex:@"A19"] isIllegalReason:&illegalReason]);
+  }
+
+  XCTAssertThrowsSpecificNamed([table isLegalMove:nil isIllegalReason:&illegalReason],
+                               NSException, NSInvalidArgumentException, @"point is nil");
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the isValidForGame:() method.
+// -----------------------------------------------------------------------------
+- (void) testIsValidForGame
+{
+  GoLegalMoveTable* table = [[[GoLegalMoveTable alloc] initWithGame:m_game] autorelease];
+  XCTAssertTrue([table isValidForGame:m_game]);
+  XCTAssertFalse([table isValidForGame:nil]);
+
+  [m_game play:[m_game.board pointAtVertex:@"D4"]];
+  XCTAssertFalse([table isValidForGame:m_game]);
+
+  table = [[[GoLegalMoveTable alloc] initWithGame:m_game] autorelease];
+  XCTAssertTrue([table isValidForGame:m_game]);
+  m_game.boardPosition.currentBoardPosition = 0;
+  XCTAssertFalse([table isValidForGame:m_game]);
+  m_game.boardPosition.currentBoardPosition = 1;
+  XCTAssertTrue([table isValidForGame:m_game]);
+}
+
+@end
@@ -0,0 +1,52 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Project includes
+#import "BaseTestCase.h"
+
+
+// -----------------------------------------------------------------------------
+/// @brief The GoModelPerformanceTest class contains performance tests that
+/// measure the hot paths of the Go model: playing moves, checking move
+/// legality, changing the board position, calculating Zobrist hashes,
+/// scoring and navigating the node tree.
+///
+/// Most tests operate on a synthetic game that is generated with a fixed
+/// seed. testSgfCorpusReplayPerformance() in addition replays real games
+/// from the SGF files in the "sgf" folder, because their move sequences
+/// (e.g. long-lived groups, ko fights, captures) differ from those of a
+/// synthetic game.
+///
+/// The tests use XCTest's measure facility, so the results are reported per
+/// test in the test log and in the result bundle, where they can be compared
+/// against a baseline.
+// -----------------------------------------------------------------------------
+@interface GoModelPerformanceTest : BaseTestCase
+{
+}
+
+- (void) testPlayMovesPerformance;
+- (void) testSgfCorpusReplayPerformance;
+- (void) testIsLegalMovePerformance;
+- (void) testChangeBoardPositionPerformance;
+- (void) testHashForBoardPerformance;
+- (void) testScoringPerformance;
+- (void) testDeadStoneEstimatorPerformance;
+- (void) testNodeTreeNavigationPerformance;
+
+@end
@@ -0,0 +1,391 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Test includes
+#import "GoModelPerformanceTest.h"
+
+// Application includes
+#import <go/GoBoard.h>
+#import <go/GoBoardPosition.h>
+#import <go/GoDeadStoneEstimator.h>
+#import <go/GoGame.h>
+#import <go/GoGameAdditions.h>
+#import <go/GoNode.h>
+#import <go/GoNodeAdditions.h>
+#import <go/GoNodeModel.h>
+#import <go/GoPoint.h>
+#import <go/GoScore.h>
+#import <go/GoVertex.h>
+#import <go/GoZobristTable.h>
+#import <main/ApplicationDelegate.h>
+#import <play/model/ScoringModel.h>
+#import <command/game/NewGameCommand.h>
+
+
+/// @brief The maximum number of moves that playRandomGame() plays.
+static const int maximumNumberOfMoves = 200;
+/// @brief The number of times that a measured block repeats the measured
+/// operation. The operations are so fast that a single execution would be
+/// lost in the measuring noise.
+static const int numberOfRepetitions = 100;
+/// @brief The number of nodes in the current variation of the node tree that
+/// createWideNodeTree() creates.
+static const int numberOfNodesInWideNodeTreeVariation = 2000;
+/// @brief The number of children that createWideNodeTree() adds to each node in
+/// the current variation, in addition to the child that is part of the current
+/// variation.
+static const int numberOfBranchesPerNodeInWideNodeTree = 9;
+/// @brief The SGF files that testSgfCorpusReplayPerformance() replays. All of
+/// them are 19x19 games without handicap or setup stones, in which the players
+/// alternate.
+static NSString* sgfCorpusResourceNames[] =
+{
+  @"Blood-vomiting game.sgf",
+  @"Ear-reddening game.sgf",
+  @"Lee's Broken Ladder Game.sgf",
+  @"Fuego vs. Fuego.sgf",
+  @"pu2-gokifu-20110910-Melkisheva_Anastasia-Shikshina_Svetlana.sgf",
+};
+
+
+@implementation GoModelPerformanceTest
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to play a game of up to
+/// #maximumNumberOfMoves moves.
+// -----------------------------------------------------------------------------
+- (void) testPlayMovesPerformance
+{
+  [self measureMetrics:[XCTestCase defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^
+  {
+    [[[[NewGameCommand alloc] init] autorelease] submit];
+    m_game = m_delegate.game;
+
+    [self startMeasuring];
+    [self playRandomGame];
+    [self stopMeasuring];
+  }];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to replay the main variation of all games
+/// in the SGF corpus (see #sgfCorpusResourceNames).
+///
+/// All games are replayed in the same GoGame. Before a game is replayed the
+/// current board position is reset to the beginning of the game, so playing
+/// the first move also discards the nodes of the previous game.
+// -----------------------------------------------------------------------------
+- (void) testSgfCorpusReplayPerformance
+{
+  NSMutableArray* corpus = [NSMutableArray array];
+  int numberOfResources = sizeof(sgfCorpusResourceNames) / sizeof(sgfCorpusResourceNames[0]);
+  for (int indexOfResource = 0; indexOfResource < numberOfResources; ++indexOfResource)
+  {
+    NSArray* moves = [self movesInSgfResource:sgfCorpusResourceNames[indexOfResource]];
+    XCTAssertTrue(moves.count > 0, @"%@", sgfCorpusResourceNames[indexOfResource]);
+    [corpus addObject:moves];
+  }
+  GoBoardPosition* boardPosition = m_game.boardPosition;
+
+  [self measureBlock:^
+  {
+    for (NSArray* moves in corpus)
+    {
+      boardPosition.currentBoardPosition = 0;
+      for (id move in moves)
+      {
+        if (move == [NSNull null])
+          [m_game pass];
+        else
+          [m_game play:move];
+      }
+    }
+  }];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to check the legality of a move on all
+/// intersections of a board in the middle of a game.
+// -----------------------------------------------------------------------------
+- (void) testIsLegalMovePerformance
+{
+  [self playRandomGame];
+  NSMutableArray* points = [NSMutableArray array];
+  NSEnumerator* enumerator = [m_game.board pointEnumerator];
+  GoPoint* point;
+  while (point = [enumerator nextObject])
+    [points addObject:point];
+
+  [self measureBlock:^
+  {
+    enum GoMoveIsIllegalReason illegalReason;
+    for (int repetition = 0; repetition < numberOfRepetitions; ++repetition)
+    {
+      for (GoPoint* point in points)
+        [m_game isLegalMove:point isIllegalReason:&illegalReason];
+    }
+  }];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to jump back and forth between the first
+/// and the last board position of a game.
+// -----------------------------------------------------------------------------
+- (void) testChangeBoardPositionPerformance
+{
+  [self playRandomGame];
+  GoBoardPosition* boardPosition = m_game.boardPosition;
+  int lastBoardPosition = boardPosition.numberOfBoardPositions - 1;
+
+  [self measureBlock:^
+  {
+    for (int repetition = 0; repetition < numberOfRepetitions; ++repetition)
+    {
+      boardPosition.currentBoardPosition = 0;
+      boardPosition.currentBoardPosition = lastBoardPosition;
+    }
+  }];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to calculate the Zobrist hash of a board
+/// in the middle of a game.
+// -----------------------------------------------------------------------------
+- (void) testHashForBoardPerformance
+{
+  [self playRandomGame];
+  GoBoard* board = m_game.board;
+  GoZobristTable* zobristTable = board.zobristTable;
+
+  [self measureBlock:^
+  {
+    for (int repetition = 0; repetition < numberOfRepetitions; ++repetition)
+      [zobristTable hashForBoard:board];
+  }];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to enable scoring mode and to calculate
+/// the score of a game, without asking the GTP engine for dead stones.
+// -----------------------------------------------------------------------------
+- (void) testScoringPerformance
+{
+  m_delegate.scoringModel.askGtpEngineForDeadStones = false;
+  [self playRandomGame];
+  GoScore* score = m_game.score;
+
+  [self measureBlock:^
+  {
+    [score enableScoring];
+    [score calculateWaitUntilDone:true];
+    [score disableScoring];
+  }];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes GoDeadStoneEstimator to estimate the dead
+/// stones of a game.
+// -----------------------------------------------------------------------------
+- (void) testDeadStoneEstimatorPerformance
+{
+  m_delegate.scoringModel.askGtpEngineForDeadStones = false;
+  [self playRandomGame];
+  GoScore* score = m_game.score;
+  // Scoring mode makes the GoBoardRegion objects cache the information that
+  // GoDeadStoneEstimator queries
+  [score enableScoring];
+
+  [self measureBlock:^
+  {
+    for (int repetition = 0; repetition < numberOfRepetitions; ++repetition)
+    {
+      GoDeadStoneEstimator* estimator = [[GoDeadStoneEstimator alloc] initWithBoard:m_game.board];
+      [estimator deadStoneGroups];
+      [estimator release];
+    }
+  }];
+
+  [score disableScoring];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Measures how long it takes to navigate a node tree with 20000 nodes
+/// and wide branching: Look up the index position of every node in the
+/// current variation, and for every branch that is not in the current
+/// variation look up the previous sibling, check the ancestry and find the
+/// nearest ancestor in the current variation.
+// -----------------------------------------------------------------------------
+- (void) testNodeTreeNavigationPerformance
+{
+  [self createWideNodeTree];
+  GoNodeModel* nodeModel = m_game.nodeModel;
+  GoNode* rootNode = nodeModel.rootNode;
+  int numberOfNodes = nodeModel.numberOfNodes;
+
+  [self measureBlock:^
+  {
+    for (int indexOfNode = 0; indexOfNode < numberOfNodes; ++indexOfNode)
+    {
+      GoNode* node = [nodeModel nodeAtIndex:indexOfNode];
+      [nodeModel indexOfNode:node];
+
+      [node enumerateChildrenUsingBlock:^(GoNode* child, int indexOfChild, bool* stop)
+      {
+        [child previousSibling];
+        [child isDescendantOfNode:rootNode];
+        [nodeModel indexOfNode:child];
+        [nodeModel ancestorOfNodeInCurrentVariation:child];
+      }];
+    }
+  }];
+}
+
+#pragma mark - Helper methods
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns the moves in the main variation of the SGF
+/// file @a resourceName, which must be a resource of the test bundle and must
+/// contain a game with the same board size as the current game. Returns the
+/// moves as GoPoint objects of the current game, or NSNull for pass moves.
+///
+/// This is not a full SGF parser, it only recognizes the B and W properties.
+/// The main variation consists of the nodes up to the first end of a game
+/// tree, because in SGF the main variation is always the first variation.
+/// The colors of the moves are ignored because the corpus games alternate.
+// -----------------------------------------------------------------------------
+- (NSArray*) movesInSgfResource:(NSString*)resourceName
+{
+  NSString* path = [m_delegate.resourceBundle pathForResource:resourceName ofType:nil];
+  NSData* data = [NSData dataWithContentsOfFile:path];
+  const char* bytes = data.bytes;
+  NSUInteger length = data.length;
+  int boardSize = m_game.board.size;
+
+  NSMutableArray* moves = [NSMutableArray array];
+  NSMutableString* propertyIdentifier = [NSMutableString string];
+  bool propertyIdentifierIsComplete = false;
+  for (NSUInteger index = 0; index < length; ++index)
+  {
+    char character = bytes[index];
+    if (character == ')')
+    {
+      break;
+    }
+    else if (character == ';')
+    {
+      [propertyIdentifier setString:@""];
+      propertyIdentifierIsComplete = false;
+    }
+    else if (character >= 'A' && character <= 'Z')
+    {
+      if (propertyIdentifierIsComplete)
+      {
+        [propertyIdentifier setString:@""];
+        propertyIdentifierIsComplete = false;
+      }
+      [propertyIdentifier appendFormat:@"%c", character];
+    }
+    else if (character == '[')
+    {
+      NSUInteger indexOfValue = index + 1;
+      for (++index; index < length && bytes[index] != ']'; ++index)
+      {
+        if (bytes[index] == '\\')
+          ++index;
+      }
+      propertyIdentifierIsComplete = true;
+      if (! [propertyIdentifier isEqualToString:@"B"] && ! [propertyIdentifier isEqualToString:@"W"])
+        continue;
+
+      // An empty value is a pass move. In FF[3] "tt" is also a pass move.
+      NSUInteger lengthOfValue = index - indexOfValue;
+      if (lengthOfValue == 0 || (boardSize <= 19 && lengthOfValue == 2 && bytes[indexOfValue] == 't' && bytes[indexOfValue + 1] == 't'))
+      {
+        [moves addObject:[NSNull null]];
+        continue;
+      }
+      // SGF counts columns from the left and rows from the top
+      struct GoVertexNumeric numericVertex;
+      numericVertex.x = bytes[indexOfValue] - 'a' + 1;
+      numericVertex.y = boardSize - (bytes[indexOfValue + 1] - 'a');
+      [moves addObject:[m_game.board pointAtVertex:[GoVertex vertexFromNumeric:numericVertex].string]];
+    }
+  }
+  return moves;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Creates a node tree with 20000 nodes in the current
+/// game. The current variation consists of #numberOfNodesInWideNodeTreeVariation
+/// nodes, each of which except the leaf node has
+/// #numberOfBranchesPerNodeInWideNodeTree additional children that are not in
+/// the current variation. The nodes are empty, i.e. they contain no moves.
+// -----------------------------------------------------------------------------
+- (void) createWideNodeTree
+{
+  GoNodeModel* nodeModel = m_game.nodeModel;
+  for (int indexOfNode = 1; indexOfNode < numberOfNodesInWideNodeTreeVariation; ++indexOfNode)
+  {
+    GoNode* parent = nodeModel.leafNode;
+    [nodeModel appendNode:[GoNode node]];
+    for (int indexOfBranch = 0; indexOfBranch < numberOfBranchesPerNodeInWideNodeTree; ++indexOfBranch)
+      [parent appendChild:[GoNode node]];
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Plays up to #maximumNumberOfMoves moves in the
+/// current game. Stops early if there are no more legal moves.
+///
+/// Move selection uses a simple linear congruential generator with a fixed
+/// seed, so that every invocation plays the same game and measurements remain
+/// comparable between test runs.
+// -----------------------------------------------------------------------------
+- (void) playRandomGame
+{
+  NSMutableArray* points = [NSMutableArray array];
+  NSEnumerator* enumerator = [m_game.board pointEnumerator];
+  GoPoint* point;
+  while (point = [enumerator nextObject])
+    [points addObject:point];
+  NSUInteger numberOfPoints = points.count;
+
+  unsigned int randomState = 12345;
+  enum GoMoveIsIllegalReason illegalReason;
+  for (int moveNumber = 0; moveNumber < maximumNumberOfMoves; ++moveNumber)
+  {
+    randomState = randomState * 1103515245 + 12345;
+    NSUInteger startIndex = (randomState >> 16) % numberOfPoints;
+
+    GoPoint* legalPoint = nil;
+    for (NSUInteger offset = 0; offset < numberOfPoints; ++offset)
+    {
+      GoPoint* candidatePoint = [points objectAtIndex:(startIndex + offset) % numberOfPoints];
+      if ([m_game isLegalMove:candidatePoint isIllegalReason:&illegalReason])
+      {
+        legalPoint = candidatePoint;
+        break;
+      }
+    }
+    if (! legalPoint)
+      break;
+    [m_game play:legalPoint];
+  }
+}
+
+@end
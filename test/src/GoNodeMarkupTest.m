@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2022-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2022-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -375,6 +375,31 @@
                                NSException, NSInvalidArgumentException, @"setLabel:labelText:atVertex: with string object for label that consists only of whitespace");
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Exercises the setLabel:labelText:atVertex:() method with letter and
+/// number markers, whose dictionary values are shared between GoNodeMarkup
+/// objects.
+// -----------------------------------------------------------------------------
+- (void) testSetLabelLabelTextAtVertexWithMarkers
+{
+  GoNodeMarkup* testee1 = [[[GoNodeMarkup alloc] init] autorelease];
+  GoNodeMarkup* testee2 = [[[GoNodeMarkup alloc] init] autorelease];
+  NSNumber* letterMarkerAsNumber = [NSNumber numberWithInt:GoMarkupLabelMarkerLetter];
+  NSNumber* numberMarkerAsNumber = [NSNumber numberWithInt:GoMarkupLabelMarkerNumber];
+
+  [testee1 setLabel:GoMarkupLabelMarkerLetter labelText:@"A" atVertex:@"A1"];
+  [testee1 setLabel:GoMarkupLabelMarkerLetter labelText:@"z" atVertex:@"B1"];
+  [testee1 setLabel:GoMarkupLabelMarkerNumber labelText:@"7" atVertex:@"C1"];
+  NSDictionary* expectedLabels = @{ @"A1": @[letterMarkerAsNumber, @"A"], @"B1": @[letterMarkerAsNumber, @"z"], @"C1": @[numberMarkerAsNumber, @"7"]};
+  XCTAssertEqualObjects(testee1.labels, expectedLabels);
+
+  [testee2 setLabel:GoMarkupLabelMarkerLetter labelText:@" A\n" atVertex:@"D1"];
+  [testee2 setLabel:GoMarkupLabelMarkerNumber labelText:@"7" atVertex:@"E1"];
+  XCTAssertEqualObjects(testee2.labels[@"D1"], testee1.labels[@"A1"]);
+  XCTAssertIdentical(testee2.labels[@"D1"], testee1.labels[@"A1"]);
+  XCTAssertIdentical(testee2.labels[@"E1"], testee1.labels[@"C1"]);
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Exercises the removeLabelAtVertex:() method.
 // -----------------------------------------------------------------------------
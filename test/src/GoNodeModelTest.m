@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2012-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2012-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -212,6 +212,58 @@
                                NSException, NSInvalidArgumentException, @"changeToVariationContainingNode with node that is not in the game tree");
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Exercises the changeToVariationContainingNode:() method when it
+/// switches back and forth between variations that share a common ancestor.
+// -----------------------------------------------------------------------------
+- (void) testChangeToVariationContainingNode_SwitchBetweenSiblingVariations
+{
+  GoNodeModel* nodeModel = m_game.nodeModel;
+  GoNode* rootNode = nodeModel.rootNode;
+
+  [self setupGameTree:rootNode];
+  [nodeModel changeToVariationContainingNode:rootNode];
+  GoNode* mainVariationNode1 = rootNode.firstChild;
+  GoNode* mainVariationNode2 = mainVariationNode1.firstChild;
+  GoNode* mainVariationNode3 = mainVariationNode2.firstChild;
+  GoNode* variation3Node2 = mainVariationNode1.lastChild;
+  GoNode* secondaryVariationNode1 = rootNode.lastChild;
+  GoNode* secondaryVariationNode2 = secondaryVariationNode1.firstChild;
+  GoNode* variation4Node2 = secondaryVariationNode1.lastChild;
+
+  [nodeModel changeToVariationContainingNode:variation4Node2];
+  XCTAssertEqual(nodeModel.numberOfNodes, 3);
+  XCTAssertEqual(nodeModel.numberOfMoves, 0);
+  XCTAssertEqual(rootNode, [nodeModel nodeAtIndex:0]);
+  XCTAssertEqual(secondaryVariationNode1, [nodeModel nodeAtIndex:1]);
+  XCTAssertEqual(variation4Node2, [nodeModel nodeAtIndex:2]);
+
+  [nodeModel changeToVariationContainingNode:secondaryVariationNode2];
+  XCTAssertEqual(nodeModel.numberOfNodes, 3);
+  XCTAssertEqual(nodeModel.numberOfMoves, 1);
+  XCTAssertEqual(secondaryVariationNode1, [nodeModel nodeAtIndex:1]);
+  XCTAssertEqual(secondaryVariationNode2, [nodeModel nodeAtIndex:2]);
+
+  // The node is an ancestor in the current variation => the first child
+  // descendants of the node replace the remainder of the current variation
+  [nodeModel changeToVariationContainingNode:variation3Node2];
+  [nodeModel changeToVariationContainingNode:mainVariationNode1];
+  XCTAssertEqual(nodeModel.numberOfNodes, 4);
+  XCTAssertEqual(nodeModel.numberOfMoves, 1);
+  XCTAssertEqual(mainVariationNode1, [nodeModel nodeAtIndex:1]);
+  XCTAssertEqual(mainVariationNode2, [nodeModel nodeAtIndex:2]);
+  XCTAssertEqual(mainVariationNode3, [nodeModel nodeAtIndex:3]);
+  XCTAssertEqual(mainVariationNode3, nodeModel.leafNode);
+
+  [nodeModel changeToVariationContainingNode:variation3Node2];
+  XCTAssertEqual(nodeModel.numberOfNodes, 3);
+  XCTAssertEqual(nodeModel.numberOfMoves, 0);
+  XCTAssertEqual(mainVariationNode1, [nodeModel nodeAtIndex:1]);
+  XCTAssertEqual(variation3Node2, [nodeModel nodeAtIndex:2]);
+  XCTAssertEqual(-1, [nodeModel indexOfNode:mainVariationNode2]);
+  XCTAssertEqual(2, [nodeModel indexOfNode:variation3Node2]);
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Exercises the ancestorOfNodeInCurrentVariation:() method.
 // -----------------------------------------------------------------------------
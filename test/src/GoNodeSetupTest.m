@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2022-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2022-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -20,6 +20,7 @@
 
 // Application includes
 #import <go/GoBoard.h>
+#import <go/GoBoardRegion.h>
 #import <go/GoGame.h>
 #import <go/GoNodeSetup.h>
 #import <go/GoPoint.h>
@@ -368,6 +369,43 @@
                                NSException, NSInternalInconsistencyException, @"revertSetup failed, black stone already exists");
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Exercises the applySetup() and revertSetup() methods with setup
+/// information that fragments and then reunites an empty region.
+// -----------------------------------------------------------------------------
+- (void) testApplyAndRevertSetupWithRegionFragmentation
+{
+  GoBoard* board = m_game.board;
+  GoPoint* pointA1 = [board pointAtVertex:@"A1"];
+  GoPoint* pointC1 = [board pointAtVertex:@"C1"];
+  GoPoint* pointC19 = [board pointAtVertex:@"C19"];
+  GoPoint* pointD1 = [board pointAtVertex:@"D1"];
+  GoBoardRegion* mainRegion = pointA1.region;
+
+  // A wall of black stones along the C column separates the A and B columns
+  // from the rest of the board
+  NSMutableArray* wall = [NSMutableArray array];
+  for (GoPoint* point = pointC1; point; point = point.above)
+    [wall addObject:point];
+  GoNodeSetup* testee = [GoNodeSetup nodeSetupWithPreviousSetupCapturedFromGame:m_game];
+  [testee setupValidatedBlackStones:wall];
+  [testee applySetup];
+  XCTAssertEqual(pointC1.region, pointC19.region);
+  XCTAssertEqual(19, [pointC1.region size]);
+  XCTAssertNotEqual(pointA1.region, pointD1.region);
+  XCTAssertEqual(38, [pointA1.region size]);
+  XCTAssertEqual(304, [pointD1.region size]);
+  // The larger part re-uses the original region
+  XCTAssertEqual(mainRegion, pointD1.region);
+
+  [testee revertSetup];
+  XCTAssertEqual(GoColorNone, pointC1.stoneState);
+  XCTAssertEqual(mainRegion, pointA1.region);
+  XCTAssertEqual(mainRegion, pointC1.region);
+  XCTAssertEqual(mainRegion, pointD1.region);
+  XCTAssertEqual(361, [mainRegion size]);
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Exercises the setupBlackStone:() method.
 // -----------------------------------------------------------------------------
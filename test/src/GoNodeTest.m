@@ -1,5 +1,5 @@
 // -----------------------------------------------------------------------------
-// Copyright 2022-2024 Patrick Näf (herzbube@herzbube.ch)
+// Copyright 2022-2026 Patrick Näf (herzbube@herzbube.ch)
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -161,6 +161,11 @@
   XCTAssertNil(testee.goNodeAnnotation);
   XCTAssertNil(testee.goNodeMarkup);
   XCTAssertEqual(0, testee.zobristHash);
+  XCTAssertEqual(0, testee.depth);
+  XCTAssertEqual(0, testee.numberOfMovesUpToAndIncludingNode);
+  XCTAssertNil(testee.nodeWithMostRecentMove);
+  XCTAssertNil(testee.nodeWithMostRecentBoardStateChange);
+  XCTAssertEqual(testee, [testee ancestorAtDepth:0]);
 }
 
 // -----------------------------------------------------------------------------
@@ -317,6 +322,39 @@
   XCTAssertFalse(testee.isBranchingNode);
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Exercises the enumerateChildrenUsingBlock:() method.
+// -----------------------------------------------------------------------------
+- (void) testEnumerateChildrenUsingBlock
+{
+  [self setupNodeTree];
+
+  NSMutableArray* enumeratedChildren = [NSMutableArray array];
+  [self.nodeA2 enumerateChildrenUsingBlock:^(GoNode* child, int indexOfChild, bool* stop)
+  {
+    XCTAssertEqual(enumeratedChildren.count, indexOfChild);
+    [enumeratedChildren addObject:child];
+  }];
+  XCTAssertEqualObjects(enumeratedChildren, self.nodeA2.children);
+
+  [enumeratedChildren removeAllObjects];
+  [self.nodeA2 enumerateChildrenUsingBlock:^(GoNode* child, int indexOfChild, bool* stop)
+  {
+    [enumeratedChildren addObject:child];
+    if (child == self.nodeA2b)
+      *stop = true;
+  }];
+  NSArray* expectedChildren = @[self.nodeA2a, self.nodeA2b];
+  XCTAssertEqualObjects(enumeratedChildren, expectedChildren);
+
+  [enumeratedChildren removeAllObjects];
+  [self.nodeA2a enumerateChildrenUsingBlock:^(GoNode* child, int indexOfChild, bool* stop)
+  {
+    [enumeratedChildren addObject:child];
+  }];
+  XCTAssertEqual(0, enumeratedChildren.count);
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Exercises the appendChild:() method.
 ///
@@ -889,6 +927,113 @@
                                NSException, NSInvalidArgumentException, @"isAncestorOfNode: node cannot be nil");
 }
 
+// -----------------------------------------------------------------------------
+/// @brief Exercises the @e depth property and the ancestorAtDepth:() method.
+// -----------------------------------------------------------------------------
+- (void) testDepthAndAncestorAtDepth
+{
+  [self setupNodeTree];
+
+  XCTAssertEqual(0, self.rootNode.depth);
+  XCTAssertEqual(1, self.nodeA.depth);
+  XCTAssertEqual(1, self.nodeC.depth);
+  XCTAssertEqual(2, self.nodeA2.depth);
+  XCTAssertEqual(3, self.nodeA2c.depth);
+  XCTAssertEqual(self.rootNode, [self.nodeA2c ancestorAtDepth:0]);
+  XCTAssertEqual(self.nodeA, [self.nodeA2c ancestorAtDepth:1]);
+  XCTAssertEqual(self.nodeA2, [self.nodeA2c ancestorAtDepth:2]);
+  XCTAssertEqual(self.nodeA2c, [self.nodeA2c ancestorAtDepth:3]);
+  XCTAssertNil([self.nodeA2c ancestorAtDepth:4]);
+  XCTAssertNil([self.nodeA2c ancestorAtDepth:-1]);
+
+  // Moving a sub tree updates the entire sub tree
+  [self.nodeC appendChild:self.nodeA2];
+  XCTAssertEqual(2, self.nodeA2.depth);
+  XCTAssertEqual(3, self.nodeA2c.depth);
+  XCTAssertEqual(self.nodeC, [self.nodeA2c ancestorAtDepth:1]);
+  XCTAssertTrue([self.nodeA2c isDescendantOfNode:self.nodeC]);
+  XCTAssertFalse([self.nodeA2c isDescendantOfNode:self.nodeA]);
+  [self.freeNode1 appendChild:self.nodeC];
+  XCTAssertEqual(1, self.nodeC.depth);
+  XCTAssertEqual(3, self.nodeA2c.depth);
+  XCTAssertEqual(self.freeNode1, [self.nodeA2c ancestorAtDepth:0]);
+  XCTAssertFalse([self.nodeA2c isDescendantOfNode:self.rootNode]);
+
+  // Removing a sub tree turns the sub tree's top node into a root node
+  [self.freeNode1 removeChild:self.nodeC];
+  XCTAssertEqual(0, self.nodeC.depth);
+  XCTAssertEqual(2, self.nodeA2c.depth);
+  XCTAssertEqual(self.nodeC, [self.nodeA2c ancestorAtDepth:0]);
+
+  // A deep node tree exercises the jump pointers
+  GoNode* deepRootNode = [GoNode node];
+  NSMutableArray* deepNodes = [NSMutableArray arrayWithObject:deepRootNode];
+  GoNode* parent = deepRootNode;
+  for (int depth = 1; depth < 1000; ++depth)
+  {
+    GoNode* child = [GoNode node];
+    [parent setFirstChild:child];
+    [deepNodes addObject:child];
+    parent = child;
+  }
+  GoNode* deepLeafNode = parent;
+  XCTAssertEqual(999, deepLeafNode.depth);
+  for (int depth = 0; depth < 1000; ++depth)
+  {
+    GoNode* deepNode = deepNodes[depth];
+    XCTAssertEqual(depth, deepNode.depth);
+    XCTAssertEqual(deepNode, [deepLeafNode ancestorAtDepth:depth]);
+    XCTAssertEqual(deepRootNode, [deepNode ancestorAtDepth:0]);
+  }
+  XCTAssertTrue([deepLeafNode isDescendantOfNode:deepRootNode]);
+  XCTAssertTrue([deepNodes[500] isAncestorOfNode:deepLeafNode]);
+  XCTAssertFalse([deepLeafNode isAncestorOfNode:deepNodes[500]]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the properties @e numberOfMovesUpToAndIncludingNode,
+/// @e nodeWithMostRecentMove and @e nodeWithMostRecentBoardStateChange.
+// -----------------------------------------------------------------------------
+- (void) testMoveAndBoardStateChangeAncestryIndex
+{
+  [self setupNodeTree];
+
+  XCTAssertEqual(0, self.nodeA2a.numberOfMovesUpToAndIncludingNode);
+  XCTAssertNil(self.nodeA2a.nodeWithMostRecentMove);
+  XCTAssertNil(self.nodeA2a.nodeWithMostRecentBoardStateChange);
+
+  self.rootNode.goNodeSetup = [[[GoNodeSetup alloc] init] autorelease];
+  XCTAssertNil(self.nodeA2a.nodeWithMostRecentMove);
+  XCTAssertEqual(self.rootNode, self.nodeA2a.nodeWithMostRecentBoardStateChange);
+
+  self.nodeA.goMove = [GoMove move:GoMoveTypePass by:m_game.playerBlack after:nil];
+  self.nodeA2.goMove = [GoMove move:GoMoveTypePass by:m_game.playerWhite after:nil];
+  XCTAssertEqual(0, self.rootNode.numberOfMovesUpToAndIncludingNode);
+  XCTAssertEqual(1, self.nodeA.numberOfMovesUpToAndIncludingNode);
+  XCTAssertEqual(1, self.nodeA1.numberOfMovesUpToAndIncludingNode);
+  XCTAssertEqual(2, self.nodeA2a.numberOfMovesUpToAndIncludingNode);
+  XCTAssertEqual(self.nodeA, self.nodeA1.nodeWithMostRecentMove);
+  XCTAssertEqual(self.nodeA2, self.nodeA2a.nodeWithMostRecentMove);
+  XCTAssertEqual(self.nodeA2, self.nodeA2a.nodeWithMostRecentBoardStateChange);
+  XCTAssertNil(self.nodeB.nodeWithMostRecentMove);
+  XCTAssertEqual(self.rootNode, self.nodeB.nodeWithMostRecentBoardStateChange);
+
+  // Removing a move updates the entire sub tree
+  self.nodeA.goMove = nil;
+  XCTAssertEqual(0, self.nodeA1.numberOfMovesUpToAndIncludingNode);
+  XCTAssertNil(self.nodeA1.nodeWithMostRecentMove);
+  XCTAssertEqual(1, self.nodeA2a.numberOfMovesUpToAndIncludingNode);
+
+  // Moving a sub tree with a move updates the new location
+  [self.nodeB appendChild:self.nodeA2];
+  XCTAssertEqual(1, self.nodeA2b.numberOfMovesUpToAndIncludingNode);
+  XCTAssertEqual(self.nodeA2, self.nodeA2b.nodeWithMostRecentMove);
+  [self.nodeA2 removeChild:self.nodeA2b];
+  XCTAssertEqual(0, self.nodeA2b.numberOfMovesUpToAndIncludingNode);
+  XCTAssertNil(self.nodeA2b.nodeWithMostRecentMove);
+  XCTAssertNil(self.nodeA2b.nodeWithMostRecentBoardStateChange);
+}
+
 // -----------------------------------------------------------------------------
 /// @brief Exercises the @e hasNextSibling property.
 // -----------------------------------------------------------------------------
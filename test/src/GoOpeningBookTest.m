@@ -0,0 +1,133 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+
+// Test includes
+#import "GoOpeningBookTest.h"
+
+// Application includes
+#import <go/GoBoard.h>
+#import <go/GoGame.h>
+#import <go/GoGameAdditions.h>
+#import <go/GoOpeningBook.h>
+#import <go/GoPoint.h>
+#import <go/GoVertex.h>
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GoOpeningBookTest.
+// -----------------------------------------------------------------------------
+@interface GoOpeningBookTest()
+@property(nonatomic, retain) NSString* textBookPath;
+@property(nonatomic, retain) NSString* binaryBookPath;
+@end
+
+
+@implementation GoOpeningBookTest
+
+// -----------------------------------------------------------------------------
+/// @brief Sets the environment for all tests in this class. Writes a small
+/// text opening book to a temporary file.
+// -----------------------------------------------------------------------------
+- (void) setUp
+{
+  [super setUp];
+
+  NSString* textBook = @"# Comment\n19 | Q4\n19 Q4 | Q16\n19 Z99 | A1\n9 | E5\n";
+  self.textBookPath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GoOpeningBookTest.dat"];
+  self.binaryBookPath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GoOpeningBookTest.bin"];
+  [textBook writeToFile:self.textBookPath atomically:YES encoding:NSUTF8StringEncoding error:nil];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Cleans up the environment after each test in this class.
+// -----------------------------------------------------------------------------
+- (void) tearDown
+{
+  NSFileManager* fileManager = [NSFileManager defaultManager];
+  [fileManager removeItemAtPath:self.textBookPath error:nil];
+  [fileManager removeItemAtPath:self.binaryBookPath error:nil];
+  self.textBookPath = nil;
+  self.binaryBookPath = nil;
+
+  [super tearDown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the compileTextBookAtPath:toBinaryBookAtPath:() method.
+// -----------------------------------------------------------------------------
+- (void) testCompileTextBook
+{
+  XCTAssertTrue([GoOpeningBook compileTextBookAtPath:self.textBookPath toBinaryBookAtPath:self.binaryBookPath]);
+  GoOpeningBook* openingBook = [[[GoOpeningBook alloc] initWithContentsOfFile:self.binaryBookPath] autorelease];
+  XCTAssertNotNil(openingBook);
+  // The line with the invalid vertex is skipped, the comment is ignored
+  XCTAssertEqual(3, openingBook.numberOfPositions);
+
+  NSString* missingTextBookPath = [self.textBookPath stringByAppendingString:@".missing"];
+  XCTAssertFalse([GoOpeningBook compileTextBookAtPath:missingTextBookPath toBinaryBookAtPath:self.binaryBookPath]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the initWithContentsOfFile:() initializer with files that
+/// are not binary opening books.
+// -----------------------------------------------------------------------------
+- (void) testInvalidBinaryBook
+{
+  XCTAssertNil([[[GoOpeningBook alloc] initWithContentsOfFile:self.binaryBookPath] autorelease]);
+  XCTAssertNil([[[GoOpeningBook alloc] initWithContentsOfFile:self.textBookPath] autorelease]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the moveForGame:() method.
+// -----------------------------------------------------------------------------
+- (void) testMoveForGame
+{
+  [GoOpeningBook compileTextBookAtPath:self.textBookPath toBinaryBookAtPath:self.binaryBookPath];
+  GoOpeningBook* openingBook = [[[GoOpeningBook alloc] initWithContentsOfFile:self.binaryBookPath] autorelease];
+
+  GoPoint* move = [openingBook moveForGame:m_game];
+  XCTAssertNotNil(move);
+  XCTAssertEqualObjects(@"Q4", move.vertex.string);
+
+  [m_game play:[m_game.board pointAtVertex:@"Q4"]];
+  move = [openingBook moveForGame:m_game];
+  XCTAssertNotNil(move);
+  XCTAssertEqualObjects(@"Q16", move.vertex.string);
+
+  // Position is not in the opening book
+  [m_game play:[m_game.board pointAtVertex:@"Q16"]];
+  XCTAssertNil([openingBook moveForGame:m_game]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the moveForGame:() method with board positions that are
+/// in the opening book only as a reflected variant.
+// -----------------------------------------------------------------------------
+- (void) testMoveForGameSymmetry
+{
+  [GoOpeningBook compileTextBookAtPath:self.textBookPath toBinaryBookAtPath:self.binaryBookPath];
+  GoOpeningBook* openingBook = [[[GoOpeningBook alloc] initWithContentsOfFile:self.binaryBookPath] autorelease];
+
+  // Horizontal reflection of Q4
+  [m_game play:[m_game.board pointAtVertex:@"D4"]];
+  GoPoint* move = [openingBook moveForGame:m_game];
+  XCTAssertNotNil(move);
+  XCTAssertEqualObjects(@"D16", move.vertex.string);
+}
+
+@end
@@ -0,0 +1,247 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GtpAnalysisCacheTest.h"
+
+// Application includes
+#import <command/game/NewGameCommand.h>
+#import <go/GoBoard.h>
+#import <go/GoGame.h>
+#import <go/GoGameAdditions.h>
+#import <go/GoPoint.h>
+#import <gtp/GtpAnalysisCache.h>
+#import <main/ApplicationDelegate.h>
+
+
+@implementation GtpAnalysisCacheTest
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the storeResult:forKey:() and resultForKey:() methods, and
+/// the size accounting of the cache.
+// -----------------------------------------------------------------------------
+- (void) testStoreResult
+{
+  GtpAnalysisCache* cache = [[[GtpAnalysisCache alloc] initWithMaximumSize:100] autorelease];
+  XCTAssertEqual(100, cache.maximumSize);
+  XCTAssertEqual(0, cache.size);
+  XCTAssertEqual(0, cache.numberOfResults);
+
+  [cache storeResult:[self resultWithLength:10] forKey:@"a"];
+  [cache storeResult:[self resultWithLength:20] forKey:@"b"];
+  XCTAssertEqual(30, cache.size);
+  XCTAssertEqual(2, cache.numberOfResults);
+  XCTAssertEqual(10, [cache resultForKey:@"a"].length);
+  XCTAssertEqual(20, [cache resultForKey:@"b"].length);
+  XCTAssertNil([cache resultForKey:@"c"]);
+  XCTAssertNil([cache resultForKey:nil]);
+  XCTAssertEqual(2, cache.numberOfHits);
+  XCTAssertEqual(2, cache.numberOfMisses);
+
+  // Replacing a result accounts only for the size of the new result
+  [cache storeResult:[self resultWithLength:5] forKey:@"a"];
+  XCTAssertEqual(25, cache.size);
+  XCTAssertEqual(2, cache.numberOfResults);
+  XCTAssertEqual(5, [cache resultForKey:@"a"].length);
+
+  // Nil arguments are ignored
+  [cache storeResult:nil forKey:@"c"];
+  [cache storeResult:[self resultWithLength:1] forKey:nil];
+  XCTAssertEqual(25, cache.size);
+  XCTAssertEqual(2, cache.numberOfResults);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the eviction of the least recently used results.
+// -----------------------------------------------------------------------------
+- (void) testEviction
+{
+  GtpAnalysisCache* cache = [[[GtpAnalysisCache alloc] initWithMaximumSize:100] autorelease];
+  [cache storeResult:[self resultWithLength:40] forKey:@"a"];
+  [cache storeResult:[self resultWithLength:40] forKey:@"b"];
+  // A lookup makes "a" the most recently used result
+  XCTAssertNotNil([cache resultForKey:@"a"]);
+
+  [cache storeResult:[self resultWithLength:40] forKey:@"c"];
+  XCTAssertEqual(80, cache.size);
+  XCTAssertEqual(2, cache.numberOfResults);
+  XCTAssertNil([cache resultForKey:@"b"]);
+  XCTAssertNotNil([cache resultForKey:@"a"]);
+  XCTAssertNotNil([cache resultForKey:@"c"]);
+
+  // A result that fills the cache on its own evicts all other results
+  [cache storeResult:[self resultWithLength:100] forKey:@"d"];
+  XCTAssertEqual(100, cache.size);
+  XCTAssertEqual(1, cache.numberOfResults);
+  XCTAssertNotNil([cache resultForKey:@"d"]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the storeResult:forKey:() method with a result that is
+/// larger than the maximum size of the cache.
+// -----------------------------------------------------------------------------
+- (void) testOversizeResult
+{
+  GtpAnalysisCache* cache = [[[GtpAnalysisCache alloc] initWithMaximumSize:100] autorelease];
+  [cache storeResult:[self resultWithLength:50] forKey:@"a"];
+
+  // The result is ignored, the results already in the cache are kept
+  [cache storeResult:[self resultWithLength:101] forKey:@"b"];
+  XCTAssertEqual(50, cache.size);
+  XCTAssertEqual(1, cache.numberOfResults);
+  XCTAssertNil([cache resultForKey:@"b"]);
+  XCTAssertNotNil([cache resultForKey:@"a"]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the removeAllResults() method.
+// -----------------------------------------------------------------------------
+- (void) testRemoveAllResults
+{
+  GtpAnalysisCache* cache = [[[GtpAnalysisCache alloc] initWithMaximumSize:100] autorelease];
+  [cache storeResult:[self resultWithLength:10] forKey:@"a"];
+  [cache storeResult:[self resultWithLength:20] forKey:@"b"];
+
+  [cache removeAllResults];
+  XCTAssertEqual(0, cache.size);
+  XCTAssertEqual(0, cache.numberOfResults);
+  XCTAssertNil([cache resultForKey:@"a"]);
+
+  // The cache remains usable
+  [cache storeResult:[self resultWithLength:30] forKey:@"c"];
+  XCTAssertEqual(30, cache.size);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the writeToFile:() and readFromFile:() methods.
+// -----------------------------------------------------------------------------
+- (void) testWriteAndReadFile
+{
+  NSString* path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GtpAnalysisCacheTest.plist"];
+  GtpAnalysisCache* cache = [[[GtpAnalysisCache alloc] initWithMaximumSize:100] autorelease];
+  [cache storeResult:[self resultWithLength:40] forKey:@"a"];
+  [cache storeResult:[self resultWithLength:30] forKey:@"b"];
+  [cache storeResult:[self resultWithLength:20] forKey:@"c"];
+  // Usage order is now b, c, a
+  [cache resultForKey:@"a"];
+  XCTAssertTrue([cache writeToFile:path]);
+
+  // A smaller cache keeps only the most recently used results
+  GtpAnalysisCache* restoredCache = [[[GtpAnalysisCache alloc] initWithMaximumSize:60] autorelease];
+  XCTAssertTrue([restoredCache readFromFile:path]);
+  XCTAssertEqual(60, restoredCache.size);
+  XCTAssertEqual(2, restoredCache.numberOfResults);
+  XCTAssertNil([restoredCache resultForKey:@"b"]);
+  XCTAssertEqual(20, [restoredCache resultForKey:@"c"].length);
+  XCTAssertEqual(40, [restoredCache resultForKey:@"a"].length);
+
+  [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+  XCTAssertFalse([restoredCache readFromFile:path]);
+  XCTAssertEqual(0, restoredCache.size);
+  XCTAssertEqual(0, restoredCache.numberOfResults);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the keyForAnalysis:() method.
+// -----------------------------------------------------------------------------
+- (void) testKeyForAnalysis
+{
+  NSString* key = [GtpAnalysisCache keyForAnalysis:@"foo"];
+  XCTAssertNotNil(key);
+  XCTAssertEqualObjects(key, [GtpAnalysisCache keyForAnalysis:@"foo"]);
+  XCTAssertNotEqualObjects(key, [GtpAnalysisCache keyForAnalysis:@"bar"]);
+
+  [m_game play:[m_game.board pointAtVertex:@"D4"]];
+  NSString* keyAfterMove = [GtpAnalysisCache keyForAnalysis:@"foo"];
+  XCTAssertNotEqualObjects(key, keyAfterMove);
+
+  // The key does not depend on the random values of the Zobrist table of the
+  // board, so a new game with the same board position has the same key
+  [[[[NewGameCommand alloc] init] autorelease] submit];
+  m_game = m_delegate.game;
+  [m_game play:[m_game.board pointAtVertex:@"D4"]];
+  XCTAssertEqualObjects(keyAfterMove, [GtpAnalysisCache keyForAnalysis:@"foo"]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the keyForAnalysis:afterMoveAtPoint:() method.
+// -----------------------------------------------------------------------------
+- (void) testKeyForAnalysisAfterMoveAtPoint
+{
+  GoPoint* pointD4 = [m_game.board pointAtVertex:@"D4"];
+  NSString* key = [GtpAnalysisCache keyForAnalysis:@"foo" afterMoveAtPoint:pointD4];
+  XCTAssertNotEqualObjects(key, [GtpAnalysisCache keyForAnalysis:@"foo"]);
+  [m_game play:pointD4];
+  XCTAssertEqualObjects(key, [GtpAnalysisCache keyForAnalysis:@"foo"]);
+
+  // The hypothetical move captures the white stone on A1
+  [m_game play:[m_game.board pointAtVertex:@"A1"]];  // W
+  [m_game play:[m_game.board pointAtVertex:@"B1"]];  // B
+  [m_game play:[m_game.board pointAtVertex:@"Q16"]];  // W
+  GoPoint* pointA2 = [m_game.board pointAtVertex:@"A2"];
+  key = [GtpAnalysisCache keyForAnalysis:@"foo" afterMoveAtPoint:pointA2];
+  [m_game play:pointA2];  // B
+  XCTAssertFalse([m_game.board pointAtVertex:@"A1"].hasStone);
+  XCTAssertEqualObjects(key, [GtpAnalysisCache keyForAnalysis:@"foo"]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the keyForAnalysis:() and keyForAnalysis:afterMoveAtPoint:()
+/// methods with a ko.
+// -----------------------------------------------------------------------------
+- (void) testKeyForAnalysisWithKo
+{
+  // Black captures the white stone on D4, which creates a ko that forbids
+  // White to recapture on D4 immediately
+  [self playMoves:@[@"D5", @"E5", @"C4", @"F4", @"D3", @"E3", @"Q16", @"D4"]];
+  GoPoint* pointE4 = [m_game.board pointAtVertex:@"E4"];
+  NSString* keyWithKo = [GtpAnalysisCache keyForAnalysis:@"foo" afterMoveAtPoint:pointE4];
+  [m_game play:pointE4];  // B
+  XCTAssertFalse([m_game.board pointAtVertex:@"D4"].hasStone);
+  XCTAssertEqualObjects(keyWithKo, [GtpAnalysisCache keyForAnalysis:@"foo"]);
+
+  // The same stones, but Black captured earlier so that White is free to play
+  // on D4
+  [[[[NewGameCommand alloc] init] autorelease] submit];
+  m_game = m_delegate.game;
+  [self playMoves:@[@"D5", @"E5", @"C4", @"F4", @"D3", @"D4", @"E4", @"E3", @"Q16"]];
+  XCTAssertFalse([m_game.board pointAtVertex:@"D4"].hasStone);
+  NSString* keyWithoutKo = [GtpAnalysisCache keyForAnalysis:@"foo"];
+  XCTAssertNotEqualObjects(keyWithKo, keyWithoutKo);
+}
+
+#pragma mark - Helper methods
+
+// -----------------------------------------------------------------------------
+/// @brief Returns a result with @a length bytes.
+// -----------------------------------------------------------------------------
+- (NSData*) resultWithLength:(NSUInteger)length
+{
+  return [NSMutableData dataWithLength:length];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Plays the moves on the intersections in @a vertices, alternating
+/// between Black and White.
+// -----------------------------------------------------------------------------
+- (void) playMoves:(NSArray*)vertices
+{
+  for (NSString* vertex in vertices)
+    [m_game play:[m_game.board pointAtVertex:vertex]];
+}
+
+@end
@@ -0,0 +1,266 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GtpClientTest.h"
+
+// Application includes
+#import <gtp/GtpClient.h>
+#import <gtp/GtpCommand.h>
+#import <gtp/GtpResponse.h>
+#import <gtp/PipeStreamBuffer.h>
+
+// System includes
+#include <ostream>
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GtpClientTest.
+///
+/// The test does not use a real GTP engine. Instead the test itself plays the
+/// role of the GTP engine: It never reads the commands that GtpClient writes,
+/// but it writes one response for each command that it expects GtpClient to
+/// process. As long as the test withholds a response, GtpClient's secondary
+/// thread is blocked, and commands that are submitted in the meantime pile up
+/// in the queue.
+// -----------------------------------------------------------------------------
+@interface GtpClientTest()
+{
+@private
+  PipeStreamBuffer* commandStreamBuffer;
+  PipeStreamBuffer* responseStreamBuffer;
+}
+@property(nonatomic, retain) GtpClient* client;
+/// @brief The commands whose responses were received by responseReceived:(),
+/// in the order in which the responses were received. GtpResponse does not
+/// retain its command, so we must keep the commands, not the responses.
+@property(nonatomic, retain) NSMutableArray* commandsWithResponse;
+@end
+
+
+@implementation GtpClientTest
+
+// -----------------------------------------------------------------------------
+/// @brief Sets the environment for all tests in this class. Creates a
+/// GtpClient that is connected to two pipes instead of a GTP engine.
+// -----------------------------------------------------------------------------
+- (void) setUp
+{
+  [super setUp];
+
+  commandStreamBuffer = new PipeStreamBuffer();
+  responseStreamBuffer = new PipeStreamBuffer();
+  NSArray* streamBuffers = @[[NSValue valueWithPointer:commandStreamBuffer],
+                             [NSValue valueWithPointer:responseStreamBuffer]];
+  self.client = [GtpClient clientWithStreamBuffers:streamBuffers];
+  self.client.postsNotifications = false;
+  self.commandsWithResponse = [NSMutableArray array];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Cleans up the environment after each test in this class. Terminates
+/// the secondary thread of the GtpClient before the pipes are deallocated.
+// -----------------------------------------------------------------------------
+- (void) tearDown
+{
+  NSUInteger numberOfResponses = self.commandsWithResponse.count;
+  [self submitCommand:@"quit" priority:GtpCommandPriorityNormal coalescingKey:nil];
+  [self writeResponses:1];
+  [self waitForNumberOfResponses:numberOfResponses + 1];
+  NSDate* timeoutDate = [NSDate dateWithTimeIntervalSinceNow:5.0];
+  while (! self.client.shouldExit && [timeoutDate timeIntervalSinceNow] > 0)
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+
+  self.client = nil;
+  self.commandsWithResponse = nil;
+  delete commandStreamBuffer;
+  delete responseStreamBuffer;
+  commandStreamBuffer = nullptr;
+  responseStreamBuffer = nullptr;
+
+  [super tearDown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that commands with a higher priority overtake pending
+/// commands with a lower priority, and that commands with the same priority
+/// are processed in the order in which they were submitted.
+// -----------------------------------------------------------------------------
+- (void) testPriority
+{
+  [self blockClient];
+  [self submitCommand:@"low1" priority:GtpCommandPriorityLow coalescingKey:nil];
+  [self submitCommand:@"normal1" priority:GtpCommandPriorityNormal coalescingKey:nil];
+  [self submitCommand:@"high1" priority:GtpCommandPriorityHigh coalescingKey:nil];
+  [self submitCommand:@"normal2" priority:GtpCommandPriorityNormal coalescingKey:nil];
+  [self submitCommand:@"low2" priority:GtpCommandPriorityLow coalescingKey:nil];
+  XCTAssertEqual(self.client.numberOfPendingCommands, 5);
+  XCTAssertEqual(self.client.maximumNumberOfPendingCommands, 5);
+
+  [self writeResponses:6];
+  [self waitForNumberOfResponses:6];
+
+  NSArray* expectedCommands = @[@"block", @"high1", @"normal1", @"normal2", @"low1", @"low2"];
+  XCTAssertEqualObjects([self commandsWithResponseStatus:true], expectedCommands);
+  XCTAssertEqual(self.client.numberOfPendingCommands, 0);
+  XCTAssertEqual(self.client.numberOfDroppedCommands, 0);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that a newly submitted command drops the pending commands
+/// with the same coalescing key, but not other commands.
+// -----------------------------------------------------------------------------
+- (void) testCoalescing
+{
+  [self blockClient];
+  [self submitCommand:@"key1-a" priority:GtpCommandPriorityLow coalescingKey:@"key1"];
+  [self submitCommand:@"key2-a" priority:GtpCommandPriorityNormal coalescingKey:@"key2"];
+  [self submitCommand:@"nokey" priority:GtpCommandPriorityNormal coalescingKey:nil];
+  [self submitCommand:@"key1-b" priority:GtpCommandPriorityLow coalescingKey:@"key1"];
+  [self submitCommand:@"key1-c" priority:GtpCommandPriorityHigh coalescingKey:@"key1"];
+  XCTAssertEqual(self.client.numberOfPendingCommands, 3);
+  XCTAssertEqual(self.client.numberOfDroppedCommands, 2);
+
+  [self writeResponses:4];
+  [self waitForNumberOfResponses:6];
+
+  NSArray* expectedCommands = @[@"block", @"key1-c", @"key2-a", @"nokey"];
+  XCTAssertEqualObjects([self commandsWithResponseStatus:true], expectedCommands);
+  // The response targets of the dropped commands were notified with a
+  // "failed" response
+  NSArray* expectedDroppedCommands = @[@"key1-a", @"key1-b"];
+  XCTAssertEqualObjects([self commandsWithResponseStatus:false], expectedDroppedCommands);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that cancelled commands are dropped, both if they are
+/// cancelled individually and if they are cancelled by coalescing key, and
+/// that cancelling has no effect on a command that is already being processed.
+// -----------------------------------------------------------------------------
+- (void) testCancellation
+{
+  GtpCommand* blockingCommand = [self blockClient];
+  GtpCommand* command1 = [self submitCommand:@"command1" priority:GtpCommandPriorityNormal coalescingKey:nil];
+  GtpCommand* command2 = [self submitCommand:@"command2" priority:GtpCommandPriorityNormal coalescingKey:nil];
+  [self submitCommand:@"command3" priority:GtpCommandPriorityNormal coalescingKey:@"key"];
+  [self submitCommand:@"command4" priority:GtpCommandPriorityNormal coalescingKey:nil];
+
+  [blockingCommand cancel];
+  [command2 cancel];
+  XCTAssertTrue(command2.isCancelled);
+  XCTAssertFalse(command1.isCancelled);
+  [self.client cancelCommandsWithCoalescingKey:@"key"];
+  // The individually cancelled command remains in the queue until GtpClient
+  // reaches it
+  XCTAssertEqual(self.client.numberOfPendingCommands, 3);
+  XCTAssertEqual(self.client.numberOfDroppedCommands, 1);
+
+  [self writeResponses:3];
+  [self waitForNumberOfResponses:5];
+
+  NSArray* expectedCommands = @[@"block", @"command1", @"command4"];
+  XCTAssertEqualObjects([self commandsWithResponseStatus:true], expectedCommands);
+  NSArray* expectedDroppedCommands = @[@"command3", @"command2"];
+  XCTAssertEqualObjects([self commandsWithResponseStatus:false], expectedDroppedCommands);
+  XCTAssertEqual(self.client.numberOfDroppedCommands, 2);
+}
+
+#pragma mark - Helper methods
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Submits a command and waits until GtpClient's
+/// secondary thread has taken the command out of the queue and is blocked
+/// waiting for the response. Returns the command.
+// -----------------------------------------------------------------------------
+- (GtpCommand*) blockClient
+{
+  GtpCommand* command = [self submitCommand:@"block" priority:GtpCommandPriorityNormal coalescingKey:nil];
+  NSDate* timeoutDate = [NSDate dateWithTimeIntervalSinceNow:5.0];
+  while (self.client.numberOfPendingCommands > 0 && [timeoutDate timeIntervalSinceNow] > 0)
+    [NSThread sleepForTimeInterval:0.01];
+  XCTAssertEqual(self.client.numberOfPendingCommands, 0);
+  return command;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Submits the asynchronous command @a commandString
+/// with priority @a priority and coalescing key @a coalescingKey. Returns the
+/// command.
+// -----------------------------------------------------------------------------
+- (GtpCommand*) submitCommand:(NSString*)commandString
+                     priority:(enum GtpCommandPriority)priority
+                coalescingKey:(NSString*)coalescingKey
+{
+  GtpCommand* command = [GtpCommand asynchronousCommand:commandString
+                                         responseTarget:self
+                                               selector:@selector(responseReceived:)];
+  command.priority = priority;
+  command.coalescingKey = coalescingKey;
+  [self.client submit:command];
+  return command;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Writes @a numberOfResponses successful responses
+/// into the response pipe.
+// -----------------------------------------------------------------------------
+- (void) writeResponses:(int)numberOfResponses
+{
+  std::ostream responseStream(responseStreamBuffer);
+  for (int responseIndex = 0; responseIndex < numberOfResponses; ++responseIndex)
+    responseStream << "= \n\n";
+  responseStream << std::flush;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Runs the main thread's run loop until at least
+/// @a numberOfResponses responses were received, or until a timeout occurs.
+// -----------------------------------------------------------------------------
+- (void) waitForNumberOfResponses:(NSUInteger)numberOfResponses
+{
+  NSDate* timeoutDate = [NSDate dateWithTimeIntervalSinceNow:5.0];
+  while (self.commandsWithResponse.count < numberOfResponses && [timeoutDate timeIntervalSinceNow] > 0)
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+  XCTAssertEqual(self.commandsWithResponse.count, numberOfResponses);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns the command strings of the responses
+/// received so far whose status is @a status, in the order in which the
+/// responses were received.
+// -----------------------------------------------------------------------------
+- (NSArray*) commandsWithResponseStatus:(bool)status
+{
+  NSMutableArray* commands = [NSMutableArray array];
+  for (GtpCommand* command in self.commandsWithResponse)
+  {
+    if (command.response.status == status)
+      [commands addObject:command.command];
+  }
+  return commands;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Is invoked in the context of the main thread when GtpClient has
+/// received the response to a command, or has dropped a command.
+// -----------------------------------------------------------------------------
+- (void) responseReceived:(GtpResponse*)response
+{
+  [self.commandsWithResponse addObject:response.command];
+}
+
+@end
@@ -0,0 +1,331 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GtpEnginePoolTest.h"
+
+// Application includes
+#import <gtp/GtpClient.h>
+#import <gtp/GtpCommand.h>
+#import <gtp/GtpEnginePool.h>
+#import <gtp/GtpEnginePositionTracker.h>
+#import <gtp/GtpResponse.h>
+#import <gtp/PipeStreamBuffer.h>
+
+// System includes
+#include <ostream>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+/// @brief Class extension with private properties for GtpEnginePoolTest.
+///
+/// The test does not use real GTP engines. Like GtpClientTest, the test itself
+/// plays the role of the GTP engines: It writes one response for each command
+/// that it expects a GtpClient to process. As long as the test withholds a
+/// response, the GtpClient is blocked, and commands that are submitted in the
+/// meantime pile up in its queue.
+// -----------------------------------------------------------------------------
+@interface GtpEnginePoolTest()
+{
+@private
+  std::vector<PipeStreamBuffer*> commandStreamBuffers;
+  std::vector<PipeStreamBuffer*> responseStreamBuffers;
+}
+@property(nonatomic, retain) GtpEnginePool* pool;
+@property(nonatomic, retain) GtpClient* primaryClient;
+@property(nonatomic, retain) GtpClient* secondaryClient;
+/// @brief The commands whose responses were received by responseReceived:(),
+/// in the order in which the responses were received.
+@property(nonatomic, retain) NSMutableArray* commandsWithResponse;
+@end
+
+
+@implementation GtpEnginePoolTest
+
+// -----------------------------------------------------------------------------
+/// @brief Sets the environment for all tests in this class. Creates a
+/// GtpEnginePool with a primary and a secondary GtpClient, each of which is
+/// connected to two pipes instead of a GTP engine.
+// -----------------------------------------------------------------------------
+- (void) setUp
+{
+  [super setUp];
+
+  NSMutableArray* clients = [NSMutableArray array];
+  for (int indexOfClient = 0; indexOfClient < 2; ++indexOfClient)
+  {
+    PipeStreamBuffer* commandStreamBuffer = new PipeStreamBuffer();
+    PipeStreamBuffer* responseStreamBuffer = new PipeStreamBuffer();
+    commandStreamBuffers.push_back(commandStreamBuffer);
+    responseStreamBuffers.push_back(responseStreamBuffer);
+    NSArray* streamBuffers = @[[NSValue valueWithPointer:commandStreamBuffer],
+                               [NSValue valueWithPointer:responseStreamBuffer]];
+    GtpClient* client = [GtpClient clientWithStreamBuffers:streamBuffers];
+    client.postsNotifications = false;
+    [clients addObject:client];
+  }
+  self.pool = [GtpEnginePool poolWithClients:clients];
+  self.primaryClient = [clients objectAtIndex:0];
+  self.secondaryClient = [clients objectAtIndex:1];
+  self.commandsWithResponse = [NSMutableArray array];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Cleans up the environment after each test in this class. Terminates
+/// the secondary threads of the GtpClients before the pipes are deallocated.
+// -----------------------------------------------------------------------------
+- (void) tearDown
+{
+  NSArray* clients = @[self.primaryClient, self.secondaryClient];
+  for (NSUInteger indexOfClient = 0; indexOfClient < clients.count; ++indexOfClient)
+  {
+    GtpClient* client = [clients objectAtIndex:indexOfClient];
+    NSUInteger numberOfResponses = self.commandsWithResponse.count;
+    [self submitCommand:@"quit" kind:GtpCommandKindGame toClient:client];
+    [self writeResponses:1 toClientAtIndex:indexOfClient];
+    [self waitForNumberOfResponses:numberOfResponses + 1];
+    NSDate* timeoutDate = [NSDate dateWithTimeIntervalSinceNow:5.0];
+    while (! client.shouldExit && [timeoutDate timeIntervalSinceNow] > 0)
+      [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+  }
+
+  self.pool = nil;
+  self.primaryClient = nil;
+  self.secondaryClient = nil;
+  self.commandsWithResponse = nil;
+  for (PipeStreamBuffer* pipeStreamBuffer : commandStreamBuffers)
+    delete pipeStreamBuffer;
+  for (PipeStreamBuffer* pipeStreamBuffer : responseStreamBuffers)
+    delete pipeStreamBuffer;
+  commandStreamBuffers.clear();
+  responseStreamBuffers.clear();
+
+  [super tearDown];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Submits the commands of a sliced territory statistics search to a
+/// pinned GtpClient, and submits a slice while the sample of the previous
+/// slice is still pending. Checks that all commands are processed by the
+/// pinned GtpClient, and that GtpEnginePool dispatches the analysis commands
+/// of other submitters to the pinned GtpClient only after it was unpinned.
+// -----------------------------------------------------------------------------
+- (void) testPinnedClientWithPendingSample
+{
+  // Give the primary GTP engine a known board position, then keep it busy
+  [self submitCommand:@"boardsize 9" kind:GtpCommandKindGame toClient:nil];
+  [self writeResponses:1 toClientAtIndex:0];
+  [self waitForNumberOfResponses:1];
+  [self submitCommand:@"block" kind:GtpCommandKindGame toClient:nil];
+  [self waitUntilClient:self.primaryClient hasNumberOfPendingCommands:0];
+
+  GtpCommand* timeLimitCommand = [self commandWithString:@"go_param timelimit 0.5" kind:GtpCommandKindAnalysis];
+  GtpClient* pinnedClient = [self.pool pinClientForAnalysisCommand:timeLimitCommand];
+  XCTAssertEqual(pinnedClient, self.secondaryClient);
+  [pinnedClient submit:timeLimitCommand];
+  [self submitCommand:@"reg_genmove B" kind:GtpCommandKindAnalysis toClient:pinnedClient];
+  // "boardsize 9" sets up the secondary GTP engine
+  [self writeResponses:3 toClientAtIndex:1];
+  [self waitForNumberOfResponses:3];
+
+  // The sample is being processed, the next slice must still go to the pinned
+  // GtpClient
+  GtpCommand* sampleCommand = [self commandWithString:@"uct_stat_territory" kind:GtpCommandKindAnalysis];
+  sampleCommand.coalescingKey = @"sample";
+  [pinnedClient submit:sampleCommand];
+  [self submitCommand:@"reg_genmove B" kind:GtpCommandKindAnalysis toClient:pinnedClient];
+  [self waitUntilClient:self.secondaryClient hasNumberOfPendingCommands:1];
+
+  // An analysis command of another submitter is not dispatched to the pinned
+  // GtpClient, even though it has the same board position as the primary
+  [self submitCommand:@"other_analysis" kind:GtpCommandKindAnalysis toClient:nil];
+  XCTAssertEqual(self.primaryClient.numberOfPendingCommands, 1);
+  XCTAssertEqual(self.secondaryClient.numberOfPendingCommands, 1);
+
+  [self submitCommand:@"go_param timelimit 10" kind:GtpCommandKindAnalysis toClient:pinnedClient];
+  [self writeResponses:3 toClientAtIndex:1];
+  [self waitForNumberOfResponses:6];
+  [self.pool unpinClient:pinnedClient];
+
+  NSArray* expectedCommands = @[@"boardsize 9", @"go_param timelimit 0.5", @"reg_genmove B",
+                                @"uct_stat_territory", @"reg_genmove B", @"go_param timelimit 10"];
+  XCTAssertEqualObjects([self commandsWithResponseStrings], expectedCommands);
+
+  [self writeResponses:2 toClientAtIndex:0];
+  [self waitForNumberOfResponses:8];
+
+  // After unpinning, the secondary GtpClient is available again
+  [self submitCommand:@"analysis_after_unpin" kind:GtpCommandKindAnalysis toClient:nil];
+  [self writeResponses:1 toClientAtIndex:1];
+  [self waitForNumberOfResponses:9];
+  XCTAssertEqualObjects([[self commandsWithResponseStrings] lastObject], @"analysis_after_unpin");
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Reserves the primary GtpClient, changes the board position of its
+/// GTP engine like an engine match would, then releases the primary GtpClient.
+/// Checks that the board position is restored.
+// -----------------------------------------------------------------------------
+- (void) testReservePrimaryClient
+{
+  [self submitCommand:@"boardsize 9" kind:GtpCommandKindGame toClient:nil];
+  [self submitCommand:@"clear_board" kind:GtpCommandKindGame toClient:nil];
+  [self submitCommand:@"play B D4" kind:GtpCommandKindGame toClient:nil];
+  // Is also replicated to the secondary GtpClient
+  [self submitCommand:@"uct_param_player max_games 100" kind:GtpCommandKindGame toClient:nil];
+  [self writeResponses:4 toClientAtIndex:0];
+  [self writeResponses:1 toClientAtIndex:1];
+  [self waitForNumberOfResponses:4];
+  [self waitUntilClient:self.secondaryClient hasNumberOfPendingCommands:0];
+  NSArray* commandsToReproducePosition = [self.primaryClient.positionTracker commandsToReproducePosition];
+  XCTAssertEqualObjects(commandsToReproducePosition, (@[@"boardsize 9", @"gogui-play_sequence B D4"]));
+
+  // The reservation blocks until the primary GtpClient has processed its
+  // barrier command
+  __block GtpClient* reservedClient = nil;
+  GtpEnginePool* pool = self.pool;
+  dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+    GtpClient* client = [pool reservePrimaryClient];
+    @synchronized(self)
+    {
+      reservedClient = client;
+    }
+  });
+  [self writeResponses:1 toClientAtIndex:0];
+  NSDate* timeoutDate = [NSDate dateWithTimeIntervalSinceNow:5.0];
+  while ([timeoutDate timeIntervalSinceNow] > 0)
+  {
+    @synchronized(self)
+    {
+      if (reservedClient)
+        break;
+    }
+    [NSThread sleepForTimeInterval:0.01];
+  }
+  @synchronized(self)
+  {
+    XCTAssertEqual(reservedClient, self.primaryClient);
+  }
+  XCTAssertNil([self.pool reservePrimaryClient]);
+
+  [self submitCommand:@"boardsize 19" kind:GtpCommandKindGame toClient:self.primaryClient];
+  [self submitCommand:@"clear_board" kind:GtpCommandKindGame toClient:self.primaryClient];
+  [self writeResponses:2 toClientAtIndex:0];
+  [self waitForNumberOfResponses:6];
+  XCTAssertEqualObjects([self.primaryClient.positionTracker commandsToReproducePosition], (@[@"boardsize 19"]));
+
+  // The configuration command and the two commands that restore the board
+  // position
+  [self.pool releasePrimaryClient:self.primaryClient];
+  [self writeResponses:3 toClientAtIndex:0];
+  [self waitUntilClient:self.primaryClient hasNumberOfPendingCommands:0];
+  timeoutDate = [NSDate dateWithTimeIntervalSinceNow:5.0];
+  while (! [[self.primaryClient.positionTracker commandsToReproducePosition] isEqualToArray:commandsToReproducePosition] && [timeoutDate timeIntervalSinceNow] > 0)
+    [NSThread sleepForTimeInterval:0.01];
+  XCTAssertEqualObjects([self.primaryClient.positionTracker commandsToReproducePosition], commandsToReproducePosition);
+}
+
+#pragma mark - Helper methods
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns a new asynchronous command of kind @a kind
+/// whose response is delivered to responseReceived:().
+// -----------------------------------------------------------------------------
+- (GtpCommand*) commandWithString:(NSString*)commandString kind:(enum GtpCommandKind)kind
+{
+  GtpCommand* command = [GtpCommand asynchronousCommand:commandString
+                                         responseTarget:self
+                                               selector:@selector(responseReceived:)];
+  command.kind = kind;
+  return command;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Submits the asynchronous command @a commandString of
+/// kind @a kind to @a client, or to the GtpEnginePool if @a client is @e nil.
+/// Returns the command.
+// -----------------------------------------------------------------------------
+- (GtpCommand*) submitCommand:(NSString*)commandString kind:(enum GtpCommandKind)kind toClient:(GtpClient*)client
+{
+  GtpCommand* command = [self commandWithString:commandString kind:kind];
+  if (client)
+    [client submit:command];
+  else
+    [self.pool submit:command];
+  return command;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Writes @a numberOfResponses successful responses
+/// into the response pipe of the GtpClient at index @a indexOfClient.
+// -----------------------------------------------------------------------------
+- (void) writeResponses:(int)numberOfResponses toClientAtIndex:(NSUInteger)indexOfClient
+{
+  std::ostream responseStream(responseStreamBuffers[indexOfClient]);
+  for (int responseIndex = 0; responseIndex < numberOfResponses; ++responseIndex)
+    responseStream << "= \n\n";
+  responseStream << std::flush;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Waits until @a client has taken commands out of its
+/// queue so that only @a numberOfPendingCommands remain, or until a timeout
+/// occurs.
+// -----------------------------------------------------------------------------
+- (void) waitUntilClient:(GtpClient*)client hasNumberOfPendingCommands:(int)numberOfPendingCommands
+{
+  NSDate* timeoutDate = [NSDate dateWithTimeIntervalSinceNow:5.0];
+  while (client.numberOfPendingCommands > numberOfPendingCommands && [timeoutDate timeIntervalSinceNow] > 0)
+    [NSThread sleepForTimeInterval:0.01];
+  XCTAssertEqual(client.numberOfPendingCommands, numberOfPendingCommands);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Runs the main thread's run loop until at least
+/// @a numberOfResponses responses were received, or until a timeout occurs.
+// -----------------------------------------------------------------------------
+- (void) waitForNumberOfResponses:(NSUInteger)numberOfResponses
+{
+  NSDate* timeoutDate = [NSDate dateWithTimeIntervalSinceNow:5.0];
+  while (self.commandsWithResponse.count < numberOfResponses && [timeoutDate timeIntervalSinceNow] > 0)
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+  XCTAssertEqual(self.commandsWithResponse.count, numberOfResponses);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns the command strings of the responses
+/// received so far, in the order in which the responses were received.
+// -----------------------------------------------------------------------------
+- (NSArray*) commandsWithResponseStrings
+{
+  NSMutableArray* commands = [NSMutableArray array];
+  for (GtpCommand* command in self.commandsWithResponse)
+    [commands addObject:command.command];
+  return commands;
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Is invoked in the context of the main thread when a GtpClient has
+/// received the response to a command, or has dropped a command.
+// -----------------------------------------------------------------------------
+- (void) responseReceived:(GtpResponse*)response
+{
+  [self.commandsWithResponse addObject:response.command];
+}
+
+@end
@@ -0,0 +1,260 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GtpEnginePositionTrackerTest.h"
+
+// Application includes
+#import <gtp/GtpCommand.h>
+#import <gtp/GtpEnginePositionTracker.h>
+#import <gtp/GtpResponse.h>
+
+
+@implementation GtpEnginePositionTrackerTest
+
+// -----------------------------------------------------------------------------
+/// @brief Checks the initial state of a GtpEnginePositionTracker object.
+// -----------------------------------------------------------------------------
+- (void) testInitialState
+{
+  GtpEnginePositionTracker* testee = [[[GtpEnginePositionTracker alloc] init] autorelease];
+  XCTAssertNil([testee movesIfSetupCommandsMatch:@[]]);
+  XCTAssertNil([testee commandsToReproducePosition]);
+
+  // Setup commands and moves are ignored while the position is invalid
+  [self trackCommand:@"komi 6.5" withTracker:testee];
+  [self trackCommand:@"play B D4" withTracker:testee];
+  XCTAssertNil([testee movesIfSetupCommandsMatch:@[@"komi 6.5"]]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the incremental tracking of moves played with the
+/// different move commands.
+// -----------------------------------------------------------------------------
+- (void) testIncrementalSync
+{
+  GtpEnginePositionTracker* testee = [[[GtpEnginePositionTracker alloc] init] autorelease];
+  [self trackCommand:@"boardsize 19" withTracker:testee];
+  XCTAssertEqualObjects([testee movesIfSetupCommandsMatch:@[]], @[]);
+
+  [self trackCommand:@"komi 6.5" withTracker:testee];
+  NSArray* setupCommands = @[@"komi 6.5"];
+  XCTAssertEqualObjects([testee movesIfSetupCommandsMatch:setupCommands], @[]);
+
+  [self trackCommand:@"play b d4" withTracker:testee];
+  NSArray* expectedMoves = @[@"B D4"];
+  XCTAssertEqualObjects([testee movesIfSetupCommandsMatch:setupCommands], expectedMoves);
+
+  [self trackCommand:@"gogui-play_sequence white Q16 black pass" withTracker:testee];
+  expectedMoves = @[@"B D4", @"W Q16", @"B PASS"];
+  XCTAssertEqualObjects([testee movesIfSetupCommandsMatch:setupCommands], expectedMoves);
+
+  [self trackCommand:@"genmove W" response:@"= c3\n\n" withTracker:testee];
+  expectedMoves = @[@"B D4", @"W Q16", @"B PASS", @"W C3"];
+  XCTAssertEqualObjects([testee movesIfSetupCommandsMatch:setupCommands], expectedMoves);
+
+  // Resigning does not change the board position
+  [self trackCommand:@"genmove B" response:@"= resign\n\n" withTracker:testee];
+  XCTAssertEqualObjects([testee movesIfSetupCommandsMatch:setupCommands], expectedMoves);
+
+  // Clearing the board forgets both setup commands and moves
+  [self trackCommand:@"clear_board" withTracker:testee];
+  XCTAssertEqualObjects([testee movesIfSetupCommandsMatch:@[]], @[]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises movesIfSetupCommandsMatch:() with setup commands that do
+/// not match the tracked setup commands.
+// -----------------------------------------------------------------------------
+- (void) testSetupMismatch
+{
+  GtpEnginePositionTracker* testee = [[[GtpEnginePositionTracker alloc] init] autorelease];
+  [self trackCommand:@"clear_board" withTracker:testee];
+  [self trackCommand:@"komi 6.5" withTracker:testee];
+  [self trackCommand:@"gogui-setup B D4 W Q16" withTracker:testee];
+  [self trackCommand:@"play B C3" withTracker:testee];
+
+  NSArray* setupCommands = @[@"komi 6.5", @"gogui-setup B D4 W Q16"];
+  XCTAssertEqualObjects([testee movesIfSetupCommandsMatch:setupCommands], @[@"B C3"]);
+  // Different value
+  XCTAssertNil([testee movesIfSetupCommandsMatch:@[@"komi 0.5", @"gogui-setup B D4 W Q16"]]);
+  // Missing command
+  XCTAssertNil([testee movesIfSetupCommandsMatch:@[@"komi 6.5"]]);
+  // Different order
+  XCTAssertNil([testee movesIfSetupCommandsMatch:@[@"gogui-setup B D4 W Q16", @"komi 6.5"]]);
+
+  // A setup command after a move cannot be replayed verbatim, so the position
+  // becomes invalid
+  [self trackCommand:@"gogui-setup_player W" withTracker:testee];
+  XCTAssertNil([testee movesIfSetupCommandsMatch:setupCommands]);
+  XCTAssertNil([testee movesIfSetupCommandsMatch:@[@"komi 6.5", @"gogui-setup B D4 W Q16", @"gogui-setup_player W"]]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the tracking of the "undo" and "gg-undo" commands.
+// -----------------------------------------------------------------------------
+- (void) testUndo
+{
+  GtpEnginePositionTracker* testee = [[[GtpEnginePositionTracker alloc] init] autorelease];
+  [self trackCommand:@"clear_board" withTracker:testee];
+  [self trackCommand:@"gogui-play_sequence B D4 W Q16 B C3 W R17" withTracker:testee];
+
+  [self trackCommand:@"undo" withTracker:testee];
+  NSArray* expectedMoves = @[@"B D4", @"W Q16", @"B C3"];
+  XCTAssertEqualObjects([testee movesIfSetupCommandsMatch:@[]], expectedMoves);
+
+  [self trackCommand:@"gg-undo 2" withTracker:testee];
+  expectedMoves = @[@"B D4"];
+  XCTAssertEqualObjects([testee movesIfSetupCommandsMatch:@[]], expectedMoves);
+
+  // A failed undo leaves the engine in an unknown state
+  [self trackCommand:@"undo" response:@"? cannot undo\n\n" withTracker:testee];
+  XCTAssertNil([testee movesIfSetupCommandsMatch:@[]]);
+
+  // Undoing more moves than were tracked invalidates the position
+  [self trackCommand:@"clear_board" withTracker:testee];
+  [self trackCommand:@"play B D4" withTracker:testee];
+  [self trackCommand:@"gg-undo 2" withTracker:testee];
+  XCTAssertNil([testee movesIfSetupCommandsMatch:@[]]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that a failed command that changes the board position
+/// invalidates the tracked position, and that "clear_board" makes it valid
+/// again.
+// -----------------------------------------------------------------------------
+- (void) testFailedCommand
+{
+  GtpEnginePositionTracker* testee = [[[GtpEnginePositionTracker alloc] init] autorelease];
+  [self trackCommand:@"clear_board" withTracker:testee];
+  [self trackCommand:@"play B D4" withTracker:testee];
+  [self trackCommand:@"play W D4" response:@"? illegal move\n\n" withTracker:testee];
+  XCTAssertNil([testee movesIfSetupCommandsMatch:@[]]);
+
+  [self trackCommand:@"play W Q16" withTracker:testee];
+  XCTAssertNil([testee movesIfSetupCommandsMatch:@[]]);
+
+  [self trackCommand:@"clear_board" withTracker:testee];
+  XCTAssertEqualObjects([testee movesIfSetupCommandsMatch:@[]], @[]);
+
+  // Commands that do not change the board position are ignored, even if they
+  // fail
+  [self trackCommand:@"showboard" response:@"? failed\n\n" withTracker:testee];
+  XCTAssertEqualObjects([testee movesIfSetupCommandsMatch:@[]], @[]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Checks that commands which change the board position in a way that
+/// GtpEnginePositionTracker does not replicate invalidate the tracked position.
+// -----------------------------------------------------------------------------
+- (void) testUnsupportedCommand
+{
+  NSArray* unsupportedCommands = @[@"fixed_handicap 2", @"place_free_handicap 2", @"set_free_handicap D4 Q16", @"loadsgf foo.sgf", @"quit"];
+  for (NSString* unsupportedCommand in unsupportedCommands)
+  {
+    GtpEnginePositionTracker* testee = [[[GtpEnginePositionTracker alloc] init] autorelease];
+    [self trackCommand:@"clear_board" withTracker:testee];
+    [self trackCommand:unsupportedCommand withTracker:testee];
+    XCTAssertNil([testee movesIfSetupCommandsMatch:@[]], @"%@", unsupportedCommand);
+  }
+
+  GtpEnginePositionTracker* testee = [[[GtpEnginePositionTracker alloc] init] autorelease];
+  [self trackCommand:@"clear_board" withTracker:testee];
+  [testee invalidate];
+  XCTAssertNil([testee movesIfSetupCommandsMatch:@[]]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the commandsToReproducePosition() method.
+// -----------------------------------------------------------------------------
+- (void) testCommandsToReproducePosition
+{
+  GtpEnginePositionTracker* testee = [[[GtpEnginePositionTracker alloc] init] autorelease];
+
+  // The board size is not known
+  [self trackCommand:@"clear_board" withTracker:testee];
+  XCTAssertNil([testee commandsToReproducePosition]);
+
+  [self trackCommand:@"boardsize 9" withTracker:testee];
+  NSArray* expectedCommands = @[@"boardsize 9"];
+  XCTAssertEqualObjects([testee commandsToReproducePosition], expectedCommands);
+
+  [self trackCommand:@"komi 7.5" withTracker:testee];
+  [self trackCommand:@"play B E5" withTracker:testee];
+  [self trackCommand:@"play W C3" withTracker:testee];
+  expectedCommands = @[@"boardsize 9", @"komi 7.5", @"gogui-play_sequence B E5 W C3"];
+  XCTAssertEqualObjects([testee commandsToReproducePosition], expectedCommands);
+
+  // The board size is remembered when the board is cleared
+  [self trackCommand:@"clear_board" withTracker:testee];
+  expectedCommands = @[@"boardsize 9"];
+  XCTAssertEqualObjects([testee commandsToReproducePosition], expectedCommands);
+
+  // A failed "boardsize" command forgets the board size
+  [self trackCommand:@"boardsize 42" response:@"? unacceptable size\n\n" withTracker:testee];
+  [self trackCommand:@"clear_board" withTracker:testee];
+  XCTAssertNil([testee commandsToReproducePosition]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the isSamePositionAsTracker:() method.
+// -----------------------------------------------------------------------------
+- (void) testIsSamePositionAsTracker
+{
+  GtpEnginePositionTracker* testee1 = [[[GtpEnginePositionTracker alloc] init] autorelease];
+  GtpEnginePositionTracker* testee2 = [[[GtpEnginePositionTracker alloc] init] autorelease];
+  XCTAssertFalse([testee1 isSamePositionAsTracker:testee2]);
+
+  [self trackCommand:@"boardsize 19" withTracker:testee1];
+  [self trackCommand:@"play B D4" withTracker:testee1];
+  XCTAssertFalse([testee1 isSamePositionAsTracker:testee2]);
+
+  // A different command sequence that results in the same normalized moves
+  [self trackCommand:@"boardsize 19" withTracker:testee2];
+  [self trackCommand:@"genmove black" response:@"= D4\n\n" withTracker:testee2];
+  XCTAssertTrue([testee1 isSamePositionAsTracker:testee2]);
+  XCTAssertTrue([testee2 isSamePositionAsTracker:testee1]);
+
+  [self trackCommand:@"play W Q16" withTracker:testee2];
+  XCTAssertFalse([testee1 isSamePositionAsTracker:testee2]);
+}
+
+#pragma mark - Helper methods
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Lets @a tracker track the successful execution of
+/// the GTP command @a commandString.
+// -----------------------------------------------------------------------------
+- (void) trackCommand:(NSString*)commandString withTracker:(GtpEnginePositionTracker*)tracker
+{
+  [self trackCommand:commandString response:@"= \n\n" withTracker:tracker];
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Lets @a tracker track the execution of the GTP
+/// command @a commandString, which the GTP engine answered with the raw
+/// response @a responseString.
+// -----------------------------------------------------------------------------
+- (void) trackCommand:(NSString*)commandString response:(NSString*)responseString withTracker:(GtpEnginePositionTracker*)tracker
+{
+  GtpCommand* command = [GtpCommand command:commandString];
+  NSData* responseData = [responseString dataUsingEncoding:[NSString defaultCStringEncoding]];
+  GtpResponse* response = [GtpResponse responseWithData:responseData toCommand:command];
+  [tracker trackResponse:response];
+}
+
+@end
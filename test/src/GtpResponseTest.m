@@ -0,0 +1,195 @@
+// -----------------------------------------------------------------------------
+// Copyright 2026 Patrick Näf (herzbube@herzbube.ch)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// -----------------------------------------------------------------------------
+
+
+// Test includes
+#import "GtpResponseTest.h"
+
+// Application includes
+#import <go/GoVertexNumeric.h>
+#import <gtp/GtpCommand.h>
+#import <gtp/GtpResponse.h>
+
+
+@implementation GtpResponseTest
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the @e status property and the parsedResponse() method.
+// -----------------------------------------------------------------------------
+- (void) testStatusAndParsedResponse
+{
+  GtpResponse* response = [self responseWithString:@"= D4\n\n"];
+  XCTAssertTrue(response.status);
+  XCTAssertEqualObjects(response.rawResponse, @"= D4\n\n");
+  XCTAssertEqualObjects(response.parsedResponse, @"D4\n\n");
+
+  response = [self responseWithString:@"? unknown command\n\n"];
+  XCTAssertFalse(response.status);
+  XCTAssertEqualObjects(response.parsedResponse, @"unknown command\n\n");
+
+  response = [self responseWithString:@""];
+  XCTAssertFalse(response.status);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the decodeFloatGrid:numberOfRows:numberOfColumns:()
+/// method.
+// -----------------------------------------------------------------------------
+- (void) testDecodeFloatGrid
+{
+  float values[6];
+
+  GtpResponse* response = [self responseWithString:@"= \n 0.5 -1 0.25\n\n1e-2  0 1.0\n\n"];
+  XCTAssertTrue([response decodeFloatGrid:values numberOfRows:2 numberOfColumns:3]);
+  XCTAssertEqual(values[0], 0.5f);
+  XCTAssertEqual(values[1], -1.0f);
+  XCTAssertEqual(values[2], 0.25f);
+  XCTAssertEqual(values[3], 0.01f);
+  XCTAssertEqual(values[4], 0.0f);
+  XCTAssertEqual(values[5], 1.0f);
+
+  // Not enough values in a row
+  response = [self responseWithString:@"= 0.5 -1\n1 2 3\n\n"];
+  XCTAssertFalse([response decodeFloatGrid:values numberOfRows:2 numberOfColumns:3]);
+  // Too many rows
+  response = [self responseWithString:@"= 1 2 3\n4 5 6\n7 8 9\n\n"];
+  XCTAssertFalse([response decodeFloatGrid:values numberOfRows:2 numberOfColumns:3]);
+  // Not enough rows
+  response = [self responseWithString:@"= 1 2 3\n\n"];
+  XCTAssertFalse([response decodeFloatGrid:values numberOfRows:2 numberOfColumns:3]);
+  // Not a number
+  response = [self responseWithString:@"= 1 2 x\n4 5 6\n\n"];
+  XCTAssertFalse([response decodeFloatGrid:values numberOfRows:2 numberOfColumns:3]);
+  // Failure response
+  response = [self responseWithString:@"? 1 2 3\n4 5 6\n\n"];
+  XCTAssertFalse([response decodeFloatGrid:values numberOfRows:2 numberOfColumns:3]);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the decodeVertexList:capacity:() method.
+// -----------------------------------------------------------------------------
+- (void) testDecodeVertexList
+{
+  struct GoVertexNumeric vertices[3];
+
+  GtpResponse* response = [self responseWithString:@"= A1 j10\nT19\n\n"];
+  XCTAssertEqual([response decodeVertexList:vertices capacity:3], 3);
+  XCTAssertEqual(vertices[0].x, 1);
+  XCTAssertEqual(vertices[0].y, 1);
+  // "I" is not used, so "J" is the 9th column
+  XCTAssertEqual(vertices[1].x, 9);
+  XCTAssertEqual(vertices[1].y, 10);
+  XCTAssertEqual(vertices[2].x, 19);
+  XCTAssertEqual(vertices[2].y, 19);
+
+  // Command ID between status and body
+  response = [self responseWithString:@"=42 D4\n\n"];
+  XCTAssertEqual([response decodeVertexList:vertices capacity:3], 1);
+  XCTAssertEqual(vertices[0].x, 4);
+  XCTAssertEqual(vertices[0].y, 4);
+
+  response = [self responseWithString:@"= \n\n"];
+  XCTAssertEqual([response decodeVertexList:vertices capacity:3], 0);
+
+  // Capacity exceeded
+  response = [self responseWithString:@"= A1 A2 A3 A4\n\n"];
+  XCTAssertEqual([response decodeVertexList:vertices capacity:3], -1);
+  // Invalid vertices
+  NSArray* invalidResponses = @[@"= I5\n\n", @"= A0\n\n", @"= A20\n\n", @"= U1\n\n", @"= A\n\n", @"= pass\n\n", @"? A1\n\n"];
+  for (NSString* invalidResponse in invalidResponses)
+  {
+    response = [self responseWithString:invalidResponse];
+    XCTAssertEqual([response decodeVertexList:vertices capacity:3], -1, @"%@", invalidResponse);
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the decodeMove:() method.
+// -----------------------------------------------------------------------------
+- (void) testDecodeMove
+{
+  struct GoVertexNumeric vertex;
+
+  GtpResponse* response = [self responseWithString:@"= q16\n\n"];
+  XCTAssertEqual([response decodeMove:&vertex], GtpMoveResponseTypeVertex);
+  XCTAssertEqual(vertex.x, 16);
+  XCTAssertEqual(vertex.y, 16);
+
+  response = [self responseWithString:@"= PASS\n\n"];
+  XCTAssertEqual([response decodeMove:&vertex], GtpMoveResponseTypePass);
+  response = [self responseWithString:@"= resign\n\n"];
+  XCTAssertEqual([response decodeMove:&vertex], GtpMoveResponseTypeResign);
+
+  response = [self responseWithString:@"= \n\n"];
+  XCTAssertEqual([response decodeMove:&vertex], GtpMoveResponseTypeInvalid);
+  response = [self responseWithString:@"= D4 D5\n\n"];
+  XCTAssertEqual([response decodeMove:&vertex], GtpMoveResponseTypeInvalid);
+  response = [self responseWithString:@"= foo\n\n"];
+  XCTAssertEqual([response decodeMove:&vertex], GtpMoveResponseTypeInvalid);
+  response = [self responseWithString:@"? D4\n\n"];
+  XCTAssertEqual([response decodeMove:&vertex], GtpMoveResponseTypeInvalid);
+}
+
+// -----------------------------------------------------------------------------
+/// @brief Exercises the enumerateKeyValuePairsUsingBlock:() method.
+// -----------------------------------------------------------------------------
+- (void) testEnumerateKeyValuePairs
+{
+  NSMutableArray* keys = [NSMutableArray array];
+  NSMutableArray* values = [NSMutableArray array];
+  void (^collectBlock)(const char*, size_t, const char*, size_t, bool*) = ^(const char* key, size_t keyLength, const char* value, size_t valueLength, bool* stop)
+  {
+    [keys addObject:[[[NSString alloc] initWithBytes:key length:keyLength encoding:NSASCIIStringEncoding] autorelease]];
+    [values addObject:[[[NSString alloc] initWithBytes:value length:valueLength encoding:NSASCIIStringEncoding] autorelease]];
+  };
+
+  GtpResponse* response = [self responseWithString:@"= Count 1234\n  Nodes   10 20  \n\nEmpty\n\n"];
+  [response enumerateKeyValuePairsUsingBlock:collectBlock];
+  NSArray* expectedKeys = @[@"Count", @"Nodes", @"Empty"];
+  NSArray* expectedValues = @[@"1234", @"10 20", @""];
+  XCTAssertEqualObjects(keys, expectedKeys);
+  XCTAssertEqualObjects(values, expectedValues);
+
+  // Stop flag
+  [keys removeAllObjects];
+  [response enumerateKeyValuePairsUsingBlock:^(const char* key, size_t keyLength, const char* value, size_t valueLength, bool* stop)
+  {
+    [keys addObject:[[[NSString alloc] initWithBytes:key length:keyLength encoding:NSASCIIStringEncoding] autorelease]];
+    *stop = true;
+  }];
+  XCTAssertEqual(keys.count, 1);
+
+  // Failure response
+  [keys removeAllObjects];
+  response = [self responseWithString:@"? Count 1234\n\n"];
+  [response enumerateKeyValuePairsUsingBlock:collectBlock];
+  XCTAssertEqual(keys.count, 0);
+}
+
+#pragma mark - Helper methods
+
+// -----------------------------------------------------------------------------
+/// @brief Private helper. Returns a GtpResponse object that wraps the raw
+/// response @a responseString.
+// -----------------------------------------------------------------------------
+- (GtpResponse*) responseWithString:(NSString*)responseString
+{
+  GtpCommand* command = [GtpCommand command:@"test"];
+  NSData* responseData = [responseString dataUsingEncoding:[NSString defaultCStringEncoding]];
+  return [GtpResponse responseWithData:responseData toCommand:command];
+}
+
+@end